@@ -0,0 +1,108 @@
+// Tests that a clustered collection stores its documents keyed by _id, without an _id index.
+(function() {
+    "use strict";
+
+    load("jstests/libs/analyze_plan.js");
+
+    // Skip this test if not running with the "wiredTiger" storage engine.
+    const storageEngine = jsTest.options().storageEngine || "wiredTiger";
+    if (storageEngine !== "wiredTiger") {
+        print('Skipping test because storageEngine is not "wiredTiger"');
+        return;
+    }
+
+    const conn = MongoRunner.runMongod();
+    const testDB = conn.getDB("test");
+    const coll = testDB.clustered_collection;
+
+    assert.commandWorked(testDB.createCollection(coll.getName(), {clustered: true}));
+    assert.eq(0, coll.getIndexes().length);
+    assert.commandFailedWithCode(
+        testDB.createCollection("capped_clustered", {clustered: true, capped: true, size: 4096}),
+        ErrorCodes.InvalidOptions);
+
+    // Integer and date _ids, inserted out of order, come back in _id order.
+    const docs = [
+        {_id: 3},
+        {_id: ISODate("2019-01-01")},
+        {_id: -1},
+        {_id: NumberLong(10)},
+        {_id: ISODate("1969-12-31")},
+    ];
+    assert.commandWorked(coll.insert(docs, {ordered: false}));
+    assert.eq(
+        [-1, 3, NumberLong(10), ISODate("1969-12-31"), ISODate("2019-01-01")],
+        coll.find().toArray().map(doc => doc._id));
+
+    // The _id stays unique, and must be an integer or a date.
+    assert.commandFailedWithCode(coll.insert({_id: 3.0}), ErrorCodes.DuplicateKey);
+    assert.commandFailedWithCode(coll.insert({_id: "abc"}), ErrorCodes.BadValue);
+    assert.commandFailedWithCode(coll.insert({a: 1}), ErrorCodes.BadValue);
+
+    // Lookups by _id read only the document with that _id.
+    const explain = assert.commandWorked(coll.find({_id: 3}).explain("executionStats"));
+    assert(isCollscan(testDB, explain.queryPlanner.winningPlan), tojson(explain));
+    assert.eq(1, explain.executionStats.nReturned, tojson(explain));
+    assert.eq(1, explain.executionStats.totalDocsExamined, tojson(explain));
+    assert.eq(null, coll.findOne({_id: 4}));
+    assert.eq(null, coll.findOne({_id: "abc"}));
+
+    assert.commandWorked(coll.update({_id: 3}, {$set: {a: 1}}));
+    assert.eq({_id: 3, a: 1}, coll.findOne({_id: 3}));
+    assert.commandWorked(coll.update({_id: 4}, {$set: {a: 2}}, {upsert: true}));
+    assert.eq({_id: 4, a: 2}, coll.findOne({_id: 4}));
+    assert.commandWorked(coll.remove({_id: ISODate("2019-01-01")}));
+    assert.eq(5, coll.find().itcount());
+
+    // A duplicate _id is still rejected after reads and updates, which leave cursors that allow
+    // overwrites in the session's cursor cache, and the existing document is left unchanged.
+    assert.eq({_id: 4, a: 2}, coll.findOne({_id: 4}));
+    assert.commandFailedWithCode(coll.insert({_id: 4, a: 3}), ErrorCodes.DuplicateKey);
+    assert.commandWorked(coll.update({_id: 4}, {$set: {a: 3}}));
+    assert.commandFailedWithCode(coll.insert({_id: 4, a: 4}), ErrorCodes.DuplicateKey);
+    assert.eq({_id: 4, a: 3}, coll.findOne({_id: 4}));
+
+    // An update after a rejected insert still overwrites the document in place.
+    assert.commandWorked(coll.update({_id: 4}, {$set: {a: 2}}));
+    assert.eq({_id: 4, a: 2}, coll.findOne({_id: 4}));
+
+    // Secondary indexes work as usual.
+    assert.commandWorked(coll.createIndex({a: 1}));
+    assert.eq([3], coll.find({a: 1}).toArray().map(doc => doc._id));
+
+    // Ranges of _ids read only the documents in the range, in either direction, and sorts on _id
+    // need no SORT stage.
+    const rangeColl = testDB.clustered_collection_range;
+    assert.commandWorked(testDB.createCollection(rangeColl.getName(), {clustered: true}));
+    const rangeDocs = [];
+    for (let i = 0; i < 100; ++i) {
+        rangeDocs.push({_id: i, a: i % 3});
+    }
+    rangeDocs.push({_id: ISODate("2019-01-01"), a: 0});
+    assert.commandWorked(rangeColl.insert(rangeDocs));
+
+    function assertRangeScan(filter, sort, expectedIds, maxDocsExamined) {
+        const explain =
+            assert.commandWorked(rangeColl.find(filter).sort(sort).explain("executionStats"));
+        assert(isCollscan(testDB, explain.queryPlanner.winningPlan), tojson(explain));
+        assert(!planHasStage(testDB, explain.queryPlanner.winningPlan, "SORT"), tojson(explain));
+        assert.lte(explain.executionStats.totalDocsExamined, maxDocsExamined, tojson(explain));
+        assert.eq(expectedIds, rangeColl.find(filter).sort(sort).toArray().map(doc => doc._id));
+    }
+
+    assertRangeScan({_id: {$gte: 10, $lt: 15}}, {_id: 1}, [10, 11, 12, 13, 14], 6);
+    assertRangeScan({_id: {$gte: 10, $lt: 15}}, {_id: -1}, [14, 13, 12, 11, 10], 6);
+    assertRangeScan({_id: {$gt: 10, $lte: 15}, a: 0}, {_id: 1}, [12, 15], 6);
+    assertRangeScan({_id: {$gt: 96}}, {_id: -1}, [99, 98, 97], 5);
+    assertRangeScan({_id: {$lt: 3}}, {}, [0, 1, 2], 4);
+    assertRangeScan({_id: {$gte: 1000, $lt: 2000}}, {_id: 1}, [], 0);
+    assertRangeScan({_id: {$lt: -5}}, {_id: -1}, [], 0);
+
+    const sorted = rangeColl.find().sort({_id: -1}).toArray().map(doc => doc._id);
+    assert.eq(rangeDocs.map(doc => doc._id).reverse(), sorted);
+    const sortExplain = rangeColl.find({a: 1}).sort({_id: -1}).explain();
+    assert(!planHasStage(testDB, sortExplain.queryPlanner.winningPlan, "SORT"),
+           tojson(sortExplain));
+
+    MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,31 @@
+// Validate that the high frequency FTDC collector is only installed when high frequency sampling is
+// enabled at startup.
+load('jstests/libs/ftdc.js');
+
+(function() {
+    'use strict';
+
+    function setHighFrequencyPeriod(adminDb, millis) {
+        return adminDb.runCommand(
+            {setParameter: 1, diagnosticDataCollectionHighFrequencyPeriodMillis: millis});
+    }
+
+    let m = MongoRunner.runMongod();
+    let adminDb = m.getDB("admin");
+    verifyGetDiagnosticData(adminDb);
+    let data = assert.commandWorked(adminDb.runCommand("getDiagnosticData")).data;
+    assert(!data.hasOwnProperty("serverStatusHighFrequency"), tojson(data));
+    assert.commandFailedWithCode(setHighFrequencyPeriod(adminDb, 100),
+                                 ErrorCodes.IllegalOperation);
+    MongoRunner.stopMongod(m);
+
+    m = MongoRunner.runMongod(
+        {setParameter: {diagnosticDataCollectionHighFrequencyPeriodMillis: 100}});
+    adminDb = m.getDB("admin");
+    verifyGetDiagnosticData(adminDb);
+    data = assert.commandWorked(adminDb.runCommand("getDiagnosticData")).data;
+    assert(data.hasOwnProperty("serverStatusHighFrequency"), tojson(data));
+    assert.commandWorked(setHighFrequencyPeriod(adminDb, 0));
+    assert.commandWorked(setHighFrequencyPeriod(adminDb, 200));
+    MongoRunner.stopMongod(m);
+})();
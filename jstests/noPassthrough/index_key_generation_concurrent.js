@@ -0,0 +1,90 @@
+// Tests that writes to a collection with several expensive indexes, whose keys are generated on the
+// shared key generation threads, leave the indexes consistent with the documents, and that key
+// generation errors on those threads fail the write as they would on the operation's thread. Also
+// tests which indexes of a single-document write the default settings hand to those threads.
+(function() {
+    "use strict";
+
+    // A threshold of 1 hands every index but one to the key generation threads.
+    const conn = MongoRunner.runMongod(
+        {setParameter: {indexKeyGenerationParallelCostThreshold: 1, indexKeyGenerationThreads: 2}});
+    assert.neq(null, conn, "mongod was unable to start up");
+
+    const testDB = conn.getDB("test");
+    const coll = testDB.index_key_generation_concurrent;
+
+    assert.commandWorked(coll.createIndex({title: "text"}));
+    assert.commandWorked(coll.createIndex({loc: "2dsphere"}));
+    assert.commandWorked(coll.createIndex({"attrs.$**": 1}));
+    assert.commandWorked(coll.createIndex({n: 1}));
+    assert.commandWorked(coll.createIndex({tags: 1}, {partialFilterExpression: {n: {$gte: 50}}}));
+
+    const bulk = coll.initializeUnorderedBulkOp();
+    for (let i = 0; i < 100; i++) {
+        bulk.insert({
+            _id: i,
+            n: i,
+            title: "document number " + i + (i % 2 ? " odd" : " even"),
+            loc: {type: "Point", coordinates: [i % 180, (i % 90) - 45]},
+            attrs: {a: i, b: [i, i + 1]},
+            tags: ["t" + (i % 5)],
+        });
+    }
+    assert.writeOK(bulk.execute());
+
+    assert.eq(50, coll.find({$text: {$search: "odd"}}).itcount());
+    const point = {type: "Point", coordinates: [3, -42]};
+    assert.eq(1, coll.find({loc: {$geoIntersects: {$geometry: point}}}).itcount());
+    assert.eq(2, coll.find({"attrs.b": 10}).itcount());
+    assert.eq(10, coll.find({tags: "t0", n: {$gte: 50}}).hint({tags: 1}).itcount());
+
+    // Updates generate the keys of both versions of the document on the same threads.
+    assert.writeOK(coll.update({_id: 1}, {$set: {title: "renamed", "attrs.a": -1}}));
+    assert.eq(0, coll.find({_id: 1, $text: {$search: "odd"}}).itcount());
+    assert.eq(1, coll.find({"attrs.a": -1}).itcount());
+
+    // An invalid geometry fails the insert, and no index gets any key of the failed batch.
+    const badPoint = {type: "Point", coordinates: [500, 500]};
+    assert.writeErrorWithCode(coll.insert({_id: 100, title: "bad", loc: badPoint}), 16755);
+    assert.eq(0, coll.find({title: "bad"}).itcount());
+    assert.eq(0, coll.find({$text: {$search: "bad"}}).itcount());
+
+    const validateRes = assert.commandWorked(coll.validate({full: true}));
+    assert(validateRes.valid, tojson(validateRes));
+
+    MongoRunner.stopMongod(conn);
+
+    // With the default settings, a single-document write keeps a lone expensive index on the
+    // operation's thread, which would otherwise have little to do but wait. A second expensive
+    // index lets it hand one of the two to the key generation threads.
+    const defaultConn = MongoRunner.runMongod();
+    assert.neq(null, defaultConn, "mongod was unable to start up");
+    const defaultDB = defaultConn.getDB("test");
+
+    function offloadedCount() {
+        const status = assert.commandWorked(defaultDB.adminCommand({serverStatus: 1}));
+        return status.metrics.indexKeyGeneration.offloaded;
+    }
+
+    const btreeColl = defaultDB.index_key_generation_btree;
+    assert.commandWorked(btreeColl.createIndex({a: 1, b: 1}));
+    let offloaded = offloadedCount();
+    assert.writeOK(btreeColl.insert({_id: 0, a: 1, b: 1}));
+    assert.eq(offloaded, offloadedCount());
+
+    const textColl = defaultDB.index_key_generation_text;
+    assert.commandWorked(textColl.createIndex({title: "text"}));
+    offloaded = offloadedCount();
+    assert.writeOK(textColl.insert({_id: 0, title: "a single document"}));
+    assert.eq(offloaded, offloadedCount());
+    assert.eq(1, textColl.find({$text: {$search: "single"}}).itcount());
+
+    assert.commandWorked(textColl.createIndex({loc: "2dsphere"}));
+    offloaded = offloadedCount();
+    assert.writeOK(textColl.insert(
+        {_id: 1, title: "another document", loc: {type: "Point", coordinates: [1, 1]}}));
+    assert.eq(offloaded + 1, offloadedCount());
+    assert.eq(1, textColl.find({$text: {$search: "another"}}).itcount());
+
+    MongoRunner.stopMongod(defaultConn);
+})();
@@ -0,0 +1,46 @@
+// Tests that with 'internalQueryPlannerGenerateSkipScans' distinct, and a $group which is rewritten
+// as a DISTINCT_SCAN, skip over the values of a leading index field to the bounds on a later one.
+(function() {
+    "use strict";
+
+    load("jstests/libs/analyze_plan.js");
+
+    const conn =
+        MongoRunner.runMongod({setParameter: {internalQueryPlannerGenerateSkipScans: true}});
+    assert.neq(null, conn, "mongod was unable to start up");
+    const testDB = conn.getDB("test");
+    const coll = testDB.skip_scan_distinct;
+
+    assert.commandWorked(coll.createIndex({a: 1, b: 1}));
+    const bulk = coll.initializeUnorderedBulkOp();
+    for (let a = 0; a < 10; a++) {
+        for (let b = 0; b < 100; b++) {
+            bulk.insert({a: a, b: b});
+        }
+    }
+    assert.writeOK(bulk.execute());
+
+    // Each value of 'a' is found by seeking to {a: <value>, b: 5}, so only a few keys are examined
+    // per value rather than the whole index.
+    assert.eq([...Array(10).keys()], coll.distinct("a", {b: 5}).sort((x, y) => x - y));
+    let explain = coll.explain("executionStats").distinct("a", {b: 5});
+    assert(planHasStage(testDB, explain.queryPlanner.winningPlan, "DISTINCT_SCAN"),
+           tojson(explain));
+    assert.lte(explain.executionStats.totalKeysExamined, 30, tojson(explain));
+    assert.eq(0, explain.executionStats.totalDocsExamined, tojson(explain));
+
+    const pipeline = [{$match: {b: 5}}, {$sort: {a: 1}}, {$group: {_id: "$a"}}];
+    assert.eq([...Array(10).keys()], coll.aggregate(pipeline).toArray().map(doc => doc._id));
+    explain = coll.explain().aggregate(pipeline);
+    assert.neq(null, getAggPlanStage(explain, "DISTINCT_SCAN"), tojson(explain));
+
+    // Without skip scans, neither can use the index.
+    assert.commandWorked(
+        testDB.adminCommand({setParameter: 1, internalQueryPlannerGenerateSkipScans: false}));
+    explain = coll.explain("executionStats").distinct("a", {b: 5});
+    assert(isCollscan(testDB, explain.queryPlanner.winningPlan), tojson(explain));
+    explain = coll.explain().aggregate(pipeline);
+    assert.eq(null, getAggPlanStage(explain, "DISTINCT_SCAN"), tojson(explain));
+
+    MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,72 @@
+// Tests that updates which change the size of a large document are written to the storage engine
+// as damages to the old document, and that serverStatus counts damaged and rewritten updates.
+(function() {
+    "use strict";
+
+    const conn = MongoRunner.runMongod();
+    assert.neq(null, conn, "mongod was unable to start up");
+
+    const testDB = conn.getDB("test");
+    const storageEngine = testDB.serverStatus().storageEngine.name;
+    if (["wiredTiger", "inMemory", "ephemeralForTest"].indexOf(storageEngine) === -1) {
+        jsTestLog("Skipping test because " + storageEngine + " doesn't support damages");
+        MongoRunner.stopMongod(conn);
+        return;
+    }
+
+    const coll = testDB.update_with_damages;
+    assert.commandWorked(coll.createIndex({indexed: 1}));
+
+    const pad = "x".repeat(200 * 1024);
+    assert.writeOK(coll.insert({_id: 0, pad: pad, counter: NumberInt(0), tags: [], sub: {a: 1}}));
+    assert.writeOK(coll.insert({_id: 1, small: 1}));
+
+    let expected = {_id: 0, pad: pad, counter: NumberInt(0), tags: [], sub: {a: 1}};
+
+    function updateCounts() {
+        return testDB.serverStatus().metrics.record.updates;
+    }
+
+    // Runs 'update' against the document with _id 'id', and checks that it was written as damages
+    // or rewritten as expected.
+    function checkUpdate(id, update, kind) {
+        const before = updateCounts();
+        assert.writeOK(coll.update({_id: id}, update));
+        const after = updateCounts();
+        assert.eq(before.damaged + (kind === "damaged" ? 1 : 0), after.damaged, tojson(update));
+        assert.eq(
+            before.rewritten + (kind === "rewritten" ? 1 : 0), after.rewritten, tojson(update));
+    }
+
+    // $inc of an int is applied in place, and converting it to a long grows the document.
+    checkUpdate(0, {$inc: {counter: NumberInt(1)}}, "damaged");
+    checkUpdate(0, {$inc: {counter: NumberLong(1)}}, "damaged");
+    expected.counter = NumberLong(2);
+
+    // $set of a new field, $push, and $unset change the size of the document.
+    checkUpdate(0, {$set: {added: "abc"}}, "damaged");
+    expected.added = "abc";
+    checkUpdate(0, {$push: {tags: "a"}}, "damaged");
+    checkUpdate(0, {$push: {tags: {$each: ["b", "c"]}}}, "damaged");
+    expected.tags = ["a", "b", "c"];
+    checkUpdate(0, {$unset: {sub: 1}}, "damaged");
+    delete expected.sub;
+    assert.docEq(expected, coll.findOne({_id: 0}));
+
+    // Updates which affect indexes, or which change most of the document, are rewritten in full.
+    checkUpdate(0, {$set: {indexed: 1}}, "rewritten");
+    expected.indexed = 1;
+    const newPad = "y".repeat(150 * 1024);
+    checkUpdate(0, {$set: {pad: newPad}}, "rewritten");
+    expected.pad = newPad;
+    assert.docEq(expected, coll.findOne({_id: 0}));
+    assert.eq(1, coll.find({indexed: 1}).itcount());
+
+    // Small documents are always rewritten.
+    checkUpdate(1, {$set: {added: "abc"}}, "rewritten");
+    assert.docEq({_id: 1, small: 1, added: "abc"}, coll.findOne({_id: 1}));
+
+    assert.commandWorked(coll.validate(true));
+
+    MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,131 @@
+// Tests that a columnstore index answers queries which need only its paths with a COLUMN_SCAN in
+// place of a collection scan, and that it returns the same results as the collection scan.
+(function() {
+    "use strict";
+
+    load("jstests/libs/analyze_plan.js");
+
+    const coll = db.columnstore_index;
+    coll.drop();
+
+    // Options which don't apply to a columnstore index, and overlapping paths, are rejected.
+    assert.commandFailedWithCode(coll.createIndex({a: "columnstore", "a.b": "columnstore"}),
+                                 ErrorCodes.CannotCreateIndex);
+    assert.commandFailedWithCode(coll.createIndex({a: "columnstore"}, {sparse: true}),
+                                 ErrorCodes.CannotCreateIndex);
+    assert.commandFailedWithCode(coll.createIndex({a: "columnstore"}, {unique: true}),
+                                 ErrorCodes.CannotCreateIndex);
+    assert.commandFailedWithCode(
+        coll.createIndex({a: "columnstore"}, {partialFilterExpression: {a: {$gt: 0}}}),
+        ErrorCodes.CannotCreateIndex);
+
+    const docs = [
+        {_id: 0, a: 1, b: {c: "x", d: 1}},
+        {_id: 1, a: 2, b: {c: "y"}},
+        {_id: 2, a: 3},
+        {_id: 3, b: {c: "z"}},
+        {_id: 4, a: [4, 5], b: {c: ["w"]}},
+        // An array along 'b.c' makes the column scan fetch this document.
+        {_id: 5, a: 6, b: [{c: "v"}, {c: "u"}]},
+        {_id: 6, a: {nested: true}, b: 7},
+        {_id: 7},
+    ];
+    assert.commandWorked(coll.insert(docs));
+    const indexName = "columns";
+    assert.commandWorked(coll.createIndex(
+        {_id: "columnstore", a: "columnstore", "b.c": "columnstore"}, {name: indexName}));
+
+    function assertColumnScanMatchesCollScan(filter, projection) {
+        const explain = coll.find(filter, projection).explain("executionStats");
+        assert(planHasStage(db, explain, "COLUMN_SCAN"), tojson(explain));
+        assert(!planHasStage(db, explain, "COLLSCAN"), tojson(explain));
+
+        const expected = coll.find(filter, projection).hint({$natural: 1}).toArray();
+        assert.sameMembers(expected, coll.find(filter, projection).toArray());
+    }
+
+    assertColumnScanMatchesCollScan({}, {a: 1});
+    assertColumnScanMatchesCollScan({}, {_id: 0, a: 1, "b.c": 1});
+    assertColumnScanMatchesCollScan({a: {$gte: 2}}, {_id: 0, a: 1});
+    assertColumnScanMatchesCollScan({"b.c": {$in: ["x", "u", "w"]}}, {a: 1, "b.c": 1});
+    assertColumnScanMatchesCollScan({a: {$exists: false}}, {_id: 1});
+
+    // Only the document with an array along 'b.c' is fetched.
+    const explain = coll.find({}, {_id: 0, "b.c": 1}).explain("executionStats");
+    const columnScan = getPlanStage(explain.executionStats.executionStages, "COLUMN_SCAN");
+    assert.eq(1, columnScan.docsExamined, tojson(explain));
+    assert.eq(["_id", "a", "b.c"], columnScan.paths, tojson(explain));
+
+    // Queries which need a field outside the index keep using a collection scan.
+    assert(isCollscan(db, coll.find({}, {a: 1, "b.d": 1}).explain()));
+    assert(isCollscan(db, coll.find({}).explain()));
+    assert(isCollscan(db, coll.find({}, {a: 1}).sort({a: 1}).explain()));
+
+    // Hinting the index fails if it can't answer the query.
+    assert.eq(docs.length, coll.find({}, {a: 1}).hint(indexName).itcount());
+    assert.throws(() => coll.find({}, {"b.d": 1}).hint(indexName).itcount());
+
+    // The index stays consistent with the collection across updates and deletes.
+    assert.commandWorked(coll.update({_id: 1}, {$set: {a: [1, 2], "b.c": "t"}}));
+    assert.commandWorked(coll.update({_id: 3}, {$unset: {b: 1}}));
+    assert.commandWorked(coll.remove({_id: 2}));
+    assertColumnScanMatchesCollScan({}, {a: 1, "b.c": 1});
+    assert.commandWorked(coll.validate({full: true}));
+
+    // Documents are rebuilt with the field order they were stored with.
+    const orderColl = db.columnstore_index_field_order;
+    orderColl.drop();
+    assert.commandWorked(orderColl.insert([
+        {_id: 0, b: 1, a: 2, x: {d: 3, c: 4}},
+        {_id: 1, x: {c: 5, d: 6}, a: 7},
+        {b: 8, _id: 2, x: {d: 9}},
+    ]));
+    const orderKeyPattern = {
+        _id: "columnstore",
+        a: "columnstore",
+        b: "columnstore",
+        "x.c": "columnstore",
+        "x.d": "columnstore",
+    };
+    assert.commandWorked(orderColl.createIndex(orderKeyPattern, {name: indexName}));
+    const orderProjection = {_id: 1, a: 1, b: 1, "x.c": 1, "x.d": 1};
+    assert.eq(orderColl.find({}, orderProjection).hint({$natural: 1}).toArray(),
+              orderColl.find({}, orderProjection).hint(indexName).toArray());
+
+    // A scan which yields between batches sees the writes to rows it hasn't reached yet, including
+    // those to the cell it had already read ahead for a row which lacks the path.
+    const yieldColl = db.columnstore_index_yield;
+    yieldColl.drop();
+    assert.commandWorked(yieldColl.insert([{_id: 0, a: 0}, {_id: 1}, {_id: 2, a: 2}, {_id: 3}]));
+    assert.commandWorked(yieldColl.createIndex({a: "columnstore"}, {name: indexName}));
+    const cursor = yieldColl.find({}, {_id: 0, a: 1}).hint(indexName).batchSize(2);
+    assert.eq([{a: 0}, {}], [cursor.next(), cursor.next()]);
+    assert.eq(0, cursor.objsLeftInBatch());
+    assert.commandWorked(yieldColl.update({_id: 2}, {$set: {a: 20}}));
+    assert.commandWorked(yieldColl.update({_id: 3}, {$set: {a: 30}}));
+    assert.eq([{a: 20}, {a: 30}], cursor.toArray());
+
+    // A row whose cells hit a write conflict is built again after the yield instead of being
+    // skipped.
+    const conflictColl = db.columnstore_index_write_conflict;
+    conflictColl.drop();
+    const conflictDocs = [];
+    for (let i = 0; i < 200; ++i) {
+        conflictDocs.push({_id: i, a: i, b: {c: i % 2 ? "odd" : [i]}});
+    }
+    assert.commandWorked(conflictColl.insert(conflictDocs));
+    assert.commandWorked(
+        conflictColl.createIndex({a: "columnstore", "b.c": "columnstore"}, {name: indexName}));
+    const expected = conflictColl.find({}, {_id: 0, a: 1, "b.c": 1}).hint({$natural: 1}).toArray();
+    assert.commandWorked(db.adminCommand({
+        configureFailPoint: "WTWriteConflictExceptionForReads",
+        mode: {activationProbability: 0.1}
+    }));
+    try {
+        assert.eq(expected,
+                  conflictColl.find({}, {_id: 0, a: 1, "b.c": 1}).hint(indexName).toArray());
+    } finally {
+        assert.commandWorked(db.adminCommand(
+            {configureFailPoint: "WTWriteConflictExceptionForReads", mode: "off"}));
+    }
+})();
@@ -0,0 +1,64 @@
+/**
+ * Tests that reads on a secondary proceed at the last applied timestamp while a batch is being
+ * applied, and that they are reported in serverStatus and the slow query log with how stale the
+ * data they read was.
+ */
+(function() {
+    "use strict";
+
+    load("jstests/libs/check_log.js");
+    load('jstests/replsets/libs/secondary_reads_test.js');
+
+    const name = "secondaryReadsStalenessMetrics";
+    const collName = "testColl";
+    let secondaryReadsTest = new SecondaryReadsTest(name);
+    let replSet = secondaryReadsTest.getReplset();
+
+    let primaryDB = secondaryReadsTest.getPrimaryDB();
+    let secondaryDB = secondaryReadsTest.getSecondaryDB();
+
+    if (!primaryDB.serverStatus().storageEngine.supportsSnapshotReadConcern) {
+        secondaryReadsTest.stop();
+        return;
+    }
+    let primaryColl = primaryDB.getCollection(collName);
+
+    assert.commandWorked(primaryDB.runCommand({create: collName}));
+    for (let i = 0; i < 10; i++) {
+        assert.commandWorked(primaryColl.insert({_id: i, x: 0}));
+    }
+    replSet.awaitReplication();
+
+    function secondaryReadsMetrics() {
+        return assert.commandWorked(secondaryDB.adminCommand({serverStatus: 1}))
+            .metrics.repl.secondaryReads;
+    }
+
+    // Log every operation on the secondary so that the reads below are logged.
+    assert.commandWorked(secondaryDB.setProfilingLevel(0, -1));
+
+    // Prevent a batch from completing on the secondary, which holds the PBWM lock.
+    let pauseAwait = secondaryReadsTest.pauseSecondaryBatchApplication();
+    assert.commandWorked(primaryColl.update({}, {$set: {x: 1}}, {multi: true}));
+    pauseAwait();
+
+    // Reads neither wait for the batch nor see any of it.
+    const before = secondaryReadsMetrics();
+    for (let i = 0; i < 5; i++) {
+        assert.eq(10,
+                  secondaryDB.getCollection(collName).find({x: 0}).maxTimeMS(10 * 1000).itcount());
+    }
+    const after = secondaryReadsMetrics();
+    assert.gte(after.atLastApplied - before.atLastApplied, 5, tojson([before, after]));
+    assert.gte(after.totalStalenessSecs, before.totalStalenessSecs, tojson([before, after]));
+    assert.eq(before.conflictedWithBatchApplication,
+              after.conflictedWithBatchApplication,
+              tojson([before, after]));
+    checkLog.contains(secondaryDB.getMongo(), "readStalenessSecs:");
+
+    secondaryReadsTest.resumeSecondaryBatchApplication();
+    replSet.awaitReplication();
+    assert.eq(10, secondaryDB.getCollection(collName).find({x: 1}).itcount());
+
+    secondaryReadsTest.stop();
+})();
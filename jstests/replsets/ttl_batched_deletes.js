@@ -0,0 +1,74 @@
+// Tests that with 'ttlMonitorBatchedDeletes' the TTL monitor deletes expired documents in batches,
+// each replicated as a single applyOps oplog entry, and reports per-collection statistics. The
+// deletes in each batch are reported to change streams as individual delete events.
+(function() {
+    "use strict";
+
+    const rst = new ReplSetTest({
+        nodes: 2,
+        nodeOptions: {
+            setParameter: {
+                ttlMonitorSleepSecs: 1,
+                ttlMonitorBatchedDeletes: true,
+                ttlMonitorBatchSize: 10,
+            }
+        }
+    });
+    rst.startSet();
+    rst.initiate();
+
+    const primary = rst.getPrimary();
+    const secondary = rst.getSecondary();
+    const testDB = primary.getDB("test");
+    const coll = testDB.ttl_batched_deletes;
+
+    assert.commandWorked(coll.createIndex({x: 1}, {expireAfterSeconds: 0}));
+    const changeStream = coll.watch([{$match: {operationType: "delete"}}]);
+
+    const expired = new Date(0);
+    const bulk = coll.initializeUnorderedBulkOp();
+    for (let i = 0; i < 25; i++) {
+        bulk.insert({_id: i, x: expired});
+    }
+    // Never expires, since the TTL monitor only considers dates.
+    bulk.insert({_id: 25, x: "not a date"});
+    assert.writeOK(bulk.execute());
+
+    assert.soon(function() {
+        return coll.find().itcount() === 1;
+    }, "TTL monitor didn't delete the expired documents");
+    rst.awaitReplication();
+
+    assert.eq(1, secondary.getDB("test").ttl_batched_deletes.find().itcount());
+
+    // The 25 deletes are replicated in applyOps entries of at most 10 deletes, and none on its own.
+    // A TTL pass may have run while the documents were being inserted, so there can be more than
+    // three batches.
+    const oplog = primary.getDB("local").oplog.rs;
+    assert.eq(0, oplog.find({op: "d", ns: coll.getFullName()}).itcount());
+    const batches = oplog.find({op: "c", "o.applyOps.ns": coll.getFullName()}).toArray();
+    assert.gte(batches.length, 3, tojson(batches));
+    batches.forEach(function(entry) {
+        assert.eq(false, entry.o.allowAtomic, tojson(entry));
+        assert.lte(entry.o.applyOps.length, 10, tojson(entry));
+    });
+
+    const stats =
+        assert.commandWorked(testDB.adminCommand({serverStatus: 1, ttl: 1})).ttl.collections;
+    assert.eq(25, stats[coll.getFullName()].deletedDocuments, tojson(stats));
+    assert.eq(batches.length, stats[coll.getFullName()].deleteBatches, tojson(stats));
+
+    // Each delete in a batch is reported as its own event, without a session or txnNumber.
+    const deletedIds = [];
+    while (deletedIds.length < 25) {
+        assert.soon(() => changeStream.hasNext());
+        const event = changeStream.next();
+        assert(!event.hasOwnProperty("lsid"), tojson(event));
+        assert(!event.hasOwnProperty("txnNumber"), tojson(event));
+        deletedIds.push(event.documentKey._id);
+    }
+    assert.eq(Array.from({length: 25}, (_, i) => i), deletedIds.sort((a, b) => a - b));
+    changeStream.close();
+
+    rst.stopSet();
+})();
@@ -0,0 +1,87 @@
+// Tests that with 'internalQueryEnableLoggingV2OplogEntries' updates which modify a small part of a
+// large document are logged to the oplog as a diff of the document ($v: 2), that secondaries apply
+// those diffs, and that change streams report the fields they modify.
+// @tags: [uses_change_streams]
+(function() {
+    "use strict";
+
+    const rst = new ReplSetTest({
+        nodes: 2,
+        nodeOptions: {
+            enableMajorityReadConcern: "",
+            setParameter: {internalQueryEnableLoggingV2OplogEntries: true},
+        }
+    });
+    rst.startSet();
+    rst.initiate();
+
+    const primary = rst.getPrimary();
+    const testDB = primary.getDB("test");
+    const coll = testDB.update_delta_oplog_entries;
+    const oplog = primary.getDB("local").oplog.rs;
+
+    const largeArray = Array.from({length: 1000}, (_, i) => ({x: i, y: "abcdefghij"}));
+    assert.writeOK(coll.insert({_id: 0, a: largeArray, b: {c: 1, d: "abcdefghij"}}));
+    const changeStream = coll.watch();
+
+    function lastUpdateEntry() {
+        return oplog.find({op: "u", ns: coll.getFullName()}).sort({$natural: -1}).limit(1).next();
+    }
+
+    function assertLoggedAsDiff() {
+        const entry = lastUpdateEntry();
+        assert.eq(2, entry.o.$v, tojson(entry));
+        assert.lt(Object.bsonsize(entry.o), 1024, tojson(entry));
+    }
+
+    // Modifiers which log the whole array. An update through arrayFilters logs the whole array
+    // when it modifies more than one element.
+    assert.writeOK(coll.update({_id: 0},
+                               {$set: {"a.$[el].y": "z"}, $unset: {"b.c": 1}},
+                               {arrayFilters: [{"el.x": {$lt: 10}}]}));
+    assertLoggedAsDiff();
+
+    // $push with $sort, and $addToSet, which here both append to the array.
+    assert.writeOK(
+        coll.update({_id: 0}, {$push: {a: {$each: [{x: 1000, y: "k"}], $sort: {x: 1}}}}));
+    assertLoggedAsDiff();
+    assert.writeOK(coll.update({_id: 0}, {$addToSet: {a: {x: 1001, y: "k"}}}));
+    assertLoggedAsDiff();
+
+    // $pull, which logs the removal of the element rather than the rest of the array.
+    assert.writeOK(coll.update({_id: 0}, {$pull: {a: {x: 500}}}));
+    assertLoggedAsDiff();
+
+    // Small updates of small documents keep logging their modifiers.
+    assert.writeOK(coll.insert({_id: 1, a: 1}));
+    assert.writeOK(coll.update({_id: 1}, {$inc: {a: 1}}));
+    const entry = lastUpdateEntry();
+    assert.eq({$set: {a: 2}}, entry.o, tojson(entry));
+
+    rst.awaitReplication();
+    const secondaryColl = rst.getSecondary().getDB("test").update_delta_oplog_entries;
+    assert.eq(coll.find().sort({_id: 1}).toArray(), secondaryColl.find().sort({_id: 1}).toArray());
+    assert.eq(1001, secondaryColl.findOne({_id: 0}).a.length);
+
+    // The arrayFilters update is reported by the change stream in terms of the fields it modified.
+    assert.soon(() => changeStream.hasNext());
+    let change = changeStream.next();
+    assert.eq("update", change.operationType, tojson(change));
+    const expectedUpdatedFields = {};
+    for (let i = 0; i < 10; i++) {
+        expectedUpdatedFields["a." + i + ".y"] = "z";
+    }
+    assert.eq(expectedUpdatedFields, change.updateDescription.updatedFields, tojson(change));
+    assert.eq(["b.c"], change.updateDescription.removedFields, tojson(change));
+
+    // The $pull is reported as the removal of the element it pulled.
+    for (let i = 0; i < 3; i++) {
+        assert.soon(() => changeStream.hasNext());
+        change = changeStream.next();
+    }
+    assert.eq("update", change.operationType, tojson(change));
+    assert.eq({}, change.updateDescription.updatedFields, tojson(change));
+    assert.eq(["a.500"], change.updateDescription.removedFields, tojson(change));
+
+    rst.stopSet();
+})();
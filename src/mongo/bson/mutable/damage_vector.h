@@ -35,10 +35,14 @@
 namespace mongo {
 namespace mutablebson {
 
-// A damage event represents a change of size 'size' byte at starting at offset
+// A damage event represents a change of size 'targetSize' bytes starting at offset
 // 'target_offset' in some target buffer, with the replacement data being 'size' bytes of
 // data from the 'source' offset. The base addresses against which these offsets are to be
 // applied are not captured here.
+//
+// Damage events are applied in the order in which they appear in a DamageVector, so the target
+// offset of an event which follows one that changes the size of the target is relative to the
+// target as already modified by the earlier events.
 struct DamageEvent {
     typedef uint32_t OffsetSizeType;
 
@@ -50,6 +54,10 @@ struct DamageEvent {
 
     // Size of the damage region.
     size_t size;
+
+    // Size of the target region replaced by the damage. This is the same as 'size' unless the
+    // damage grows or shrinks the target.
+    size_t targetSize;
 };
 
 typedef std::vector<DamageEvent> DamageVector;
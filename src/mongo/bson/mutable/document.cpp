@@ -1035,6 +1035,7 @@ public:
         _damages.back().targetOffset = targetOffset;
         _damages.back().sourceOffset = sourceOffset;
         _damages.back().size = size;
+        _damages.back().targetSize = size;
         if (kDebugBuild && paranoid) {
             // Force damage events to new addresses to catch invalidation errors.
             DamageVector new_damages(_damages);
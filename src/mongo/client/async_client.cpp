@@ -218,6 +218,147 @@ Future<Message> AsyncDBClient::_call(Message request, const BatonHandle& baton)
         });
 }
 
+Future<Message> AsyncDBClient::_multiplexedCall(Message request) {
+    auto swm = _compressorManager.compressMessage(request);
+    if (!swm.isOK()) {
+        return swm.getStatus();
+    }
+
+    request = std::move(swm.getValue());
+    auto msgId = nextMessageId();
+    request.header().setId(msgId);
+    request.header().setResponseToMsgId(0);
+
+    auto pf = makePromiseFuture<Message>();
+    bool startSink = false;
+    bool startSource = false;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_multiplexMutex);
+        _multiplexedReplies.emplace(msgId, std::move(pf.promise));
+        _multiplexedSinkQueue.push_back(std::move(request));
+        startSink = !std::exchange(_multiplexedSinkRunning, true);
+        startSource = !std::exchange(_multiplexedSourceRunning, true);
+    }
+
+    if (startSink) {
+        _sinkNextMultiplexedMessage();
+    }
+
+    if (startSource) {
+        _sourceNextMultiplexedReply();
+    }
+
+    return std::move(pf.future).then([this](Message response) -> StatusWith<Message> {
+        if (response.operation() == dbCompressed) {
+            return _compressorManager.decompressMessage(response);
+        } else {
+            return response;
+        }
+    });
+}
+
+void AsyncDBClient::_sinkNextMultiplexedMessage() {
+    Message request;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_multiplexMutex);
+        if (_multiplexedSinkQueue.empty()) {
+            _multiplexedSinkRunning = false;
+            return;
+        }
+
+        request = std::move(_multiplexedSinkQueue.front());
+        _multiplexedSinkQueue.pop_front();
+    }
+
+    _session->asyncSinkMessage(std::move(request))
+        .getAsync([ this, self = shared_from_this() ](Status status) {
+            if (!status.isOK()) {
+                {
+                    stdx::lock_guard<stdx::mutex> lk(_multiplexMutex);
+                    _multiplexedSinkRunning = false;
+                }
+
+                // A failed write leaves the stream in an unknown state, so every request sharing
+                // this session is failed along with the one that was being written.
+                _failMultiplexedRequests(status);
+                return;
+            }
+
+            _sinkNextMultiplexedMessage();
+        });
+}
+
+void AsyncDBClient::_sourceNextMultiplexedReply() {
+    _session->asyncSourceMessage().getAsync([ this, self = shared_from_this() ](
+        StatusWith<Message> swResponse) {
+        if (!swResponse.isOK()) {
+            {
+                stdx::lock_guard<stdx::mutex> lk(_multiplexMutex);
+                _multiplexedSourceRunning = false;
+            }
+
+            _failMultiplexedRequests(swResponse.getStatus());
+            return;
+        }
+
+        auto response = std::move(swResponse.getValue());
+        auto responseTo = response.header().getResponseToMsgId();
+
+        boost::optional<Promise<Message>> promise;
+        bool keepReading = false;
+        {
+            stdx::lock_guard<stdx::mutex> lk(_multiplexMutex);
+            auto it = _multiplexedReplies.find(responseTo);
+            if (it != _multiplexedReplies.end()) {
+                promise.emplace(std::move(it->second));
+                _multiplexedReplies.erase(it);
+                keepReading = !_multiplexedReplies.empty();
+            }
+
+            // Only stop reading once nothing is waiting for a reply; a request submitted after
+            // this point restarts the reader.
+            _multiplexedSourceRunning = keepReading;
+        }
+
+        if (!promise) {
+            _failMultiplexedRequests(
+                Status(ErrorCodes::ProtocolError,
+                       str::stream() << "Received a reply to unknown message ID " << responseTo
+                                     << " on a multiplexed connection to "
+                                     << _peer));
+            return;
+        }
+
+        promise->emplaceValue(std::move(response));
+
+        if (keepReading) {
+            _sourceNextMultiplexedReply();
+        }
+    });
+}
+
+void AsyncDBClient::_failMultiplexedRequests(const Status& status) {
+    auto replies = [&] {
+        stdx::lock_guard<stdx::mutex> lk(_multiplexMutex);
+        _multiplexedSinkQueue.clear();
+        return std::exchange(_multiplexedReplies, {});
+    }();
+
+    if (replies.empty()) {
+        return;
+    }
+
+    LOG(2) << "Failing " << replies.size() << " multiplexed requests to " << _peer << ": "
+           << status;
+
+    // Make sure a read or write still outstanding on the session is interrupted as well.
+    _session->cancelAsyncOperations();
+
+    for (auto&& reply : replies) {
+        reply.second.setError(status);
+    }
+}
+
 Future<rpc::UniqueReply> AsyncDBClient::runCommand(OpMsgRequest request, const BatonHandle& baton) {
     invariant(_negotiatedProtocol);
     auto requestMsg = rpc::messageFromOpMsgRequest(*_negotiatedProtocol, std::move(request));
@@ -233,8 +374,34 @@ Future<executor::RemoteCommandResponse> AsyncDBClient::runCommandRequest(
     auto start = clkSource->now();
     auto opMsgRequest = OpMsgRequest::fromDBAndBody(
         std::move(request.dbname), std::move(request.cmdObj), std::move(request.metadata));
-    return runCommand(std::move(opMsgRequest), baton)
-        .then([start, clkSource, this](rpc::UniqueReply response) {
+    return _makeRemoteCommandResponse(runCommand(std::move(opMsgRequest), baton), start, clkSource);
+}
+
+Future<executor::RemoteCommandResponse> AsyncDBClient::runMultiplexedCommandRequest(
+    executor::RemoteCommandRequest request) {
+    invariant(_negotiatedProtocol);
+    auto clkSource = _svcCtx->getPreciseClockSource();
+    auto start = clkSource->now();
+    auto requestMsg = rpc::messageFromOpMsgRequest(
+        *_negotiatedProtocol,
+        OpMsgRequest::fromDBAndBody(
+            std::move(request.dbname), std::move(request.cmdObj), std::move(request.metadata)));
+    auto reply = _multiplexedCall(std::move(requestMsg))
+                     .then([](Message response) -> Future<rpc::UniqueReply> {
+                         return rpc::UniqueReply(response, rpc::makeReply(&response));
+                     });
+    return _makeRemoteCommandResponse(std::move(reply), start, clkSource);
+}
+
+size_t AsyncDBClient::getMultiplexedRequestsInFlight() const {
+    stdx::lock_guard<stdx::mutex> lk(_multiplexMutex);
+    return _multiplexedReplies.size();
+}
+
+Future<executor::RemoteCommandResponse> AsyncDBClient::_makeRemoteCommandResponse(
+    Future<rpc::UniqueReply> reply, Date_t start, ClockSource* clkSource) {
+    return std::move(reply)
+        .then([start, clkSource](rpc::UniqueReply response) {
             auto duration = duration_cast<Milliseconds>(clkSource->now() - start);
             return executor::RemoteCommandResponse(*response, duration);
         })
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <deque>
 #include <memory>
 
 #include "mongo/client/authenticate.h"
@@ -38,6 +39,8 @@
 #include "mongo/executor/remote_command_response.h"
 #include "mongo/rpc/protocol.h"
 #include "mongo/rpc/unique_message.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/unordered_map.h"
 #include "mongo/transport/baton.h"
 #include "mongo/transport/message_compressor_manager.h"
 #include "mongo/transport/transport_layer.h"
@@ -64,6 +67,22 @@ public:
         executor::RemoteCommandRequest request, const BatonHandle& baton = nullptr);
     Future<rpc::UniqueReply> runCommand(OpMsgRequest request, const BatonHandle& baton = nullptr);
 
+    /**
+     * Runs a command on a connection which may be shared by several concurrent callers. Requests
+     * are written to the session in the order they are submitted and each reply is matched back
+     * to its request by responseTo, so any number of multiplexed commands may be in flight at once.
+     *
+     * Multiplexed commands must not be mixed with the exclusive runCommand()/runCommandRequest()
+     * calls on the same client while any multiplexed command is outstanding.
+     */
+    Future<executor::RemoteCommandResponse> runMultiplexedCommandRequest(
+        executor::RemoteCommandRequest request);
+
+    /**
+     * Returns the number of multiplexed commands which have been sent but not yet answered.
+     */
+    size_t getMultiplexedRequestsInFlight() const;
+
     Future<void> authenticate(const BSONObj& params);
 
     Future<void> authenticateInternal(boost::optional<std::string> mechanismHint);
@@ -82,6 +101,12 @@ public:
 
 private:
     Future<Message> _call(Message request, const BatonHandle& baton = nullptr);
+    Future<Message> _multiplexedCall(Message request);
+    void _sinkNextMultiplexedMessage();
+    void _sourceNextMultiplexedReply();
+    void _failMultiplexedRequests(const Status& status);
+    Future<executor::RemoteCommandResponse> _makeRemoteCommandResponse(
+        Future<rpc::UniqueReply> reply, Date_t start, ClockSource* clkSource);
     BSONObj _buildIsMasterRequest(const std::string& appName,
                                   executor::NetworkConnectionHook* hook);
     void _parseIsMasterResponse(BSONObj request,
@@ -93,6 +118,16 @@ private:
     ServiceContext* const _svcCtx;
     MessageCompressorManager _compressorManager;
     boost::optional<rpc::Protocol> _negotiatedProtocol;
+
+    // Protects the multiplexing state below. Requests waiting to be written are kept in
+    // _multiplexedSinkQueue so that only one write is ever outstanding on the session, and
+    // requests which have been written are kept in _multiplexedReplies until a reply with a
+    // matching responseTo is read.
+    mutable stdx::mutex _multiplexMutex;
+    std::deque<Message> _multiplexedSinkQueue;
+    stdx::unordered_map<int32_t, Promise<Message>> _multiplexedReplies;
+    bool _multiplexedSinkRunning = false;
+    bool _multiplexedSourceRunning = false;
 };
 
 }  // namespace mongo
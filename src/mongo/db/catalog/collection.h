@@ -401,6 +401,12 @@ public:
 
     virtual bool isCapped() const = 0;
 
+    /**
+     * Returns true if the documents of this collection are stored keyed by their _id, in which
+     * case the collection has no _id index. See CollectionOptions::clustered.
+     */
+    virtual bool isClustered() const = 0;
+
     /**
      * Returns a pointer to a capped callback object.
      * The storage engine interacts with capped collections through a CappedCallback interface.
@@ -206,6 +206,7 @@ CollectionImpl::CollectionImpl(OperationContext* opCtx,
       _recordStore(recordStore),
       _dbce(dbce),
       _needCappedLock(supportsDocLocking() && _recordStore->isCapped() && _ns.db() != "local"),
+      _isClustered(_details->getCollectionOptions(opCtx).clustered),
       _infoCache(std::make_unique<CollectionInfoCacheImpl>(this, _ns)),
       _indexCatalog(
           std::make_unique<IndexCatalogImpl>(this, getCatalogEntry()->getMaxAllowedIndexes())),
@@ -251,6 +252,11 @@ bool CollectionImpl::requiresIdIndex() const {
         return false;
     }
 
+    if (_isClustered) {
+        // The record store is keyed by _id.
+        return false;
+    }
+
     if (_ns.isSystem()) {
         StringData shortName = _ns.coll().substr(_ns.coll().find('.') + 1);
         if (shortName == "indexes" || shortName == "namespaces" || shortName == "profile") {
@@ -383,7 +389,7 @@ Status CollectionImpl::insertDocuments(OperationContext* opCtx,
     const bool hasIdIndex = _indexCatalog->findIdIndex(opCtx);
 
     for (auto it = begin; it != end; it++) {
-        if (hasIdIndex && it->doc["_id"].eoo()) {
+        if ((hasIdIndex || _isClustered) && it->doc["_id"].eoo()) {
             return Status(ErrorCodes::InternalError,
                           str::stream()
                               << "Collection::insertDocument got document without _id for ns:"
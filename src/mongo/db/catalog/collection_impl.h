@@ -303,6 +303,10 @@ public:
 
     bool isCapped() const final;
 
+    bool isClustered() const final {
+        return _isClustered;
+    }
+
     CappedCallback* getCappedCallback() final;
 
     /**
@@ -400,6 +404,7 @@ private:
     RecordStore* const _recordStore;
     DatabaseCatalogEntry* const _dbce;
     const bool _needCappedLock;
+    const bool _isClustered;
     std::unique_ptr<CollectionInfoCache> _infoCache;
     std::unique_ptr<IndexCatalog> _indexCatalog;
 
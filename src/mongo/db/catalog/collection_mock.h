@@ -230,6 +230,10 @@ public:
         std::abort();
     }
 
+    bool isClustered() const {
+        std::abort();
+    }
+
     CappedCallback* getCappedCallback() {
         std::abort();
     }
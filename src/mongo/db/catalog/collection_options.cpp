@@ -166,6 +166,8 @@ Status CollectionOptions::parse(const BSONObj& options, ParseKind kind) {
             } else {
                 initialNumExtents = e.safeNumberLong();
             }
+        } else if (fieldName == "clustered") {
+            clustered = e.trueValue();
         } else if (fieldName == "autoIndexId") {
             if (e.trueValue())
                 autoIndexId = YES;
@@ -266,6 +268,19 @@ Status CollectionOptions::parse(const BSONObj& options, ParseKind kind) {
         return Status(ErrorCodes::BadValue, "'pipeline' cannot be specified without 'viewOn'");
     }
 
+    if (clustered) {
+        if (capped) {
+            return Status(ErrorCodes::InvalidOptions, "A clustered collection cannot be capped");
+        }
+        if (!viewOn.empty()) {
+            return Status(ErrorCodes::InvalidOptions, "A view cannot be clustered");
+        }
+        if (autoIndexId != DEFAULT || !idIndex.isEmpty()) {
+            return Status(ErrorCodes::InvalidOptions,
+                          "A clustered collection is keyed by _id and has no _id index");
+        }
+    }
+
     return Status::OK();
 }
 
@@ -296,6 +311,9 @@ void CollectionOptions::appendBSON(BSONObjBuilder* builder) const {
     if (autoIndexId != DEFAULT)
         builder->appendBool("autoIndexId", autoIndexId == YES);
 
+    if (clustered)
+        builder->appendBool("clustered", true);
+
     if (flagsSet)
         builder->append("flags", flags);
 
@@ -371,6 +389,10 @@ bool CollectionOptions::matchesStorageOptions(const CollectionOptions& other,
         return false;
     }
 
+    if (clustered != other.clustered) {
+        return false;
+    }
+
     if (flagsSet != other.flagsSet) {
         return false;
     }
@@ -107,6 +107,10 @@ struct CollectionOptions {
     long long initialNumExtents = 0;
     std::vector<long long> initialExtentSizes;
 
+    // Whether the documents are stored keyed by their _id, which replaces the _id index. Only
+    // integer and date _ids are allowed. See clustered_record_id.h.
+    bool clustered = false;
+
     // The behavior of _id index creation when collection created
     void setNoIdIndex() {
         autoIndexId = NO;
@@ -108,6 +108,27 @@ TEST(CollectionOptions, CappedSizeRoundsUpForAlignment) {
     ASSERT_EQUALS(options.cappedMaxDocs, 0);
 }
 
+TEST(CollectionOptions, ClusteredRoundTrip) {
+    CollectionOptions options;
+    ASSERT_OK(options.parse(fromjson("{clustered: true}")));
+    ASSERT_TRUE(options.clustered);
+    ASSERT_BSONOBJ_EQ(fromjson("{clustered: true}"), options.toBSON());
+
+    CollectionOptions reparsed;
+    ASSERT_OK(reparsed.parse(options.toBSON()));
+    ASSERT_TRUE(reparsed.clustered);
+}
+
+TEST(CollectionOptions, ErrorClusteredWithIncompatibleOptions) {
+    ASSERT_NOT_OK(
+        CollectionOptions().parse(fromjson("{clustered: true, capped: true, size: 1024}")));
+    ASSERT_NOT_OK(CollectionOptions().parse(fromjson("{clustered: true, autoIndexId: true}")));
+    ASSERT_NOT_OK(
+        CollectionOptions().parse(fromjson("{clustered: true, viewOn: 'c', pipeline: []}")));
+    ASSERT_NOT_OK(CollectionOptions().parse(
+        fromjson("{clustered: true, idIndex: {key: {_id: 1}, name: '_id_'}}")));
+}
+
 TEST(CollectionOptions, IgnoreSizeWrongType) {
     CollectionOptions options;
     ASSERT_OK(options.parse(fromjson("{size: undefined, capped: undefined}")));
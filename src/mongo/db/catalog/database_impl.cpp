@@ -633,6 +633,16 @@ void DatabaseImpl::_checkCanCreateCollection(OperationContext* opCtx,
 
     uassert(17316, "cannot create a blank collection", nss.coll() > 0);
     uassert(28838, "cannot create a non-capped oplog collection", options.capped || !nss.isOplog());
+    if (options.clustered) {
+        uassert(ErrorCodes::InvalidOptions,
+                str::stream() << "Cannot create collection " << nss
+                              << " - the storage engine does not support clustered collections",
+                opCtx->getServiceContext()->getStorageEngine()->supportsClusteredCollections());
+        uassert(ErrorCodes::InvalidOptions,
+                str::stream() << "Cannot create collection " << nss
+                              << " - system collections cannot be clustered",
+                !nss.isSystem());
+    }
     uassert(ErrorCodes::DatabaseDropPending,
             str::stream() << "Cannot create collection " << nss
                           << " - database is in the process of being dropped.",
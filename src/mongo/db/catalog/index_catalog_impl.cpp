@@ -33,8 +33,10 @@
 
 #include "mongo/db/catalog/index_catalog_impl.h"
 
+#include <algorithm>
 #include <vector>
 
+#include "mongo/base/counter.h"
 #include "mongo/base/init.h"
 #include "mongo/bson/simple_bsonelement_comparator.h"
 #include "mongo/bson/simple_bsonobj_comparator.h"
@@ -44,9 +46,11 @@
 #include "mongo/db/catalog/collection_catalog_entry.h"
 #include "mongo/db/catalog/database_catalog_entry.h"
 #include "mongo/db/catalog/index_catalog_entry_impl.h"
+#include "mongo/db/catalog/index_catalog_impl_gen.h"
 #include "mongo/db/catalog/index_key_validate.h"
 #include "mongo/db/client.h"
 #include "mongo/db/clientcursor.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/field_ref.h"
 #include "mongo/db/index/index_access_method.h"
@@ -67,9 +71,12 @@
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/storage_engine_init.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/future.h"
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
 #include "mongo/util/represent_as.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -499,7 +506,8 @@ Status IndexCatalogImpl::_isSpecOk(OperationContext* opCtx, const BSONObj& spec)
         }
 
         if ((pluginName != IndexNames::BTREE) && (pluginName != IndexNames::GEO_2DSPHERE) &&
-            (pluginName != IndexNames::HASHED) && (pluginName != IndexNames::WILDCARD)) {
+            (pluginName != IndexNames::HASHED) && (pluginName != IndexNames::WILDCARD) &&
+            (pluginName != IndexNames::COLUMN)) {
             return Status(ErrorCodes::CannotCreateIndex,
                           str::stream() << "Index type '" << pluginName
                                         << "' does not support collation: "
@@ -509,7 +517,7 @@ Status IndexCatalogImpl::_isSpecOk(OperationContext* opCtx, const BSONObj& spec)
 
     const bool isSparse = spec["sparse"].trueValue();
 
-    if (pluginName == IndexNames::WILDCARD) {
+    if (pluginName == IndexNames::WILDCARD || pluginName == IndexNames::COLUMN) {
         if (isSparse) {
             return Status(ErrorCodes::CannotCreateIndex,
                           str::stream() << "Index type '" << pluginName
@@ -532,6 +540,13 @@ Status IndexCatalogImpl::_isSpecOk(OperationContext* opCtx, const BSONObj& spec)
     // Ensure if there is a filter, its valid.
     BSONElement filterElement = spec.getField("partialFilterExpression");
     if (filterElement) {
+        // A column scan must visit every document in the collection.
+        if (pluginName == IndexNames::COLUMN) {
+            return Status(ErrorCodes::CannotCreateIndex,
+                          str::stream() << "Index type '" << pluginName
+                                        << "' does not support the partialFilterExpression option");
+        }
+
         if (isSparse) {
             return Status(ErrorCodes::CannotCreateIndex,
                           "cannot mix \"partialFilterExpression\" and \"sparse\" options");
@@ -1162,44 +1177,219 @@ const IndexDescriptor* IndexCatalogImpl::refreshEntry(OperationContext* opCtx,
 
 // ---------------------------
 
+namespace {
+
+std::vector<BsonRecord> filterRecords(const IndexCatalogEntry* index,
+                                      const std::vector<BsonRecord>& bsonRecords) {
+    const MatchExpression* filter = index->getFilterExpression();
+    if (!filter)
+        return bsonRecords;
+
+    std::vector<BsonRecord> filteredBsonRecords;
+    for (auto bsonRecord : bsonRecords) {
+        if (filter->matchesBSON(*(bsonRecord.docPtr)))
+            filteredBsonRecords.push_back(bsonRecord);
+    }
+    return filteredBsonRecords;
+}
+
+/**
+ * Returns a rough estimate of the cost of generating the keys of 'desc' for 'numDocs' documents,
+ * in single-field btree keys. Text, geo, wildcard and columnstore indexes parse or walk far more of
+ * each document than btree and hashed indexes do.
+ */
+int64_t estimateKeyGenerationCost(const IndexDescriptor* desc, size_t numDocs) {
+    const int64_t kExpensiveIndexCostFactor = 16;
+
+    int64_t costPerDoc = desc->keyPattern().nFields();
+    switch (IndexNames::nameToType(desc->getAccessMethodName())) {
+        case INDEX_BTREE:
+        case INDEX_HASHED:
+            break;
+        default:
+            costPerDoc *= kExpensiveIndexCostFactor;
+    }
+    return costPerDoc * static_cast<int64_t>(numDocs);
+}
+
+/**
+ * Given the estimated key generation cost of each index, or boost::none for the indexes which
+ * generate no keys ahead of their writes, returns which indexes to hand to the key generation pool.
+ * Only the indexes whose cost reaches 'indexKeyGenerationParallelCostThreshold' are worth the
+ * coordination, and only if the indexes left to the operation's thread cost as much, so that it
+ * doesn't just wait for the pool. Returns an empty vector if no index is worth offloading.
+ */
+std::vector<bool> chooseIndexesToOffload(const std::vector<boost::optional<int64_t>>& costs) {
+    const int threshold = indexKeyGenerationParallelCostThreshold.load();
+    if (threshold == 0) {
+        return {};
+    }
+
+    std::vector<bool> offload(costs.size(), false);
+    boost::optional<size_t> lastOffloaded;
+    int64_t localCost = 0;
+    for (size_t i = 0; i < costs.size(); ++i) {
+        if (!costs[i]) {
+            continue;
+        }
+        if (*costs[i] >= threshold) {
+            offload[i] = true;
+            lastOffloaded = i;
+        } else {
+            localCost += *costs[i];
+        }
+    }
+
+    if (!lastOffloaded) {
+        return {};
+    }
+    if (localCost < threshold) {
+        // Keep the last expensive index on the operation's thread, so that it has work of its own
+        // while the pool generates the others.
+        offload[*lastOffloaded] = false;
+        if (std::find(offload.begin(), offload.end(), true) == offload.end()) {
+            return {};
+        }
+    }
+    return offload;
+}
+
+ThreadPool* keyGenerationPool() {
+    // Shared by all the writes in the process, and never shut down.
+    static ThreadPool* const pool = [] {
+        ThreadPool::Options options;
+        options.poolName = "IndexKeyGeneration";
+        options.minThreads = 0;
+        options.maxThreads = static_cast<size_t>(indexKeyGenerationThreads);
+        auto pool = new ThreadPool(std::move(options));
+        pool->startup();
+        return pool;
+    }();
+    return pool;
+}
+
+// The number of key generations scheduled on the key generation pool which haven't finished.
+AtomicWord<int> keyGenerationsInFlight;
+
+// The number of indexes whose keys a write generated on the key generation pool.
+Counter64 offloadedKeyGenerations;
+ServerStatusMetricField<Counter64> offloadedKeyGenerationsDisplay("indexKeyGeneration.offloaded",
+                                                                  &offloadedKeyGenerations);
+
+/**
+ * Calls 'generate(i)' for every index 'i' whose cost is known, on the key generation pool if
+ * 'offload[i]' is set and a thread of the pool is free, and on this thread otherwise. Returns once
+ * all the calls are done. If any call fails, rethrows the error of the first index which failed.
+ */
+void generateKeysConcurrently(const std::vector<boost::optional<int64_t>>& costs,
+                              const std::vector<bool>& offload,
+                              const stdx::function<void(size_t)>& generate) {
+    std::vector<Status> statuses(costs.size(), Status::OK());
+    std::vector<bool> scheduled(costs.size(), false);
+    std::vector<std::pair<size_t, Future<void>>> futures;
+
+    // The offloaded calls refer to this frame, so they must finish before it unwinds.
+    auto waitForPool = [&] {
+        for (auto&& future : futures) {
+            statuses[future.first] = future.second.getNoThrow();
+        }
+        futures.clear();
+    };
+    auto guard = makeGuard(waitForPool);
+
+    for (size_t i = 0; i < costs.size(); ++i) {
+        if (!costs[i] || !offload[i]) {
+            continue;
+        }
+
+        // Queueing behind the other writes' key generations would be slower than generating the
+        // keys on this thread.
+        if (keyGenerationsInFlight.fetchAndAdd(1) >= indexKeyGenerationThreads) {
+            keyGenerationsInFlight.subtractAndFetch(1);
+            continue;
+        }
+
+        auto pf = makePromiseFuture<void>();
+        auto task = [&generate, i, promise = std::move(pf.promise) ]() mutable noexcept {
+            promise.setWith([&] {
+                ON_BLOCK_EXIT([] { keyGenerationsInFlight.subtractAndFetch(1); });
+                generate(i);
+            });
+        };
+        scheduled[i] = keyGenerationPool()->schedule(std::move(task)).isOK();
+        if (scheduled[i]) {
+            offloadedKeyGenerations.increment();
+            futures.emplace_back(i, std::move(pf.future));
+        } else {
+            keyGenerationsInFlight.subtractAndFetch(1);
+        }
+    }
+
+    // This thread also generates the keys of the indexes which could not be scheduled.
+    for (size_t i = 0; i < costs.size(); ++i) {
+        if (!costs[i] || scheduled[i]) {
+            continue;
+        }
+        try {
+            generate(i);
+        } catch (const DBException& ex) {
+            statuses[i] = ex.toStatus();
+        }
+    }
+
+    guard.dismiss();
+    waitForPool();
+    for (auto&& status : statuses) {
+        uassertStatusOK(status);
+    }
+}
+
+}  // namespace
+
 Status IndexCatalogImpl::_indexFilteredRecords(OperationContext* opCtx,
                                                IndexCatalogEntry* index,
                                                const std::vector<BsonRecord>& bsonRecords,
-                                               int64_t* keysInsertedOut) {
+                                               int64_t* keysInsertedOut,
+                                               const BatchedKeys* generatedKeys) {
     InsertDeleteOptions options;
     prepareInsertDeleteOptions(opCtx, index->descriptor(), &options);
 
-    for (auto bsonRecord : bsonRecords) {
+    for (const auto& bsonRecord : bsonRecords) {
         invariant(bsonRecord.id != RecordId());
+    }
+
+    if (!index->isHybridBuilding()) {
+        // The keys of the whole batch are inserted in index order, each at the timestamp of its
+        // document.
+        InsertResult result;
+        Status status = generatedKeys
+            ? index->accessMethod()->insertBatchKeys(opCtx, *generatedKeys, options, &result)
+            : index->accessMethod()->insertBatch(opCtx, bsonRecords, options, &result);
+        if (keysInsertedOut) {
+            *keysInsertedOut += result.numInserted;
+        }
+        return status;
+    }
 
+    for (const auto& bsonRecord : bsonRecords) {
         if (!bsonRecord.ts.isNull()) {
             Status status = opCtx->recoveryUnit()->setTimestamp(bsonRecord.ts);
             if (!status.isOK())
                 return status;
         }
 
-        Status status = Status::OK();
-        if (index->isHybridBuilding()) {
-            int64_t inserted;
-            status = index->indexBuildInterceptor()->sideWrite(opCtx,
-                                                               index->accessMethod(),
-                                                               bsonRecord.docPtr,
-                                                               options,
-                                                               bsonRecord.id,
-                                                               IndexBuildInterceptor::Op::kInsert,
-                                                               &inserted);
-            if (keysInsertedOut) {
-                *keysInsertedOut += inserted;
-            }
-        } else {
-            InsertResult result;
-            status = index->accessMethod()->insert(
-                opCtx, *bsonRecord.docPtr, bsonRecord.id, options, &result);
-            if (keysInsertedOut) {
-                *keysInsertedOut += result.numInserted;
-            }
+        int64_t inserted;
+        Status status =
+            index->indexBuildInterceptor()->sideWrite(opCtx,
+                                                      index->accessMethod(),
+                                                      bsonRecord.docPtr,
+                                                      options,
+                                                      bsonRecord.id,
+                                                      IndexBuildInterceptor::Op::kInsert,
+                                                      &inserted);
+        if (keysInsertedOut) {
+            *keysInsertedOut += inserted;
         }
-
         if (!status.isOK()) {
             return status;
         }
@@ -1211,17 +1401,11 @@ Status IndexCatalogImpl::_indexRecords(OperationContext* opCtx,
                                        IndexCatalogEntry* index,
                                        const std::vector<BsonRecord>& bsonRecords,
                                        int64_t* keysInsertedOut) {
-    const MatchExpression* filter = index->getFilterExpression();
-    if (!filter)
+    if (!index->getFilterExpression())
         return _indexFilteredRecords(opCtx, index, bsonRecords, keysInsertedOut);
 
-    std::vector<BsonRecord> filteredBsonRecords;
-    for (auto bsonRecord : bsonRecords) {
-        if (filter->matchesBSON(*(bsonRecord.docPtr)))
-            filteredBsonRecords.push_back(bsonRecord);
-    }
-
-    return _indexFilteredRecords(opCtx, index, filteredBsonRecords, keysInsertedOut);
+    return _indexFilteredRecords(
+        opCtx, index, filterRecords(index, bsonRecords), keysInsertedOut);
 }
 
 Status IndexCatalogImpl::_unindexRecord(OperationContext* opCtx,
@@ -1281,18 +1465,58 @@ Status IndexCatalogImpl::indexRecords(OperationContext* opCtx,
         *keysInsertedOut = 0;
     }
 
+    std::vector<IndexCatalogEntry*> indexes;
     for (auto&& it : _readyIndexes) {
-        Status s = _indexRecords(opCtx, it.get(), bsonRecords, keysInsertedOut);
-        if (!s.isOK())
-            return s;
+        indexes.push_back(it.get());
     }
-
     for (auto&& it : _buildingIndexes) {
-        Status s = _indexRecords(opCtx, it.get(), bsonRecords, keysInsertedOut);
+        indexes.push_back(it.get());
+    }
+
+    // Hybrid index builds generate their keys as part of their side writes.
+    std::vector<boost::optional<int64_t>> costs;
+    for (auto index : indexes) {
+        costs.push_back(index->isHybridBuilding()
+                            ? boost::none
+                            : boost::make_optional(estimateKeyGenerationCost(
+                                  index->descriptor(), bsonRecords.size())));
+    }
+
+    const auto offload = chooseIndexesToOffload(costs);
+    if (offload.empty()) {
+        for (auto index : indexes) {
+            Status s = _indexRecords(opCtx, index, bsonRecords, keysInsertedOut);
+            if (!s.isOK())
+                return s;
+        }
+        return Status::OK();
+    }
+
+    // Generate the keys of every index up front, some of them concurrently, then insert them one
+    // index after another on this thread, within the operation's WriteUnitOfWork.
+    std::vector<std::vector<BsonRecord>> filteredRecords(indexes.size());
+    std::vector<BatchedKeys> generatedKeys(indexes.size());
+    std::vector<InsertDeleteOptions> options(indexes.size());
+    for (size_t i = 0; i < indexes.size(); ++i) {
+        if (costs[i]) {
+            filteredRecords[i] = filterRecords(indexes[i], bsonRecords);
+            prepareInsertDeleteOptions(opCtx, indexes[i]->descriptor(), &options[i]);
+        }
+    }
+
+    generateKeysConcurrently(costs, offload, [&](size_t i) {
+        indexes[i]->accessMethod()->getBatchKeys(
+            filteredRecords[i], options[i].getKeysMode, &generatedKeys[i]);
+    });
+
+    for (size_t i = 0; i < indexes.size(); ++i) {
+        Status s = costs[i]
+            ? _indexFilteredRecords(
+                  opCtx, indexes[i], filteredRecords[i], keysInsertedOut, &generatedKeys[i])
+            : _indexRecords(opCtx, indexes[i], bsonRecords, keysInsertedOut);
         if (!s.isOK())
             return s;
     }
-
     return Status::OK();
 }
 
@@ -1305,28 +1529,45 @@ Status IndexCatalogImpl::updateRecord(OperationContext* const opCtx,
     *keysInsertedOut = 0;
     *keysDeletedOut = 0;
 
-    // Ready indexes go directly through the IndexAccessMethod.
-    for (IndexCatalogEntryContainer::const_iterator it = _readyIndexes.begin();
-         it != _readyIndexes.end();
-         ++it) {
-        IndexCatalogEntry* entry = it->get();
-
-        IndexDescriptor* descriptor = entry->descriptor();
-        IndexAccessMethod* iam = entry->accessMethod();
-
-        InsertDeleteOptions options;
-        prepareInsertDeleteOptions(opCtx, descriptor, &options);
-
-        UpdateTicket updateTicket;
+    // Ready indexes go directly through the IndexAccessMethod. validateUpdate() only generates the
+    // keys of both versions of the document, so it may run on the key generation pool for the
+    // expensive indexes, while the updates themselves are applied on this thread.
+    const size_t numReady = _readyIndexes.size();
+    std::vector<IndexCatalogEntry*> readyIndexes;
+    std::vector<boost::optional<int64_t>> costs;
+    for (auto&& it : _readyIndexes) {
+        readyIndexes.push_back(it.get());
+        costs.push_back(estimateKeyGenerationCost(it->descriptor(), 2));
+    }
+
+    std::vector<InsertDeleteOptions> options(numReady);
+    std::vector<UpdateTicket> updateTickets(numReady);
+    std::vector<Status> validateStatuses(numReady, Status::OK());
+    for (size_t i = 0; i < numReady; ++i) {
+        prepareInsertDeleteOptions(opCtx, readyIndexes[i]->descriptor(), &options[i]);
+    }
+
+    auto offload = chooseIndexesToOffload(costs);
+    offload.resize(numReady, false);
+    generateKeysConcurrently(costs, offload, [&](size_t i) {
+        IndexCatalogEntry* entry = readyIndexes[i];
+        validateStatuses[i] = entry->accessMethod()->validateUpdate(opCtx,
+                                                                    oldDoc,
+                                                                    newDoc,
+                                                                    recordId,
+                                                                    options[i],
+                                                                    &updateTickets[i],
+                                                                    entry->getFilterExpression());
+    });
 
-        auto status = iam->validateUpdate(
-            opCtx, oldDoc, newDoc, recordId, options, &updateTicket, entry->getFilterExpression());
-        if (!status.isOK())
-            return status;
+    for (size_t i = 0; i < numReady; ++i) {
+        if (!validateStatuses[i].isOK())
+            return validateStatuses[i];
 
         int64_t keysInserted;
         int64_t keysDeleted;
-        status = iam->update(opCtx, updateTicket, &keysInserted, &keysDeleted);
+        auto status = readyIndexes[i]->accessMethod()->update(
+            opCtx, updateTickets[i], &keysInserted, &keysDeleted);
         if (!status.isOK())
             return status;
 
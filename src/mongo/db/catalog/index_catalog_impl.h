@@ -382,10 +382,15 @@ private:
 
     void _checkMagic() const;
 
+    /**
+     * Inserts the keys of 'bsonRecords', all of which pass the filter of 'index', into 'index'. If
+     * 'generatedKeys' is not null, it holds the keys already generated for 'bsonRecords'.
+     */
     Status _indexFilteredRecords(OperationContext* opCtx,
                                  IndexCatalogEntry* index,
                                  const std::vector<BsonRecord>& bsonRecords,
-                                 int64_t* keysInsertedOut);
+                                 int64_t* keysInsertedOut,
+                                 const BatchedKeys* generatedKeys = nullptr);
 
     Status _indexRecords(OperationContext* opCtx,
                          IndexCatalogEntry* index,
@@ -125,6 +125,27 @@ Status validateKeyPattern(const BSONObj& key, IndexDescriptor::IndexVersion inde
                 code, mongoutils::str::stream() << "Unknown index plugin '" << pluginName << '\'');
     }
 
+    // Each path of a columnstore index is stored as a separate column, so the value of one indexed
+    // path cannot contain another.
+    if (pluginName == IndexNames::COLUMN) {
+        std::vector<FieldRef> paths;
+        for (auto&& keyElement : key) {
+            paths.emplace_back(keyElement.fieldNameStringData());
+        }
+        for (auto&& path : paths) {
+            for (auto&& other : paths) {
+                if (path.isPrefixOf(other)) {
+                    return Status(code,
+                                  str::stream() << "columnstore index paths cannot overlap: '"
+                                                << path.dottedField()
+                                                << "' is a prefix of '"
+                                                << other.dottedField()
+                                                << "'");
+                }
+            }
+        }
+    }
+
     BSONObjIterator it(key);
     while (it.more()) {
         BSONElement keyElement = it.next();
@@ -139,7 +160,7 @@ Status validateKeyPattern(const BSONObj& key, IndexDescriptor::IndexVersion inde
                                           << static_cast<int>(indexVersion)};
                 }
 
-                if (pluginName == IndexNames::WILDCARD) {
+                if (pluginName == IndexNames::WILDCARD || pluginName == IndexNames::COLUMN) {
                     return {code,
                             str::stream() << "'" << pluginName
                                           << "' index plugin is not allowed with index version v:"
@@ -301,13 +322,13 @@ StatusWith<BSONObj> validateIndexSpec(
                 return keyPatternValidateStatus;
             }
 
+            const auto pluginName = IndexNames::findPluginName(
+                indexSpec.getObjectField(IndexDescriptor::kKeyPatternFieldName));
             if ((featureCompatibility.getVersion() <
                  ServerGlobalParams::FeatureCompatibility::Version::kFullyUpgradedTo42) &&
-                (IndexNames::findPluginName(indexSpec.getObjectField(
-                     IndexDescriptor::kKeyPatternFieldName)) == IndexNames::WILDCARD)) {
+                (pluginName == IndexNames::WILDCARD || pluginName == IndexNames::COLUMN)) {
                 return {ErrorCodes::CannotCreateIndex,
-                        mongoutils::str::stream() << "Unknown index plugin '"
-                                                  << IndexNames::WILDCARD
+                        mongoutils::str::stream() << "Unknown index plugin '" << pluginName
                                                   << "'"};
             }
             hasKeyPatternField = true;
@@ -110,7 +110,8 @@ Status RecordStoreValidateAdaptor::validate(const RecordId& recordId,
                      IndexAccessMethod::GetKeysMode::kEnforceConstraints,
                      &documentKeySet,
                      &multikeyMetadataKeys,
-                     &multikeyPaths);
+                     &multikeyPaths,
+                     recordId);
 
         if (!descriptor->isMultikey(_opCtx) &&
             iam->shouldMarkIndexAsMultikey(documentKeySet, multikeyMetadataKeys, multikeyPaths)) {
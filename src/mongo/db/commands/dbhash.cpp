@@ -314,7 +314,8 @@ private:
                                               PlanExecutor::NO_YIELD,
                                               InternalPlanner::FORWARD,
                                               InternalPlanner::IXSCAN_FETCH);
-        } else if (collection->isCapped()) {
+        } else if (collection->isCapped() || collection->isClustered()) {
+            // A clustered collection is stored in _id order.
             exec = InternalPlanner::collectionScan(
                 opCtx, fullCollectionName, collection, PlanExecutor::NO_YIELD);
         } else {
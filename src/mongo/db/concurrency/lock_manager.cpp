@@ -42,6 +42,7 @@
 #include "mongo/config.h"
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/concurrency/locker.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/log.h"
 #include "mongo/util/stringutils.h"
@@ -411,15 +412,32 @@ void LockHead::migratePartitionedLockHeads() {
 // Have more buckets than CPUs to reduce contention on lock and caches
 const unsigned LockManager::_numLockBuckets(128);
 
-// Balance scalability of intent locks against potential added cost of conflicting locks.
-// The exact value doesn't appear very important, but should be power of two
-const unsigned LockManager::_numPartitions = 32;
+namespace {
+
+// Balance scalability of intent locks against potential added cost of conflicting locks, which
+// have to visit every partition which holds intent requests for the resource. The number of
+// partitions is a power of two between these bounds, and at least twice the number of hardware
+// threads.
+const unsigned kMinNumPartitions = 32;
+const unsigned kMaxNumPartitions = 1024;
 
-LockManager::LockManager() {
-    _lockBuckets = new LockBucket[_numLockBuckets];
-    _partitions = new Partition[_numPartitions];
+unsigned computeNumPartitions() {
+    const unsigned hardwareThreads = stdx::thread::hardware_concurrency();
+
+    unsigned numPartitions = kMinNumPartitions;
+    while (numPartitions < 2 * hardwareThreads && numPartitions < kMaxNumPartitions) {
+        numPartitions *= 2;
+    }
+    return numPartitions;
 }
 
+}  // namespace
+
+LockManager::LockManager()
+    : _lockBuckets(_numLockBuckets),
+      _numPartitions(computeNumPartitions()),
+      _partitions(_numPartitions) {}
+
 LockManager::~LockManager() {
     cleanupUnusedLocks();
 
@@ -427,9 +445,6 @@ LockManager::~LockManager() {
         // TODO: dump more information about the non-empty bucket to see what locks were leaked
         invariant(_lockBuckets[i].data.empty());
     }
-
-    delete[] _lockBuckets;
-    delete[] _partitions;
 }
 
 LockResult LockManager::lock(ResourceId resId, LockRequest* request, LockMode mode) {
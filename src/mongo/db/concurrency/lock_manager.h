@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <boost/align/aligned_allocator.hpp>
 #include <cstdint>
 #include <deque>
 #include <map>
@@ -44,6 +45,7 @@
 #include "mongo/stdx/mutex.h"
 #include "mongo/stdx/unordered_map.h"
 #include "mongo/util/concurrency/mutex.h"
+#include "mongo/util/with_alignment.h"
 
 namespace mongo {
 
@@ -146,9 +148,12 @@ private:
         LockHead* findOrInsert(ResourceId resId);
     };
 
-    // Each locker maps to a partition that is used for resources acquired in intent modes
-    // modes and potentially other modes that don't conflict with themselves. This avoids
-    // contention on the regular LockHead in the lock manager.
+    // Each locker maps to a partition, by its id modulo the number of partitions, that is used for
+    // resources acquired in intent modes and potentially other modes that don't conflict with
+    // themselves. This avoids contention on the regular LockHead in the lock manager. The first
+    // request for a resource in a partition still takes the resource's bucket mutex; after that,
+    // intent mode requests only take their partition's mutex, which is shared by all lockers whose
+    // ids map to the same partition, until a conflicting mode is requested on the resource.
     struct Partition {
         PartitionedLockHead* find(ResourceId resId);
         PartitionedLockHead* findOrInsert(ResourceId resId);
@@ -210,10 +215,18 @@ private:
      */
     void _cleanupUnusedLocksInBucket(LockBucket* bucket);
 
+    // Buckets and partitions are aligned to the size of a cache line, so that threads working on
+    // neighbouring buckets or partitions do not contend on the same cache line.
+    template <typename T>
+    using CacheAlignedVector =
+        std::vector<CacheAligned<T>, boost::alignment::aligned_allocator<CacheAligned<T>>>;
+
     static const unsigned _numLockBuckets;
-    LockBucket* _lockBuckets;
+    CacheAlignedVector<LockBucket> _lockBuckets;
 
-    static const unsigned _numPartitions;
-    Partition* _partitions;
+    // Scaled with the number of hardware threads, so that concurrently running lockers rarely
+    // map to the same partition.
+    const unsigned _numPartitions;
+    CacheAlignedVector<Partition> _partitions;
 };
 }  // namespace mongo
@@ -350,6 +350,40 @@ TEST(LockManager, MultipleConflict) {
     }
 }
 
+TEST(LockManager, IntentLocksFromManyLockersMigrateOnConflict) {
+    LockManager lockMgr;
+    const ResourceId resId(RESOURCE_DATABASE, std::string("TestDB"));
+
+    // Use enough lockers that their intent requests are spread over every partition.
+    const int kNumLockers = 2048;
+    std::vector<std::unique_ptr<LockerImpl>> lockers;
+    std::vector<std::unique_ptr<LockRequestCombo>> requests;
+    for (int i = 0; i < kNumLockers; i++) {
+        lockers.push_back(std::make_unique<LockerImpl>());
+        requests.push_back(std::make_unique<LockRequestCombo>(lockers.back().get()));
+        ASSERT(LOCK_OK == lockMgr.lock(resId, requests.back().get(), i % 2 ? MODE_IX : MODE_IS));
+    }
+
+    // The conflicting request has to wait for all of the partitioned intent requests.
+    LockerImpl lockerX;
+    LockRequestCombo requestX(&lockerX);
+    ASSERT(LOCK_WAITING == lockMgr.lock(resId, &requestX, MODE_X));
+
+    for (int i = 0; i < kNumLockers; i++) {
+        ASSERT(requestX.numNotifies == 0);
+        lockMgr.unlock(requests[i].get());
+    }
+
+    ASSERT(requestX.numNotifies == 1);
+    ASSERT(requestX.lastResult == LOCK_OK);
+    lockMgr.unlock(&requestX);
+
+    // Once the conflict is gone, intent requests are granted again.
+    LockRequestCombo requestIS(lockers[0].get());
+    ASSERT(LOCK_OK == lockMgr.lock(resId, &requestIS, MODE_IS));
+    lockMgr.unlock(&requestIS);
+}
+
 TEST(LockManager, ConflictCancelWaiting) {
     LockManager lockMgr;
     const ResourceId resId(RESOURCE_COLLECTION, std::string("TestDB.collection"));
@@ -180,6 +180,10 @@ public:
     // The hash of the query's "stable" key. This represents the query's shape.
     boost::optional<uint32_t> queryHash;
 
+    // For reads on secondaries at the last applied timestamp, the most seconds that a timestamp the
+    // operation read at was behind the wall clock.
+    boost::optional<long long> readStalenessSecs;
+
     // Details of any error (whether from an exception or a command returning failure).
     Status errInfo = Status::OK();
 
@@ -33,7 +33,9 @@
 
 #include "mongo/db/db_raii.h"
 
+#include "mongo/base/counter.h"
 #include "mongo/db/catalog/database_holder.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/concurrency/locker.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/db_raii_gen.h"
@@ -46,6 +48,41 @@ namespace {
 
 const boost::optional<int> kDoNotChangeProfilingLevel = boost::none;
 
+// Reads served at the last applied timestamp without conflicting with secondary batch application,
+// and how many seconds the timestamps they read at were behind the wall clock in total.
+Counter64 lastAppliedReads;
+ServerStatusMetricField<Counter64> displayLastAppliedReads("repl.secondaryReads.atLastApplied",
+                                                           &lastAppliedReads);
+Counter64 lastAppliedReadsStalenessSecs;
+ServerStatusMetricField<Counter64> displayLastAppliedReadsStalenessSecs(
+    "repl.secondaryReads.totalStalenessSecs", &lastAppliedReadsStalenessSecs);
+
+// Reads which tried the last applied timestamp but had to conflict with batch application because
+// of catalog changes pending after it.
+Counter64 batchApplicationConflicts;
+ServerStatusMetricField<Counter64> displayBatchApplicationConflicts(
+    "repl.secondaryReads.conflictedWithBatchApplication", &batchApplicationConflicts);
+
+/**
+ * Records a read at the last applied timestamp 'readTimestamp', both in the server-wide metrics and
+ * in the operation's debug information, so slow reads report how stale the data they saw was.
+ */
+void recordLastAppliedRead(OperationContext* opCtx, Timestamp readTimestamp) {
+    lastAppliedReads.increment();
+    if (readTimestamp.isNull()) {
+        return;
+    }
+
+    const long long staleness = std::max(
+        0LL,
+        static_cast<long long>(durationCount<Seconds>(Date_t::now().toDurationSinceEpoch())) -
+            static_cast<long long>(readTimestamp.getSecs()));
+    lastAppliedReadsStalenessSecs.increment(staleness);
+
+    auto& readStalenessSecs = CurOp::get(opCtx)->debug().readStalenessSecs;
+    readStalenessSecs = std::max(readStalenessSecs.value_or(0), staleness);
+}
+
 }  // namespace
 
 AutoStatsTracker::AutoStatsTracker(OperationContext* opCtx,
@@ -149,14 +186,20 @@ AutoGetCollectionForRead::AutoGetCollectionForRead(OperationContext* opCtx,
             opCtx->recoveryUnit()->setTimestampReadSource(RecoveryUnit::ReadSource::kLastApplied);
         }
 
-        // This timestamp could be earlier than the timestamp seen when the transaction is opened
-        // because it is set asynchonously. This is not problematic because holding the collection
-        // lock guarantees no metadata changes will occur in that time.
+        // Use the timestamp of the snapshot the read will see, which opens the storage
+        // transaction. Unlike the last applied optime of the replication coordinator, this never
+        // waits on batch application, which holds the replication coordinator's mutex while it
+        // completes a batch. The timestamp is null if the storage engine has no last applied
+        // snapshot yet, in which case the read is not done at a timestamp.
         auto lastAppliedTimestamp = readAtLastAppliedTimestamp
-            ? boost::optional<Timestamp>(replCoord->getMyLastAppliedOpTime().getTimestamp())
+            ? boost::optional<Timestamp>(
+                  opCtx->recoveryUnit()->getPointInTimeReadTimestamp().value_or(Timestamp()))
             : boost::none;
 
         if (!_conflictingCatalogChanges(opCtx, minSnapshot, lastAppliedTimestamp)) {
+            if (lastAppliedTimestamp) {
+                recordLastAppliedRead(opCtx, *lastAppliedTimestamp);
+            }
             return;
         }
 
@@ -176,6 +219,7 @@ AutoGetCollectionForRead::AutoGetCollectionForRead(OperationContext* opCtx,
         // waiting for the lastAppliedTimestamp to move forward. Instead we force the reader take
         // the PBWM lock and retry.
         if (lastAppliedTimestamp) {
+            batchApplicationConflicts.increment();
             LOG(2) << "Tried reading at last-applied time: " << *lastAppliedTimestamp
                    << " on ns: " << nss.ns() << ", but future catalog changes are pending at time "
                    << *minSnapshot << ". Trying again without reading at last-applied time.";
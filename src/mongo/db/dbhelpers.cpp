@@ -51,6 +51,7 @@
 #include "mongo/db/repl/repl_client_info.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/storage/clustered_record_id.h"
 #include "mongo/db/write_concern.h"
 #include "mongo/db/write_concern_options.h"
 #include "mongo/util/log.h"
@@ -146,6 +147,18 @@ bool Helpers::findById(OperationContext* opCtx,
     if (nsFound)
         *nsFound = true;
 
+    if (collection->isClustered()) {
+        // Looking up a document by _id needs no index.
+        if (indexFound)
+            *indexFound = 1;
+
+        RecordId loc = findById(opCtx, collection, query);
+        if (loc.isNull())
+            return false;
+        result = collection->docFor(opCtx, loc).value();
+        return true;
+    }
+
     IndexCatalog* catalog = collection->getIndexCatalog();
     const IndexDescriptor* desc = catalog->findIdIndex(opCtx);
 
@@ -166,6 +179,19 @@ RecordId Helpers::findById(OperationContext* opCtx,
                            Collection* collection,
                            const BSONObj& idquery) {
     verify(collection);
+    if (collection->isClustered()) {
+        // The documents are keyed by _id, so there is no index to search.
+        auto loc = clustered_record_id::keyForId(idquery["_id"]);
+        if (!loc.isOK()) {
+            return RecordId();
+        }
+        RecordData unused;
+        if (!collection->getRecordStore()->findRecord(opCtx, loc.getValue(), &unused)) {
+            return RecordId();
+        }
+        return loc.getValue();
+    }
+
     IndexCatalog* catalog = collection->getIndexCatalog();
     const IndexDescriptor* desc = catalog->findIdIndex(opCtx);
     uassert(13430, "no _id index", desc);
@@ -42,6 +42,22 @@ namespace {
 // Stage execution will fail once size of all buffered data exceeds this threshold.
 const size_t kDefaultMaxMemUsageBytes = 32 * 1024 * 1024;
 
+// Bits per hashed RecordId in the Bloom filter. With two hash functions this gives a false
+// positive rate of about 5%.
+const size_t kBloomFilterBitsPerEntry = 8;
+
+// RecordIds are usually dense integers, so their bits are mixed before being used to pick Bloom
+// filter bits. This is the 64-bit finalizer from MurmurHash3.
+uint64_t bloomFilterHash(const mongo::RecordId& recordId) {
+    uint64_t hash = static_cast<uint64_t>(recordId.repr());
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
 }  // namespace
 
 namespace mongo {
@@ -55,9 +71,10 @@ const size_t AndHashStage::kLookAheadWorks = 10;
 // static
 const char* AndHashStage::kStageType = "AND_HASH";
 
-AndHashStage::AndHashStage(OperationContext* opCtx, WorkingSet* ws)
+AndHashStage::AndHashStage(OperationContext* opCtx, WorkingSet* ws, bool chooseBuildChild)
     : PlanStage(kStageType, opCtx),
       _ws(ws),
+      _chooseBuildChild(chooseBuildChild),
       _hashingChildren(true),
       _currentChild(0),
       _memUsage(0),
@@ -66,6 +83,7 @@ AndHashStage::AndHashStage(OperationContext* opCtx, WorkingSet* ws)
 AndHashStage::AndHashStage(OperationContext* opCtx, WorkingSet* ws, size_t maxMemUsage)
     : PlanStage(kStageType, opCtx),
       _ws(ws),
+      _chooseBuildChild(false),
       _hashingChildren(true),
       _currentChild(0),
       _memUsage(0),
@@ -90,17 +108,22 @@ bool AndHashStage::isEOF() {
         return false;
     }
 
-    // Or we're streaming in results from the last child.
+    // Or we're returning results found while choosing which child to hash.
+    if (!_bufferedResults.empty()) {
+        return false;
+    }
+
+    // Or we're streaming in results from the probe child.
 
     // If there's nothing to probe against, we're EOF.
     if (_dataMap.empty()) {
         return true;
     }
 
-    // Otherwise, we're done when the last child is done.
+    // Otherwise, we're done when the probe child is done.
     invariant(_children.size() >= 2);
-    return (WorkingSet::INVALID_ID == _lookAheadResults[_children.size() - 1]) &&
-        _children[_children.size() - 1]->isEOF();
+    return (WorkingSet::INVALID_ID == _lookAheadResults[_probeChild]) &&
+        _children[_probeChild]->isEOF();
 }
 
 PlanStage::StageState AndHashStage::doWork(WorkingSetID* out) {
@@ -120,6 +143,7 @@ PlanStage::StageState AndHashStage::doWork(WorkingSetID* out) {
         for (size_t i = 0; i < _children.size(); ++i) {
             _lookAheadResults[i] = WorkingSet::INVALID_ID;
         }
+        _probeChild = _children.size() - 1;
 
         // Work each child some number of times until it's either EOF or produces
         // a result.  If it's EOF this whole stage will be EOF.  If it produces a
@@ -173,7 +197,9 @@ PlanStage::StageState AndHashStage::doWork(WorkingSetID* out) {
             return PlanStage::FAILURE;
         }
 
-        if (0 == _currentChild) {
+        if (_chooseBuildChild && 2 == _children.size() && 0 == _currentChild) {
+            return readChildrenInTurn(out);
+        } else if (0 == _currentChild) {
             return readFirstChild(out);
         } else if (_currentChild < _children.size() - 1) {
             return hashOtherChildren(out);
@@ -185,17 +211,23 @@ PlanStage::StageState AndHashStage::doWork(WorkingSetID* out) {
         }
     }
 
-    // Returning results.  We read from the last child and return the results that are in our
-    // hash map.
+    // Returning results.  First return any found while choosing which child to hash.
+    if (!_bufferedResults.empty()) {
+        *out = _bufferedResults.front();
+        _bufferedResults.pop_front();
+        return PlanStage::ADVANCED;
+    }
+
+    // Then read from the probe child and return the results that are in our hash map.
 
     // We should be EOF if we're not hashing results and the dataMap is empty.
     verify(!_dataMap.empty());
 
-    // We probe _dataMap with the last child.
-    verify(_currentChild == _children.size() - 1);
+    // We probe _dataMap with the probe child.
+    verify(_currentChild == _probeChild);
 
-    // Get the next result for the (_children.size() - 1)-th child.
-    StageState childStatus = workChild(_children.size() - 1, out);
+    // Get the next result for the probe child.
+    StageState childStatus = workChild(_probeChild, out);
     if (PlanStage::ADVANCED != childStatus) {
         return childStatus;
     }
@@ -208,6 +240,13 @@ PlanStage::StageState AndHashStage::doWork(WorkingSetID* out) {
     // with no record id.
     invariant(member->hasRecordId());
 
+    if (!bloomFilterMayContain(member->recordId)) {
+        // Child's output definitely wasn't in every previous child.  Throw it out.
+        ++_specificStats.bloomFilterRejects;
+        _ws->free(*out);
+        return PlanStage::NEED_TIME;
+    }
+
     DataMap::iterator it = _dataMap.find(member->recordId);
     if (_dataMap.end() == it) {
         // Child's output wasn't in every previous child.  Throw it out.
@@ -277,6 +316,65 @@ PlanStage::StageState AndHashStage::readFirstChild(WorkingSetID* out) {
         }
 
         _specificStats.mapAfterChild.push_back(_dataMap.size());
+        buildBloomFilter();
+
+        return PlanStage::NEED_TIME;
+    } else if (PlanStage::FAILURE == childStatus) {
+        // The stage which produces a failure is responsible for allocating a working set member
+        // with error details.
+        invariant(WorkingSet::INVALID_ID != id);
+        *out = id;
+        return childStatus;
+    } else {
+        if (PlanStage::NEED_YIELD == childStatus) {
+            *out = id;
+        }
+
+        return childStatus;
+    }
+}
+
+PlanStage::StageState AndHashStage::readChildrenInTurn(WorkingSetID* out) {
+    verify(_currentChild == 0);
+
+    // Alternate between the two children on every call, so that whichever needs less work to reach
+    // EOF gets there first.
+    const size_t childNo = _nextChildToRead;
+    _nextChildToRead = 1 - childNo;
+
+    WorkingSetID id = WorkingSet::INVALID_ID;
+    StageState childStatus = workChild(childNo, &id);
+
+    if (PlanStage::ADVANCED == childStatus) {
+        WorkingSetMember* member = _ws->get(id);
+
+        // The child must give us a WorkingSetMember with a record id, since we intersect index keys
+        // based on the record id. The planner ensures that the child stage can never produce an WSM
+        // with no record id.
+        invariant(member->hasRecordId());
+
+        DataMap& dataMap = (0 == childNo) ? _dataMap : _secondChildMap;
+        if (!dataMap.insert(std::make_pair(member->recordId, id)).second) {
+            // As in readFirstChild(), this is a newer copy of a doc we already have. Throw it out.
+            _ws->free(id);
+            return PlanStage::NEED_TIME;
+        }
+
+        // Ensure that the BSONObj underlying the WorkingSetMember is owned in case we yield.
+        member->makeObjOwnedIfNeeded();
+
+        // Update memory stats.
+        _memUsage += member->getMemUsage();
+
+        return PlanStage::NEED_TIME;
+    } else if (PlanStage::IS_EOF == childStatus) {
+        chooseBuildChild(childNo);
+
+        // If the smaller child was empty, or all of its results have already been found in the
+        // other child, no more results are possible.
+        if (_dataMap.empty() && _bufferedResults.empty()) {
+            return PlanStage::IS_EOF;
+        }
 
         return PlanStage::NEED_TIME;
     } else if (PlanStage::FAILURE == childStatus) {
@@ -294,6 +392,75 @@ PlanStage::StageState AndHashStage::readFirstChild(WorkingSetID* out) {
     }
 }
 
+void AndHashStage::chooseBuildChild(size_t childNo) {
+    if (1 == childNo) {
+        std::swap(_dataMap, _secondChildMap);
+    }
+
+    _specificStats.buildChild = childNo;
+    _specificStats.mapAfterChild.push_back(_dataMap.size());
+
+    _probeChild = 1 - childNo;
+    _currentChild = _probeChild;
+    _hashingChildren = false;
+
+    // Probe the results already read from the other child, so that we don't need to hold on to
+    // them.
+    for (auto&& entry : _secondChildMap) {
+        WorkingSetMember* member = _ws->get(entry.second);
+        _memUsage -= member->getMemUsage();
+
+        DataMap::iterator it = _dataMap.find(entry.first);
+        if (_dataMap.end() != it) {
+            WorkingSetMember* hashedMember = _ws->get(it->second);
+            size_t memUsageBefore = hashedMember->getMemUsage();
+
+            AndCommon::mergeFrom(_ws, it->second, *member);
+
+            // Update memory stats.
+            _memUsage += hashedMember->getMemUsage() - memUsageBefore;
+
+            _bufferedResults.push_back(it->second);
+            _dataMap.erase(it);
+        }
+
+        _ws->free(entry.second);
+    }
+    _secondChildMap.clear();
+
+    buildBloomFilter();
+}
+
+void AndHashStage::buildBloomFilter() {
+    size_t numBits = 64;
+    while (numBits < _dataMap.size() * kBloomFilterBitsPerEntry) {
+        numBits *= 2;
+    }
+    _bloomFilter.assign(numBits / 64, 0);
+
+    const uint64_t mask = numBits - 1;
+    for (auto&& entry : _dataMap) {
+        const uint64_t hash = bloomFilterHash(entry.first);
+        const uint64_t bit1 = hash & mask;
+        const uint64_t bit2 = ((hash >> 32) | (hash << 32)) & mask;
+        _bloomFilter[bit1 / 64] |= uint64_t(1) << (bit1 % 64);
+        _bloomFilter[bit2 / 64] |= uint64_t(1) << (bit2 % 64);
+    }
+}
+
+bool AndHashStage::bloomFilterMayContain(const RecordId& recordId) const {
+    if (_bloomFilter.empty()) {
+        return true;
+    }
+
+    const uint64_t mask = _bloomFilter.size() * 64 - 1;
+    const uint64_t hash = bloomFilterHash(recordId);
+    const uint64_t bit1 = hash & mask;
+    const uint64_t bit2 = ((hash >> 32) | (hash << 32)) & mask;
+    return (_bloomFilter[bit1 / 64] & (uint64_t(1) << (bit1 % 64))) &&
+        (_bloomFilter[bit2 / 64] & (uint64_t(1) << (bit2 % 64)));
+}
+
 PlanStage::StageState AndHashStage::hashOtherChildren(WorkingSetID* out) {
     verify(_currentChild > 0);
 
@@ -308,7 +475,10 @@ PlanStage::StageState AndHashStage::hashOtherChildren(WorkingSetID* out) {
         // WSM with no record id.
         invariant(member->hasRecordId());
 
-        if (_dataMap.end() == _dataMap.find(member->recordId)) {
+        if (!bloomFilterMayContain(member->recordId)) {
+            // Ignore.  It's definitely not in every previous child.
+            ++_specificStats.bloomFilterRejects;
+        } else if (_dataMap.end() == _dataMap.find(member->recordId)) {
             // Ignore.  It's not in any previous child.
         } else {
             // We have a hit.  Copy data into the WSM we already have.
@@ -358,6 +528,8 @@ PlanStage::StageState AndHashStage::hashOtherChildren(WorkingSetID* out) {
             return PlanStage::IS_EOF;
         }
 
+        buildBloomFilter();
+
         // We've finished scanning all children.  Return results with the next call to work().
         if (_currentChild == _children.size()) {
             _hashingChildren = false;
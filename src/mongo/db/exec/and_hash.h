@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <cstdint>
+#include <deque>
 #include <vector>
 
 #include "mongo/db/exec/plan_stage.h"
@@ -44,11 +46,20 @@ namespace mongo {
  * Reads from N children, each of which must have a valid RecordId. Uses a hash table to intersect
  * the outputs of the N children based on their record ids, and outputs the intersection.
  *
+ * The hash table is built from every child but the last, which is streamed and probed against it.
+ * A Bloom filter over the hashed RecordIds lets most results which are not in the intersection be
+ * discarded without probing the hash table.
+ *
+ * If 'chooseBuildChild' is set and there are exactly two children, the children are read in turn
+ * and whichever reaches EOF first is the one hashed, since it is the more selective of the two. The
+ * results already read from the other child are probed as soon as the choice is made. This holds
+ * up to twice as much data in memory as hashing a fixed child, but never hashes the larger child.
+ *
  * Preconditions: Valid RecordId. More than one child.
  */
 class AndHashStage final : public PlanStage {
 public:
-    AndHashStage(OperationContext* opCtx, WorkingSet* ws);
+    AndHashStage(OperationContext* opCtx, WorkingSet* ws, bool chooseBuildChild = false);
 
     /**
      * For testing only. Allows tests to set memory usage threshold.
@@ -80,9 +91,26 @@ private:
     static const size_t kLookAheadWorks;
 
     StageState readFirstChild(WorkingSetID* out);
+    StageState readChildrenInTurn(WorkingSetID* out);
     StageState hashOtherChildren(WorkingSetID* out);
     StageState workChild(size_t childNo, WorkingSetID* out);
 
+    /**
+     * Called once 'childNo' is known to be the smaller of two children read in turn. Makes it the
+     * hashed child and probes the results already read from the other child against it.
+     */
+    void chooseBuildChild(size_t childNo);
+
+    /**
+     * Rebuilds the Bloom filter from the RecordIds currently in '_dataMap'.
+     */
+    void buildBloomFilter();
+
+    /**
+     * Returns false if 'recordId' is definitely not in '_dataMap'.
+     */
+    bool bloomFilterMayContain(const RecordId& recordId) const;
+
     // Not owned by us.
     WorkingSet* _ws;
 
@@ -101,6 +129,29 @@ private:
     typedef stdx::unordered_set<RecordId, RecordId::Hasher> SeenMap;
     SeenMap _seenMap;
 
+    // A Bloom filter over the RecordIds in _dataMap, rebuilt each time a child has been hashed.
+    // Entries removed from _dataMap afterwards are not removed from the filter. Empty until the
+    // first child has been hashed. It uses one byte per hashed result, and like _lookAheadResults
+    // does not count towards the memory limit.
+    std::vector<uint64_t> _bloomFilter;
+
+    // Whether to choose which of two children to hash, rather than always hashing the first.
+    const bool _chooseBuildChild;
+
+    // When choosing which of two children to hash, the results read so far from the second child.
+    // _dataMap holds those from the first.
+    DataMap _secondChildMap;
+
+    // Which of two children to read from next while choosing which one to hash.
+    size_t _nextChildToRead = 0;
+
+    // The child whose results are streamed and probed against _dataMap. This is the last child
+    // unless the build child was chosen.
+    size_t _probeChild = 0;
+
+    // Results found in the intersection while choosing which child to hash, and not yet returned.
+    std::deque<WorkingSetID> _bufferedResults;
+
     // True if we're still intersecting _children[0..._children.size()-1].
     bool _hashingChildren;
 
@@ -63,6 +63,7 @@ CollectionScan::CollectionScan(OperationContext* opCtx,
     : RequiresCollectionStage(kStageType, opCtx, collection),
       _workingSet(workingSet),
       _filter(filter),
+      _compiledFilter(Filter::compile(filter)),
       _params(params) {
     // Explain reports the direction of the collection scan.
     _specificStats.direction = params.direction;
@@ -83,10 +84,11 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
 
     boost::optional<Record> record;
     const bool needToMakeCursor = !_cursor;
+    const bool forward = _params.direction == CollectionScanParams::FORWARD;
+    const auto& startBound = forward ? _params.minRecord : _params.maxRecord;
+    const auto& endBound = forward ? _params.maxRecord : _params.minRecord;
     try {
         if (needToMakeCursor) {
-            const bool forward = _params.direction == CollectionScanParams::FORWARD;
-
             if (forward && _params.shouldWaitForOplogVisibility) {
                 // Forward, non-tailable scans from the oplog need to wait until all oplog entries
                 // before the read begins to be visible. This isn't needed for reverse scans because
@@ -130,6 +132,21 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
 
         if (_lastSeenId.isNull() && !_params.start.isNull()) {
             record = _cursor->seekExact(_params.start);
+        } else if (_lastSeenId.isNull() && startBound) {
+            // Rather than reading every record ahead of the range, position the cursor on the
+            // highest record at or below the bound the scan starts from. A forward scan skips that
+            // record if it falls below the range.
+            auto startLoc =
+                collection()->getRecordStore()->oplogStartHack(getOpCtx(), *startBound);
+            if (startLoc && !startLoc->isNull()) {
+                record = _cursor->seekExact(*startLoc);
+            } else if (startLoc && !forward) {
+                // No record is at or below the upper bound.
+                _commonStats.isEOF = true;
+                return PlanStage::IS_EOF;
+            } else {
+                record = _cursor->next();
+            }
         } else {
             record = _cursor->next();
         }
@@ -154,6 +171,16 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
         return PlanStage::IS_EOF;
     }
 
+    if (endBound && (forward ? record->id > *endBound : record->id < *endBound)) {
+        _commonStats.isEOF = true;
+        return PlanStage::IS_EOF;
+    }
+    if (startBound && (forward ? record->id < *startBound : record->id > *startBound)) {
+        // Not yet in the range.
+        _lastSeenId = record->id;
+        return PlanStage::NEED_TIME;
+    }
+
     _lastSeenId = record->id;
     if (_params.shouldTrackLatestOplogTimestamp) {
         auto status = setLatestOplogEntryTimestamp(*record);
@@ -190,9 +217,10 @@ PlanStage::StageState CollectionScan::returnIfMatches(WorkingSetMember* member,
                                                       WorkingSetID* out) {
     ++_specificStats.docsTested;
 
-    if (Filter::passes(member, _filter)) {
+    if (Filter::passes(member, _filter, _compiledFilter.get())) {
         if (_params.stopApplyingFilterAfterFirstMatch) {
             _filter = nullptr;
+            _compiledFilter.reset();
         }
         *out = memberID;
         return PlanStage::ADVANCED;
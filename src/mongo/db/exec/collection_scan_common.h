@@ -45,6 +45,12 @@ struct CollectionScanParams {
     // The RecordId to which we should seek to as the first document of the scan.
     RecordId start;
 
+    // If present, the scan returns only the records from 'minRecord' to 'maxRecord'. Unless 'start'
+    // is set, it begins near the bound it reads towards and stops past the other one. Used to scan
+    // a range of _ids of a clustered collection, whose RecordIds are derived from the _id.
+    boost::optional<RecordId> minRecord;
+    boost::optional<RecordId> maxRecord;
+
     // If present, the collection scan will stop and return EOF the first time it sees a document
     // that does not pass the filter and has 'ts' greater than 'maxTs'.
     boost::optional<Timestamp> maxTs;
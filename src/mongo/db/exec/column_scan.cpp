@@ -0,0 +1,337 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/column_scan.h"
+
+#include <algorithm>
+
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/concurrency/write_conflict_exception.h"
+#include "mongo/db/exec/filter.h"
+#include "mongo/db/exec/working_set.h"
+#include "mongo/db/index/column_key_generator.h"
+#include "mongo/db/index/index_access_method.h"
+#include "mongo/stdx/memory.h"
+
+namespace mongo {
+namespace {
+
+struct Cell {
+    const FieldRef* path;
+    BSONElement value;
+
+    // The rank of 'path' among the paths of the document, in document order.
+    size_t rank;
+};
+
+/**
+ * Appends the values of 'cells', whose paths share their first 'depth' components, to 'bob'. The
+ * cells whose paths share their first 'depth' + 1 components must be adjacent.
+ */
+void appendCells(std::vector<Cell>::const_iterator begin,
+                 std::vector<Cell>::const_iterator end,
+                 size_t depth,
+                 BSONObjBuilder* bob) {
+    while (begin != end) {
+        const FieldRef& path = *begin->path;
+        const StringData part = path.getPart(depth);
+        if (path.numParts() == depth + 1) {
+            bob->appendAs(begin->value, part);
+            ++begin;
+            continue;
+        }
+
+        auto groupEnd = std::find_if(begin, end, [&](const Cell& cell) {
+            return cell.path->numParts() <= depth + 1 || cell.path->getPart(depth) != part;
+        });
+        BSONObjBuilder sub(bob->subobjStart(part));
+        appendCells(begin, groupEnd, depth + 1, &sub);
+        sub.doneFast();
+        begin = groupEnd;
+    }
+}
+
+}  // namespace
+
+// static
+const char* ColumnScan::kStageType = "COLUMN_SCAN";
+
+ColumnScan::ColumnScan(OperationContext* opCtx,
+                       const IndexDescriptor* descriptor,
+                       std::vector<std::string> paths,
+                       WorkingSet* workingSet,
+                       const MatchExpression* filter)
+    : RequiresIndexStage(kStageType, opCtx, descriptor), _workingSet(workingSet), _filter(filter) {
+    _specificStats.indexName = descriptor->indexName();
+    _specificStats.keyPattern = descriptor->keyPattern();
+    _specificStats.paths = paths;
+
+    // Put _id first, as in stored documents. Sorting the rest by path keeps paths which share a
+    // prefix adjacent, so the values beneath a common prefix are appended as one subobject. This
+    // order is only used for rows whose key does not give the document order of their paths.
+    std::sort(paths.begin(), paths.end(), [](const std::string& lhs, const std::string& rhs) {
+        const bool lhsIsId = FieldRef(lhs).getPart(0) == "_id";
+        const bool rhsIsId = FieldRef(rhs).getPart(0) == "_id";
+        return lhsIsId != rhsIsId ? lhsIsId : lhs < rhs;
+    });
+    const ColumnKeyGenerator keyGen(descriptor->keyPattern());
+    const auto& keyPatternPaths = keyGen.getPaths();
+    for (auto&& path : paths) {
+        const auto it = std::find(keyPatternPaths.begin(), keyPatternPaths.end(), path);
+        invariant(it != keyPatternPaths.end());
+        _columns.push_back({FieldRef(path),
+                            static_cast<int>(it - keyPatternPaths.begin()),
+                            nullptr,
+                            boost::none});
+    }
+}
+
+std::pair<std::unique_ptr<SortedDataInterface::Cursor>, boost::optional<IndexKeyEntry>>
+ColumnScan::openColumn(StringData path) {
+    auto cursor = indexAccessMethod()->newCursor(getOpCtx(), true);
+    cursor->setEndPosition(ColumnKeyGenerator::columnEndKey(path), true);
+    auto entry = cursor->seek(ColumnKeyGenerator::columnStartKey(path), true);
+    if (entry) {
+        ++_specificStats.keysExamined;
+        entry->key = entry->key.getOwned();
+    }
+    return {std::move(cursor), std::move(entry)};
+}
+
+boost::optional<IndexKeyEntry> ColumnScan::initCursors() {
+    for (auto&& column : _columns) {
+        std::tie(column.cursor, column.cell) = openColumn(column.path.dottedField());
+    }
+
+    // The row cursor is opened last, so that a write conflict while opening the columns is retried
+    // from the start.
+    auto row = openColumn(ColumnKeyGenerator::kRowPath);
+    _rowCursor = std::move(row.first);
+    return row.second;
+}
+
+void ColumnScan::advanceColumn(Column* column, const RecordId& id) {
+    while (column->cell && column->cell->loc < id) {
+        column->cell = column->cursor->next();
+        if (column->cell) {
+            ++_specificStats.keysExamined;
+            column->cell->key = column->cell->key.getOwned();
+        }
+    }
+}
+
+PlanStage::StageState ColumnScan::doWork(WorkingSetID* out) {
+    if (_commonStats.isEOF) {
+        return PlanStage::IS_EOF;
+    }
+
+    BSONObj obj;
+    bool rowRead = false;
+    try {
+        if (_rowRetrying) {
+            // The row cursor is still positioned on the row which hit a write conflict.
+            _rowRetrying = false;
+        } else {
+            boost::optional<IndexKeyEntry> row;
+            if (!_rowCursor) {
+                row = initCursors();
+            } else {
+                row = _rowCursor->next();
+                if (row) {
+                    ++_specificStats.keysExamined;
+                }
+            }
+
+            if (!row) {
+                _commonStats.isEOF = true;
+                _rowCursor.reset();
+                _columns.clear();
+                return PlanStage::IS_EOF;
+            }
+            _rowId = row->loc;
+            _rowKey = row->key.getOwned();
+        }
+        rowRead = true;
+
+        const RecordId id = _rowId;
+
+        // The row key lists the key pattern positions of the document's paths in document order.
+        std::vector<size_t> ranks;
+        const BSONElement order = ColumnKeyGenerator::parseKey(_rowKey).value;
+        if (order.type() == BSONType::Array) {
+            size_t rank = 0;
+            for (auto&& position : order.Obj()) {
+                const size_t index = position.numberInt();
+                if (ranks.size() <= index) {
+                    ranks.resize(index + 1, 0);
+                }
+                ranks[index] = rank++;
+            }
+        }
+
+        std::vector<Cell> cells;
+        bool needsDocument = false;
+        for (size_t i = 0; i < _columns.size(); ++i) {
+            auto& column = _columns[i];
+            advanceColumn(&column, id);
+            if (!column.cell || column.cell->loc != id) {
+                continue;
+            }
+
+            const auto cell = ColumnKeyGenerator::parseKey(column.cell->key);
+            if (cell.irregular) {
+                needsDocument = true;
+                break;
+            }
+            const size_t position = column.keyPatternPosition;
+            const size_t rank = position < ranks.size() ? ranks[position] : i;
+            cells.push_back({&column.path, cell.value, rank});
+        }
+
+        if (needsDocument) {
+            Snapshotted<BSONObj> doc;
+            ++_specificStats.docsExamined;
+            if (!collection()->findDoc(getOpCtx(), id, &doc)) {
+                return PlanStage::NEED_TIME;
+            }
+            obj = doc.value().getOwned();
+        } else {
+            std::stable_sort(cells.begin(), cells.end(), [](const Cell& lhs, const Cell& rhs) {
+                return lhs.rank < rhs.rank;
+            });
+            BSONObjBuilder bob;
+            appendCells(cells.begin(), cells.end(), 0, &bob);
+            obj = bob.obj();
+        }
+    } catch (const WriteConflictException&) {
+        // If the cursors could not all be opened, they are opened again after the yield. A row
+        // which was already read is built again once the columns are back on its cells.
+        _rowRetrying = rowRead;
+        *out = WorkingSet::INVALID_ID;
+        return PlanStage::NEED_YIELD;
+    }
+
+    WorkingSetID id = _workingSet->allocate();
+    WorkingSetMember* member = _workingSet->get(id);
+    member->obj = Snapshotted<BSONObj>(SnapshotId(), std::move(obj));
+    _workingSet->transitionToOwnedObj(id);
+
+    if (!Filter::passes(member, _filter)) {
+        _workingSet->free(id);
+        return PlanStage::NEED_TIME;
+    }
+
+    *out = id;
+    return PlanStage::ADVANCED;
+}
+
+bool ColumnScan::isEOF() {
+    return _commonStats.isEOF;
+}
+
+void ColumnScan::doSaveStateRequiresIndex() {
+    if (_rowCursor) {
+        _rowCursor->save();
+    }
+    for (auto&& column : _columns) {
+        if (column.cursor) {
+            column.cursor->save();
+        }
+    }
+}
+
+void ColumnScan::doRestoreStateRequiresIndex() {
+    if (_rowCursor) {
+        _rowCursor->restore();
+    }
+    for (auto&& column : _columns) {
+        if (column.cursor) {
+            column.cursor->restore();
+        }
+    }
+
+    if (!_rowCursor || _rowId.isNull()) {
+        // The columns are (re)opened along with the row cursor.
+        return;
+    }
+
+    // Cells may have been inserted or deleted while yielded, so the cached cells can't be trusted.
+    // Position each column on the first cell of the current row or a later one again.
+    for (auto&& column : _columns) {
+        column.cell = column.cursor->seek(
+            ColumnKeyGenerator::cellStartKey(column.path.dottedField(), _rowId), true);
+        if (column.cell) {
+            ++_specificStats.keysExamined;
+            column.cell->key = column.cell->key.getOwned();
+        }
+    }
+}
+
+void ColumnScan::doDetachFromOperationContext() {
+    if (_rowCursor) {
+        _rowCursor->detachFromOperationContext();
+    }
+    for (auto&& column : _columns) {
+        if (column.cursor) {
+            column.cursor->detachFromOperationContext();
+        }
+    }
+}
+
+void ColumnScan::doReattachToOperationContext() {
+    if (_rowCursor) {
+        _rowCursor->reattachToOperationContext(getOpCtx());
+    }
+    for (auto&& column : _columns) {
+        if (column.cursor) {
+            column.cursor->reattachToOperationContext(getOpCtx());
+        }
+    }
+}
+
+std::unique_ptr<PlanStageStats> ColumnScan::getStats() {
+    // Add a BSON representation of the filter to the stats tree, if there is one.
+    if (_filter) {
+        BSONObjBuilder bob;
+        _filter->serialize(&bob);
+        _commonStats.filter = bob.obj();
+    }
+
+    auto ret = stdx::make_unique<PlanStageStats>(_commonStats, STAGE_COLUMN_SCAN);
+    ret->specific = stdx::make_unique<ColumnScanStats>(_specificStats);
+    return ret;
+}
+
+const SpecificStats* ColumnScan::getSpecificStats() const {
+    return &_specificStats;
+}
+
+}  // namespace mongo
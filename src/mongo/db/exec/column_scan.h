@@ -0,0 +1,135 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/db/exec/plan_stats.h"
+#include "mongo/db/exec/requires_index_stage.h"
+#include "mongo/db/field_ref.h"
+#include "mongo/db/matcher/expression.h"
+#include "mongo/db/storage/index_entry_comparison.h"
+#include "mongo/db/storage/sorted_data_interface.h"
+
+namespace mongo {
+
+class WorkingSet;
+
+/**
+ * Reads the columns of a columnstore index in RecordId order, returning for each document in the
+ * collection an owned object which holds only the values of 'paths', in the field order of the
+ * document, and passes the provided filter.
+ * A document whose cell for one of 'paths' holds no value, because an array lies along the path, is
+ * fetched from the collection and returned whole.
+ *
+ * Preconditions: None. Is a leaf and consumes no stage data.
+ */
+class ColumnScan final : public RequiresIndexStage {
+public:
+    static const char* kStageType;
+
+    ColumnScan(OperationContext* opCtx,
+               const IndexDescriptor* descriptor,
+               std::vector<std::string> paths,
+               WorkingSet* workingSet,
+               const MatchExpression* filter);
+
+    StageState doWork(WorkingSetID* out) final;
+    bool isEOF() final;
+
+    void doDetachFromOperationContext() final;
+    void doReattachToOperationContext() final;
+
+    StageType stageType() const final {
+        return STAGE_COLUMN_SCAN;
+    }
+
+    std::unique_ptr<PlanStageStats> getStats() final;
+
+    const SpecificStats* getSpecificStats() const final;
+
+protected:
+    void doSaveStateRequiresIndex() final;
+
+    void doRestoreStateRequiresIndex() final;
+
+private:
+    struct Column {
+        FieldRef path;
+
+        // The position of 'path' in the key pattern, by which row keys refer to it.
+        int keyPatternPosition;
+
+        std::unique_ptr<SortedDataInterface::Cursor> cursor;
+
+        // The first cell of the column which belongs to the current row or a later one. Owned.
+        boost::optional<IndexKeyEntry> cell;
+    };
+
+    /**
+     * Opens a cursor over the row keys and one cursor over each column.
+     */
+    boost::optional<IndexKeyEntry> initCursors();
+
+    /**
+     * Returns a cursor positioned on the first key of 'path', and that key.
+     */
+    std::pair<std::unique_ptr<SortedDataInterface::Cursor>, boost::optional<IndexKeyEntry>>
+    openColumn(StringData path);
+
+    /**
+     * Advances 'column' past the cells of the rows preceding 'id'.
+     */
+    void advanceColumn(Column* column, const RecordId& id);
+
+    WorkingSet* const _workingSet;
+
+    const MatchExpression* const _filter;
+
+    std::unique_ptr<SortedDataInterface::Cursor> _rowCursor;
+
+    // The RecordId of the row the row cursor is positioned on, null until the first row is read.
+    RecordId _rowId;
+
+    // The row key of '_rowId', which gives the document order of its paths. Owned.
+    BSONObj _rowKey;
+
+    // Whether the row '_rowId' hit a write conflict and must be built again before moving on.
+    bool _rowRetrying = false;
+
+    // Ordered so that the columns which share a path prefix are adjacent.
+    std::vector<Column> _columns;
+
+    ColumnScanStats _specificStats;
+};
+
+}  // namespace mongo
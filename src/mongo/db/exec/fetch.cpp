@@ -57,6 +57,7 @@ FetchStage::FetchStage(OperationContext* opCtx,
     : RequiresCollectionStage(kStageType, opCtx, collection),
       _ws(ws),
       _filter(filter),
+      _compiledFilter(Filter::compile(filter)),
       _idRetrying(WorkingSet::INVALID_ID) {
     _children.emplace_back(child);
 }
@@ -173,7 +174,7 @@ PlanStage::StageState FetchStage::returnIfMatches(WorkingSetMember* member,
     // predicate.
     ++_specificStats.docsExamined;
 
-    if (Filter::passes(member, _filter)) {
+    if (Filter::passes(member, _filter, _compiledFilter.get())) {
         *out = memberID;
         return PlanStage::ADVANCED;
     } else {
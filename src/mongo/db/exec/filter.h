@@ -29,9 +29,14 @@
 
 #pragma once
 
+#include <memory>
+
 #include "mongo/db/exec/working_set.h"
+#include "mongo/db/matcher/compiled_match_expression.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/matcher/matchable.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/stdx/memory.h"
 
 namespace mongo {
 
@@ -158,6 +163,30 @@ public:
         return filter->matches(&doc, NULL);
     }
 
+    /**
+     * Same as above, but uses 'compiledFilter', the compiled form of 'filter', if there is one and
+     * 'wsm' has a document.
+     */
+    static bool passes(WorkingSetMember* wsm,
+                       const MatchExpression* filter,
+                       CompiledMatchExpression* compiledFilter) {
+        if (compiledFilter && wsm->hasObj()) {
+            return compiledFilter->matchesBSON(wsm->obj.value());
+        }
+        return passes(wsm, filter);
+    }
+
+    /**
+     * Returns the compiled form of 'filter', or nullptr if there is no filter or compiled filters
+     * are disabled.
+     */
+    static std::unique_ptr<CompiledMatchExpression> compile(const MatchExpression* filter) {
+        if (NULL == filter || !internalQueryEnableCompiledMatchExpression.load()) {
+            return nullptr;
+        }
+        return stdx::make_unique<CompiledMatchExpression>(filter);
+    }
+
     static bool passes(const BSONObj& keyData,
                        const BSONObj& keyPattern,
                        const MatchExpression* filter) {
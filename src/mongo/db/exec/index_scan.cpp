@@ -41,6 +41,7 @@
 #include "mongo/db/index/index_access_method.h"
 #include "mongo/db/index_names.h"
 #include "mongo/db/query/index_bounds_builder.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/log.h"
 
@@ -111,6 +112,8 @@ boost::optional<IndexKeyEntry> IndexScan::initIndexScan() {
             return _indexCursor->seek(_startKey, _startKeyInclusive);
         } else {
             _checker.reset(new IndexBoundsChecker(&_bounds, _keyPattern, _direction));
+            _maxNextsBeforeSeek = std::max(0, internalQueryIndexScanMaxNextsBeforeSeek.load());
+            _nextsBeforeSeek = _maxNextsBeforeSeek;
 
             if (!_checker->getStartSeekPoint(&_seekPoint))
                 return boost::none;
@@ -131,10 +134,34 @@ PlanStage::StageState IndexScan::doWork(WorkingSetID* out) {
             case GETTING_NEXT:
                 kv = _indexCursor->next();
                 break;
-            case NEED_SEEK:
-                ++_specificStats.seeks;
-                kv = _indexCursor->seek(_seekPoint);
+            case NEED_SEEK: {
+                if (_cursorUnpositioned) {
+                    _cursorUnpositioned = false;
+                    ++_specificStats.seeks;
+                    kv = _indexCursor->seek(_seekPoint);
+                    break;
+                }
+
+                SortedDataInterface::Cursor::SeekAheadStats seekStats;
+                // The entries stepped over are not counted in keysExamined, so that it does not
+                // depend on whether the target was reached by stepping or by seeking.
+                kv = _indexCursor->seekAhead(_seekPoint, _nextsBeforeSeek, &seekStats);
+                if (seekStats.seeked) {
+                    // Stepping over keys did not reach the seek point, so spend less effort on it
+                    // next time. Keep stepping over at least one key, or the budget could never
+                    // grow again.
+                    _nextsBeforeSeek =
+                        std::max(_nextsBeforeSeek / 2, std::min(1, _maxNextsBeforeSeek));
+                    ++_specificStats.seeks;
+                } else {
+                    // We reached the seek point without a seek.
+                    ++_specificStats.seeksAvoided;
+                    if (_nextsBeforeSeek < _maxNextsBeforeSeek) {
+                        ++_nextsBeforeSeek;
+                    }
+                }
                 break;
+            }
             case HIT_END:
                 return PlanStage::IS_EOF;
         }
@@ -233,6 +260,9 @@ void IndexScan::doSaveStateRequiresIndex() {
         return;
 
     if (_scanState == NEED_SEEK) {
+        // The cursor will not have a position to step forward from after restoring, so we must
+        // seek.
+        _cursorUnpositioned = true;
         _indexCursor->saveUnpositioned();
         return;
     }
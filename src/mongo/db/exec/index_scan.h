@@ -183,6 +183,18 @@ private:
     std::unique_ptr<IndexBoundsChecker> _checker;
     IndexSeekPoint _seekPoint;
 
+    // When the checker asks us to advance, the target is often only a few keys away, for example
+    // the next value of a large $in over a dense index. Rather than seeking straight away, the
+    // cursor may step over up to '_nextsBeforeSeek' keys, which is much cheaper than a seek.
+    // The budget halves, but not below one, each time stepping fails to reach the target and grows
+    // when it succeeds, up to '_maxNextsBeforeSeek'.
+    int _maxNextsBeforeSeek = 0;
+    int _nextsBeforeSeek = 0;
+
+    // Set when the cursor has been saved without a position, so that it can only be repositioned
+    // by a full seek.
+    bool _cursorUnpositioned = false;
+
     //
     // 2) If the index scan is a single contiguous interval, then the scan can execute faster by
     //    letting the index cursor tell us when it hits the end, rather than repeatedly doing
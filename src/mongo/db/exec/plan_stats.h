@@ -157,6 +157,13 @@ struct AndHashStats : public SpecificStats {
 
     // What's our memory limit?
     size_t memLimit = 0u;
+
+    // Which child was hashed first. This is child 0 unless the stage chose between two children.
+    size_t buildChild = 0u;
+
+    // How many results from the children after the first were discarded by the Bloom filter
+    // without probing the hash table?
+    size_t bloomFilterRejects = 0u;
 };
 
 struct AndSortedStats : public SpecificStats {
@@ -202,6 +209,28 @@ struct CollectionScanStats : public SpecificStats {
     boost::optional<Timestamp> maxTs;
 };
 
+struct ColumnScanStats : public SpecificStats {
+    SpecificStats* clone() const final {
+        ColumnScanStats* specific = new ColumnScanStats(*this);
+        // BSON objects have to be explicitly copied.
+        specific->keyPattern = keyPattern.getOwned();
+        return specific;
+    }
+
+    std::string indexName;
+
+    BSONObj keyPattern;
+
+    // The indexed paths whose columns are read.
+    std::vector<std::string> paths;
+
+    // Number of entries retrieved from the index, counting both row keys and cells.
+    size_t keysExamined = 0;
+
+    // Number of documents fetched because one of their cells holds no value.
+    size_t docsExamined = 0;
+};
+
 struct CountStats : public SpecificStats {
     CountStats() : nCounted(0), nSkipped(0) {}
 
@@ -369,7 +398,8 @@ struct IndexScanStats : public SpecificStats {
           dupsTested(0),
           dupsDropped(0),
           keysExamined(0),
-          seeks(0) {}
+          seeks(0),
+          seeksAvoided(0) {}
 
     SpecificStats* clone() const final {
         IndexScanStats* specific = new IndexScanStats(*this);
@@ -419,6 +449,10 @@ struct IndexScanStats : public SpecificStats {
 
     // Number of times the index cursor is re-positioned during the execution of the scan.
     size_t seeks;
+
+    // Number of times the index cursor reached the next seek point by stepping over entries
+    // rather than re-positioning.
+    size_t seeksAvoided;
 };
 
 struct LimitStats : public SpecificStats {
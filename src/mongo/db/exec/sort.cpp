@@ -33,11 +33,15 @@
 
 #include <algorithm>
 
+#include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/db/catalog/collection.h"
+#include "mongo/db/concurrency/write_conflict_exception.h"
+#include "mongo/db/exec/filter.h"
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set_common.h"
 #include "mongo/db/exec/working_set_computed_data.h"
 #include "mongo/db/index/btree_key_generator.h"
+#include "mongo/db/index/sort_key_generator.h"
 #include "mongo/db/index_names.h"
 #include "mongo/db/query/find_common.h"
 #include "mongo/db/query/query_knobs_gen.h"
@@ -76,6 +80,10 @@ SortStage::SortStage(OperationContext* opCtx,
       _ws(ws),
       _pattern(params.pattern),
       _limit(params.limit),
+      _bufferLimit(params.limit),
+      _collection(params.limit > 0 ? params.collection : nullptr),
+      _filter(params.filter),
+      _collator(params.collator),
       _sorted(false),
       _resultIterator(_data.end()),
       _memUsage(0) {
@@ -84,9 +92,10 @@ SortStage::SortStage(OperationContext* opCtx,
     BSONObj sortComparator = FindCommon::transformSortSpec(_pattern);
     _sortKeyComparator = stdx::make_unique<WorkingSetComparator>(sortComparator);
 
-    // If limit > 1, we need to initialize _dataSet here to maintain ordered set of data items while
-    // fetching from the child stage.
-    if (_limit > 1) {
+    // If limit > 1, or items may be buffered without a WSM and so with a reserve, we need to
+    // initialize _dataSet here to maintain ordered set of data items while fetching from the child
+    // stage.
+    if (_limit > 1 || _collection) {
         const WorkingSetComparator& cmp = *_sortKeyComparator;
         _dataSet.reset(new SortableDataItemSet(cmp));
     }
@@ -97,7 +106,8 @@ SortStage::~SortStage() {}
 bool SortStage::isEOF() {
     // We're done when our child has no more results, we've sorted the child's results, and
     // we've returned all sorted results.
-    return child()->isEOF() && _sorted && (_data.end() == _resultIterator);
+    return child()->isEOF() && _sorted &&
+        (_data.end() == _resultIterator || (_limit > 0 && _numReturned >= _limit));
 }
 
 PlanStage::StageState SortStage::doWork(WorkingSetID* out) {
@@ -137,6 +147,16 @@ PlanStage::StageState SortStage::doWork(WorkingSetID* out) {
                 item.recordId = member->recordId;
             }
 
+            if (canMaterializeLate(*member)) {
+                // Keep only what is needed to order the item and to fetch its document again,
+                // along with a reserve of items to replace those whose documents change.
+                _bufferLimit = 2 * _limit;
+                item.sortKey = item.sortKey.getOwned();
+                item.snapshotId = member->obj.snapshotId();
+                item.wsid = WorkingSet::INVALID_ID;
+                _ws->free(id);
+            }
+
             addToBuffer(item);
 
             return PlanStage::NEED_TIME;
@@ -163,12 +183,110 @@ PlanStage::StageState SortStage::doWork(WorkingSetID* out) {
     // Returning results.
     verify(_resultIterator != _data.end());
     verify(_sorted);
+    if (WorkingSet::INVALID_ID == _resultIterator->wsid) {
+        return materializeResult(out);
+    }
     *out = _resultIterator->wsid;
     _resultIterator++;
+    ++_numReturned;
+
+    return PlanStage::ADVANCED;
+}
+
+PlanStage::StageState SortStage::materializeResult(WorkingSetID* out) {
+    const SortableDataItem item = *_resultIterator;
+
+    WorkingSetID id = _ws->allocate();
+    WorkingSetMember* member = _ws->get(id);
+    member->recordId = item.recordId;
+    _ws->transitionToRecordIdAndIdx(id);
+
+    try {
+        if (!_cursor) {
+            _cursor = _collection->getCursor(getOpCtx());
+        }
+
+        if (!WorkingSetCommon::fetch(getOpCtx(), _ws, id, _cursor)) {
+            // The document was deleted since it was buffered.
+            _ws->free(id);
+            ++_resultIterator;
+            return PlanStage::NEED_TIME;
+        }
+    } catch (const WriteConflictException&) {
+        // The same item is fetched again once we have yielded.
+        _ws->free(id);
+        *out = WorkingSet::INVALID_ID;
+        return PlanStage::NEED_YIELD;
+    }
 
+    ++_resultIterator;
+
+    if (item.snapshotId.isNull() || member->obj.snapshotId() != item.snapshotId) {
+        // We may have yielded since the document was buffered, so it may have been updated. Only
+        // return it if it still belongs at this position in the output.
+        if (!_sortKeyGen) {
+            _sortKeyGen = stdx::make_unique<SortKeyGenerator>(_pattern, _collator);
+        }
+        auto sortKey = _sortKeyGen->getSortKey(member->obj.value(), nullptr);
+        if (!Filter::passes(member, _filter) || !sortKey.isOK()) {
+            _ws->free(id);
+            return PlanStage::NEED_TIME;
+        }
+
+        if (SimpleBSONObjComparator::kInstance.evaluate(sortKey.getValue() != item.sortKey)) {
+            SortableDataItem moved;
+            moved.wsid = id;
+            moved.sortKey = sortKey.getValue().getOwned();
+            moved.recordId = item.recordId;
+
+            // Every result returned so far sorts before 'item', so a document which now sorts
+            // before it may belong among them and can no longer be returned in order.
+            const WorkingSetComparator& cmp = *_sortKeyComparator;
+            if (cmp(moved, item)) {
+                _ws->free(id);
+                return PlanStage::NEED_TIME;
+            }
+
+            member->makeObjOwnedIfNeeded();
+            member->addComputed(new SortKeyComputedData(moved.sortKey));
+            const auto position = _resultIterator - _data.begin();
+            _data.insert(std::upper_bound(_resultIterator, _data.end(), moved, cmp), moved);
+            _resultIterator = _data.begin() + position;
+            return PlanStage::NEED_TIME;
+        }
+    }
+
+    member->addComputed(new SortKeyComputedData(item.sortKey));
+    ++_numReturned;
+    *out = id;
     return PlanStage::ADVANCED;
 }
 
+void SortStage::doSaveState() {
+    if (_cursor) {
+        _cursor->saveUnpositioned();
+    }
+}
+
+void SortStage::doRestoreState() {
+    if (_cursor) {
+        const bool couldRestore = _cursor->restore();
+        uassert(51159, "could not restore cursor for SORT stage", couldRestore);
+    }
+}
+
+void SortStage::doDetachFromOperationContext() {
+    if (_cursor) {
+        _cursor->detachFromOperationContext();
+    }
+}
+
+void SortStage::doReattachToOperationContext() {
+    if (_cursor) {
+        _cursor->reattachToOperationContext(getOpCtx());
+    }
+}
+
 unique_ptr<PlanStageStats> SortStage::getStats() {
     _commonStats.isEOF = isEOF();
     const size_t maxBytes = static_cast<size_t>(internalQueryExecMaxBlockingSortBytes.load());
@@ -201,27 +319,31 @@ const SpecificStats* SortStage::getSpecificStats() const {
  *                     current and new item.
  *                     Updates memory usage if item was replaced.
  *     sortBuffer() - Does nothing.
- * limit > 1:
+ * limit > 1, or items may be buffered without a WSM:
  *     addToBuffer() - Does not update vector. Adds item to set.
- *                     If size of set exceeds limit, remove item from set
+ *                     If size of set exceeds the buffer limit, remove item from set
  *                     with lowest key. Updates memory usage accordingly.
  *     sortBuffer() - Copies items from set to vectors.
+ *
+ * Items buffered without a WSM (see canMaterializeLate()) are accounted by the size of their
+ * sort key rather than by the size of a WSM.
  */
 void SortStage::addToBuffer(const SortableDataItem& item) {
     // Holds ID of working set member to be freed at end of this function.
     WorkingSetID wsidToFree = WorkingSet::INVALID_ID;
 
-    WorkingSetMember* member = _ws->get(item.wsid);
-    if (_limit == 0) {
+    if (item.wsid != WorkingSet::INVALID_ID) {
         // Ensure that the BSONObj underlying the WorkingSetMember is owned in case we yield.
-        member->makeObjOwnedIfNeeded();
+        _ws->get(item.wsid)->makeObjOwnedIfNeeded();
+    }
+
+    if (_limit == 0) {
         _data.push_back(item);
-        _memUsage += member->getMemUsage();
-    } else if (_limit == 1) {
+        _memUsage += getMemUsage(item);
+    } else if (!_dataSet) {
         if (_data.empty()) {
-            member->makeObjOwnedIfNeeded();
             _data.push_back(item);
-            _memUsage = member->getMemUsage();
+            _memUsage = getMemUsage(item);
             return;
         }
         wsidToFree = item.wsid;
@@ -229,18 +351,16 @@ void SortStage::addToBuffer(const SortableDataItem& item) {
         // Compare new item with existing item in vector.
         if (cmp(item, _data[0])) {
             wsidToFree = _data[0].wsid;
-            member->makeObjOwnedIfNeeded();
             _data[0] = item;
-            _memUsage = member->getMemUsage();
+            _memUsage = getMemUsage(item);
         }
     } else {
         // Update data item set instead of vector
         // Limit not reached - insert and return
-        vector<SortableDataItem>::size_type limit(_limit);
+        vector<SortableDataItem>::size_type limit(_bufferLimit);
         if (_dataSet->size() < limit) {
-            member->makeObjOwnedIfNeeded();
             _dataSet->insert(item);
-            _memUsage += member->getMemUsage();
+            _memUsage += getMemUsage(item);
             return;
         }
         // Limit will be exceeded - compare with item with lowest key
@@ -251,15 +371,14 @@ void SortStage::addToBuffer(const SortableDataItem& item) {
         const SortableDataItem& lastItem = *lastItemIt;
         const WorkingSetComparator& cmp = *_sortKeyComparator;
         if (cmp(item, lastItem)) {
-            _memUsage -= _ws->get(lastItem.wsid)->getMemUsage();
-            _memUsage += member->getMemUsage();
+            _memUsage -= getMemUsage(lastItem);
+            _memUsage += getMemUsage(item);
             wsidToFree = lastItem.wsid;
             // According to std::set iterator validity rules,
             // it does not matter which of erase()/insert() happens first.
             // Here, we choose to erase first to release potential resources
             // used by the last item and to keep the scope of the iterator to a minimum.
             _dataSet->erase(lastItemIt);
-            member->makeObjOwnedIfNeeded();
             _dataSet->insert(item);
         }
     }
@@ -272,11 +391,34 @@ void SortStage::addToBuffer(const SortableDataItem& item) {
     }
 }
 
+bool SortStage::canMaterializeLate(const WorkingSetMember& member) const {
+    if (!_collection || member.getState() != WorkingSetMember::RID_AND_OBJ) {
+        return false;
+    }
+
+    // Any other computed data, such as a text score or a geo distance, could not be recomputed
+    // from the document alone.
+    for (int i = 0; i < WSM_COMPUTED_NUM_TYPES; ++i) {
+        auto type = static_cast<WorkingSetComputedDataType>(i);
+        if (type != WSM_SORT_KEY && member.hasComputed(type)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t SortStage::getMemUsage(const SortableDataItem& item) const {
+    if (item.wsid == WorkingSet::INVALID_ID) {
+        return sizeof(SortableDataItem) + item.sortKey.objsize();
+    }
+    return _ws->get(item.wsid)->getMemUsage();
+}
+
 void SortStage::sortBuffer() {
     if (_limit == 0) {
         const WorkingSetComparator& cmp = *_sortKeyComparator;
         std::sort(_data.begin(), _data.end(), cmp);
-    } else if (_limit == 1) {
+    } else if (!_dataSet) {
         // Buffer contains either 0 or 1 item so it is already in a sorted state.
         return;
     } else {
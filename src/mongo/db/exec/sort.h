@@ -38,11 +38,17 @@
 #include "mongo/db/jsobj.h"
 #include "mongo/db/query/index_bounds.h"
 #include "mongo/db/record_id.h"
+#include "mongo/db/storage/snapshot.h"
 #include "mongo/stdx/unordered_map.h"
 
 namespace mongo {
 
 class BtreeKeyGenerator;
+class Collection;
+class CollatorInterface;
+class MatchExpression;
+class SeekableRecordCursor;
+class SortKeyGenerator;
 
 // Parameters that must be provided to a SortStage
 class SortStageParams {
@@ -54,6 +60,17 @@ public:
 
     // Equal to 0 for no limit.
     size_t limit = 0;
+
+    // If set and 'limit' is non-zero, fetched documents are buffered as just their sort key and
+    // RecordId, and the documents which make the top 'limit' are fetched again from this
+    // collection when the results are returned. Not owned.
+    const Collection* collection = nullptr;
+
+    // The query predicate and collation. A document fetched again in a different snapshot is
+    // only returned if it still matches 'filter' and still has the sort key it was buffered
+    // with. Not owned.
+    const MatchExpression* filter = nullptr;
+    const CollatorInterface* collator = nullptr;
 };
 
 /**
@@ -63,6 +80,12 @@ public:
  *   -- For each field in 'pattern', all inputs in the child must handle a getFieldDotted for that
  *   field.
  *   -- All WSMs produced by the child stage must have the sort key available as WSM computed data.
+ *
+ * When sorting with a limit and given a collection, fetched WSMs with no computed data other than
+ * the sort key are freed as soon as they are buffered. Only their sort key and RecordId are kept,
+ * which bounds memory by the size of the keys rather than the size of the documents, and the
+ * winners are fetched again as they are returned. Since a winner may have been deleted or changed
+ * by then, the next 'limit' best items are kept as well to take its place.
  */
 class SortStage final : public PlanStage {
 public:
@@ -85,6 +108,12 @@ public:
 
     static const char* kStageType;
 
+protected:
+    void doSaveState() final;
+    void doRestoreState() final;
+    void doDetachFromOperationContext() final;
+    void doReattachToOperationContext() final;
+
 private:
     //
     // Query Stage
@@ -99,6 +128,24 @@ private:
     // Equal to 0 for no limit.
     size_t _limit;
 
+    // The number of items kept in the buffer. Equal to '_limit', or to twice '_limit' once items
+    // are buffered without a WSM, so that the next best items can replace those whose documents
+    // were deleted or changed by the time they are fetched again.
+    size_t _bufferLimit;
+
+    // The number of results returned, which stops at '_limit' if it is non-zero.
+    size_t _numReturned = 0;
+
+    // Used to fetch the documents of items buffered without a WSM. Null unless sorting with a
+    // limit and given a collection.
+    const Collection* _collection;
+    const MatchExpression* _filter;
+    const CollatorInterface* _collator;
+
+    // Created on first use.
+    std::unique_ptr<SeekableRecordCursor> _cursor;
+    std::unique_ptr<SortKeyGenerator> _sortKeyGen;
+
     //
     // Data storage
     //
@@ -109,12 +156,16 @@ private:
 
     // Collection of working set members to sort with their respective sort key.
     struct SortableDataItem {
+        // WorkingSet::INVALID_ID if the member was freed when the item was buffered, in which
+        // case the document is fetched again by 'recordId' when the item is returned.
         WorkingSetID wsid;
         BSONObj sortKey;
         // Since we must replicate the behavior of a covered sort as much as possible we use the
         // RecordId to break sortKey ties.
         // See sorta.js.
         RecordId recordId;
+        // The snapshot the document was read in, for items buffered without a WSM.
+        SnapshotId snapshotId;
     };
 
     // Comparison object for data buffers (vector and set). Items are compared on (sortKey, loc).
@@ -137,6 +188,24 @@ private:
      */
     void addToBuffer(const SortableDataItem& item);
 
+    /**
+     * Returns true if 'member' can be freed once buffered and its document fetched again later.
+     */
+    bool canMaterializeLate(const WorkingSetMember& member) const;
+
+    /**
+     * Returns the number of bytes accounted to 'item' while it is buffered.
+     */
+    size_t getMemUsage(const SortableDataItem& item) const;
+
+    /**
+     * Fetches the document of the item at '_resultIterator', which was buffered without a WSM,
+     * and advances the iterator. Documents which were deleted, or which no longer match the
+     * query, are skipped. A document whose sort key changed is put back among the remaining items
+     * at its new position, unless it now sorts before this item, in which case it is skipped.
+     */
+    StageState materializeResult(WorkingSetID* out);
+
     /**
      * Sorts data buffer.
      * Assumes no more items will be added to buffer.
@@ -152,7 +221,7 @@ private:
     // The data we buffer and sort.
     // _data will contain sorted data when all data is gathered
     // and sorted.
-    // When _limit is greater than 1 and not all data has been gathered from child stage,
+    // When _bufferLimit may be greater than 1 and not all data has been gathered from child stage,
     // _dataSet is used instead to maintain an ordered set of the incomplete data set.
     // When the data set is complete, we copy the items from _dataSet to _data which will
     // be used to provide the results of this stage through _resultIterator.
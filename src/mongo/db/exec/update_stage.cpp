@@ -35,9 +35,11 @@
 
 #include <algorithm>
 
+#include "mongo/base/counter.h"
 #include "mongo/base/status_with.h"
 #include "mongo/bson/bson_comparator_interface_base.h"
 #include "mongo/bson/mutable/algorithm.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/curop_failpoint_helpers.h"
 #include "mongo/db/exec/scoped_timer.h"
@@ -45,9 +47,13 @@
 #include "mongo/db/exec/write_stage_common.h"
 #include "mongo/db/op_observer.h"
 #include "mongo/db/query/explain.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/duplicate_key_error_info.h"
+#include "mongo/db/update/document_diff.h"
+#include "mongo/db/update/log_builder.h"
+#include "mongo/db/update/object_diff.h"
 #include "mongo/db/update/path_support.h"
 #include "mongo/db/update/storage_validation.h"
 #include "mongo/s/would_change_owning_shard_exception.h"
@@ -73,6 +79,23 @@ namespace {
 const char idFieldName[] = "_id";
 const FieldRef idFieldRef(idFieldName);
 
+// Updates whose new document is smaller than this are written out in full when they can't be
+// applied in place, since rewriting a small document is no more expensive than diffing it.
+const int kMinDocumentSizeForDamages = 1024;
+
+// Updates which can't be applied in place are written out in full if their damages would copy
+// more than 1/kMaxDamagedFraction of the new document.
+const int kMaxDamagedFraction = 4;
+
+// Counts of updates written to the storage engine as damages to the old document, and as a full
+// copy of the new document.
+Counter64 damagedUpdates;
+ServerStatusMetricField<Counter64> damagedUpdatesDisplay("record.updates.damaged",
+                                                         &damagedUpdates);
+Counter64 rewrittenUpdates;
+ServerStatusMetricField<Counter64> rewrittenUpdatesDisplay("record.updates.rewritten",
+                                                           &rewrittenUpdates);
+
 Status ensureIdFieldIsFirst(mb::Document* doc) {
     mb::Element idElem = mb::findFirstChildNamed(doc->root(), idFieldName);
 
@@ -101,6 +124,57 @@ void addObjectIDIdField(mb::Document* doc) {
     uassertStatusOK(doc->root().pushFront(idElem));
 }
 
+// Updates logged as modifiers smaller than this are not worth diffing, since their diff can't be
+// much smaller.
+const int kMinLogObjSizeForDelta = 128;
+
+/**
+ * Returns the oplog entry for the update of 'oldObj' to 'newObj' as a document diff, or
+ * boost::none if it isn't smaller than 'logObj', the update modifiers which would otherwise be
+ * logged.
+ */
+boost::optional<BSONObj> makeDeltaLogObj(const BSONObj& oldObj,
+                                         const BSONObj& newObj,
+                                         const BSONObj& logObj) {
+    if (logObj.objsize() < kMinLogObjSizeForDelta) {
+        return boost::none;
+    }
+
+    auto diff = doc_diff::computeDiff(oldObj, newObj, logObj.objsize());
+    if (!diff) {
+        return boost::none;
+    }
+
+    auto deltaObj = BSON(LogBuilder::kUpdateSemanticsFieldName
+                         << static_cast<int>(UpdateSemantics::kDelta)
+                         << doc_diff::kDiffFieldName
+                         << *diff);
+    if (deltaObj.objsize() >= logObj.objsize()) {
+        return boost::none;
+    }
+    return deltaObj;
+}
+
+/**
+ * Computes the damages which turn 'oldObj' into 'newObj' for an update that couldn't be applied in
+ * place. Returns false if the update should instead be written out as a full copy of 'newObj'.
+ */
+bool computeUpdateDamages(const Collection* collection,
+                          const BSONObj& oldObj,
+                          const BSONObj& newObj,
+                          bool indexesAffected,
+                          mb::DamageVector* damages) {
+    // Index maintenance needs the full documents, and capped collections reject size changes.
+    if (indexesAffected || collection->isCapped() || !collection->updateWithDamagesSupported()) {
+        return false;
+    }
+    if (newObj.objsize() < kMinDocumentSizeForDamages) {
+        return false;
+    }
+    return object_diff::computeDamages(
+        oldObj, newObj, newObj.objsize() / kMaxDamagedFraction, damages);
+}
+
 /**
  * Uasserts if any of the paths in 'requiredPaths' are not present in 'document', or if they are
  * arrays or array descendants.
@@ -308,6 +382,16 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
             }
         }
 
+        // Modifiers which change arrays are often logged as the whole array, so log the update as
+        // a diff of the document instead when that is smaller. Only nodes which all understand
+        // diffs, as implied by FCV 4.2, can be sent them, and internal collections whose oplog
+        // entries are inspected by op observers keep logging modifiers.
+        const bool logDelta = !request->isExplain() && !driver->isDocReplacement() &&
+            !logObj.isEmpty() && isFCV42 && internalQueryEnableLoggingV2OplogEntries.load() &&
+            !collection()->ns().isOnInternalDb() && !collection()->ns().isSystem() &&
+            !repl::ReplicationCoordinator::get(getOpCtx())
+                 ->isOplogDisabledFor(getOpCtx(), collection()->ns());
+
         if (inPlace) {
             if (!request->isExplain()) {
                 newObj = oldObj.value();
@@ -319,6 +403,13 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
                     assertUpdateToShardKeyFieldsIsValidAndDocStillBelongsToNode(metadata, oldObj);
                 }
 
+                if (logDelta) {
+                    if (auto deltaObj =
+                            makeDeltaLogObj(oldObj.value(), _doc.getObject(), logObj)) {
+                        args.update = *deltaObj;
+                    }
+                }
+
                 WriteUnitOfWork wunit(getOpCtx());
                 StatusWith<RecordData> newRecStatus = collection()->updateDocumentWithDamages(
                     getOpCtx(), recordId, std::move(snap), source, _damages, &args);
@@ -326,6 +417,7 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
                 wunit.commit();
 
                 newObj = uassertStatusOK(std::move(newRecStatus)).releaseToBson();
+                damagedUpdates.increment();
             }
 
             newRecordId = recordId;
@@ -342,17 +434,51 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
                 assertUpdateToShardKeyFieldsIsValidAndDocStillBelongsToNode(metadata, oldObj);
             }
 
+            if (logDelta) {
+                if (auto deltaObj = makeDeltaLogObj(oldObj.value(), newObj, logObj)) {
+                    args.update = *deltaObj;
+                }
+            }
+
             if (!request->isExplain()) {
+                // A small change to a large document is still written as damages to the old
+                // document when the indexes don't need updating, even though it changes the size
+                // of the document.
+                const bool useDamages = computeUpdateDamages(
+                    collection(), oldObj.value(), newObj, driver->modsAffectIndices(), &_damages);
+
                 WriteUnitOfWork wunit(getOpCtx());
-                newRecordId = collection()->updateDocument(getOpCtx(),
-                                                           recordId,
-                                                           oldObj,
-                                                           newObj,
-                                                           driver->modsAffectIndices(),
-                                                           _params.opDebug,
-                                                           &args);
+                if (useDamages) {
+                    const RecordData oldRec(oldObj.value().objdata(), oldObj.value().objsize());
+                    Snapshotted<RecordData> snap(oldObj.snapshotId(), oldRec);
+
+                    StatusWith<RecordData> newRecStatus =
+                        collection()->updateDocumentWithDamages(getOpCtx(),
+                                                                recordId,
+                                                                std::move(snap),
+                                                                newObj.objdata(),
+                                                                _damages,
+                                                                &args);
+                    uassertStatusOK(newRecStatus.getStatus());
+                    dassert(newRecStatus.getValue().toBson().binaryEqual(newObj));
+                    newRecordId = recordId;
+                } else {
+                    newRecordId = collection()->updateDocument(getOpCtx(),
+                                                               recordId,
+                                                               oldObj,
+                                                               newObj,
+                                                               driver->modsAffectIndices(),
+                                                               _params.opDebug,
+                                                               &args);
+                }
                 invariant(oldObj.snapshotId() == getOpCtx()->recoveryUnit()->getSnapshotId());
                 wunit.commit();
+
+                if (useDamages) {
+                    damagedUpdates.increment();
+                } else {
+                    rewrittenUpdates.increment();
+                }
             }
         }
 
@@ -157,6 +157,8 @@ public:
                        const NamespaceString& collectionName,
                        OptionalCollectionUUID uuid) final {}
 
+    void onBatchedWriteCommit(OperationContext* opCtx) final {}
+
     void onUnpreparedTransactionCommit(OperationContext* opCtx,
                                        const std::vector<repl::ReplOperation>& statements) final {}
 
@@ -32,12 +32,32 @@
 #include "mongo/db/ftdc/block_compressor.h"
 
 #include <zlib.h>
+#include <zstd.h>
 
+#include "mongo/base/data_type_endian.h"
+#include "mongo/base/data_view.h"
 #include "mongo/util/mongoutils/str.h"
 
 namespace mongo {
 
-StatusWith<ConstDataRange> BlockCompressor::compress(ConstDataRange source) {
+namespace {
+
+// Magic number at the start of every zstd frame, stored little endian. It is part of the zstd
+// frame format and so is stable across zstd versions.
+const std::uint32_t kZstdFrameMagic = 0xFD2FB528;
+
+bool isZstdFrame(ConstDataRange source) {
+    return source.length() >= sizeof(std::uint32_t) &&
+        ConstDataView(source.data()).read<LittleEndian<std::uint32_t>>() == kZstdFrameMagic;
+}
+
+}  // namespace
+
+StatusWith<ConstDataRange> BlockCompressor::compress(ConstDataRange source, Algorithm algorithm) {
+    if (algorithm == Algorithm::kZstd) {
+        return _compressZstd(source);
+    }
+
     z_stream stream;
     int level = Z_DEFAULT_COMPRESSION;
 
@@ -79,6 +99,10 @@ StatusWith<ConstDataRange> BlockCompressor::compress(ConstDataRange source) {
 
 StatusWith<ConstDataRange> BlockCompressor::uncompress(ConstDataRange source,
                                                        size_t uncompressedLength) {
+    if (isZstdFrame(source)) {
+        return _uncompressZstd(source, uncompressedLength);
+    }
+
     z_stream stream;
 
     stream.next_in = reinterpret_cast<unsigned char*>(const_cast<char*>(source.data()));
@@ -115,4 +139,30 @@ StatusWith<ConstDataRange> BlockCompressor::uncompress(ConstDataRange source,
     return ConstDataRange(reinterpret_cast<char*>(_buffer.data()), stream.total_out);
 }
 
+StatusWith<ConstDataRange> BlockCompressor::_compressZstd(ConstDataRange source) {
+    _buffer.resize(ZSTD_compressBound(source.length()));
+
+    size_t ret = ZSTD_compress(
+        _buffer.data(), _buffer.size(), source.data(), source.length(), ZSTD_CLEVEL_DEFAULT);
+    if (ZSTD_isError(ret)) {
+        return {ErrorCodes::BadValue,
+                str::stream() << "ZSTD_compress failed with " << ZSTD_getErrorName(ret)};
+    }
+
+    return ConstDataRange(reinterpret_cast<char*>(_buffer.data()), ret);
+}
+
+StatusWith<ConstDataRange> BlockCompressor::_uncompressZstd(ConstDataRange source,
+                                                            size_t uncompressedLength) {
+    _buffer.resize(uncompressedLength);
+
+    size_t ret = ZSTD_decompress(_buffer.data(), _buffer.size(), source.data(), source.length());
+    if (ZSTD_isError(ret)) {
+        return {ErrorCodes::BadValue,
+                str::stream() << "ZSTD_decompress failed with " << ZSTD_getErrorName(ret)};
+    }
+
+    return ConstDataRange(reinterpret_cast<char*>(_buffer.data()), ret);
+}
+
 }  // namespace mongo
@@ -38,13 +38,24 @@
 namespace mongo {
 
 /**
- * Compesses and uncompresses a block of buffer using zlib.
+ * Compesses and uncompresses a block of buffer using zlib or zstd.
  */
 class BlockCompressor {
     BlockCompressor(const BlockCompressor&) = delete;
     BlockCompressor& operator=(const BlockCompressor&) = delete;
 
 public:
+    /**
+     * Compression algorithm used for a block.
+     *
+     * NOTE: Persisted to disk. Blocks do not record the algorithm, uncompress() tells them apart
+     * by the zstd frame magic number which can never start a zlib stream.
+     */
+    enum class Algorithm {
+        kZlib,
+        kZstd,
+    };
+
     BlockCompressor() = default;
 
     /**
@@ -53,10 +64,11 @@ public:
      * Returns a pointer to a buffer that BlockCompressor owns.
      * The returned buffer is valid until the next call to compress or uncompress.
      */
-    StatusWith<ConstDataRange> compress(ConstDataRange source);
+    StatusWith<ConstDataRange> compress(ConstDataRange source,
+                                        Algorithm algorithm = Algorithm::kZlib);
 
     /**
-     * Uncompress a buffer of data.
+     * Uncompress a buffer of data compressed with either algorithm.
      *
      * maxUncompressedLength is the upper bound on the size of the uncompressed data
      * so that an internal buffer can be allocated to fit it.
@@ -66,6 +78,12 @@ public:
      */
     StatusWith<ConstDataRange> uncompress(ConstDataRange source, size_t maxUncompressedLength);
 
+private:
+    StatusWith<ConstDataRange> _compressZstd(ConstDataRange source);
+
+    StatusWith<ConstDataRange> _uncompressZstd(ConstDataRange source,
+                                               size_t maxUncompressedLength);
+
 private:
     std::vector<std::uint8_t> _buffer;
 };
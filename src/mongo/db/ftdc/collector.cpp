@@ -43,12 +43,14 @@
 
 namespace mongo {
 
-void FTDCCollectorCollection::add(std::unique_ptr<FTDCCollectorInterface> collector) {
+void FTDCCollectorCollection::add(std::unique_ptr<FTDCCollectorInterface> collector,
+                                  FTDCCollectorSampleRate rate) {
     // TODO: ensure the collectors all have unique names.
-    _collectors.emplace_back(std::move(collector));
+    _collectors.push_back(CollectorEntry{std::move(collector), rate, BSONObj()});
 }
 
-std::tuple<BSONObj, Date_t> FTDCCollectorCollection::collect(Client* client) {
+std::tuple<BSONObj, Date_t> FTDCCollectorCollection::collect(Client* client,
+                                                             FTDCCollectorSampleRate rate) {
     // If there are no collectors, just return an empty BSONObj so that that are caller knows we did
     // not collect anything
     if (_collectors.empty()) {
@@ -58,7 +60,7 @@ std::tuple<BSONObj, Date_t> FTDCCollectorCollection::collect(Client* client) {
     BSONObjBuilder builder;
 
     Date_t start = client->getServiceContext()->getPreciseClockSource()->now();
-    Date_t end;
+    Date_t end = start;
     bool firstLoop = true;
 
     builder.appendDate(kFTDCCollectStartField, start);
@@ -73,7 +75,17 @@ std::tuple<BSONObj, Date_t> FTDCCollectorCollection::collect(Client* client) {
     // Explicitly start future read transactions without a timestamp.
     opCtx->recoveryUnit()->setTimestampReadSource(RecoveryUnit::ReadSource::kNoTimestamp);
 
-    for (auto& collector : _collectors) {
+    for (auto& entry : _collectors) {
+        auto& collector = entry.collector;
+
+        // Repeat the last result of collectors which are not due so that their metrics are
+        // compressed as runs of zero deltas.
+        if (rate == FTDCCollectorSampleRate::kHighFrequency &&
+            entry.rate == FTDCCollectorSampleRate::kPeriod && !entry.lastSample.isEmpty()) {
+            builder.append(collector->name(), entry.lastSample);
+            continue;
+        }
+
         BSONObjBuilder subObjBuilder(builder.subobjStart(collector->name()));
 
         // Add a Date_t before and after each BSON is collected so that we can track timing of the
@@ -92,6 +104,10 @@ std::tuple<BSONObj, Date_t> FTDCCollectorCollection::collect(Client* client) {
 
         end = client->getServiceContext()->getPreciseClockSource()->now();
         subObjBuilder.appendDate(kFTDCCollectEndField, end);
+
+        if (entry.rate == FTDCCollectorSampleRate::kPeriod) {
+            entry.lastSample = subObjBuilder.asTempObj().getOwned();
+        }
     }
 
     builder.appendDate(kFTDCCollectEndField, end);
@@ -33,10 +33,10 @@
 #include <tuple>
 #include <vector>
 
+#include "mongo/bson/bsonobj.h"
 
 namespace mongo {
 
-class BSONObj;
 class BSONObjBuilder;
 class Date_t;
 class Client;
@@ -73,6 +73,21 @@ protected:
     FTDCCollectorInterface() = default;
 };
 
+/**
+ * How often a periodic collector is run.
+ */
+enum class FTDCCollectorSampleRate {
+    /**
+     * Run once per FTDCConfig::period.
+     */
+    kPeriod,
+
+    /**
+     * Run on every sample, including the samples taken every FTDCConfig::highFrequencyPeriod.
+     */
+    kHighFrequency,
+};
+
 /**
  * Manages the set of BSON collectors
  *
@@ -89,7 +104,8 @@ public:
      * Add a metric collector to the collection.
      * Must be called before collect. Cannot be called after collect is called.
      */
-    void add(std::unique_ptr<FTDCCollectorInterface> collector);
+    void add(std::unique_ptr<FTDCCollectorInterface> collector,
+             FTDCCollectorSampleRate rate = FTDCCollectorSampleRate::kPeriod);
 
     /**
      * Collect a sample from all collectors. Called after all adding is complete.
@@ -106,12 +122,25 @@ public:
      *    ...
      *    "end" : Date_t,      <- Time at which all collecting ended
      * }
+     *
+     * If rate is kHighFrequency, only the high frequency collectors are run. The other collectors
+     * repeat the sub-document of their last run so that the schema of the sample does not change.
      */
-    std::tuple<BSONObj, Date_t> collect(Client* client);
+    std::tuple<BSONObj, Date_t> collect(
+        Client* client, FTDCCollectorSampleRate rate = FTDCCollectorSampleRate::kPeriod);
 
 private:
+    struct CollectorEntry {
+        std::unique_ptr<FTDCCollectorInterface> collector;
+
+        FTDCCollectorSampleRate rate;
+
+        // Owned copy of the sub-document from the last time the collector was run
+        BSONObj lastSample;
+    };
+
     // collection of collectors
-    std::vector<std::unique_ptr<FTDCCollectorInterface>> _collectors;
+    std::vector<CollectorEntry> _collectors;
 };
 
 }  // namespace mongo
@@ -54,7 +54,10 @@ namespace mongo {
  * 2. It stores the deltas into an array of std::int64_t.
  * 3. It compressed each std::int64_t using VarInt integer compression. See varint.h.
  * 4. Encodes zeros in Run Length Encoded pairs of <Count, Zero>
- * 5. ZLIB compresses the final processed array
+ * 5. ZLIB (or ZSTD, see FTDCConfig::compressor) compresses the final processed array
+ *
+ * The deltas are laid out metric by metric (see getArrayOffset), so each metric's samples form a
+ * contiguous column before compression.
  *
  * NOTE: This compression ignores non-number data, and assumes the non-number data is constant
  * across all documents in the series of documents.
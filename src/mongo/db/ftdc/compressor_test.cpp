@@ -128,8 +128,11 @@ TEST_F(FTDCCompressorTest, TestStrings) {
  */
 class TestTie {
 public:
-    TestTie(FTDCValidationMode mode = FTDCValidationMode::kStrict)
-        : _compressor(&_config), _mode(mode) {}
+    TestTie(FTDCValidationMode mode = FTDCValidationMode::kStrict,
+            BlockCompressor::Algorithm algorithm = BlockCompressor::Algorithm::kZlib)
+        : _compressor(&_config), _mode(mode) {
+        _config.compressor = algorithm;
+    }
 
     ~TestTie() {
         validate(boost::none);
@@ -610,6 +613,74 @@ TEST_F(FTDCCompressorTest, TestFull) {
     }
 }
 
+// Test a full buffer compressed with zstd, and a schema change in it
+TEST_F(FTDCCompressorTest, TestFullZstd) {
+    TestTie c(FTDCValidationMode::kStrict, BlockCompressor::Algorithm::kZstd);
+
+    auto st = c.addSample(BSON("name"
+                               << "joe"
+                               << "key1"
+                               << 33
+                               << "key2"
+                               << 42));
+    ASSERT_HAS_SPACE(st);
+
+    for (size_t i = 0; i != FTDCConfig::kMaxSamplesPerArchiveMetricChunkDefault - 2; i++) {
+        st = c.addSample(BSON("name"
+                              << "joe"
+                              << "key1"
+                              << static_cast<long long int>(i * 37)
+                              << "key2"
+                              << 45));
+        ASSERT_HAS_SPACE(st);
+    }
+
+    st = c.addSample(BSON("name"
+                          << "joe"
+                          << "key1"
+                          << 34
+                          << "key2"
+                          << 45));
+    ASSERT_FULL(st);
+
+    st = c.addSample(BSON("name"
+                          << "joe"
+                          << "key1"
+                          << 34
+                          << "key2"
+                          << 45));
+    ASSERT_HAS_SPACE(st);
+
+    st = c.addSample(BSON("name"
+                          << "joe"
+                          << "key3"
+                          << 34));
+    ASSERT_SCHEMA_CHANGED(st);
+}
+
+// Test a block compressor uncompresses blocks of either algorithm
+TEST_F(FTDCCompressorTest, TestBlockCompressorAlgorithms) {
+    std::string source(4096, 'a');
+    for (size_t i = 0; i < source.size(); i += 7) {
+        source[i] = static_cast<char>('a' + i % 26);
+    }
+
+    for (auto algorithm : {BlockCompressor::Algorithm::kZlib, BlockCompressor::Algorithm::kZstd}) {
+        BlockCompressor compressor;
+        auto swCompressed = compressor.compress({source.data(), source.size()}, algorithm);
+        ASSERT_OK(swCompressed.getStatus());
+        std::string compressed(swCompressed.getValue().data(), swCompressed.getValue().length());
+
+        BlockCompressor uncompressor;
+        auto swUncompressed =
+            uncompressor.uncompress({compressed.data(), compressed.size()}, source.size());
+        ASSERT_OK(swUncompressed.getStatus());
+        ASSERT_EQUALS(source,
+                      std::string(swUncompressed.getValue().data(),
+                                  swUncompressed.getValue().length()));
+    }
+}
+
 template <typename T>
 BSONObj generateSample(std::random_device& rd, T generator, size_t count) {
     BSONObjBuilder builder;
@@ -31,6 +31,7 @@
 
 #include <cstdint>
 
+#include "mongo/db/ftdc/block_compressor.h"
 #include "mongo/util/time_support.h"
 
 namespace mongo {
@@ -46,8 +47,10 @@ struct FTDCConfig {
           maxDirectorySizeBytes(kMaxDirectorySizeBytesDefault),
           maxFileSizeBytes(kMaxFileSizeBytesDefault),
           period(kPeriodMillisDefault),
+          highFrequencyPeriod(kHighFrequencyPeriodMillisDefault),
           maxSamplesPerArchiveMetricChunk(kMaxSamplesPerArchiveMetricChunkDefault),
-          maxSamplesPerInterimMetricChunk(kMaxSamplesPerInterimMetricChunkDefault) {}
+          maxSamplesPerInterimMetricChunk(kMaxSamplesPerInterimMetricChunkDefault),
+          compressor(BlockCompressor::Algorithm::kZlib) {}
 
     /**
      * True if FTDC is collecting data. False otherwise
@@ -73,6 +76,15 @@ struct FTDCConfig {
      */
     Milliseconds period;
 
+    /**
+     * Period at which to run the high frequency collectors, zero if disabled.
+     *
+     * When enabled and shorter than period, FTDC samples at this period. Only the high frequency
+     * collectors are run for samples in between two periods, the other collectors repeat their
+     * last result so they cost nothing but runs of zero deltas in the metric chunk.
+     */
+    Milliseconds highFrequencyPeriod;
+
     /**
      * Maximum number of samples to collect in an archive metric chunk for long term storage.
      */
@@ -84,9 +96,15 @@ struct FTDCConfig {
      */
     std::uint32_t maxSamplesPerInterimMetricChunk;
 
+    /**
+     * Algorithm used to compress metric chunks. Readers handle either algorithm.
+     */
+    BlockCompressor::Algorithm compressor;
+
     static const bool kEnabledDefault = true;
 
     static const std::int64_t kPeriodMillisDefault;
+    static const std::int64_t kHighFrequencyPeriodMillisDefault = 0;
     static const std::uint64_t kMaxDirectorySizeBytesDefault = 200 * 1024 * 1024;
     static const std::uint64_t kMaxFileSizeBytesDefault = 10 * 1024 * 1024;
 
@@ -69,6 +69,12 @@ void FTDCController::setPeriod(Milliseconds millis) {
     _condvar.notify_one();
 }
 
+void FTDCController::setHighFrequencyPeriod(Milliseconds millis) {
+    stdx::lock_guard<stdx::mutex> lock(_mutex);
+    _configTemp.highFrequencyPeriod = millis;
+    _condvar.notify_one();
+}
+
 void FTDCController::setMaxDirectorySizeBytes(std::uint64_t size) {
     stdx::lock_guard<stdx::mutex> lock(_mutex);
     _configTemp.maxDirectorySizeBytes = size;
@@ -110,12 +116,13 @@ Status FTDCController::setDirectory(const boost::filesystem::path& path) {
 }
 
 
-void FTDCController::addPeriodicCollector(std::unique_ptr<FTDCCollectorInterface> collector) {
+void FTDCController::addPeriodicCollector(std::unique_ptr<FTDCCollectorInterface> collector,
+                                          FTDCCollectorSampleRate rate) {
     {
         stdx::lock_guard<stdx::mutex> lock(_mutex);
         invariant(_state == State::kNotStarted);
 
-        _periodicCollectors.add(std::move(collector));
+        _periodicCollectors.add(std::move(collector), rate);
     }
 }
 
@@ -195,13 +202,23 @@ void FTDCController::doLoop() {
         Client::initThread("ftdc");
         Client* client = &cc();
 
+        // Time at which all the periodic collectors are next due
+        Date_t nextPeriodTime;
+
         while (true) {
             // Compute the next interval to run regardless of how we were woken up
             // Skipping an interval due to a race condition with a config signal is harmless.
             auto now = getGlobalServiceContext()->getPreciseClockSource()->now();
 
+            // Sample at the high frequency period when it is enabled and shorter than the period
+            auto samplePeriod = _config.period;
+            if (_config.highFrequencyPeriod > Milliseconds(0) &&
+                _config.highFrequencyPeriod < _config.period) {
+                samplePeriod = _config.highFrequencyPeriod;
+            }
+
             // Get next time to run at
-            auto next_time = FTDCUtil::roundTime(now, _config.period);
+            auto next_time = FTDCUtil::roundTime(now, samplePeriod);
 
             // Wait for the next run or signal to shutdown
             {
@@ -242,7 +259,13 @@ void FTDCController::doLoop() {
                     _mgr = uassertStatusOK(std::move(swMgr));
                 }
 
-                auto collectSample = _periodicCollectors.collect(client);
+                auto rate = FTDCCollectorSampleRate::kHighFrequency;
+                if (next_time >= nextPeriodTime) {
+                    rate = FTDCCollectorSampleRate::kPeriod;
+                    nextPeriodTime = FTDCUtil::roundTime(next_time, _config.period);
+                }
+
+                auto collectSample = _periodicCollectors.collect(client, rate);
 
                 Status s = _mgr->writeSampleAndRotateIfNeeded(
                     client, std::get<0>(collectSample), std::get<1>(collectSample));
@@ -75,6 +75,11 @@ public:
      */
     void setPeriod(Milliseconds millis);
 
+    /**
+     * Set the period for the high frequency collectors, zero to disable high frequency sampling.
+     */
+    void setHighFrequencyPeriod(Milliseconds millis);
+
     /**
      * Set the maximum directory size in bytes.
      */
@@ -108,8 +113,11 @@ public:
 
     /**
      * Add a metric collector to collect periodically. i.e., serverStatus
+     *
+     * kHighFrequency collectors are also run every FTDCConfig::highFrequencyPeriod.
      */
-    void addPeriodicCollector(std::unique_ptr<FTDCCollectorInterface> collector);
+    void addPeriodicCollector(std::unique_ptr<FTDCCollectorInterface> collector,
+                              FTDCCollectorSampleRate rate = FTDCCollectorSampleRate::kPeriod);
 
     /**
      * Add a collector to collect on server start, and file rotation. i.e. hostInfo
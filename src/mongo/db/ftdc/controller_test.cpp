@@ -43,6 +43,7 @@
 #include "mongo/db/ftdc/constants.h"
 #include "mongo/db/ftdc/controller.h"
 #include "mongo/db/ftdc/ftdc_test.h"
+#include "mongo/db/ftdc/util.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/service_context.h"
 #include "mongo/stdx/memory.h"
@@ -280,4 +281,48 @@ TEST_F(FTDCControllerTest, TestStartAsDisabled) {
     ValidateDocumentList(alog, allDocs, FTDCValidationMode::kStrict);
 }
 
+class FTDCCountingCollector : public FTDCCollectorInterface {
+public:
+    explicit FTDCCountingCollector(std::string name) : _name(std::move(name)) {}
+
+    void collect(OperationContext* opCtx, BSONObjBuilder& builder) final {
+        builder.append("count", ++_count);
+    }
+
+    std::string name() const final {
+        return _name;
+    }
+
+private:
+    std::string _name;
+    int _count{0};
+};
+
+// Test high frequency samples only run the high frequency collectors, and repeat the last result of
+// the other collectors
+TEST_F(FTDCControllerTest, TestHighFrequencyCollectors) {
+    FTDCCollectorCollection collectors;
+    collectors.add(stdx::make_unique<FTDCCountingCollector>("slow"));
+    collectors.add(stdx::make_unique<FTDCCountingCollector>("fast"),
+                   FTDCCollectorSampleRate::kHighFrequency);
+
+    BSONObj s1 = std::get<0>(collectors.collect(getClient(), FTDCCollectorSampleRate::kPeriod));
+    ASSERT_EQUALS(s1["slow"]["count"].numberInt(), 1);
+    ASSERT_EQUALS(s1["fast"]["count"].numberInt(), 1);
+
+    BSONObj s2 =
+        std::get<0>(collectors.collect(getClient(), FTDCCollectorSampleRate::kHighFrequency));
+    ASSERT_BSONOBJ_EQ(s2["slow"].Obj(), s1["slow"].Obj());
+    ASSERT_EQUALS(s2["fast"]["count"].numberInt(), 2);
+
+    BSONObj s3 = std::get<0>(collectors.collect(getClient(), FTDCCollectorSampleRate::kPeriod));
+    ASSERT_EQUALS(s3["slow"]["count"].numberInt(), 2);
+    ASSERT_EQUALS(s3["fast"]["count"].numberInt(), 3);
+
+    // The schema of the samples is unchanged so they compress into the same metric chunk
+    std::vector<std::uint64_t> metrics;
+    ASSERT_TRUE(FTDCBSONUtil::extractMetricsFromDocument(s1, s2, &metrics).getValue());
+    ASSERT_TRUE(FTDCBSONUtil::extractMetricsFromDocument(s1, s3, &metrics).getValue());
+}
+
 }  // namespace mongo
@@ -38,6 +38,7 @@
 #include "mongo/base/data_type_validated.h"
 #include "mongo/bson/bsonmisc.h"
 #include "mongo/db/ftdc/config.h"
+#include "mongo/db/ftdc/constants.h"
 #include "mongo/db/ftdc/util.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/rpc/object_check.h"
@@ -49,14 +50,18 @@ FTDCFileReader::~FTDCFileReader() {
     _stream.close();
 }
 
+void FTDCFileReader::setTimeRange(Date_t start, Date_t end) {
+    _timeRange = std::make_pair(start, end);
+}
+
 StatusWith<bool> FTDCFileReader::hasNext() {
     while (true) {
         if (_state == State::kNeedsDoc) {
-            if (_stream.eof()) {
+            if (!_readAhead && _stream.eof()) {
                 return {false};
             }
 
-            auto swDoc = readDocument();
+            auto swDoc = nextDocument();
             if (!swDoc.isOK()) {
                 return swDoc.getStatus();
             }
@@ -92,6 +97,18 @@ StatusWith<bool> FTDCFileReader::hasNext() {
 
                 _metadata = swMetadata.getValue();
             } else if (type == FTDCBSONUtil::FTDCType::kMetricChunk) {
+                if (_timeRange) {
+                    auto swSkip = canSkipMetricChunk();
+                    if (!swSkip.isOK()) {
+                        return swSkip.getStatus();
+                    }
+
+                    if (swSkip.getValue()) {
+                        ++_skippedMetricChunks;
+                        continue;
+                    }
+                }
+
                 _state = State::kMetricChunk;
 
                 auto swDocs = FTDCBSONUtil::getMetricsFromMetricDoc(_parent, &_decompressor);
@@ -103,6 +120,11 @@ StatusWith<bool> FTDCFileReader::hasNext() {
 
                 // There is always at least the reference document
                 _pos = 0;
+
+                if (!advanceToSampleInTimeRange()) {
+                    _state = State::kNeedsDoc;
+                    continue;
+                }
             }
 
             return {true};
@@ -117,13 +139,13 @@ StatusWith<bool> FTDCFileReader::hasNext() {
         // If we have a metric chunk, return the next document in the chunk until the chunk is
         // exhausted
         if (_state == State::kMetricChunk) {
-            if (_pos + 1 == _docs.size()) {
+            _pos++;
+
+            if (!advanceToSampleInTimeRange()) {
                 _state = State::kNeedsDoc;
                 continue;
             }
 
-            _pos++;
-
             return {true};
         }
     }
@@ -145,6 +167,80 @@ std::tuple<FTDCBSONUtil::FTDCType, const BSONObj&, Date_t> FTDCFileReader::next(
     MONGO_UNREACHABLE;
 }
 
+StatusWith<BSONObj> FTDCFileReader::nextDocument() {
+    if (_readAhead) {
+        BSONObj doc = std::move(_readAhead.get());
+        _readAhead = boost::none;
+        return {doc};
+    }
+
+    return readDocument();
+}
+
+StatusWith<bool> FTDCFileReader::canSkipMetricChunk() {
+    if (_dateId > _timeRange->second) {
+        return {true};
+    }
+
+    if (_dateId >= _timeRange->first) {
+        return {false};
+    }
+
+    // The chunk starts before the range, so it ends before the range if the next chunk starts
+    // no later than the start of the range. Read ahead to find out, which reuses the buffer that
+    // _parent points into.
+    if (!_readAhead) {
+        _parent = _parent.getOwned();
+
+        auto swDoc = readDocument();
+        if (!swDoc.isOK()) {
+            return swDoc.getStatus();
+        }
+
+        _readAhead = swDoc.getValue().getOwned();
+    }
+
+    const BSONObj& next = _readAhead.get();
+    if (next.isEmpty()) {
+        return {false};
+    }
+
+    // Errors in the next document are reported when it is read by hasNext()
+    auto swType = FTDCBSONUtil::getBSONDocumentType(next);
+    if (!swType.isOK() || swType.getValue() != FTDCBSONUtil::FTDCType::kMetricChunk) {
+        return {false};
+    }
+
+    auto swId = FTDCBSONUtil::getBSONDocumentId(next);
+    if (!swId.isOK()) {
+        return {false};
+    }
+
+    return {swId.getValue() <= _timeRange->first};
+}
+
+bool FTDCFileReader::isOutsideTimeRange(const BSONObj& doc) const {
+    if (!_timeRange) {
+        return false;
+    }
+
+    // Samples without a start date cannot be placed in time, so they are always returned
+    auto element = doc[kFTDCCollectStartField];
+    if (element.type() != BSONType::Date) {
+        return false;
+    }
+
+    return element.Date() < _timeRange->first || element.Date() > _timeRange->second;
+}
+
+bool FTDCFileReader::advanceToSampleInTimeRange() {
+    while (_pos < _docs.size() && isOutsideTimeRange(_docs[_pos])) {
+        _pos++;
+    }
+
+    return _pos < _docs.size();
+}
+
 StatusWith<BSONObj> FTDCFileReader::readDocument() {
     if (!_stream.is_open()) {
         return {ErrorCodes::FileNotOpen, "open() needs to be called first."};
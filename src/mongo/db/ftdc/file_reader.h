@@ -61,6 +61,23 @@ public:
      */
     Status open(const boost::filesystem::path& file);
 
+    /**
+     * Only return the metric samples collected in [start, end]. Must be called before hasNext().
+     *
+     * Metric chunks are ordered by time in a file, and each chunk's _id is the time of its first
+     * sample. A chunk is skipped without being decompressed if it starts after end, or if the
+     * following chunk starts no later than start. Samples of the remaining chunks are filtered
+     * by their "start" field. Metadata documents are always returned.
+     */
+    void setTimeRange(Date_t start, Date_t end);
+
+    /**
+     * Returns the number of metric chunks skipped without being decompressed.
+     */
+    std::size_t getSkippedMetricChunkCount() const {
+        return _skippedMetricChunks;
+    }
+
     /**
      * Returns true if their are more records in the file.
      * Returns false if the end of the file has been reached.
@@ -81,6 +98,27 @@ private:
      */
     StatusWith<BSONObj> readDocument();
 
+    /**
+     * Read the next document, either the one read ahead by canSkipMetricChunk() or from disk.
+     */
+    StatusWith<BSONObj> nextDocument();
+
+    /**
+     * Returns true if the metric chunk in _parent starting at _dateId cannot contain a sample
+     * in the time range. May read ahead the next document.
+     */
+    StatusWith<bool> canSkipMetricChunk();
+
+    /**
+     * Returns true if the metric document is outside the time range.
+     */
+    bool isOutsideTimeRange(const BSONObj& doc) const;
+
+    /**
+     * Advance _pos to the next metric document in the time range, returns false if there is none.
+     */
+    bool advanceToSampleInTimeRange();
+
 private:
     FTDCDecompressor _decompressor;
 
@@ -143,6 +181,15 @@ private:
 
     // Input file stream
     std::ifstream _stream;
+
+    // Time range of the samples to return, if set
+    boost::optional<std::pair<Date_t, Date_t>> _timeRange;
+
+    // Owned document read ahead of _parent to find the end of its metric chunk
+    boost::optional<BSONObj> _readAhead;
+
+    // Number of metric chunks skipped without being decompressed
+    std::size_t _skippedMetricChunks{0};
 };
 
 }  // namespace mongo
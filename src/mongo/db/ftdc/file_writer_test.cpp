@@ -35,6 +35,7 @@
 #include "mongo/bson/bsonmisc.h"
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/ftdc/config.h"
+#include "mongo/db/ftdc/constants.h"
 #include "mongo/db/ftdc/file_reader.h"
 #include "mongo/db/ftdc/file_writer.h"
 #include "mongo/db/ftdc/ftdc_test.h"
@@ -359,4 +360,46 @@ TEST_F(FTDCFileTest, TestBadFile) {
     ASSERT_NOT_OK(sw);
 }
 
+// Test reading a time range of samples skips the metric chunks outside of it
+TEST_F(FTDCFileTest, TestTimeRange) {
+    unittest::TempDir tempdir("metrics_testpath");
+    boost::filesystem::path p(tempdir.path());
+    p /= kTestFile;
+
+    deleteFileIfNeeded(p);
+
+    FTDCConfig config;
+    config.maxSamplesPerArchiveMetricChunk = 10;
+    FTDCFileWriter writer(&config);
+
+    ASSERT_OK(writer.open(p));
+
+    // 5 metric chunks of 10 samples each, one sample per second
+    for (int i = 0; i < 50; i++) {
+        Date_t date = Date_t::fromMillisSinceEpoch(i * 1000);
+        ASSERT_OK(writer.writeSample(BSON(kFTDCCollectStartField << date << "key1" << i), date));
+    }
+
+    writer.close().transitional_ignore();
+
+    FTDCFileReader reader;
+    ASSERT_OK(reader.open(p));
+    reader.setTimeRange(Date_t::fromMillisSinceEpoch(22 * 1000),
+                        Date_t::fromMillisSinceEpoch(27 * 1000));
+
+    std::vector<int> keys;
+    auto sw = reader.hasNext();
+    while (sw.isOK() && sw.getValue()) {
+        ASSERT_TRUE(std::get<0>(reader.next()) == FTDCBSONUtil::FTDCType::kMetricChunk);
+        keys.push_back(std::get<1>(reader.next())["key1"].numberInt());
+        sw = reader.hasNext();
+    }
+    ASSERT_OK(sw);
+
+    ASSERT_TRUE(keys == std::vector<int>({22, 23, 24, 25, 26, 27}));
+
+    // Only the chunk starting at 20 seconds overlaps the range
+    ASSERT_EQUALS(reader.getSkippedMetricChunkCount(), 4UL);
+}
+
 }  // namespace mongo
@@ -37,6 +37,7 @@
 
 #include "mongo/base/status.h"
 #include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/bson/dotted_path_support.h"
 #include "mongo/db/commands.h"
 #include "mongo/db/ftdc/collector.h"
 #include "mongo/db/ftdc/config.h"
@@ -68,6 +69,13 @@ FTDCController* getGlobalFTDCController() {
  */
 synchronized_value<boost::filesystem::path> ftdcDirectoryPathParameter;
 
+/**
+ * Whether the high frequency collectors were installed. Collectors cannot be added once the
+ * controller has started, so they are only installed if high frequency sampling is enabled at
+ * startup.
+ */
+AtomicWord<bool> highFrequencyCollectorsInstalled{false};
+
 }  // namespace
 
 FTDCStartupParams ftdcStartupParams;
@@ -116,6 +124,33 @@ Status onUpdateFTDCPeriod(const std::int32_t potentialNewValue) {
     return Status::OK();
 }
 
+Status onUpdateFTDCHighFrequencyPeriod(const std::int32_t potentialNewValue) {
+    auto controller = getGlobalFTDCController();
+    if (controller) {
+        if (potentialNewValue > 0 && !highFrequencyCollectorsInstalled.load()) {
+            return Status(ErrorCodes::IllegalOperation,
+                          "diagnosticDataCollectionHighFrequencyPeriodMillis must be set at "
+                          "startup to enable high frequency diagnostic data collection");
+        }
+
+        controller->setHighFrequencyPeriod(Milliseconds(potentialNewValue));
+    }
+
+    return Status::OK();
+}
+
+Status onValidateFTDCCompressor(const std::string& value) {
+    if (value != "zlib" && value != "zstd") {
+        return Status(ErrorCodes::BadValue,
+                      str::stream() << "diagnosticDataCollectionCompressor must be 'zlib' or "
+                                       "'zstd', found '"
+                                    << value
+                                    << "'");
+    }
+
+    return Status::OK();
+}
+
 Status onUpdateFTDCDirectorySize(const std::int32_t potentialNewValue) {
     if (potentialNewValue < ftdcStartupParams.maxFileSizeMB.load()) {
         return Status(
@@ -188,6 +223,29 @@ std::string FTDCSimpleInternalCommandCollector::name() const {
     return _name;
 }
 
+FTDCFilteredInternalCommandCollector::FTDCFilteredInternalCommandCollector(
+    StringData command,
+    StringData name,
+    StringData ns,
+    BSONObj cmdObj,
+    std::vector<std::string> fields)
+    : FTDCSimpleInternalCommandCollector(command, name, ns, std::move(cmdObj)),
+      _fields(std::move(fields)) {}
+
+void FTDCFilteredInternalCommandCollector::collect(OperationContext* opCtx,
+                                                   BSONObjBuilder& builder) {
+    BSONObjBuilder resultBuilder;
+    FTDCSimpleInternalCommandCollector::collect(opCtx, resultBuilder);
+    BSONObj result = resultBuilder.obj();
+
+    for (const auto& field : _fields) {
+        auto element = dotted_path_support::extractElementAtPath(result, field);
+        if (!element.eoo()) {
+            builder.append(element);
+        }
+    }
+}
+
 // Register the FTDC system
 // Note: This must be run before the server parameters are parsed during startup
 // so that the FTDCController is initialized.
@@ -197,6 +255,7 @@ void startFTDC(boost::filesystem::path& path,
                RegisterCollectorsFunction registerCollectors) {
     FTDCConfig config;
     config.period = Milliseconds(ftdcStartupParams.periodMillis.load());
+    config.highFrequencyPeriod = Milliseconds(ftdcStartupParams.highFrequencyPeriodMillis.load());
     // Only enable FTDC if our caller says to enable FTDC, MongoS may not have a valid path to write
     // files to so update the diagnosticDataCollectionEnabled set parameter to reflect that.
     ftdcStartupParams.enabled.store(startupMode == FTDCStartMode::kStart &&
@@ -208,6 +267,8 @@ void startFTDC(boost::filesystem::path& path,
         ftdcStartupParams.maxSamplesPerArchiveMetricChunk.load();
     config.maxSamplesPerInterimMetricChunk =
         ftdcStartupParams.maxSamplesPerInterimMetricChunk.load();
+    config.compressor = gFTDCCompressor == "zstd" ? BlockCompressor::Algorithm::kZstd
+                                                  : BlockCompressor::Algorithm::kZlib;
 
     ftdcDirectoryPathParameter = path;
 
@@ -232,6 +293,55 @@ void startFTDC(boost::filesystem::path& path,
         BSON("serverStatus" << 1 << "tcMalloc" << true << "sharding" << false << "timing"
                             << false)));
 
+    // Subset of serverStatus for the tickets, cache, and queues. It is sampled every
+    // diagnosticDataCollectionHighFrequencyPeriodMillis, so the sections it does not use are turned
+    // off to keep it cheap. It is only installed when high frequency sampling is enabled, since it
+    // would otherwise run a second serverStatus on every sample for data the first one has.
+    if (config.highFrequencyPeriod > Milliseconds(0)) {
+        highFrequencyCollectorsInstalled.store(true);
+        controller->addPeriodicCollector(
+            stdx::make_unique<FTDCFilteredInternalCommandCollector>(
+                "serverStatus",
+                "serverStatusHighFrequency",
+                "",
+                BSON("serverStatus" << 1 << "asserts" << false << "connections" << false
+                                    << "extra_info"
+                                    << false
+                                    << "locks"
+                                    << false
+                                    << "logicalSessionRecordCache"
+                                    << false
+                                    << "metrics"
+                                    << false
+                                    << "network"
+                                    << false
+                                    << "opLatencies"
+                                    << false
+                                    << "opcounters"
+                                    << false
+                                    << "opcountersRepl"
+                                    << false
+                                    << "repl"
+                                    << false
+                                    << "sharding"
+                                    << false
+                                    << "shardingStatistics"
+                                    << false
+                                    << "storageEngine"
+                                    << false
+                                    << "tcmalloc"
+                                    << false
+                                    << "timing"
+                                    << false
+                                    << "transactions"
+                                    << false),
+                std::vector<std::string>{"globalLock.currentQueue",
+                                         "globalLock.activeClients",
+                                         "wiredTiger.concurrentTransactions",
+                                         "wiredTiger.cache"}),
+            FTDCCollectorSampleRate::kHighFrequency);
+    }
+
     registerCollectors(controller.get());
 
     // Install System Metric Collector as a periodic collector
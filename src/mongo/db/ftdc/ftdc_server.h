@@ -30,6 +30,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/commands.h"
@@ -98,6 +99,26 @@ private:
     const OpMsgRequest _request;
 };
 
+/**
+ * An FTDC Collector that runs a Command, and only keeps a set of fields from its reply.
+ *
+ * Fields are dotted paths into the reply, and are appended under their last path component.
+ * Missing fields are skipped.
+ */
+class FTDCFilteredInternalCommandCollector : public FTDCSimpleInternalCommandCollector {
+public:
+    FTDCFilteredInternalCommandCollector(StringData command,
+                                         StringData name,
+                                         StringData ns,
+                                         BSONObj cmdObj,
+                                         std::vector<std::string> fields);
+
+    void collect(OperationContext* opCtx, BSONObjBuilder& builder) override;
+
+private:
+    const std::vector<std::string> _fields;
+};
+
 /**
  * FTDC startup parameters.
  *
@@ -106,6 +127,7 @@ private:
 struct FTDCStartupParams {
     AtomicWord<bool> enabled;
     AtomicWord<int> periodMillis;
+    AtomicWord<int> highFrequencyPeriodMillis;
 
     AtomicWord<int> maxDirectorySizeMB;
     AtomicWord<int> maxFileSizeMB;
@@ -115,6 +137,7 @@ struct FTDCStartupParams {
     FTDCStartupParams()
         : enabled(FTDCConfig::kEnabledDefault),
           periodMillis(FTDCConfig::kPeriodMillisDefault),
+          highFrequencyPeriodMillis(FTDCConfig::kHighFrequencyPeriodMillisDefault),
           // Scale the values down since are defaults are in bytes, but the user interface is MB
           maxDirectorySizeMB(FTDCConfig::kMaxDirectorySizeBytesDefault / (1024 * 1024)),
           maxFileSizeMB(FTDCConfig::kMaxFileSizeBytesDefault / (1024 * 1024)),
@@ -129,6 +152,8 @@ extern FTDCStartupParams ftdcStartupParams;
  */
 Status onUpdateFTDCEnabled(const bool value);
 Status onUpdateFTDCPeriod(const std::int32_t value);
+Status onUpdateFTDCHighFrequencyPeriod(const std::int32_t value);
+Status onValidateFTDCCompressor(const std::string& value);
 Status onUpdateFTDCDirectorySize(const std::int32_t value);
 Status onUpdateFTDCFileSize(const std::int32_t value);
 Status onUpdateFTDCSamplesPerChunk(const std::int32_t value);
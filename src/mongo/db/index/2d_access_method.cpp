@@ -52,7 +52,8 @@ TwoDAccessMethod::TwoDAccessMethod(IndexCatalogEntry* btreeState, SortedDataInte
 void TwoDAccessMethod::doGetKeys(const BSONObj& obj,
                                  BSONObjSet* keys,
                                  BSONObjSet* multikeyMetadataKeys,
-                                 MultikeyPaths* multikeyPaths) const {
+                                 MultikeyPaths* multikeyPaths,
+                                 boost::optional<RecordId> id) const {
     ExpressionKeysPrivate::get2DKeys(obj, _params, keys);
 }
 
@@ -61,7 +61,8 @@ private:
     void doGetKeys(const BSONObj& obj,
                    BSONObjSet* keys,
                    BSONObjSet* multikeyMetadataKeys,
-                   MultikeyPaths* multikeyPaths) const final;
+                   MultikeyPaths* multikeyPaths,
+                   boost::optional<RecordId> id) const final;
 
     TwoDIndexingParams _params;
 };
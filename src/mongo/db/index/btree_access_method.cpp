@@ -62,7 +62,8 @@ BtreeAccessMethod::BtreeAccessMethod(IndexCatalogEntry* btreeState, SortedDataIn
 void BtreeAccessMethod::doGetKeys(const BSONObj& obj,
                                   BSONObjSet* keys,
                                   BSONObjSet* multikeyMetadataKeys,
-                                  MultikeyPaths* multikeyPaths) const {
+                                  MultikeyPaths* multikeyPaths,
+                                  boost::optional<RecordId> id) const {
     _keyGenerator->getKeys(obj, keys, multikeyPaths);
 }
 
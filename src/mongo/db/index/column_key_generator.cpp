@@ -0,0 +1,183 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/index/column_key_generator.h"
+
+#include <algorithm>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/field_ref.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+namespace {
+
+enum class PathValue { kMissing, kPresent, kIrregular };
+
+/**
+ * Looks up 'path' in 'doc' without traversing arrays. Sets 'out' to the value at the end of the
+ * path if it is present. Appends to 'positions' the index of each field along the path within its
+ * enclosing object.
+ */
+PathValue extractPathValue(const BSONObj& doc,
+                           const FieldRef& path,
+                           BSONElement* out,
+                           std::vector<int>* positions) {
+    BSONObj current = doc;
+    for (size_t i = 0; i < path.numParts(); ++i) {
+        const StringData part = path.getPart(i);
+        BSONElement elem;
+        int position = 0;
+        for (auto&& field : current) {
+            if (field.fieldNameStringData() == part) {
+                elem = field;
+                break;
+            }
+            ++position;
+        }
+        if (elem.eoo()) {
+            return PathValue::kMissing;
+        }
+        positions->push_back(position);
+
+        if (i + 1 == path.numParts()) {
+            *out = elem;
+            return PathValue::kPresent;
+        }
+
+        if (elem.type() == BSONType::Array) {
+            return PathValue::kIrregular;
+        }
+        if (elem.type() != BSONType::Object) {
+            return PathValue::kMissing;
+        }
+        current = elem.embeddedObject();
+    }
+    MONGO_UNREACHABLE;
+}
+
+}  // namespace
+
+constexpr StringData ColumnKeyGenerator::kRowPath;
+
+// static
+ColumnKeyGenerator::Cell ColumnKeyGenerator::parseKey(const BSONObj& key) {
+    BSONObjIterator it(key);
+    Cell cell;
+
+    const BSONElement pathElem = it.next();
+    invariant(pathElem.type() == BSONType::String);
+    cell.path = pathElem.valueStringData();
+
+    invariant(it.more());
+    const BSONElement idElem = it.next();
+    invariant(idElem.type() == BSONType::NumberLong);
+    cell.id = RecordId(idElem._numberLong());
+
+    if (it.more()) {
+        cell.value = it.next();
+        invariant(!it.more());
+    } else {
+        cell.irregular = (cell.path != kRowPath);
+    }
+    return cell;
+}
+
+// static
+BSONObj ColumnKeyGenerator::columnStartKey(StringData path) {
+    BSONObjBuilder bob;
+    bob.append("", path);
+    bob.appendMinKey("");
+    return bob.obj();
+}
+
+// static
+BSONObj ColumnKeyGenerator::columnEndKey(StringData path) {
+    BSONObjBuilder bob;
+    bob.append("", path);
+    bob.appendMaxKey("");
+    return bob.obj();
+}
+
+// static
+BSONObj ColumnKeyGenerator::cellStartKey(StringData path, RecordId id) {
+    BSONObjBuilder bob;
+    bob.append("", path);
+    bob.append("", id.repr());
+    return bob.obj();
+}
+
+ColumnKeyGenerator::ColumnKeyGenerator(const BSONObj& keyPattern) {
+    for (auto&& elem : keyPattern) {
+        _paths.push_back(elem.fieldName());
+    }
+}
+
+void ColumnKeyGenerator::generateKeys(const BSONObj& doc, RecordId id, BSONObjSet* keys) const {
+    const long long idRepr = id.repr();
+
+    // The key pattern position of each path present in 'doc', along with the positions of the
+    // fields along the path. Ordering paths by the latter puts them in document order.
+    std::vector<std::pair<std::vector<int>, int>> presentPaths;
+
+    for (size_t i = 0; i < _paths.size(); ++i) {
+        const auto& path = _paths[i];
+        BSONElement value;
+        std::vector<int> positions;
+        const PathValue kind = extractPathValue(doc, FieldRef(path), &value, &positions);
+        if (kind == PathValue::kMissing) {
+            continue;
+        }
+        presentPaths.emplace_back(std::move(positions), static_cast<int>(i));
+
+        BSONObjBuilder cell;
+        cell.append("", path);
+        cell.append("", idRepr);
+        if (kind == PathValue::kPresent) {
+            cell.appendAs(value, "");
+        }
+        keys->insert(cell.obj());
+    }
+
+    BSONObjBuilder rowKey;
+    rowKey.append("", kRowPath);
+    rowKey.append("", idRepr);
+    if (!presentPaths.empty()) {
+        std::sort(presentPaths.begin(), presentPaths.end());
+        BSONArrayBuilder order(rowKey.subarrayStart(""));
+        for (auto&& presentPath : presentPaths) {
+            order.append(presentPath.second);
+        }
+    }
+    keys->insert(rowKey.obj());
+}
+
+}  // namespace mongo
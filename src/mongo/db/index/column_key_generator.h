@@ -0,0 +1,116 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/simple_bsonobj_comparator.h"
+#include "mongo/db/record_id.h"
+
+namespace mongo {
+
+/**
+ * Generates the keys of a columnstore index, which is created with a key pattern such as
+ * { "a": "columnstore", "b.c": "columnstore" }. Rather than one key per document, the index stores
+ * one cell per indexed path and document, so that all the values of a path form a column ordered by
+ * RecordId:
+ *      { '': 'path.to.field', '': NumberLong(<RecordId>), '': <value> }
+ * A document that traverses an array along the path (strictly before its last component) gets a
+ * cell with no value, which tells readers to consult the document itself:
+ *      { '': 'path.to.field', '': NumberLong(<RecordId>) }
+ * Documents in which the path is missing get no cell for it. Every document also gets one row key,
+ * so that a scan of the index visits the documents which contain none of the indexed paths. The
+ * row key lists the positions in the key pattern of the paths present in the document, in the
+ * order the document holds them, so that readers can rebuild the document with its field order:
+ *      { '': '', '': NumberLong(<RecordId>), '': [ <position>, ... ] }
+ * The list is left out if none of the indexed paths is present.
+ */
+class ColumnKeyGenerator {
+public:
+    /**
+     * The path under which the row keys are stored. No indexed path can be empty.
+     */
+    static constexpr StringData kRowPath = ""_sd;
+
+    /**
+     * A decoded index key. 'path' and 'value' point into the key they were parsed from. The value
+     * of a row key is its array of key pattern positions, or EOO if the list was left out.
+     */
+    struct Cell {
+        StringData path;
+        RecordId id;
+        BSONElement value;
+
+        // True if the document has an array along 'path', so the cell holds no value.
+        bool irregular = false;
+    };
+
+    /**
+     * Decodes an index key generated by generateKeys().
+     */
+    static Cell parseKey(const BSONObj& key);
+
+    /**
+     * Returns the key preceding every cell of 'path', to seek a cursor to the start of the column.
+     */
+    static BSONObj columnStartKey(StringData path);
+
+    /**
+     * Returns the key following every cell of 'path', to use as the end position of a cursor.
+     */
+    static BSONObj columnEndKey(StringData path);
+
+    /**
+     * Returns the key preceding the cells of 'path' for the document 'id' and every later document,
+     * to seek a cursor within the column.
+     */
+    static BSONObj cellStartKey(StringData path, RecordId id);
+
+    explicit ColumnKeyGenerator(const BSONObj& keyPattern);
+
+    /**
+     * Returns the indexed paths, in key pattern order.
+     */
+    const std::vector<std::string>& getPaths() const {
+        return _paths;
+    }
+
+    /**
+     * Adds the row key and one cell per indexed path present in 'doc' to 'keys'.
+     */
+    void generateKeys(const BSONObj& doc, RecordId id, BSONObjSet* keys) const;
+
+private:
+    std::vector<std::string> _paths;
+};
+
+}  // namespace mongo
@@ -0,0 +1,226 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kIndex
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/json.h"
+#include "mongo/db/index/column_key_generator.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/log.h"
+
+namespace mongo {
+namespace {
+
+BSONObjSet makeKeySet(std::initializer_list<BSONObj> init = {}) {
+    return SimpleBSONObjComparator::kInstance.makeBSONObjSet(std::move(init));
+}
+
+std::string dumpKeyset(const BSONObjSet& objs) {
+    std::stringstream ss;
+    ss << "[ ";
+    for (BSONObjSet::iterator i = objs.begin(); i != objs.end(); ++i) {
+        ss << i->toString() << " ";
+    }
+    ss << "]";
+
+    return ss.str();
+}
+
+bool assertKeysetsEqual(const BSONObjSet& expectedKeys, const BSONObjSet& actualKeys) {
+    if (expectedKeys.size() != actualKeys.size()) {
+        log() << "Expected: " << dumpKeyset(expectedKeys) << ", "
+              << "Actual: " << dumpKeyset(actualKeys);
+        return false;
+    }
+
+    if (!std::equal(expectedKeys.begin(),
+                    expectedKeys.end(),
+                    actualKeys.begin(),
+                    SimpleBSONObjComparator::kInstance.makeEqualTo())) {
+        log() << "Expected: " << dumpKeyset(expectedKeys) << ", "
+              << "Actual: " << dumpKeyset(actualKeys);
+        return false;
+    }
+
+    return true;
+}
+
+TEST(ColumnKeyGeneratorTest, GeneratesRowKeyForEmptyDocument) {
+    ColumnKeyGenerator keyGen{fromjson("{a: 'columnstore'}")};
+
+    auto expectedKeys = makeKeySet({fromjson("{'': '', '': NumberLong(7)}")});
+
+    auto outputKeys = makeKeySet();
+    keyGen.generateKeys(BSONObj(), RecordId(7), &outputKeys);
+
+    ASSERT(assertKeysetsEqual(expectedKeys, outputKeys));
+}
+
+TEST(ColumnKeyGeneratorTest, GeneratesOneCellPerPresentPath) {
+    ColumnKeyGenerator keyGen{fromjson("{a: 'columnstore', b: 'columnstore', c: 'columnstore'}")};
+
+    auto expectedKeys = makeKeySet({fromjson("{'': '', '': NumberLong(3), '': [0, 1]}"),
+                                    fromjson("{'': 'a', '': NumberLong(3), '': 1}"),
+                                    fromjson("{'': 'b', '': NumberLong(3), '': 'str'}")});
+
+    auto outputKeys = makeKeySet();
+    keyGen.generateKeys(fromjson("{a: 1, b: 'str', d: 2}"), RecordId(3), &outputKeys);
+
+    ASSERT(assertKeysetsEqual(expectedKeys, outputKeys));
+}
+
+TEST(ColumnKeyGeneratorTest, GeneratesCellsForNestedPaths) {
+    ColumnKeyGenerator keyGen{fromjson("{'a.b': 'columnstore', 'a.c.d': 'columnstore'}")};
+
+    auto expectedKeys = makeKeySet({fromjson("{'': '', '': NumberLong(1), '': [0, 1]}"),
+                                    fromjson("{'': 'a.b', '': NumberLong(1), '': {e: 1}}"),
+                                    fromjson("{'': 'a.c.d', '': NumberLong(1), '': null}")});
+
+    auto outputKeys = makeKeySet();
+    keyGen.generateKeys(fromjson("{a: {b: {e: 1}, c: {d: null}}}"), RecordId(1), &outputKeys);
+
+    ASSERT(assertKeysetsEqual(expectedKeys, outputKeys));
+}
+
+TEST(ColumnKeyGeneratorTest, RowKeyListsPathsInDocumentOrder) {
+    ColumnKeyGenerator keyGen{fromjson(
+        "{a: 'columnstore', 'b.c': 'columnstore', 'b.d': 'columnstore', e: 'columnstore'}")};
+
+    auto expectedKeys = makeKeySet({fromjson("{'': '', '': NumberLong(1), '': [3, 2, 1, 0]}"),
+                                    fromjson("{'': 'a', '': NumberLong(1), '': 1}"),
+                                    fromjson("{'': 'b.c', '': NumberLong(1), '': 2}"),
+                                    fromjson("{'': 'b.d', '': NumberLong(1), '': 3}"),
+                                    fromjson("{'': 'e', '': NumberLong(1), '': 4}")});
+
+    auto outputKeys = makeKeySet();
+    keyGen.generateKeys(
+        fromjson("{e: 4, x: 0, b: {d: 3, y: 0, c: 2}, a: 1}"), RecordId(1), &outputKeys);
+
+    ASSERT(assertKeysetsEqual(expectedKeys, outputKeys));
+}
+
+TEST(ColumnKeyGeneratorTest, TreatsScalarAlongPathAsMissing) {
+    ColumnKeyGenerator keyGen{fromjson("{'a.b': 'columnstore'}")};
+
+    auto expectedKeys = makeKeySet({fromjson("{'': '', '': NumberLong(1)}")});
+
+    auto outputKeys = makeKeySet();
+    keyGen.generateKeys(fromjson("{a: 5}"), RecordId(1), &outputKeys);
+
+    ASSERT(assertKeysetsEqual(expectedKeys, outputKeys));
+}
+
+TEST(ColumnKeyGeneratorTest, StoresArrayAtEndOfPathAsValue) {
+    ColumnKeyGenerator keyGen{fromjson("{'a.b': 'columnstore'}")};
+
+    auto expectedKeys = makeKeySet({fromjson("{'': '', '': NumberLong(2), '': [0]}"),
+                                    fromjson("{'': 'a.b', '': NumberLong(2), '': [1, [2]]}")});
+
+    auto outputKeys = makeKeySet();
+    keyGen.generateKeys(fromjson("{a: {b: [1, [2]]}}"), RecordId(2), &outputKeys);
+
+    ASSERT(assertKeysetsEqual(expectedKeys, outputKeys));
+}
+
+TEST(ColumnKeyGeneratorTest, GeneratesIrregularCellForArrayAlongPath) {
+    ColumnKeyGenerator keyGen{fromjson("{'a.b': 'columnstore'}")};
+
+    auto expectedKeys = makeKeySet({fromjson("{'': '', '': NumberLong(2), '': [0]}"),
+                                    fromjson("{'': 'a.b', '': NumberLong(2)}")});
+
+    auto outputKeys = makeKeySet();
+    keyGen.generateKeys(fromjson("{a: [{b: 1}, {b: 2}]}"), RecordId(2), &outputKeys);
+
+    ASSERT(assertKeysetsEqual(expectedKeys, outputKeys));
+}
+
+TEST(ColumnKeyGeneratorTest, ParseKeyRoundTripsGeneratedKeys) {
+    ColumnKeyGenerator keyGen{fromjson("{a: 'columnstore', 'b.c': 'columnstore'}")};
+
+    auto outputKeys = makeKeySet();
+    keyGen.generateKeys(fromjson("{a: 'x', b: [{c: 1}]}"), RecordId(9), &outputKeys);
+    ASSERT_EQ(3U, outputKeys.size());
+
+    for (auto&& key : outputKeys) {
+        auto cell = ColumnKeyGenerator::parseKey(key);
+        ASSERT_EQ(RecordId(9), cell.id);
+        if (cell.path == ColumnKeyGenerator::kRowPath) {
+            ASSERT_FALSE(cell.irregular);
+            const auto expectedOrder = fromjson("{'': [0, 1]}");
+            ASSERT_BSONELT_EQ(expectedOrder.firstElement(), cell.value);
+        } else if (cell.path == "a") {
+            ASSERT_FALSE(cell.irregular);
+            ASSERT_EQ("x", cell.value.valueStringData());
+        } else {
+            ASSERT_EQ("b.c", cell.path);
+            ASSERT_TRUE(cell.irregular);
+            ASSERT(cell.value.eoo());
+        }
+    }
+}
+
+TEST(ColumnKeyGeneratorTest, ColumnBoundsEncloseEveryCellOfPath) {
+    ColumnKeyGenerator keyGen{fromjson("{a: 'columnstore'}")};
+
+    auto outputKeys = makeKeySet();
+    keyGen.generateKeys(fromjson("{a: [1]}"), RecordId(4), &outputKeys);
+    keyGen.generateKeys(fromjson("{a: {b: 1}}"), RecordId(5), &outputKeys);
+
+    const auto start = ColumnKeyGenerator::columnStartKey("a");
+    const auto end = ColumnKeyGenerator::columnEndKey("a");
+    for (auto&& key : outputKeys) {
+        const bool inColumn = ColumnKeyGenerator::parseKey(key).path == "a";
+        ASSERT_EQ(inColumn, SimpleBSONObjComparator::kInstance.evaluate(start < key));
+        ASSERT_EQ(inColumn, SimpleBSONObjComparator::kInstance.evaluate(key < end));
+    }
+}
+
+TEST(ColumnKeyGeneratorTest, CellStartKeyPrecedesCellsOfLaterDocuments) {
+    ColumnKeyGenerator keyGen{fromjson("{a: 'columnstore'}")};
+
+    auto outputKeys = makeKeySet();
+    keyGen.generateKeys(fromjson("{a: 1}"), RecordId(4), &outputKeys);
+    keyGen.generateKeys(fromjson("{a: [1]}"), RecordId(5), &outputKeys);
+    keyGen.generateKeys(fromjson("{a: 1}"), RecordId(6), &outputKeys);
+
+    const auto start = ColumnKeyGenerator::cellStartKey("a", RecordId(5));
+    for (auto&& key : outputKeys) {
+        const auto cell = ColumnKeyGenerator::parseKey(key);
+        if (cell.path != "a") {
+            continue;
+        }
+        ASSERT_EQ(cell.id >= RecordId(5),
+                  SimpleBSONObjComparator::kInstance.evaluate(start <= key));
+    }
+}
+
+}  // namespace
+}  // namespace mongo
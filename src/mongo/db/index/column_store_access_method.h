@@ -0,0 +1,74 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/db/index/column_key_generator.h"
+#include "mongo/db/index/index_access_method.h"
+#include "mongo/db/jsobj.h"
+
+namespace mongo {
+
+/**
+ * This is the access method for "columnstore" indexes, which store each indexed path as a column
+ * of values ordered by RecordId. See ColumnKeyGenerator for the format of the keys.
+ */
+class ColumnStoreAccessMethod final : public AbstractIndexAccessMethod {
+public:
+    ColumnStoreAccessMethod(IndexCatalogEntry* columnState, SortedDataInterface* btree);
+
+    /**
+     * A columnstore index stores a separate cell for every path and document, so it never needs
+     * to be marked multikey.
+     */
+    bool shouldMarkIndexAsMultikey(const BSONObjSet& keys,
+                                   const BSONObjSet& multikeyMetadataKeys,
+                                   const MultikeyPaths& multikeyPaths) const final {
+        return false;
+    }
+
+    const ColumnKeyGenerator& getKeyGenerator() const {
+        return _keyGen;
+    }
+
+private:
+    /**
+     * Fills 'keys' with the cells of 'obj'. The keys embed 'id', so no keys are generated when it
+     * is not known.
+     */
+    void doGetKeys(const BSONObj& obj,
+                   BSONObjSet* keys,
+                   BSONObjSet* multikeyMetadataKeys,
+                   MultikeyPaths* multikeyPaths,
+                   boost::optional<RecordId> id) const final;
+
+    const ColumnKeyGenerator _keyGen;
+};
+
+}  // namespace mongo
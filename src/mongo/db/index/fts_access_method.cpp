@@ -40,7 +40,8 @@ FTSAccessMethod::FTSAccessMethod(IndexCatalogEntry* btreeState, SortedDataInterf
 void FTSAccessMethod::doGetKeys(const BSONObj& obj,
                                 BSONObjSet* keys,
                                 BSONObjSet* multikeyMetadataKeys,
-                                MultikeyPaths* multikeyPaths) const {
+                                MultikeyPaths* multikeyPaths,
+                                boost::optional<RecordId> id) const {
     ExpressionKeysPrivate::getFTSKeys(obj, _ftsSpec, keys);
 }
 
@@ -57,7 +57,8 @@ HashAccessMethod::HashAccessMethod(IndexCatalogEntry* btreeState, SortedDataInte
 void HashAccessMethod::doGetKeys(const BSONObj& obj,
                                  BSONObjSet* keys,
                                  BSONObjSet* multikeyMetadataKeys,
-                                 MultikeyPaths* multikeyPaths) const {
+                                 MultikeyPaths* multikeyPaths,
+                                 boost::optional<RecordId> id) const {
     ExpressionKeysPrivate::getHashKeys(
         obj, _hashedField, _seed, _hashVersion, _descriptor->isSparse(), _collator, keys);
 }
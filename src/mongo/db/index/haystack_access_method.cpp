@@ -67,7 +67,8 @@ HaystackAccessMethod::HaystackAccessMethod(IndexCatalogEntry* btreeState,
 void HaystackAccessMethod::doGetKeys(const BSONObj& obj,
                                      BSONObjSet* keys,
                                      BSONObjSet* multikeyMetadataKeys,
-                                     MultikeyPaths* multikeyPaths) const {
+                                     MultikeyPaths* multikeyPaths,
+                                     boost::optional<RecordId> id) const {
     ExpressionKeysPrivate::getHaystackKeys(obj, _geoField, _otherFields, _bucketSize, keys);
 }
 
@@ -33,6 +33,7 @@
 
 #include "mongo/db/index/btree_access_method.h"
 
+#include <algorithm>
 #include <utility>
 #include <vector>
 
@@ -186,7 +187,7 @@ Status AbstractIndexAccessMethod::insert(OperationContext* opCtx,
     MultikeyPaths multikeyPaths;
 
     // Delegate to the subclass.
-    getKeys(obj, options.getKeysMode, &keys, &multikeyMetadataKeys, &multikeyPaths);
+    getKeys(obj, options.getKeysMode, &keys, &multikeyMetadataKeys, &multikeyPaths, loc);
 
     return insertKeys(opCtx, keys, multikeyMetadataKeys, multikeyPaths, loc, options, result);
 }
@@ -206,32 +207,7 @@ Status AbstractIndexAccessMethod::insertKeys(OperationContext* opCtx,
     for (const auto keySet : {&keys, &multikeyMetadataKeys}) {
         const auto& recordId = (keySet == &keys ? loc : kMultikeyMetadataKeyId);
         for (const auto& key : *keySet) {
-            Status status = checkIndexKeySize ? checkKeySize(key) : Status::OK();
-            if (status.isOK()) {
-                bool unique = _descriptor->unique();
-                StatusWith<SpecialFormatInserted> ret =
-                    _newInterface->insert(opCtx, key, recordId, !unique /* dupsAllowed */);
-                status = ret.getStatus();
-
-                // When duplicates are encountered and allowed, retry with dupsAllowed. Add the
-                // key to the output vector so callers know which duplicate keys were inserted.
-                if (ErrorCodes::DuplicateKey == status.code() && options.dupsAllowed) {
-                    invariant(unique);
-                    ret = _newInterface->insert(opCtx, key, recordId, true /* dupsAllowed */);
-                    status = ret.getStatus();
-
-                    // This is speculative in that the 'dupsInserted' vector is not used by any code
-                    // today. It is currently in place to test detecting duplicate key errors during
-                    // hybrid index builds. Duplicate detection in the future will likely not take
-                    // place in this insert() method.
-                    if (status.isOK() && result) {
-                        result->dupsInserted.push_back(key);
-                    }
-                }
-
-                if (status.isOK() && ret.getValue() == SpecialFormatInserted::LongTypeBitsInserted)
-                    _btreeState->setIndexKeyStringWithLongTypeBitsExistsOnDisk(opCtx);
-            }
+            Status status = insertOneKey(opCtx, key, recordId, options, checkIndexKeySize, result);
             if (isFatalError(opCtx, status, key)) {
                 return status;
             }
@@ -248,6 +224,155 @@ Status AbstractIndexAccessMethod::insertKeys(OperationContext* opCtx,
     return Status::OK();
 }
 
+Status AbstractIndexAccessMethod::insertBatch(OperationContext* opCtx,
+                                              const std::vector<BsonRecord>& bsonRecords,
+                                              const InsertDeleteOptions& options,
+                                              InsertResult* result) {
+    BatchedKeys batchedKeys;
+    getBatchKeys(bsonRecords, options.getKeysMode, &batchedKeys);
+    return insertBatchKeys(opCtx, batchedKeys, options, result);
+}
+
+void AbstractIndexAccessMethod::getBatchKeys(const std::vector<BsonRecord>& bsonRecords,
+                                             GetKeysMode mode,
+                                             BatchedKeys* batchedKeys) const {
+    // The paths which make the index multikey are merged across the documents, so that the catalog
+    // is updated at most once.
+    for (const auto& bsonRecord : bsonRecords) {
+        BSONObjSet docKeys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+        BSONObjSet multikeyMetadataKeys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+        MultikeyPaths multikeyPaths;
+        getKeys(*bsonRecord.docPtr,
+                mode,
+                &docKeys,
+                &multikeyMetadataKeys,
+                &multikeyPaths,
+                bsonRecord.id);
+
+        if (shouldMarkIndexAsMultikey(docKeys, multikeyMetadataKeys, multikeyPaths)) {
+            auto& mergedPaths = batchedKeys->multikeyPaths;
+            batchedKeys->isMultikey = true;
+            mergedPaths.resize(std::max(mergedPaths.size(), multikeyPaths.size()));
+            for (size_t i = 0; i < multikeyPaths.size(); ++i) {
+                mergedPaths[i].insert(multikeyPaths[i].begin(), multikeyPaths[i].end());
+            }
+        }
+
+        for (auto&& key : docKeys) {
+            batchedKeys->keys.push_back({key, bsonRecord.id, bsonRecord.ts});
+        }
+        for (auto&& key : multikeyMetadataKeys) {
+            batchedKeys->keys.push_back({key, kMultikeyMetadataKeyId, bsonRecord.ts});
+        }
+    }
+
+    // Sort the keys as the index stores them, so that each insert lands next to the previous one.
+    const Ordering ordering = Ordering::make(_descriptor->keyPattern());
+    std::sort(batchedKeys->keys.begin(),
+              batchedKeys->keys.end(),
+              [&](const BatchedKeys::Key& lhs, const BatchedKeys::Key& rhs) {
+                  const int cmp = lhs.key.woCompare(rhs.key, ordering, false);
+                  return cmp != 0 ? cmp < 0 : lhs.loc < rhs.loc;
+              });
+}
+
+Status AbstractIndexAccessMethod::insertBatchKeys(OperationContext* opCtx,
+                                                  const BatchedKeys& batchedKeys,
+                                                  const InsertDeleteOptions& options,
+                                                  InsertResult* result) {
+    invariant(options.fromIndexBuilder || !_btreeState->isHybridBuilding());
+
+    // The keys of a replicated batch are in index order rather than timestamp order. WiredTiger
+    // lets the writes of a transaction use any commit timestamp from the first one it was given,
+    // so the earliest is set first, then each key is written at the timestamp of its document.
+    Timestamp minTs;
+    Timestamp maxTs;
+    for (const auto& batchedKey : batchedKeys.keys) {
+        if (!batchedKey.ts.isNull()) {
+            minTs = minTs.isNull() ? batchedKey.ts : std::min(minTs, batchedKey.ts);
+            maxTs = std::max(maxTs, batchedKey.ts);
+        }
+    }
+    Timestamp currentTs = minTs;
+    if (!minTs.isNull()) {
+        Status status = opCtx->recoveryUnit()->setTimestamp(minTs);
+        if (!status.isOK()) {
+            return status;
+        }
+    }
+
+    // Readers at the earliest timestamp already see some of the keys, so the index becomes
+    // multikey as of then.
+    if (batchedKeys.isMultikey) {
+        _btreeState->setMultikey(opCtx, batchedKeys.multikeyPaths);
+    }
+
+    const bool checkIndexKeySize = shouldCheckIndexKeySize(opCtx);
+    for (const auto& batchedKey : batchedKeys.keys) {
+        if (!batchedKey.ts.isNull() && batchedKey.ts != currentTs) {
+            Status status = opCtx->recoveryUnit()->setTimestamp(batchedKey.ts);
+            if (!status.isOK()) {
+                return status;
+            }
+            currentTs = batchedKey.ts;
+        }
+
+        Status status =
+            insertOneKey(opCtx, batchedKey.key, batchedKey.loc, options, checkIndexKeySize, result);
+        if (isFatalError(opCtx, status, batchedKey.key)) {
+            return status;
+        }
+    }
+
+    if (currentTs != maxTs) {
+        Status status = opCtx->recoveryUnit()->setTimestamp(maxTs);
+        if (!status.isOK()) {
+            return status;
+        }
+    }
+
+    if (result) {
+        result->numInserted += batchedKeys.keys.size();
+    }
+    return Status::OK();
+}
+
+Status AbstractIndexAccessMethod::insertOneKey(OperationContext* opCtx,
+                                               const BSONObj& key,
+                                               const RecordId& loc,
+                                               const InsertDeleteOptions& options,
+                                               bool checkIndexKeySize,
+                                               InsertResult* result) {
+    Status status = checkIndexKeySize ? checkKeySize(key) : Status::OK();
+    if (!status.isOK()) {
+        return status;
+    }
+
+    bool unique = _descriptor->unique();
+    StatusWith<SpecialFormatInserted> ret =
+        _newInterface->insert(opCtx, key, loc, !unique /* dupsAllowed */);
+    status = ret.getStatus();
+
+    // When duplicates are encountered and allowed, retry with dupsAllowed. Add the key to the
+    // output vector so callers know which duplicate keys were inserted.
+    if (ErrorCodes::DuplicateKey == status.code() && options.dupsAllowed) {
+        invariant(unique);
+        ret = _newInterface->insert(opCtx, key, loc, true /* dupsAllowed */);
+        status = ret.getStatus();
+
+        // This is speculative in that the 'dupsInserted' vector is not used by any code today. It
+        // is currently in place to test detecting duplicate key errors during hybrid index builds.
+        // Duplicate detection in the future will likely not take place in this insert() method.
+        if (status.isOK() && result) {
+            result->dupsInserted.push_back(key);
+        }
+    }
+
+    if (status.isOK() && ret.getValue() == SpecialFormatInserted::LongTypeBitsInserted)
+        _btreeState->setIndexKeyStringWithLongTypeBitsExistsOnDisk(opCtx);
+    return status;
+}
+
 void AbstractIndexAccessMethod::removeOneKey(OperationContext* opCtx,
                                              const BSONObj& key,
                                              const RecordId& loc,
@@ -292,8 +417,12 @@ Status AbstractIndexAccessMethod::remove(OperationContext* opCtx,
 
     // Relax key constraints on removal when deleting documents with invalid formats, but only
     // those that don't apply to the partialIndex filter.
-    getKeys(
-        obj, GetKeysMode::kRelaxConstraintsUnfiltered, &keys, multikeyMetadataKeys, multikeyPaths);
+    getKeys(obj,
+            GetKeysMode::kRelaxConstraintsUnfiltered,
+            &keys,
+            multikeyMetadataKeys,
+            multikeyPaths,
+            loc);
 
     return removeKeys(opCtx, keys, loc, options, numDeleted);
 }
@@ -322,7 +451,12 @@ Status AbstractIndexAccessMethod::touch(OperationContext* opCtx, const BSONObj&
     // multikey when paging a document's index entries into memory.
     BSONObjSet* multikeyMetadataKeys = nullptr;
     MultikeyPaths* multikeyPaths = nullptr;
-    getKeys(obj, GetKeysMode::kEnforceConstraints, &keys, multikeyMetadataKeys, multikeyPaths);
+    getKeys(obj,
+            GetKeysMode::kEnforceConstraints,
+            &keys,
+            multikeyMetadataKeys,
+            multikeyPaths,
+            boost::none);
 
     std::unique_ptr<SortedDataInterface::Cursor> cursor(_newInterface->newCursor(opCtx));
     for (const auto& key : keys) {
@@ -350,7 +484,8 @@ RecordId AbstractIndexAccessMethod::findSingle(OperationContext* opCtx,
                 GetKeysMode::kEnforceConstraints,
                 &keys,
                 multikeyMetadataKeys,
-                multikeyPaths);
+                multikeyPaths,
+                boost::none);
         invariant(keys.size() == 1);
         actualKey = *keys.begin();
     } else {
@@ -439,7 +574,12 @@ Status AbstractIndexAccessMethod::validateUpdate(OperationContext* opCtx,
         // metadata isn't updated when keys are deleted.
         BSONObjSet* multikeyMetadataKeys = nullptr;
         MultikeyPaths* multikeyPaths = nullptr;
-        getKeys(from, options.getKeysMode, &ticket->oldKeys, multikeyMetadataKeys, multikeyPaths);
+        getKeys(from,
+                options.getKeysMode,
+                &ticket->oldKeys,
+                multikeyMetadataKeys,
+                multikeyPaths,
+                record);
     }
 
     if (!indexFilter || indexFilter->matchesBSON(to)) {
@@ -447,7 +587,8 @@ Status AbstractIndexAccessMethod::validateUpdate(OperationContext* opCtx,
                 options.getKeysMode,
                 &ticket->newKeys,
                 &ticket->newMultikeyMetadataKeys,
-                &ticket->newMultikeyPaths);
+                &ticket->newMultikeyPaths,
+                record);
     }
 
     ticket->loc = record;
@@ -583,7 +724,8 @@ Status AbstractIndexAccessMethod::BulkBuilderImpl::insert(OperationContext* opCt
     BSONObjSet keys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
     MultikeyPaths multikeyPaths;
 
-    _real->getKeys(obj, options.getKeysMode, &keys, &_multikeyMetadataKeys, &multikeyPaths);
+    _real->getKeys(
+        obj, options.getKeysMode, &keys, &_multikeyMetadataKeys, &multikeyPaths, loc);
 
     if (!multikeyPaths.empty()) {
         if (_indexMultikeyPaths.empty()) {
@@ -737,7 +879,8 @@ void AbstractIndexAccessMethod::getKeys(const BSONObj& obj,
                                         GetKeysMode mode,
                                         BSONObjSet* keys,
                                         BSONObjSet* multikeyMetadataKeys,
-                                        MultikeyPaths* multikeyPaths) const {
+                                        MultikeyPaths* multikeyPaths,
+                                        boost::optional<RecordId> id) const {
     // TODO SERVER-36385: Remove ErrorCodes::KeyTooLong.
     static stdx::unordered_set<int> whiteList{ErrorCodes::CannotBuildIndexKeys,
                                               // Btree
@@ -764,7 +907,7 @@ void AbstractIndexAccessMethod::getKeys(const BSONObj& obj,
                                               13026,
                                               13027};
     try {
-        doGetKeys(obj, keys, multikeyMetadataKeys, multikeyPaths);
+        doGetKeys(obj, keys, multikeyMetadataKeys, multikeyPaths, id);
     } catch (const AssertionException& ex) {
         // Suppress all indexing errors when mode is kRelaxConstraints.
         if (mode == GetKeysMode::kEnforceConstraints) {
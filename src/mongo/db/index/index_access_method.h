@@ -30,6 +30,7 @@
 #pragma once
 
 #include <atomic>
+#include <boost/optional.hpp>
 #include <memory>
 #include <set>
 
@@ -48,6 +49,8 @@ namespace mongo {
 class BSONObjBuilder;
 class MatchExpression;
 class UpdateTicket;
+struct BatchedKeys;
+struct BsonRecord;
 struct InsertResult;
 struct InsertDeleteOptions;
 
@@ -100,6 +103,18 @@ public:
                               const InsertDeleteOptions& options,
                               InsertResult* result) = 0;
 
+    /**
+     * Inserts the keys of every document in 'bsonRecords', as insert() would for each of them in
+     * turn. The keys of the whole batch are generated first and inserted in index order, so that
+     * consecutive inserts go to neighbouring positions in the index rather than random ones.
+     * If 'result' is not null, 'numInserted' will be incremented by the number of keys added to
+     * the index for all the documents.
+     */
+    virtual Status insertBatch(OperationContext* opCtx,
+                               const std::vector<BsonRecord>& bsonRecords,
+                               const InsertDeleteOptions& options,
+                               InsertResult* result) = 0;
+
     /**
      * Analogous to above, but remove the records instead of inserting them.
      * 'numDeleted' will be set to the number of keys removed from the index for the document.
@@ -318,12 +333,35 @@ public:
      * BSONObjSet with any multikey metadata keys generated while processing the document. These
      * keys are not associated with the document itself, but instead represent multi-key path
      * information that must be stored in a reserved keyspace within the index.
+     *
+     * 'id' is the RecordId of 'obj' when it is known. Index types whose keys embed the RecordId,
+     * such as columnstore indexes, generate no keys when it is boost::none.
      */
     virtual void getKeys(const BSONObj& obj,
                          GetKeysMode mode,
                          BSONObjSet* keys,
                          BSONObjSet* multikeyMetadataKeys,
-                         MultikeyPaths* multikeyPaths) const = 0;
+                         MultikeyPaths* multikeyPaths,
+                         boost::optional<RecordId> id) const = 0;
+
+    /**
+     * Generates the keys that insertBatch() would insert for 'bsonRecords' into 'batchedKeys',
+     * sorted in index order. Touches neither the index nor the catalog, so it may be called on a
+     * thread other than the operation's.
+     */
+    virtual void getBatchKeys(const std::vector<BsonRecord>& bsonRecords,
+                              GetKeysMode mode,
+                              BatchedKeys* batchedKeys) const = 0;
+
+    /**
+     * Inserts keys generated by getBatchKeys(), and marks the index multikey if they require it.
+     * Each key is written at the timestamp of its document. The timestamp of later writes in the
+     * unit of work is left at the latest of them.
+     */
+    virtual Status insertBatchKeys(OperationContext* opCtx,
+                                   const BatchedKeys& batchedKeys,
+                                   const InsertDeleteOptions& options,
+                                   InsertResult* result) = 0;
 
     /**
      * Given the set of keys, multikeyMetadataKeys and multikeyPaths generated by a particular
@@ -372,6 +410,24 @@ public:
     std::vector<BSONObj> dupsInserted;
 };
 
+/**
+ * The keys of a batch of documents, in index order. Each key is paired with the RecordId it points
+ * to and the timestamp of the write of its document, which is null for unreplicated writes.
+ */
+struct BatchedKeys {
+    struct Key {
+        BSONObj key;
+        RecordId loc;
+        Timestamp ts;
+    };
+    std::vector<Key> keys;
+
+    // True if inserting 'keys' makes the index multikey. Holds the union of the paths which cause
+    // it for all the documents, if the index tracks path-level multikey information.
+    bool isMultikey = false;
+    MultikeyPaths multikeyPaths;
+};
+
 /**
  * Updates are two steps: verify that it's a valid update, and perform it.
  * validateUpdate fills out the UpdateStatus and update actually applies it.
@@ -464,6 +520,20 @@ public:
                       const InsertDeleteOptions& options,
                       InsertResult* result) final;
 
+    Status insertBatch(OperationContext* opCtx,
+                       const std::vector<BsonRecord>& bsonRecords,
+                       const InsertDeleteOptions& options,
+                       InsertResult* result) final;
+
+    void getBatchKeys(const std::vector<BsonRecord>& bsonRecords,
+                      GetKeysMode mode,
+                      BatchedKeys* batchedKeys) const final;
+
+    Status insertBatchKeys(OperationContext* opCtx,
+                           const BatchedKeys& batchedKeys,
+                           const InsertDeleteOptions& options,
+                           InsertResult* result) final;
+
     Status remove(OperationContext* opCtx,
                   const BSONObj& obj,
                   const RecordId& loc,
@@ -527,7 +597,8 @@ public:
                  GetKeysMode mode,
                  BSONObjSet* keys,
                  BSONObjSet* multikeyMetadataKeys,
-                 MultikeyPaths* multikeyPaths) const final;
+                 MultikeyPaths* multikeyPaths,
+                 boost::optional<RecordId> id) const final;
 
     bool shouldMarkIndexAsMultikey(const BSONObjSet& keys,
                                    const BSONObjSet& multikeyMetadataKeys,
@@ -549,11 +620,14 @@ protected:
      * BSONObjSet with any multikey metadata keys generated while processing the document. These
      * keys are not associated with the document itself, but instead represent multi-key path
      * information that must be stored in a reserved keyspace within the index.
+     *
+     * 'id' is the RecordId of 'obj', or boost::none if it is not known.
      */
     virtual void doGetKeys(const BSONObj& obj,
                            BSONObjSet* keys,
                            BSONObjSet* multikeyMetadataKeys,
-                           MultikeyPaths* multikeyPaths) const = 0;
+                           MultikeyPaths* multikeyPaths,
+                           boost::optional<RecordId> id) const = 0;
 
     IndexCatalogEntry* const _btreeState;  // owned by IndexCatalogEntry
     const IndexDescriptor* const _descriptor;
@@ -581,6 +655,19 @@ private:
      */
     bool shouldCheckIndexKeySize(OperationContext* opCtx);
 
+    /**
+     * Inserts a single key into the index. Returns the status of the insert, which the caller
+     * checks with isFatalError().
+     *
+     * Used by insertKeys() and insertBatchKeys() only.
+     */
+    Status insertOneKey(OperationContext* opCtx,
+                        const BSONObj& key,
+                        const RecordId& loc,
+                        const InsertDeleteOptions& options,
+                        bool checkIndexKeySize,
+                        InsertResult* result);
+
     /**
      * Removes a single key from the index.
      *
@@ -382,7 +382,8 @@ Status IndexBuildInterceptor::sideWrite(OperationContext* opCtx,
     const auto getKeysMode = op == Op::kInsert
         ? options.getKeysMode
         : IndexAccessMethod::GetKeysMode::kRelaxConstraintsUnfiltered;
-    indexAccessMethod->getKeys(*obj, getKeysMode, &keys, &multikeyMetadataKeys, &multikeyPaths);
+    indexAccessMethod->getKeys(
+        *obj, getKeysMode, &keys, &multikeyMetadataKeys, &multikeyPaths, loc);
 
     // Maintain parity with IndexAccessMethods handling of key counting. Only include
     // `multikeyMetadataKeys` when inserting.
@@ -52,7 +52,8 @@ bool WildcardAccessMethod::shouldMarkIndexAsMultikey(const BSONObjSet& keys,
 void WildcardAccessMethod::doGetKeys(const BSONObj& obj,
                                      BSONObjSet* keys,
                                      BSONObjSet* multikeyMetadataKeys,
-                                     MultikeyPaths* multikeyPaths) const {
+                                     MultikeyPaths* multikeyPaths,
+                                     boost::optional<RecordId> id) const {
     _keyGen.generateKeys(obj, keys, multikeyMetadataKeys);
 }
 
@@ -95,7 +95,8 @@ private:
     void doGetKeys(const BSONObj& obj,
                    BSONObjSet* keys,
                    BSONObjSet* multikeyMetadataKeys,
-                   MultikeyPaths* multikeyPaths) const final;
+                   MultikeyPaths* multikeyPaths,
+                   boost::optional<RecordId> id) const final;
 
     std::set<FieldRef> _getMultikeyPathSet(OperationContext* opCtx,
                                            const IndexBounds& indexBounds,
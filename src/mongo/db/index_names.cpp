@@ -42,6 +42,7 @@ const string IndexNames::TEXT = "text";
 const string IndexNames::HASHED = "hashed";
 const string IndexNames::BTREE = "";
 const string IndexNames::WILDCARD = "wildcard";
+const string IndexNames::COLUMN = "columnstore";
 
 const StringMap<IndexType> kIndexNameToType = {
     {IndexNames::GEO_2D, INDEX_2D},
@@ -50,6 +51,7 @@ const StringMap<IndexType> kIndexNameToType = {
     {IndexNames::TEXT, INDEX_TEXT},
     {IndexNames::HASHED, INDEX_HASHED},
     {IndexNames::WILDCARD, INDEX_WILDCARD},
+    {IndexNames::COLUMN, INDEX_COLUMN},
 };
 
 // static
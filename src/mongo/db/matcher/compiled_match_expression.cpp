@@ -0,0 +1,332 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/matcher/compiled_match_expression.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "mongo/base/compare_numbers.h"
+#include "mongo/db/matcher/expression_leaf.h"
+#include "mongo/db/matcher/matchable.h"
+
+namespace mongo {
+
+namespace {
+
+// Relative costs used to order predicates with the same selectivity.
+const double kSpecializedCost = 1;
+const double kSingleElementCost = 2;
+const double kRegexCost = 8;
+const double kDocumentCost = 16;
+
+template <MatchExpression::MatchType type>
+bool comparisonResult(int cmp) {
+    switch (type) {
+        case MatchExpression::LT:
+            return cmp < 0;
+        case MatchExpression::LTE:
+            return cmp <= 0;
+        case MatchExpression::EQ:
+            return cmp == 0;
+        case MatchExpression::GT:
+            return cmp > 0;
+        case MatchExpression::GTE:
+            return cmp >= 0;
+        default:
+            MONGO_UNREACHABLE;
+    }
+}
+
+/**
+ * Returns true if the leaf is a LeafMatchExpression which traverses arrays, so that evaluating
+ * matchesSingleElement() on the element of a path without arrays is equivalent to matches().
+ */
+bool isSingleElementLeaf(const MatchExpression* expr) {
+    switch (expr->matchType()) {
+        case MatchExpression::EQ:
+        case MatchExpression::LT:
+        case MatchExpression::LTE:
+        case MatchExpression::GT:
+        case MatchExpression::GTE:
+        case MatchExpression::MATCH_IN:
+        case MatchExpression::REGEX:
+        case MatchExpression::MOD:
+        case MatchExpression::EXISTS:
+        case MatchExpression::BITS_ALL_SET:
+        case MatchExpression::BITS_ALL_CLEAR:
+        case MatchExpression::BITS_ANY_SET:
+        case MatchExpression::BITS_ANY_CLEAR:
+            return !expr->path().empty();
+        default:
+            return false;
+    }
+}
+
+}  // namespace
+
+template <MatchExpression::MatchType type>
+bool CompiledMatchExpression::_evaluateLong(const Predicate& predicate,
+                                            const BSONElement& element) {
+    if (element.type() == NumberInt) {
+        return comparisonResult<type>(compareLongs(element._numberInt(), predicate.rhsLong));
+    }
+
+    if (element.type() == NumberLong) {
+        return comparisonResult<type>(compareLongs(element._numberLong(), predicate.rhsLong));
+    }
+
+    return _evaluateSingleElement(predicate, element);
+}
+
+template <MatchExpression::MatchType type>
+bool CompiledMatchExpression::_evaluateDouble(const Predicate& predicate,
+                                              const BSONElement& element) {
+    if (element.type() == NumberDouble && !std::isnan(element._numberDouble())) {
+        return comparisonResult<type>(
+            compareDoubles(element._numberDouble(), predicate.rhsDouble));
+    }
+
+    return _evaluateSingleElement(predicate, element);
+}
+
+template <MatchExpression::MatchType type>
+bool CompiledMatchExpression::_evaluateString(const Predicate& predicate,
+                                              const BSONElement& element) {
+    if (element.type() == String) {
+        return comparisonResult<type>(element.valueStringData().compare(predicate.rhsString));
+    }
+
+    return _evaluateSingleElement(predicate, element);
+}
+
+bool CompiledMatchExpression::_evaluateSingleElement(const Predicate& predicate,
+                                                     const BSONElement& element) {
+    return predicate.expr->matchesSingleElement(element);
+}
+
+template <MatchExpression::MatchType type>
+CompiledMatchExpression::EvaluateFn CompiledMatchExpression::_comparisonFn(ComparisonKind kind) {
+    switch (kind) {
+        case ComparisonKind::kLong:
+            return &_evaluateLong<type>;
+        case ComparisonKind::kDouble:
+            return &_evaluateDouble<type>;
+        case ComparisonKind::kString:
+            return &_evaluateString<type>;
+    }
+    MONGO_UNREACHABLE;
+}
+
+CompiledMatchExpression::CompiledMatchExpression(const MatchExpression* expr) : _expr(expr) {
+    invariant(_expr);
+    _addPredicate(_expr);
+}
+
+void CompiledMatchExpression::_addPredicate(const MatchExpression* expr) {
+    if (expr->matchType() == MatchExpression::AND) {
+        for (size_t i = 0; i < expr->numChildren(); ++i) {
+            _addPredicate(expr->getChild(i));
+        }
+        return;
+    }
+
+    Predicate predicate{expr, -1, nullptr, 0, 0, StringData(), kDocumentCost, 0, 0};
+
+    if (!isSingleElementLeaf(expr)) {
+        _predicates.push_back(predicate);
+        return;
+    }
+
+    auto path = expr->path();
+    auto slot = std::find_if(_paths.begin(), _paths.end(), [&](const PathSlot& pathSlot) {
+        return pathSlot.path.dottedField() == path;
+    });
+    if (slot == _paths.end()) {
+        slot = _paths.insert(_paths.end(), PathSlot{FieldRef(path), PathState::kUnresolved, {}});
+    }
+    predicate.pathSlot = slot - _paths.begin();
+    predicate.evaluate = &_evaluateSingleElement;
+    predicate.cost = expr->matchType() == MatchExpression::REGEX ? kRegexCost : kSingleElementCost;
+
+    if (!ComparisonMatchExpression::isComparisonMatchExpression(expr)) {
+        _predicates.push_back(predicate);
+        return;
+    }
+
+    auto comparison = static_cast<const ComparisonMatchExpression*>(expr);
+    const auto& rhs = comparison->getData();
+
+    boost::optional<ComparisonKind> kind;
+    switch (rhs.type()) {
+        case NumberInt:
+        case NumberLong:
+            predicate.rhsLong = rhs.numberLong();
+            kind = ComparisonKind::kLong;
+            break;
+        case NumberDouble:
+            if (!std::isnan(rhs._numberDouble())) {
+                predicate.rhsDouble = rhs._numberDouble();
+                kind = ComparisonKind::kDouble;
+            }
+            break;
+        case String:
+            if (!comparison->getCollator()) {
+                predicate.rhsString = rhs.valueStringData();
+                kind = ComparisonKind::kString;
+            }
+            break;
+        default:
+            break;
+    }
+
+    if (kind) {
+        switch (expr->matchType()) {
+            case MatchExpression::LT:
+                predicate.evaluate = _comparisonFn<MatchExpression::LT>(*kind);
+                break;
+            case MatchExpression::LTE:
+                predicate.evaluate = _comparisonFn<MatchExpression::LTE>(*kind);
+                break;
+            case MatchExpression::EQ:
+                predicate.evaluate = _comparisonFn<MatchExpression::EQ>(*kind);
+                break;
+            case MatchExpression::GT:
+                predicate.evaluate = _comparisonFn<MatchExpression::GT>(*kind);
+                break;
+            case MatchExpression::GTE:
+                predicate.evaluate = _comparisonFn<MatchExpression::GTE>(*kind);
+                break;
+            default:
+                MONGO_UNREACHABLE;
+        }
+        predicate.cost = kSpecializedCost;
+    }
+
+    _predicates.push_back(predicate);
+}
+
+void CompiledMatchExpression::_resolve(const BSONObj& doc, PathSlot* slot) const {
+    slot->state = PathState::kFallback;
+
+    BSONObj obj = doc;
+    for (size_t i = 0; i < slot->path.numParts(); ++i) {
+        BSONElement element = obj[slot->path.getPart(i)];
+        if (element.eoo() || element.type() == Array) {
+            return;
+        }
+
+        if (i + 1 == slot->path.numParts()) {
+            slot->value = element;
+            slot->state = PathState::kValue;
+            return;
+        }
+
+        if (element.type() != Object) {
+            return;
+        }
+        obj = element.embeddedObject();
+    }
+}
+
+bool CompiledMatchExpression::matchesBSON(const BSONObj& doc) {
+    for (auto& slot : _paths) {
+        slot.state = PathState::kUnresolved;
+    }
+
+    // Only needed by the predicates which fall back to the MatchExpression.
+    boost::optional<BSONMatchableDocument> matchable;
+
+    bool result = true;
+    for (auto& predicate : _predicates) {
+        ++predicate.evaluated;
+
+        bool passed;
+        PathSlot* slot = predicate.pathSlot >= 0 ? &_paths[predicate.pathSlot] : nullptr;
+        if (slot && slot->state == PathState::kUnresolved) {
+            _resolve(doc, slot);
+        }
+
+        if (slot && slot->state == PathState::kValue) {
+            passed = predicate.evaluate(predicate, slot->value);
+        } else {
+            if (!matchable) {
+                matchable.emplace(doc);
+            }
+            passed = predicate.expr->matches(matchable.get_ptr());
+        }
+
+        if (!passed) {
+            result = false;
+            break;
+        }
+        ++predicate.passed;
+    }
+
+    if (++_docsSinceReorder >= kReorderInterval) {
+        _reorder();
+    }
+
+    return result;
+}
+
+void CompiledMatchExpression::_reorder() {
+    _docsSinceReorder = 0;
+
+    // Expected cost of rejecting a document with the predicate. The pass rate is smoothed so that
+    // predicates which were rarely evaluated keep a sensible rank.
+    auto rank = [](const Predicate& predicate) {
+        double passRate = (predicate.passed + 1.0) / (predicate.evaluated + 2.0);
+        return predicate.cost / (1.0 - passRate);
+    };
+
+    std::stable_sort(
+        _predicates.begin(), _predicates.end(), [&](const Predicate& lhs, const Predicate& rhs) {
+            return rank(lhs) < rank(rhs);
+        });
+
+    // Decay the measurements so the order adapts when the data changes.
+    for (auto& predicate : _predicates) {
+        predicate.evaluated /= 2;
+        predicate.passed /= 2;
+    }
+}
+
+std::vector<const MatchExpression*> CompiledMatchExpression::getPredicates() const {
+    std::vector<const MatchExpression*> predicates;
+    for (const auto& predicate : _predicates) {
+        predicates.push_back(predicate.expr);
+    }
+    return predicates;
+}
+
+}  // namespace mongo
@@ -0,0 +1,167 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/field_ref.h"
+#include "mongo/db/matcher/expression.h"
+
+namespace mongo {
+
+/**
+ * A flat program equivalent to a MatchExpression tree, for stages which filter many documents
+ * with the same expression.
+ *
+ * The top level conjunction of the tree is flattened into a list of predicates. Predicates on the
+ * same path share a path slot, so each path is resolved at most once per document. Paths are only
+ * resolved through embedded objects: when the path is missing or crosses an array, the predicate
+ * is evaluated by the original MatchExpression so that the array and missing field semantics are
+ * unchanged.
+ *
+ * $eq, $lt, $lte, $gt and $gte against numbers, and against strings without a collator, are
+ * evaluated by type-specialized comparisons. Other leaves are evaluated by matchesSingleElement()
+ * on the resolved element, and the remaining expressions by matches() on the whole document.
+ *
+ * The predicates are reordered every kReorderInterval documents by their measured selectivity and
+ * estimated cost, so that cheap and selective predicates run first.
+ *
+ * The MatchExpression must outlive the CompiledMatchExpression, and must not be modified while it
+ * is in use. Not thread-safe.
+ */
+class CompiledMatchExpression {
+    CompiledMatchExpression(const CompiledMatchExpression&) = delete;
+    CompiledMatchExpression& operator=(const CompiledMatchExpression&) = delete;
+
+public:
+    static constexpr long long kReorderInterval = 1024;
+
+    explicit CompiledMatchExpression(const MatchExpression* expr);
+
+    /**
+     * Returns true if 'doc' satisfies the expression.
+     */
+    bool matchesBSON(const BSONObj& doc);
+
+    const MatchExpression* getExpression() const {
+        return _expr;
+    }
+
+    /**
+     * Returns the predicates of the flattened conjunction, in their current evaluation order.
+     */
+    std::vector<const MatchExpression*> getPredicates() const;
+
+    /**
+     * Returns the number of distinct paths resolved by the predicates.
+     */
+    size_t numPathSlots() const {
+        return _paths.size();
+    }
+
+private:
+    struct Predicate;
+
+    using EvaluateFn = bool (*)(const Predicate&, const BSONElement&);
+
+    struct Predicate {
+        const MatchExpression* expr;
+
+        // Index into _paths, or -1 if the predicate is evaluated against the whole document.
+        int pathSlot;
+
+        // Evaluates the predicate against the element its path resolved to.
+        EvaluateFn evaluate;
+
+        // Right hand side of the specialized comparisons.
+        long long rhsLong;
+        double rhsDouble;
+        StringData rhsString;
+
+        // Estimated relative cost of evaluating the predicate.
+        double cost;
+
+        // Number of documents the predicate was evaluated on, and the number which passed it,
+        // since the last reordering.
+        long long evaluated;
+        long long passed;
+    };
+
+    enum class PathState {
+        kUnresolved,
+        kValue,
+        kFallback,
+    };
+
+    struct PathSlot {
+        FieldRef path;
+        PathState state;
+        BSONElement value;
+    };
+
+    template <MatchExpression::MatchType type>
+    static bool _evaluateLong(const Predicate& predicate, const BSONElement& element);
+
+    template <MatchExpression::MatchType type>
+    static bool _evaluateDouble(const Predicate& predicate, const BSONElement& element);
+
+    template <MatchExpression::MatchType type>
+    static bool _evaluateString(const Predicate& predicate, const BSONElement& element);
+
+    static bool _evaluateSingleElement(const Predicate& predicate, const BSONElement& element);
+
+    enum class ComparisonKind {
+        kLong,
+        kDouble,
+        kString,
+    };
+
+    template <MatchExpression::MatchType type>
+    static EvaluateFn _comparisonFn(ComparisonKind kind);
+
+    void _addPredicate(const MatchExpression* expr);
+
+    void _resolve(const BSONObj& doc, PathSlot* slot) const;
+
+    void _reorder();
+
+    const MatchExpression* const _expr;
+
+    std::vector<Predicate> _predicates;
+
+    std::vector<PathSlot> _paths;
+
+    long long _docsSinceReorder = 0;
+};
+
+}  // namespace mongo
@@ -0,0 +1,153 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/matcher/compiled_match_expression.h"
+
+#include <limits>
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/json.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+std::unique_ptr<MatchExpression> parse(const BSONObj& filter,
+                                       const CollatorInterface* collator = nullptr) {
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    expCtx->setCollator(collator);
+    auto swExpr = MatchExpressionParser::parse(filter, expCtx);
+    ASSERT_OK(swExpr.getStatus());
+    return std::move(swExpr.getValue());
+}
+
+/**
+ * Asserts the compiled form of 'filter' agrees with the MatchExpression on every document.
+ */
+void assertSameResults(const BSONObj& filter,
+                       const std::vector<BSONObj>& docs,
+                       const CollatorInterface* collator = nullptr) {
+    auto expr = parse(filter, collator);
+    CompiledMatchExpression compiled(expr.get());
+
+    for (const auto& doc : docs) {
+        ASSERT_EQ(expr->matchesBSON(doc), compiled.matchesBSON(doc))
+            << "filter: " << filter << " doc: " << doc;
+    }
+}
+
+const std::vector<BSONObj> kDocs{
+    fromjson("{}"),
+    fromjson("{a: 1}"),
+    fromjson("{a: 1, b: 2}"),
+    fromjson("{a: 2, b: 'x'}"),
+    fromjson("{a: NumberLong(3), b: 'y'}"),
+    fromjson("{a: 2.5, b: 'xy'}"),
+    fromjson("{a: NumberDecimal('2'), b: 'X'}"),
+    fromjson("{a: NaN}"),
+    fromjson("{a: null}"),
+    fromjson("{a: 'abc'}"),
+    fromjson("{a: [1, 5]}"),
+    fromjson("{a: []}"),
+    fromjson("{a: {b: 2}}"),
+    fromjson("{a: {b: [1, 3]}}"),
+    fromjson("{a: [{b: 2}, {b: 4}]}"),
+    fromjson("{a: {b: {c: 'x'}}}"),
+    fromjson("{a: {c: 1}}"),
+    fromjson("{a: 5, b: {c: 1}}"),
+};
+
+TEST(CompiledMatchExpressionTest, ComparisonsMatchLikeMatchExpression) {
+    for (auto op : {"$eq", "$lt", "$lte", "$gt", "$gte"}) {
+        assertSameResults(BSON("a" << BSON(op << 2)), kDocs);
+        assertSameResults(BSON("a" << BSON(op << 2LL)), kDocs);
+        assertSameResults(BSON("a" << BSON(op << 2.0)), kDocs);
+        assertSameResults(BSON("a" << BSON(op << std::numeric_limits<double>::quiet_NaN())),
+                          kDocs);
+        assertSameResults(BSON("b" << BSON(op << "x")), kDocs);
+        assertSameResults(BSON("a.b" << BSON(op << 2)), kDocs);
+        assertSameResults(BSON("a.b.c" << BSON(op << "x")), kDocs);
+        assertSameResults(BSON("a" << BSON(op << BSONNULL)), kDocs);
+        assertSameResults(BSON("a" << BSON(op << BSON("b" << 2))), kDocs);
+    }
+}
+
+TEST(CompiledMatchExpressionTest, ConjunctionsMatchLikeMatchExpression) {
+    assertSameResults(fromjson("{a: {$gt: 1, $lt: 3}, b: {$in: ['x', 'y']}}"), kDocs);
+    assertSameResults(fromjson("{a: {$exists: true}, b: {$regex: '^x'}}"), kDocs);
+    assertSameResults(fromjson("{$and: [{a: {$gte: 1}}, {$or: [{b: 2}, {'b.c': 1}]}]}"), kDocs);
+    assertSameResults(fromjson("{a: {$not: {$gt: 1}}, b: {$exists: false}}"), kDocs);
+    assertSameResults(fromjson("{'a.b': {$in: [2, 3]}, a: {$type: 'object'}}"), kDocs);
+    assertSameResults(fromjson("{a: {$elemMatch: {b: 4}}}"), kDocs);
+    assertSameResults(fromjson("{a: {$mod: [2, 1]}, b: {$ne: 2}}"), kDocs);
+    assertSameResults(fromjson("{$nor: [{a: 1}]}"), kDocs);
+}
+
+TEST(CompiledMatchExpressionTest, StringComparisonsRespectCollation) {
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kToLowerString);
+    for (auto op : {"$eq", "$lt", "$lte", "$gt", "$gte"}) {
+        assertSameResults(BSON("b" << BSON(op << "x")), kDocs, &collator);
+    }
+}
+
+TEST(CompiledMatchExpressionTest, PredicatesOnTheSamePathShareAPathSlot) {
+    auto expr = parse(fromjson("{a: {$gt: 1, $lt: 3}, 'a.b': 1, c: {$in: [1, 2]}, d: /x/}"));
+    CompiledMatchExpression compiled(expr.get());
+
+    ASSERT_EQ(compiled.getPredicates().size(), 5U);
+    ASSERT_EQ(compiled.numPathSlots(), 4U);
+}
+
+TEST(CompiledMatchExpressionTest, SelectivePredicatesAreReorderedFirst) {
+    auto expr = parse(fromjson("{a: {$exists: true}, b: 1}"));
+    CompiledMatchExpression compiled(expr.get());
+
+    auto predicates = compiled.getPredicates();
+    ASSERT_EQ(predicates.size(), 2U);
+    ASSERT_EQ(predicates[0]->path(), "a");
+
+    // Every document passes the predicate on 'a', few pass the predicate on 'b'.
+    for (long long i = 0; i < CompiledMatchExpression::kReorderInterval; ++i) {
+        BSONObj doc = BSON("a" << i << "b" << i % 100);
+        ASSERT_EQ(expr->matchesBSON(doc), compiled.matchesBSON(doc));
+    }
+
+    predicates = compiled.getPredicates();
+    ASSERT_EQ(predicates[0]->path(), "b");
+    ASSERT_EQ(predicates[1]->path(), "a");
+}
+
+}  // namespace
+}  // namespace mongo
@@ -43,6 +43,7 @@
 #include "mongo/db/matcher/expression_parser.h"
 #include "mongo/db/matcher/path.h"
 #include "mongo/db/query/collation/collator_interface.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/mongoutils/str.h"
 #include "mongo/util/regex_util.h"
@@ -365,7 +366,8 @@ bool ExistsMatchExpression::equivalent(const MatchExpression* other) const {
 InMatchExpression::InMatchExpression(StringData path)
     : LeafMatchExpression(MATCH_IN, path),
       _eltCmp(BSONElementComparator::FieldNamesMode::kIgnore, _collator),
-      _equalitySet(_eltCmp.makeBSONEltFlatSet(_originalEqualityVector)) {}
+      _equalitySet(_eltCmp.makeBSONEltFlatSet(_originalEqualityVector)),
+      _equalityHashSet(_eltCmp.makeBSONEltUnorderedSet()) {}
 
 std::unique_ptr<MatchExpression> InMatchExpression::shallowClone() const {
     auto next = stdx::make_unique<InMatchExpression>(path());
@@ -377,6 +379,7 @@ std::unique_ptr<MatchExpression> InMatchExpression::shallowClone() const {
     next->_hasEmptyArray = _hasEmptyArray;
     next->_equalitySet = _equalitySet;
     next->_originalEqualityVector = _originalEqualityVector;
+    next->_updateEqualityHashSet();
     for (auto&& regex : _regexes) {
         std::unique_ptr<RegexMatchExpression> clonedRegex(
             static_cast<RegexMatchExpression*>(regex->shallowClone().release()));
@@ -389,7 +392,11 @@ bool InMatchExpression::matchesSingleElement(const BSONElement& e, MatchDetails*
     if (_hasNull && e.eoo()) {
         return true;
     }
-    if (_equalitySet.find(e) != _equalitySet.end()) {
+    if (!_equalityHashSet.empty()) {
+        if (_equalityHashSet.count(e)) {
+            return true;
+        }
+    } else if (_equalitySet.find(e) != _equalitySet.end()) {
         return true;
     }
     for (auto&& regex : _regexes) {
@@ -493,6 +500,7 @@ void InMatchExpression::_doSetCollator(const CollatorInterface* collator) {
         _originalEqualityVector.begin(),
         std::unique(
             _originalEqualityVector.begin(), _originalEqualityVector.end(), _eltCmp.makeEqualTo()));
+    _updateEqualityHashSet();
 }
 
 Status InMatchExpression::setEqualities(std::vector<BSONElement> equalities) {
@@ -525,10 +533,25 @@ Status InMatchExpression::setEqualities(std::vector<BSONElement> equalities) {
         _originalEqualityVector.begin(),
         std::unique(
             _originalEqualityVector.begin(), _originalEqualityVector.end(), _eltCmp.makeEqualTo()));
+    _updateEqualityHashSet();
 
     return Status::OK();
 }
 
+void InMatchExpression::_updateEqualityHashSet() {
+    // The hash set's hasher and equality functor point at '_eltCmp', so build a fresh set rather
+    // than copying one constructed against another comparator.
+    _equalityHashSet = _eltCmp.makeBSONEltUnorderedSet();
+
+    const auto threshold = internalQueryInHashedMembershipThreshold.load();
+    if (threshold <= 0 || _equalitySet.size() < static_cast<size_t>(threshold)) {
+        return;
+    }
+
+    _equalityHashSet.reserve(_equalitySet.size());
+    _equalityHashSet.insert(_equalitySet.begin(), _equalitySet.end());
+}
+
 Status InMatchExpression::addRegex(std::unique_ptr<RegexMatchExpression> expr) {
     _regexes.push_back(std::move(expr));
     return Status::OK();
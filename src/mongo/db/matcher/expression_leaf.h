@@ -449,6 +449,12 @@ public:
 private:
     ExpressionOptimizerFunc getOptimizer() const final;
 
+    /**
+     * Rebuilds '_equalityHashSet' from '_equalitySet'. Must be called whenever '_equalitySet' or
+     * '_eltCmp' changes.
+     */
+    void _updateEqualityHashSet();
+
     // Whether or not '_equalities' has a jstNULL element in it.
     bool _hasNull = false;
 
@@ -475,6 +481,11 @@ private:
     // for this set.
     BSONEltFlatSet _equalitySet;
 
+    // Hashed copy of '_equalitySet', populated only when the number of equalities reaches
+    // 'internalQueryInHashedMembershipThreshold'. For large $in lists a hash lookup is cheaper than
+    // the O(log n) comparisons of a binary search over '_equalitySet'.
+    BSONEltUnorderedSet _equalityHashSet;
+
     // Container of regex elements this object owns.
     std::vector<std::unique_ptr<RegexMatchExpression>> _regexes;
 };
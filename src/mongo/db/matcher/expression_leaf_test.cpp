@@ -1370,6 +1370,65 @@ TEST(InMatchExpression, ChangingCollationAfterAddingEqualitiesPreservesEqualitie
     ASSERT(in.getEqualities().count(obj2.firstElement()));
 }
 
+TEST(InMatchExpression, LargeInListMatchesNumericEqualitiesAcrossTypes) {
+    BSONArrayBuilder operandBuilder;
+    for (int i = 0; i < 1000; i += 2) {
+        operandBuilder.append(i);
+    }
+    BSONArray operand = operandBuilder.arr();
+
+    InMatchExpression in("");
+    std::vector<BSONElement> equalities;
+    for (auto&& elt : operand) {
+        equalities.push_back(elt);
+    }
+    ASSERT_OK(in.setEqualities(std::move(equalities)));
+    ASSERT_EQ(in.getEqualities().size(), 500U);
+
+    ASSERT(in.matchesSingleElement(BSON("a" << 0)["a"]));
+    ASSERT(in.matchesSingleElement(BSON("a" << 998LL)["a"]));
+    ASSERT(in.matchesSingleElement(BSON("a" << 512.0)["a"]));
+    ASSERT(in.matchesSingleElement(BSON("a" << Decimal128("100"))["a"]));
+    ASSERT(!in.matchesSingleElement(BSON("a" << 1)["a"]));
+    ASSERT(!in.matchesSingleElement(BSON("a" << 2.5)["a"]));
+    ASSERT(!in.matchesSingleElement(BSON("a" << 1000)["a"]));
+    ASSERT(!in.matchesSingleElement(BSON("a"
+                                         << "2")["a"]));
+
+    auto clone = in.shallowClone();
+    ASSERT(clone->matchesSingleElement(BSON("a" << 4LL)["a"]));
+    ASSERT(!clone->matchesSingleElement(BSON("a" << 5LL)["a"]));
+}
+
+TEST(InMatchExpression, LargeInListStringMatchingRespectsCollation) {
+    BSONArrayBuilder operandBuilder;
+    for (int i = 0; i < 200; ++i) {
+        operandBuilder.append(std::string("s") + std::to_string(i));
+    }
+    BSONArray operand = operandBuilder.arr();
+
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kToLowerString);
+    InMatchExpression in("");
+    in.setCollator(&collator);
+    std::vector<BSONElement> equalities;
+    for (auto&& elt : operand) {
+        equalities.push_back(elt);
+    }
+    ASSERT_OK(in.setEqualities(std::move(equalities)));
+
+    ASSERT(in.matchesSingleElement(BSON("a"
+                                        << "S17")["a"]));
+    ASSERT(!in.matchesSingleElement(BSON("a"
+                                         << "S200")["a"]));
+
+    // Switching back to the simple collation must rebuild the hashed membership set.
+    in.setCollator(nullptr);
+    ASSERT(!in.matchesSingleElement(BSON("a"
+                                         << "S17")["a"]));
+    ASSERT(in.matchesSingleElement(BSON("a"
+                                        << "s17")["a"]));
+}
+
 std::vector<uint32_t> bsonArrayToBitPositions(const BSONArray& ba) {
     std::vector<uint32_t> bitPositions;
 
@@ -36,12 +36,17 @@
 namespace mongo {
 namespace {
 const auto getOpObserverTimes = OperationContext::declareDecoration<OpObserver::Times>();
+const auto getBatchedWrites = OperationContext::declareDecoration<OpObserver::BatchedWrites>();
 }  // namespace
 
 auto OpObserver::Times::get(OperationContext* const opCtx) -> Times& {
     return getOpObserverTimes(opCtx);
 }
 
+auto OpObserver::BatchedWrites::get(OperationContext* const opCtx) -> BatchedWrites& {
+    return getBatchedWrites(opCtx);
+}
+
 OpObserver::ReservedTimes::ReservedTimes(OperationContext* const opCtx)
     : _times(Times::get(opCtx)) {
     // Every time that a `ReservedTimes` scope object is instantiated, we have to track if there was
@@ -35,6 +35,7 @@
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/collection_options.h"
 #include "mongo/db/jsobj.h"
+#include "mongo/db/repl/oplog_entry.h"
 #include "mongo/db/repl/rollback.h"
 #include "mongo/db/s/collection_sharding_state.h"
 
@@ -279,6 +280,13 @@ public:
                                const NamespaceString& collectionName,
                                OptionalCollectionUUID uuid) = 0;
 
+    /**
+     * The onBatchedWriteCommit method is called before committing a WriteUnitOfWork in which
+     * deletes were made while the operation's BatchedWrites was active. It logs the collected
+     * deletes as a single applyOps oplog entry.
+     */
+    virtual void onBatchedWriteCommit(OperationContext* opCtx) = 0;
+
     /**
      * The onUnpreparedTransactionCommit method is called on the commit of an unprepared
      * transaction, before the RecoveryUnit onCommit() is called.  It must not be called when no
@@ -377,6 +385,7 @@ public:
                                        const RollbackObserverInfo& rbInfo) = 0;
 
     struct Times;
+    struct BatchedWrites;
 
 protected:
     class ReservedTimes;
@@ -400,6 +409,29 @@ private:
     int _recursionDepth = 0;
 };
 
+/**
+ * Collects the deletes made by an operation, rather than logging each of them, while 'active' is
+ * set. They are logged together by `OpObserver::onBatchedWriteCommit()`.
+ */
+struct OpObserver::BatchedWrites {
+    static BatchedWrites& get(OperationContext*);
+
+    /**
+     * Stops collecting and discards the collected operations.
+     */
+    void reset() {
+        active = false;
+        operations.clear();
+        operationsBytes = 0;
+    }
+
+    bool active = false;
+    std::vector<repl::ReplOperation> operations;
+
+    // The total BSON size of 'operations', which bounds the size of the oplog entry.
+    size_t operationsBytes = 0;
+};
+
 /**
  * This class is an RAII object to manage the state of the `OpObserver::Times` decoration on an
  * operation context. Upon destruction the list of times in the decoration on the operation context
@@ -647,11 +647,18 @@ void OpObserverImpl::onDelete(OperationContext* opCtx,
     const bool inMultiDocumentTransaction = txnParticipant && opCtx->writesAreReplicated() &&
         txnParticipant.inMultiDocumentTransaction();
 
+    auto& batchedWrites = BatchedWrites::get(opCtx);
+
     OpTimeBundle opTime;
     if (inMultiDocumentTransaction) {
         auto operation =
             OplogEntry::makeDeleteOperation(nss, uuid, deletedDoc ? deletedDoc.get() : documentKey);
         txnParticipant.addTransactionOperation(opCtx, operation);
+    } else if (batchedWrites.active && opCtx->writesAreReplicated()) {
+        // Logged together with the rest of the batch by onBatchedWriteCommit().
+        auto operation = OplogEntry::makeDeleteOperation(nss, uuid, documentKey);
+        batchedWrites.operationsBytes += operation.toBSON().objsize();
+        batchedWrites.operations.push_back(std::move(operation));
     } else {
         opTime = replLogDelete(opCtx, nss, uuid, stmtId, fromMigrate, deletedDoc);
         onWriteOpCompleted(opCtx,
@@ -983,6 +990,34 @@ void OpObserverImpl::onApplyOps(OperationContext* opCtx,
     replLogApplyOps(opCtx, cmdNss, applyOpCmd, {}, kUninitializedStmtId, {}, prepare, OplogSlot());
 }
 
+void OpObserverImpl::onBatchedWriteCommit(OperationContext* opCtx) {
+    auto& batchedWrites = BatchedWrites::get(opCtx);
+    if (!opCtx->writesAreReplicated() || batchedWrites.operations.empty()) {
+        return;
+    }
+
+    BSONObjBuilder applyOpsBuilder;
+    BSONArrayBuilder opsArray(applyOpsBuilder.subarrayStart("applyOps"_sd));
+    for (auto& operation : batchedWrites.operations) {
+        opsArray.append(operation.toBSON());
+    }
+    opsArray.done();
+
+    // The deletes are independent of each other, so secondaries may apply them one at a time
+    // under a database lock, instead of atomically under the global lock.
+    applyOpsBuilder.append("allowAtomic", false);
+
+    const NamespaceString cmdNss{"admin", "$cmd"};
+    replLogApplyOps(opCtx,
+                    cmdNss,
+                    applyOpsBuilder.done(),
+                    {},
+                    kUninitializedStmtId,
+                    {},
+                    false /* prepare */,
+                    OplogSlot());
+}
+
 void OpObserverImpl::onEmptyCapped(OperationContext* opCtx,
                                    const NamespaceString& collectionName,
                                    OptionalCollectionUUID uuid) {
@@ -138,6 +138,7 @@ public:
     void onEmptyCapped(OperationContext* opCtx,
                        const NamespaceString& collectionName,
                        OptionalCollectionUUID uuid);
+    void onBatchedWriteCommit(OperationContext* opCtx) final;
     void onUnpreparedTransactionCommit(OperationContext* opCtx,
                                        const std::vector<repl::ReplOperation>& statements) final;
     void onPreparedTransactionCommit(
@@ -521,6 +521,51 @@ TEST_F(OpObserverTest, MultipleAboutToDeleteAndOnDelete) {
     opObserver.onDelete(opCtx.get(), nss, uuid, {}, false, {});
 }
 
+TEST_F(OpObserverTest, BatchedDeletesAreLoggedAsOneApplyOps) {
+    auto uuid = UUID::gen();
+    OpObserverImpl opObserver;
+    auto opCtx = cc().makeOperationContext();
+    NamespaceString nss = {"test", "coll"};
+
+    auto& batchedWrites = OpObserver::BatchedWrites::get(opCtx.get());
+    batchedWrites.active = true;
+    {
+        AutoGetDb autoDb(opCtx.get(), nss.db(), MODE_X);
+        WriteUnitOfWork wunit(opCtx.get());
+        opObserver.aboutToDelete(opCtx.get(), nss, BSON("_id" << 0 << "x" << 1));
+        opObserver.onDelete(opCtx.get(), nss, uuid, kUninitializedStmtId, false, boost::none);
+        opObserver.aboutToDelete(opCtx.get(), nss, BSON("_id" << 1 << "x" << 2));
+        opObserver.onDelete(opCtx.get(), nss, uuid, kUninitializedStmtId, false, boost::none);
+        ASSERT_EQ(batchedWrites.operations.size(), 2U);
+        opObserver.onBatchedWriteCommit(opCtx.get());
+        wunit.commit();
+    }
+    batchedWrites.reset();
+
+    auto oplogEntry = getSingleOplogEntry(opCtx.get());
+    ASSERT_EQ("c", oplogEntry.getStringField("op"));
+    auto o = oplogEntry.getObjectField("o");
+    auto oExpected = BSON("applyOps" << BSON_ARRAY(BSON("op"
+                                                        << "d"
+                                                        << "ns"
+                                                        << nss.toString()
+                                                        << "ui"
+                                                        << uuid
+                                                        << "o"
+                                                        << BSON("_id" << 0))
+                                                   << BSON("op"
+                                                           << "d"
+                                                           << "ns"
+                                                           << nss.toString()
+                                                           << "ui"
+                                                           << uuid
+                                                           << "o"
+                                                           << BSON("_id" << 1)))
+                                     << "allowAtomic"
+                                     << false);
+    ASSERT_BSONOBJ_EQ(oExpected, o);
+}
+
 DEATH_TEST_F(OpObserverTest, AboutToDeleteMustPreceedOnDelete, "invariant") {
     OpObserverImpl opObserver;
     auto opCtx = cc().makeOperationContext();
@@ -136,6 +136,7 @@ public:
     void onEmptyCapped(OperationContext* opCtx,
                        const NamespaceString& collectionName,
                        OptionalCollectionUUID uuid) override {}
+    void onBatchedWriteCommit(OperationContext* opCtx) override {}
     void onUnpreparedTransactionCommit(
         OperationContext* opCtx, const std::vector<repl::ReplOperation>& statements) override{};
     void onPreparedTransactionCommit(
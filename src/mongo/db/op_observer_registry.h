@@ -259,6 +259,12 @@ public:
             o->onEmptyCapped(opCtx, collectionName, uuid);
     }
 
+    void onBatchedWriteCommit(OperationContext* opCtx) override {
+        ReservedTimes times{opCtx};
+        for (auto& o : _observers)
+            o->onBatchedWriteCommit(opCtx);
+    }
+
     void onUnpreparedTransactionCommit(
         OperationContext* opCtx, const std::vector<repl::ReplOperation>& statements) override {
         ReservedTimes times{opCtx};
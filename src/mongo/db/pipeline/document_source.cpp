@@ -87,6 +87,19 @@ const char* DocumentSource::getSourceName() const {
     return unknown;
 }
 
+DocumentSource::GetNextResult::ReturnStatus DocumentSource::getNextBatch(vector<Document>* batch,
+                                                                         size_t maxBatchSize) {
+    invariant(batch->empty());
+    while (batch->size() < maxBatchSize) {
+        auto nextResult = getNext();
+        if (!nextResult.isAdvanced()) {
+            return nextResult.getStatus();
+        }
+        batch->push_back(nextResult.releaseDocument());
+    }
+    return GetNextResult::ReturnStatus::kAdvanced;
+}
+
 intrusive_ptr<DocumentSource> DocumentSource::optimize() {
     return this;
 }
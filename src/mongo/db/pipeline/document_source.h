@@ -249,6 +249,27 @@ public:
      */
     virtual GetNextResult getNext() = 0;
 
+    /**
+     * Batched variant of getNext(). Appends up to 'maxBatchSize' results to 'batch', which must be
+     * empty on entry. Returns kAdvanced if at least one document was appended and no other status
+     * was encountered. Otherwise returns the kEOF or kPauseExecution status which ended the batch;
+     * any documents appended to 'batch' are results which precede that status.
+     *
+     * The default implementation calls getNext() repeatedly. Stages which can produce results
+     * more cheaply in bulk should override this, together with canProduceBatches().
+     */
+    virtual GetNextResult::ReturnStatus getNextBatch(std::vector<Document>* batch,
+                                                     size_t maxBatchSize);
+
+    /**
+     * Returns true if this stage overrides getNextBatch() to process its input a batch at a time.
+     * A pipeline is only executed in batches if all of its stages return true, since batching
+     * reads results ahead of the consumer.
+     */
+    virtual bool canProduceBatches() const {
+        return false;
+    }
+
     /**
      * Returns a struct containing information about any special constraints imposed on using this
      * stage. Input parameter Pipeline::SplitState is used by stages whose requirements change
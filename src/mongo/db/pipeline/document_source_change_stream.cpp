@@ -173,6 +173,22 @@ BSONObj getTxnApplyOpsFilter(BSONElement nsMatch, const NamespaceString& nss) {
     applyOpsBuilder.appendAs(nsMatch, kApplyOpsNs);
     return applyOpsBuilder.obj();
 }
+
+/**
+ * Constructs a filter matching the 'applyOps' oplog entries logged by
+ * OpObserver::onBatchedWriteCommit(), such as batches of TTL deletes, which have sub-entries that
+ * should be returned in the change stream. These are the only 'applyOps' entries which carry
+ * {allowAtomic: false} and no session, since the applyOps command itself logs each operation
+ * separately when it is not applied atomically.
+ */
+BSONObj getBatchedWriteApplyOpsFilter(BSONElement nsMatch) {
+    BSONObjBuilder applyOpsBuilder;
+    applyOpsBuilder.append("op", "c");
+    applyOpsBuilder.append("lsid", BSON("$exists" << false));
+    applyOpsBuilder.append("o.allowAtomic", false);
+    applyOpsBuilder.appendAs(nsMatch, "o.applyOps.ns");
+    return applyOpsBuilder.obj();
+}
 }  // namespace
 
 DocumentSourceChangeStream::ChangeStreamType DocumentSourceChangeStream::getChangeStreamType(
@@ -268,11 +284,14 @@ BSONObj DocumentSourceChangeStream::buildMatchFilter(
     // 3) Look for 'applyOps' which were created as part of a transaction.
     BSONObj applyOps = getTxnApplyOpsFilter(nsMatch["ns"], nss);
 
+    // 4) Look for 'applyOps' which were created by a batch of writes outside a transaction.
+    BSONObj batchedWrites = getBatchedWriteApplyOpsFilter(nsMatch["ns"]);
+
     // Match oplog entries after "start" and are either supported (1) commands or (2) operations,
     // excepting those tagged "fromMigrate". Include the resume token, if resuming, so we can verify
     // it was still present in the oplog.
     return BSON("$and" << BSON_ARRAY(BSON("ts" << (startFromInclusive ? GTE : GT) << startFrom)
-                                     << BSON(OR(opMatch, commandMatch, applyOps))
+                                     << BSON(OR(opMatch, commandMatch, applyOps, batchedWrites))
                                      << BSON("fromMigrate" << NE << true)));
 }
 
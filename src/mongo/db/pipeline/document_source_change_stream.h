@@ -226,6 +226,15 @@ public:
         MONGO_UNREACHABLE;
     }
 
+    GetNextResult::ReturnStatus getNextBatch(std::vector<Document>* batch,
+                                             size_t maxBatchSize) final {
+        MONGO_UNREACHABLE;
+    }
+
+    bool canProduceBatches() const final {
+        return false;
+    }
+
     StageConstraints constraints(Pipeline::SplitState pipeState) const final;
 
     Value serialize(boost::optional<ExplainOptions::Verbosity> explain) const final;
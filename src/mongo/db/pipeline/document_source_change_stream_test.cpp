@@ -852,6 +852,57 @@ TEST_F(ChangeStreamStageTest, TransformNonTransactionApplyOps) {
     checkTransformation(oplogEntry, boost::none);
 }
 
+TEST_F(ChangeStreamStageTest, TransformBatchedWriteApplyOps) {
+    // A batch of writes, such as a batch of TTL deletes, is logged as a non-atomic applyOps
+    // without an lsid or txnNumber.
+    Document applyOpsDoc{
+        {"applyOps",
+         Value{std::vector<Document>{
+             Document{{"op", "d"_sd},
+                      {"ns", nss.ns()},
+                      {"ui", testUuid()},
+                      {"o", Value{Document{{"_id", 1}}}}},
+             // Operation on another namespace which should be skipped.
+             Document{{"op", "d"_sd},
+                      {"ns", "someotherdb.collname"_sd},
+                      {"ui", UUID::gen()},
+                      {"o", Value{Document{{"_id", 0}}}}},
+             Document{{"op", "d"_sd},
+                      {"ns", nss.ns()},
+                      {"ui", testUuid()},
+                      {"o", Value{Document{{"_id", 2}}}}},
+         }}},
+        {"allowAtomic", false},
+    };
+    auto oplogEntry = makeOplogEntry(OpTypeEnum::kCommand,
+                                     NamespaceString("admin.$cmd"),
+                                     applyOpsDoc.toBson(),
+                                     boost::none,  // uuid
+                                     boost::none,  // fromMigrate
+                                     boost::none);  // o2
+
+    vector<intrusive_ptr<DocumentSource>> stages = makeStages(oplogEntry);
+    auto transform = stages[2].get();
+    invariant(dynamic_cast<DocumentSourceChangeStreamTransform*>(transform) != nullptr);
+
+    std::vector<Document> results;
+    for (auto next = transform->getNext(); next.isAdvanced(); next = transform->getNext()) {
+        results.push_back(next.releaseDocument());
+    }
+
+    // The delete on the other namespace should be skipped.
+    ASSERT_EQ(results.size(), 2u);
+    for (size_t i = 0; i < results.size(); ++i) {
+        ASSERT_EQ(results[i][DSChangeStream::kOperationTypeField].getString(),
+                  DSChangeStream::kDeleteOpType);
+        ASSERT_EQ(results[i][DSChangeStream::kDocumentKeyField]["_id"].getInt(),
+                  static_cast<int>(i + 1));
+        ASSERT_EQ(results[i][DSChangeStream::kClusterTimeField].getTimestamp(), kDefaultTs);
+        ASSERT(results[i]["txnNumber"].missing());
+        ASSERT(results[i]["lsid"].missing());
+    }
+}
+
 TEST_F(ChangeStreamStageTest, TransformApplyOpsWithEntriesOnDifferentNs) {
     // Doesn't use the checkTransformation() pattern that other tests use since we expect multiple
     // documents to be returned from one applyOps.
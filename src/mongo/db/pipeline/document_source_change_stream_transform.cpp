@@ -54,6 +54,7 @@
 #include "mongo/db/repl/oplog_entry_gen.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/transaction_history_iterator.h"
+#include "mongo/db/update/document_diff.h"
 #include "mongo/s/catalog_cache.h"
 #include "mongo/s/grid.h"
 #include "mongo/util/log.h"
@@ -250,15 +251,30 @@ Document DocumentSourceChangeStreamTransform::applyTransformation(const Document
                                repl::OplogEntry::kObjectFieldName,
                                BSONType::Object);
                 Document opObject = input[repl::OplogEntry::kObjectFieldName].getDocument();
-                Value updatedFields = opObject["$set"];
-                Value removedFields = opObject["$unset"];
-
-                // Extract the field names of $unset document.
+                Value updatedFields;
                 vector<Value> removedFieldsVector;
-                if (removedFields.getType() == BSONType::Object) {
-                    auto iter = removedFields.getDocument().fieldIterator();
-                    while (iter.more()) {
-                        removedFieldsVector.push_back(Value(iter.next().first));
+                Value diff = opObject[doc_diff::kDiffFieldName];
+                if (diff.getType() == BSONType::Object) {
+                    // The update was logged as a diff of the document, which we describe in terms
+                    // of the paths it sets and unsets.
+                    BSONObjBuilder updatedFieldsBuilder;
+                    std::vector<std::string> removedFieldPaths;
+                    doc_diff::describeDiff(
+                        diff.getDocument().toBson(), &updatedFieldsBuilder, &removedFieldPaths);
+                    updatedFields = Value(updatedFieldsBuilder.obj());
+                    for (auto&& path : removedFieldPaths) {
+                        removedFieldsVector.push_back(Value(path));
+                    }
+                } else {
+                    updatedFields = opObject["$set"];
+                    Value removedFields = opObject["$unset"];
+
+                    // Extract the field names of $unset document.
+                    if (removedFields.getType() == BSONType::Object) {
+                        auto iter = removedFields.getDocument().fieldIterator();
+                        while (iter.more()) {
+                            removedFieldsVector.push_back(Value(iter.next().first));
+                        }
                     }
                 }
                 updateDescription = Value(Document{
@@ -327,10 +343,10 @@ Document DocumentSourceChangeStreamTransform::applyTransformation(const Document
     auto resumeToken = ResumeToken(resumeTokenData).toDocument();
 
     // Add some additional fields only relevant to transactions.
-    if (_txnContext) {
+    if (_txnContext && _txnContext->txnNumber) {
         doc.addField(DocumentSourceChangeStream::kTxnNumberField,
-                     Value(static_cast<long long>(_txnContext->txnNumber)));
-        doc.addField(DocumentSourceChangeStream::kLsidField, Value(_txnContext->lsid));
+                     Value(static_cast<long long>(*_txnContext->txnNumber)));
+        doc.addField(DocumentSourceChangeStream::kLsidField, Value(*_txnContext->lsid));
     }
 
     doc.addField(DocumentSourceChangeStream::kIdField, Value(resumeToken));
@@ -416,17 +432,30 @@ void DocumentSourceChangeStreamTransform::initializeTransactionContext(const Doc
     // allowed in the oplog.
     invariant(!_txnContext);
 
+    Value ts = input[repl::OplogEntry::kTimestampFieldName];
+    Timestamp txnApplyTime = ts.getTimestamp();
+
+    auto commandObj = input["o"].getDocument();
+    Value applyOps = commandObj["applyOps"];
+
+    // An "applyOps" without a session is a batch of independent writes logged outside of a
+    // transaction, such as a batch of TTL deletes. Its operations are unwound in the same way,
+    // but the resulting events carry no 'lsid' or 'txnNumber'.
+    if (!applyOps.missing() && input["lsid"].missing()) {
+        invariant(ValueComparator::kInstance.evaluate(commandObj["allowAtomic"] == Value(false)));
+        applyOps = input.getNestedField("o.applyOps");
+        checkValueType(applyOps, "applyOps", BSONType::Array);
+        invariant(applyOps.getArrayLength() > 0);
+        _txnContext.emplace(applyOps, txnApplyTime, boost::none, boost::none);
+        return;
+    }
+
     Value lsid = input["lsid"];
     checkValueType(lsid, "lsid", BSONType::Object);
 
     Value txnNumber = input["txnNumber"];
     checkValueType(txnNumber, "txnNumber", BSONType::NumberLong);
 
-    Value ts = input[repl::OplogEntry::kTimestampFieldName];
-    Timestamp txnApplyTime = ts.getTimestamp();
-
-    auto commandObj = input["o"].getDocument();
-    Value applyOps = commandObj["applyOps"];
     if (!applyOps.missing()) {
         // An "applyOps" command represents an immediately-committed transaction. We place the
         // operations within the "applyOps" array directly into the transaction context.
@@ -107,14 +107,15 @@ private:
         // The clusterTime of the applyOps.
         Timestamp clusterTime;
 
-        // Fields that were taken from the 'applyOps' oplog entry.
-        Document lsid;
-        TxnNumber txnNumber;
+        // Fields that were taken from the 'applyOps' oplog entry. Both are boost::none for a batch
+        // of writes which was logged outside a transaction.
+        boost::optional<Document> lsid;
+        boost::optional<TxnNumber> txnNumber;
 
         TransactionContext(const Value& applyOpsVal,
                            Timestamp ts,
-                           const Document& lsidDoc,
-                           TxnNumber n)
+                           const boost::optional<Document>& lsidDoc,
+                           boost::optional<TxnNumber> n)
             : opArray(applyOpsVal),
               arr(opArray.getArray()),
               pos(0),
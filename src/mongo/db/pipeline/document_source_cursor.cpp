@@ -74,6 +74,29 @@ DocumentSource::GetNextResult DocumentSourceCursor::getNext() {
     return std::move(out);
 }
 
+DocumentSource::GetNextResult::ReturnStatus DocumentSourceCursor::getNextBatch(
+    std::vector<Document>* batch, size_t maxBatchSize) {
+    if (_trackOplogTS) {
+        return DocumentSource::getNextBatch(batch, maxBatchSize);
+    }
+
+    pExpCtx->checkForInterrupt();
+    invariant(batch->empty());
+
+    if (_currentBatch.empty()) {
+        loadBatch();
+    }
+
+    if (_currentBatch.empty())
+        return GetNextResult::ReturnStatus::kEOF;
+
+    // Hand out the documents we have already buffered rather than reading further ahead.
+    const auto end = _currentBatch.begin() + std::min(maxBatchSize, _currentBatch.size());
+    std::move(_currentBatch.begin(), end, std::back_inserter(*batch));
+    _currentBatch.erase(_currentBatch.begin(), end);
+    return GetNextResult::ReturnStatus::kAdvanced;
+}
+
 Document DocumentSourceCursor::transformBSONObjToDocument(const BSONObj& obj) const {
     return _dependencies ? _dependencies->extractFields(obj) : Document::fromBsonWithMetaData(obj);
 }
@@ -48,6 +48,16 @@ class DocumentSourceCursor : public DocumentSource {
 public:
     // virtuals from DocumentSource
     GetNextResult getNext() final;
+    GetNextResult::ReturnStatus getNextBatch(std::vector<Document>* batch,
+                                             size_t maxBatchSize) final;
+
+    /**
+     * Results are handed out a batch at a time unless we are tracking the latest oplog timestamp,
+     * which must be observed as each document is consumed.
+     */
+    bool canProduceBatches() const final {
+        return !_trackOplogTS;
+    }
 
     const char* getSourceName() const override;
 
@@ -135,6 +135,10 @@ const char* DocumentSourceGroup::getSourceName() const {
 DocumentSource::GetNextResult DocumentSourceGroup::getNext() {
     pExpCtx->checkForInterrupt();
 
+    if (_streaming) {
+        return getNextStreaming();
+    }
+
     if (!_initialized) {
         const auto initializationResult = initialize();
         if (initializationResult.isPaused()) {
@@ -201,10 +205,91 @@ DocumentSource::GetNextResult DocumentSourceGroup::getNextStandard() {
     return std::move(out);
 }
 
+DocumentSource::GetNextResult DocumentSourceGroup::getNextStreaming() {
+    // Our input is sorted on the group key, so we only need to read until the sort key changes to
+    // know that the groups we are holding are complete.
+    while (_completedGroups.empty()) {
+        if (_streamingEOF) {
+            return GetNextResult::makeEOF();
+        }
+
+        auto input = pSource->getNext();
+        if (input.isPaused()) {
+            return input;
+        } else if (input.isEOF()) {
+            completeStreamingGroups();
+            _streamingEOF = true;
+            continue;
+        }
+
+        auto rootDocument = input.releaseDocument();
+        Value id = computeId(rootDocument);
+        if (!isStreamableId(id)) {
+            // Groups which are still open may have more documents later in the input, but every
+            // group we have already returned is complete. Hash the rest of the input along with the
+            // open groups.
+            _streaming = false;
+            accumulate(id, rootDocument);
+            return getNext();
+        }
+
+        Value sortKey = computeStreamingSortKey(id);
+        if (!_groups->empty() &&
+            pExpCtx->getValueComparator().evaluate(sortKey != _currentStreamingSortKey)) {
+            completeStreamingGroups();
+        }
+        _currentStreamingSortKey = std::move(sortKey);
+        accumulate(id, rootDocument);
+    }
+
+    Document out = std::move(_completedGroups.front());
+    _completedGroups.pop_front();
+    if (_completedGroups.empty() && _streamingEOF) {
+        dispose();
+    }
+    return std::move(out);
+}
+
+bool DocumentSourceGroup::isStreamableId(const Value& id) const {
+    const auto isStreamable = [](const Value& value) {
+        return value.getType() != BSONType::Array && value.getType() != BSONType::Undefined;
+    };
+
+    if (_idExpressions.size() == 1) {
+        return isStreamable(id);
+    }
+    const auto& components = id.getArray();
+    return std::all_of(components.begin(), components.end(), isStreamable);
+}
+
+Value DocumentSourceGroup::computeStreamingSortKey(const Value& id) const {
+    // A single group key has already had missing replaced with null by computeId().
+    if (_idExpressions.size() == 1) {
+        return id;
+    }
+
+    vector<Value> sortKey = id.getArray();
+    for (auto&& component : sortKey) {
+        if (component.missing()) {
+            component = Value(BSONNULL);
+        }
+    }
+    return Value(std::move(sortKey));
+}
+
+void DocumentSourceGroup::completeStreamingGroups() {
+    for (auto&& group : *_groups) {
+        _completedGroups.push_back(makeDocument(group.first, group.second, pExpCtx->needsMerge));
+    }
+    _groups->clear();
+    _memoryUsageBytes = 0;
+}
+
 void DocumentSourceGroup::doDispose() {
     // Free our resources.
     _groups = pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>();
     _sorterIterator.reset();
+    _completedGroups.clear();
 
     // Make us look done.
     groupsIterator = _groups->end();
@@ -256,6 +341,10 @@ Value DocumentSourceGroup::serialize(boost::optional<ExplainOptions::Verbosity>
         insides["$doingMerge"] = Value(true);
     }
 
+    if (explain && _streaming) {
+        insides["$streaming"] = Value(true);
+    }
+
     return Value(DOC(getSourceName() << insides.freeze()));
 }
 
@@ -468,38 +557,7 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
         // iteration. Not releasing could lead to an array copy when this group follows an unwind.
         auto rootDocument = input.releaseDocument();
         Value id = computeId(rootDocument);
-
-        // Look for the _id value in the map. If it's not there, add a new entry with a blank
-        // accumulator. This is done in a somewhat odd way in order to avoid hashing 'id' and
-        // looking it up in '_groups' multiple times.
-        const size_t oldSize = _groups->size();
-        vector<intrusive_ptr<Accumulator>>& group = (*_groups)[id];
-        const bool inserted = _groups->size() != oldSize;
-
-        if (inserted) {
-            _memoryUsageBytes += id.getApproximateSize();
-
-            // Add the accumulators
-            group.reserve(numAccumulators);
-            for (auto&& accumulatedField : _accumulatedFields) {
-                group.push_back(accumulatedField.makeAccumulator(pExpCtx));
-            }
-        } else {
-            for (auto&& groupObj : group) {
-                // subtract old mem usage. New usage added back after processing.
-                _memoryUsageBytes -= groupObj->memUsageForSorter();
-            }
-        }
-
-        /* tickle all the accumulators for the group we found */
-        dassert(numAccumulators == group.size());
-
-        for (size_t i = 0; i < numAccumulators; i++) {
-            group[i]->process(_accumulatedFields[i].expression->evaluate(rootDocument),
-                              _doingMerge);
-
-            _memoryUsageBytes += group[i]->memUsageForSorter();
-        }
+        const bool inserted = accumulate(id, rootDocument);
 
         if (kDebugBuild && !storageGlobalParams.readOnly) {
             // In debug mode, spill every time we have a duplicate id to stress merge logic.
@@ -560,6 +618,43 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
     MONGO_UNREACHABLE;
 }
 
+bool DocumentSourceGroup::accumulate(const Value& id, const Document& root) {
+    const size_t numAccumulators = _accumulatedFields.size();
+
+    // Look for the _id value in the map. If it's not there, add a new entry with a blank
+    // accumulator. This is done in a somewhat odd way in order to avoid hashing 'id' and looking it
+    // up in '_groups' multiple times.
+    const size_t oldSize = _groups->size();
+    vector<intrusive_ptr<Accumulator>>& group = (*_groups)[id];
+    const bool inserted = _groups->size() != oldSize;
+
+    if (inserted) {
+        _memoryUsageBytes += id.getApproximateSize();
+
+        // Add the accumulators
+        group.reserve(numAccumulators);
+        for (auto&& accumulatedField : _accumulatedFields) {
+            group.push_back(accumulatedField.makeAccumulator(pExpCtx));
+        }
+    } else {
+        for (auto&& groupObj : group) {
+            // subtract old mem usage. New usage added back after processing.
+            _memoryUsageBytes -= groupObj->memUsageForSorter();
+        }
+    }
+
+    /* tickle all the accumulators for the group we found */
+    dassert(numAccumulators == group.size());
+
+    for (size_t i = 0; i < numAccumulators; i++) {
+        group[i]->process(_accumulatedFields[i].expression->evaluate(root), _doingMerge);
+
+        _memoryUsageBytes += group[i]->memUsageForSorter();
+    }
+
+    return inserted;
+}
+
 bool DocumentSourceGroup::usedDisk() {
     return _usedDisk;
 }
@@ -725,6 +820,50 @@ bool DocumentSourceGroup::canRunInParallelBeforeOut(
     return true;
 }
 
+BSONObj DocumentSourceGroup::getStreamingSortPattern() const {
+    BSONObjBuilder sortPattern;
+    std::set<std::string> paths;
+    for (auto&& idExpression : _idExpressions) {
+        auto fieldPathExpr = dynamic_cast<ExpressionFieldPath*>(idExpression.get());
+        if (!fieldPathExpr || !fieldPathExpr->isRootFieldPath() ||
+            fieldPathExpr->getFieldPath().getPathLength() == 1) {
+            // The group key must be made of paths within the input document.
+            return BSONObj();
+        }
+
+        auto path = fieldPathExpr->getFieldPath().tail().fullPath();
+        if (!paths.insert(path).second) {
+            return BSONObj();
+        }
+        sortPattern.append(path, 1);
+    }
+    return sortPattern.obj();
+}
+
+bool DocumentSourceGroup::canStreamWithSortPattern(const BSONObj& sortPattern) const {
+    std::set<std::string> groupPaths;
+    for (auto&& elem : getStreamingSortPattern()) {
+        groupPaths.insert(elem.fieldName());
+    }
+    if (groupPaths.empty()) {
+        return false;
+    }
+
+    // The sort may have trailing fields which are not part of the group key, since those only
+    // order documents within a group.
+    BSONObjIterator sortIt(sortPattern);
+    while (!groupPaths.empty()) {
+        if (!sortIt.more()) {
+            return false;
+        }
+        auto elem = sortIt.next();
+        if (!elem.isNumber() || groupPaths.erase(elem.fieldName()) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
 std::unique_ptr<GroupFromFirstDocumentTransformation>
 DocumentSourceGroup::rewriteGroupAsTransformOnFirstDocument() const {
     if (!_idFieldNames.empty()) {
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <deque>
 #include <memory>
 #include <utility>
 
@@ -151,6 +152,34 @@ public:
         _doingMerge = doingMerge;
     }
 
+    /**
+     * Returns the sort pattern on which this stage's input must be ordered for it to run in
+     * streaming mode, or an empty object if the group key is not a set of distinct field paths.
+     * The pattern lists the group key fields in the order they appear in the _id, all ascending.
+     */
+    BSONObj getStreamingSortPattern() const;
+
+    /**
+     * Returns true if input ordered by 'sortPattern' keeps all documents with the same group key
+     * together, i.e. if the leading fields of 'sortPattern' are exactly the group key fields, in
+     * any order and direction.
+     */
+    bool canStreamWithSortPattern(const BSONObj& sortPattern) const;
+
+    /**
+     * Tells this stage that its input is sorted such that canStreamWithSortPattern() holds. A
+     * streaming $group outputs each group as soon as a document with a different group key
+     * arrives, so it only holds one group in memory at a time. Must be called before getNext().
+     */
+    void setStreaming(bool streaming) {
+        invariant(!_initialized);
+        _streaming = streaming;
+    }
+
+    bool isStreaming() const {
+        return _streaming;
+    }
+
     /**
      * Returns true if this $group stage used disk during execution and false otherwise.
      */
@@ -188,6 +217,7 @@ private:
      */
     GetNextResult getNextSpilled();
     GetNextResult getNextStandard();
+    GetNextResult getNextStreaming();
 
     /**
      * Before returning anything, this source must prepare itself. In a streaming $group,
@@ -208,6 +238,31 @@ private:
      */
     std::shared_ptr<Sorter<Value, Value>::Iterator> spill();
 
+    /**
+     * Feeds 'root' to the accumulators of the group identified by 'id', creating the group in
+     * '_groups' if it does not exist yet. Returns true if a new group was created.
+     */
+    bool accumulate(const Value& id, const Document& root);
+
+    /**
+     * Returns true if documents with group key 'id' can be grouped by a streaming $group. An
+     * array or undefined anywhere in the key does not sort the same way it groups, so we fall
+     * back to hashing when we see one.
+     */
+    bool isStreamableId(const Value& id) const;
+
+    /**
+     * Returns the key on which a sorted input orders the group 'id', which treats missing fields
+     * as null. Groups whose keys differ only in missing versus null fields are interleaved in the
+     * input, so a streaming $group must keep all of them open at once.
+     */
+    Value computeStreamingSortKey(const Value& id) const;
+
+    /**
+     * Moves every group in '_groups' into '_completedGroups' as an output document.
+     */
+    void completeStreamingGroups();
+
     Document makeDocument(const Value& id, const Accumulators& accums, bool mergeableOutput);
 
     /**
@@ -241,6 +296,13 @@ private:
 
     bool _initialized;
 
+    // When streaming, '_groups' only holds the groups whose streaming sort key equals
+    // '_currentStreamingSortKey'. They are moved to '_completedGroups' when the sort key changes.
+    bool _streaming = false;
+    bool _streamingEOF = false;
+    Value _currentStreamingSortKey;
+    std::deque<Document> _completedGroups;
+
     Value _currentId;
     Accumulators _currentAccumulators;
 
@@ -228,6 +228,157 @@ TEST_F(DocumentSourceGroupTest, ShouldNotReportDottedGroupKeyAsARename) {
     ASSERT_EQ(modifiedPathsRet.renames.size(), 0UL);
 }
 
+intrusive_ptr<DocumentSourceGroup> makeStreamingCountGroup(
+    const intrusive_ptr<ExpressionContext>& expCtx,
+    const intrusive_ptr<Expression>& groupByExpression) {
+    AccumulationStatement countStatement{"count",
+                                         ExpressionConstant::create(expCtx, Value(1)),
+                                         AccumulationStatement::getFactory("$sum")};
+    auto group = DocumentSourceGroup::create(expCtx, groupByExpression, {countStatement});
+    group->setStreaming(true);
+    return group;
+}
+
+TEST_F(DocumentSourceGroupTest, StreamingGroupShouldReturnEachGroupOnceItsKeyChanges) {
+    auto expCtx = getExpCtx();
+    VariablesParseState vps = expCtx->variablesParseState;
+    auto group = makeStreamingCountGroup(expCtx, ExpressionFieldPath::parse(expCtx, "$a", vps));
+    auto mock = DocumentSourceMock::create(
+        {"{a: 1}", "{a: 1}", "{a: 2}", "{a: 2}", "{a: 2}", "{a: 3}", "{b: 1}"});
+    group->setSource(mock.get());
+
+    // The first group is complete as soon as we see the first document of the second group.
+    auto result = group->getNext();
+    ASSERT_TRUE(result.isAdvanced());
+    ASSERT_DOCUMENT_EQ(result.releaseDocument(), (Document{{"_id", 1}, {"count", 2}}));
+    ASSERT_EQ(mock->queue.size(), 4UL);
+
+    result = group->getNext();
+    ASSERT_TRUE(result.isAdvanced());
+    ASSERT_DOCUMENT_EQ(result.releaseDocument(), (Document{{"_id", 2}, {"count", 3}}));
+
+    result = group->getNext();
+    ASSERT_TRUE(result.isAdvanced());
+    ASSERT_DOCUMENT_EQ(result.releaseDocument(), (Document{{"_id", 3}, {"count", 1}}));
+
+    result = group->getNext();
+    ASSERT_TRUE(result.isAdvanced());
+    ASSERT_DOCUMENT_EQ(result.releaseDocument(), (Document{{"_id", BSONNULL}, {"count", 1}}));
+
+    ASSERT_TRUE(group->getNext().isEOF());
+    ASSERT_TRUE(group->getNext().isEOF());
+}
+
+TEST_F(DocumentSourceGroupTest, StreamingGroupShouldPropagatePauses) {
+    auto expCtx = getExpCtx();
+    VariablesParseState vps = expCtx->variablesParseState;
+    auto group = makeStreamingCountGroup(expCtx, ExpressionFieldPath::parse(expCtx, "$a", vps));
+    auto mock = DocumentSourceMock::create({Document{{"a", 1}},
+                                            DocumentSource::GetNextResult::makePauseExecution(),
+                                            Document{{"a", 1}},
+                                            Document{{"a", 2}}});
+    group->setSource(mock.get());
+
+    ASSERT_TRUE(group->getNext().isPaused());
+
+    auto result = group->getNext();
+    ASSERT_TRUE(result.isAdvanced());
+    ASSERT_DOCUMENT_EQ(result.releaseDocument(), (Document{{"_id", 1}, {"count", 2}}));
+
+    result = group->getNext();
+    ASSERT_TRUE(result.isAdvanced());
+    ASSERT_DOCUMENT_EQ(result.releaseDocument(), (Document{{"_id", 2}, {"count", 1}}));
+    ASSERT_TRUE(group->getNext().isEOF());
+}
+
+TEST_F(DocumentSourceGroupTest, StreamingGroupShouldKeepGroupsDifferingInNullAndMissingOpen) {
+    auto expCtx = getExpCtx();
+    VariablesParseState vps = expCtx->variablesParseState;
+    auto x = ExpressionFieldPath::parse(expCtx, "$x", vps);
+    auto y = ExpressionFieldPath::parse(expCtx, "$y", vps);
+    auto group =
+        makeStreamingCountGroup(expCtx, ExpressionObject::create(expCtx, {{"x", x}, {"y", y}}));
+
+    // An index on {x: 1, y: 1} puts null and missing values of 'x' together, in any order.
+    auto mock = DocumentSourceMock::create(
+        {"{x: null, y: 1}", "{y: 1}", "{x: null, y: 1}", "{x: 1, y: 1}", "{x: 1, y: 1}"});
+    group->setSource(mock.get());
+
+    std::map<std::string, int> counts;
+    for (auto result = group->getNext(); result.isAdvanced(); result = group->getNext()) {
+        auto doc = result.releaseDocument();
+        counts[doc["_id"].toString()] = doc["count"].getInt();
+    }
+
+    ASSERT_EQ(counts.size(), 3UL);
+    ASSERT_EQ(counts[Value(Document{{"x", BSONNULL}, {"y", 1}}).toString()], 2);
+    ASSERT_EQ(counts[Value(Document{{"y", 1}}).toString()], 1);
+    ASSERT_EQ(counts[Value(Document{{"x", 1}, {"y", 1}}).toString()], 2);
+}
+
+TEST_F(DocumentSourceGroupTest, StreamingGroupShouldFallBackToHashingWhenKeyIsAnArray) {
+    auto expCtx = getExpCtx();
+    expCtx->inMongos = true;  // Disallow external sort.
+                              // This is the only way to do this in a debug build.
+    VariablesParseState vps = expCtx->variablesParseState;
+    auto group = makeStreamingCountGroup(expCtx, ExpressionFieldPath::parse(expCtx, "$a", vps));
+
+    // A multikey index does not keep documents with equal arrays together.
+    auto mock = DocumentSourceMock::create(
+        {"{a: 0}", "{a: 1}", "{a: [1, 2]}", "{a: 1}", "{a: [1, 2]}", "{a: 2}"});
+    group->setSource(mock.get());
+
+    // The first group is complete before we see an array.
+    auto result = group->getNext();
+    ASSERT_TRUE(result.isAdvanced());
+    ASSERT_DOCUMENT_EQ(result.releaseDocument(), (Document{{"_id", 0}, {"count", 1}}));
+
+    std::map<std::string, int> counts;
+    for (result = group->getNext(); result.isAdvanced(); result = group->getNext()) {
+        auto doc = result.releaseDocument();
+        counts[doc["_id"].toString()] = doc["count"].getInt();
+    }
+    ASSERT_FALSE(group->isStreaming());
+    ASSERT_EQ(counts.size(), 3UL);
+    ASSERT_EQ(counts[Value(1).toString()], 2);
+    ASSERT_EQ(counts[Value(BSON_ARRAY(1 << 2)).toString()], 2);
+    ASSERT_EQ(counts[Value(2).toString()], 1);
+}
+
+TEST_F(DocumentSourceGroupTest, StreamingSortPatternShouldListGroupKeyFields) {
+    auto expCtx = getExpCtx();
+    VariablesParseState vps = expCtx->variablesParseState;
+    auto x = ExpressionFieldPath::parse(expCtx, "$x", vps);
+    auto yz = ExpressionFieldPath::parse(expCtx, "$y.z", vps);
+    auto group = DocumentSourceGroup::create(
+        expCtx, ExpressionObject::create(expCtx, {{"a", x}, {"b", yz}}), {});
+
+    ASSERT_BSONOBJ_EQ(group->getStreamingSortPattern(), BSON("x" << 1 << "y.z" << 1));
+    ASSERT_TRUE(group->canStreamWithSortPattern(BSON("x" << 1 << "y.z" << 1)));
+    ASSERT_TRUE(group->canStreamWithSortPattern(BSON("y.z" << -1 << "x" << 1 << "w" << 1)));
+    ASSERT_FALSE(group->canStreamWithSortPattern(BSON("x" << 1)));
+    ASSERT_FALSE(group->canStreamWithSortPattern(BSON("x" << 1 << "w" << 1 << "y.z" << 1)));
+}
+
+TEST_F(DocumentSourceGroupTest, StreamingSortPatternShouldBeEmptyUnlessGroupingByFieldPaths) {
+    auto expCtx = getExpCtx();
+    VariablesParseState vps = expCtx->variablesParseState;
+
+    auto constantGroup =
+        DocumentSourceGroup::create(expCtx, ExpressionConstant::create(expCtx, Value(1)), {});
+    ASSERT_BSONOBJ_EQ(constantGroup->getStreamingSortPattern(), BSONObj());
+    ASSERT_FALSE(constantGroup->canStreamWithSortPattern(BSON("a" << 1)));
+
+    auto rootGroup =
+        DocumentSourceGroup::create(expCtx, ExpressionFieldPath::parse(expCtx, "$$ROOT", vps), {});
+    ASSERT_BSONOBJ_EQ(rootGroup->getStreamingSortPattern(), BSONObj());
+
+    auto x = ExpressionFieldPath::parse(expCtx, "$x", vps);
+    auto duplicateGroup = DocumentSourceGroup::create(
+        expCtx, ExpressionObject::create(expCtx, {{"a", x}, {"b", x}}), {});
+    ASSERT_BSONOBJ_EQ(duplicateGroup->getStreamingSortPattern(), BSONObj());
+}
+
 BSONObj toBson(const intrusive_ptr<DocumentSource>& source) {
     vector<Value> arr;
     source->serializeToArray(arr);
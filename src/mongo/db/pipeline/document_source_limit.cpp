@@ -84,6 +84,26 @@ DocumentSource::GetNextResult DocumentSourceLimit::getNext() {
     return nextInput;
 }
 
+DocumentSource::GetNextResult::ReturnStatus DocumentSourceLimit::getNextBatch(
+    std::vector<Document>* batch, size_t maxBatchSize) {
+    pExpCtx->checkForInterrupt();
+
+    if (_nReturned >= _limit) {
+        return GetNextResult::ReturnStatus::kEOF;
+    }
+
+    // Never ask our source for more documents than we are going to return.
+    const auto remaining = static_cast<unsigned long long>(_limit - _nReturned);
+    auto status =
+        pSource->getNextBatch(batch, std::min<unsigned long long>(maxBatchSize, remaining));
+    _nReturned += batch->size();
+    if (_nReturned >= _limit) {
+        dispose();
+    }
+
+    return status;
+}
+
 Value DocumentSourceLimit::serialize(boost::optional<ExplainOptions::Verbosity> explain) const {
     return Value(Document{{getSourceName(), _limit}});
 }
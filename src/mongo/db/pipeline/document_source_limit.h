@@ -59,6 +59,11 @@ public:
     }
 
     GetNextResult getNext() final;
+    GetNextResult::ReturnStatus getNextBatch(std::vector<Document>* batch,
+                                             size_t maxBatchSize) final;
+    bool canProduceBatches() const final {
+        return true;
+    }
     const char* getSourceName() const final {
         return kStageName.rawData();
     }
@@ -141,5 +141,30 @@ TEST_F(DocumentSourceLimitTest, ShouldPropagatePauses) {
     ASSERT_TRUE(limit->getNext().isEOF());
 }
 
+TEST_F(DocumentSourceLimitTest, GetNextBatchShouldNotRequestMoreThanTheLimit) {
+    auto limit = DocumentSourceLimit::create(getExpCtx(), 3);
+    auto mock = DocumentSourceMock::create({"{a: 1}", "{a: 2}", "{a: 3}", "{a: 4}"});
+    limit->setSource(mock.get());
+
+    std::vector<Document> batch;
+    ASSERT(limit->getNextBatch(&batch, 2) ==
+           DocumentSource::GetNextResult::ReturnStatus::kAdvanced);
+    ASSERT_EQ(2U, batch.size());
+    ASSERT_FALSE(mock->isDisposed);
+
+    batch.clear();
+    ASSERT(limit->getNextBatch(&batch, 2) ==
+           DocumentSource::GetNextResult::ReturnStatus::kAdvanced);
+    ASSERT_EQ(1U, batch.size());
+    ASSERT_VALUE_EQ(Value(3), batch[0].getField("a"));
+
+    // We've reached the limit, and the fourth document was never pulled from the source.
+    ASSERT_TRUE(mock->isDisposed);
+    ASSERT_EQ(1U, mock->queue.size());
+    batch.clear();
+    ASSERT(limit->getNextBatch(&batch, 2) == DocumentSource::GetNextResult::ReturnStatus::kEOF);
+    ASSERT_TRUE(batch.empty());
+}
+
 }  // namespace
 }  // namespace mongo
@@ -87,14 +87,7 @@ DocumentSource::GetNextResult DocumentSourceMatch::getNext() {
 
     auto nextInput = pSource->getNext();
     for (; nextInput.isAdvanced(); nextInput = pSource->getNext()) {
-        // MatchExpression only takes BSON documents, so we have to make one. As an optimization,
-        // only serialize the fields we need to do the match.
-        BSONObj toMatch = _dependencies.needWholeDocument
-            ? nextInput.getDocument().toBson()
-            : document_path_support::documentToBsonWithPaths(nextInput.getDocument(),
-                                                             _dependencies.fields);
-
-        if (_expression->matchesBSON(toMatch)) {
+        if (documentMatches(nextInput.getDocument())) {
             return nextInput;
         }
 
@@ -109,6 +102,39 @@ DocumentSource::GetNextResult DocumentSourceMatch::getNext() {
     return nextInput;
 }
 
+DocumentSource::GetNextResult::ReturnStatus DocumentSourceMatch::getNextBatch(
+    std::vector<Document>* batch, size_t maxBatchSize) {
+    pExpCtx->checkForInterrupt();
+
+    // The user facing error should have been generated earlier.
+    massert(51158,
+            "Should never call getNextBatch on a $match stage with $text clause",
+            !_isTextQuery);
+
+    // Keep pulling batches until at least one document passes the filter, so that callers never
+    // see an empty kAdvanced batch. Documents which don't match are released as soon as the batch
+    // has been filtered.
+    while (true) {
+        auto status = pSource->getNextBatch(batch, maxBatchSize);
+        batch->erase(std::remove_if(batch->begin(),
+                                    batch->end(),
+                                    [this](const Document& doc) { return !documentMatches(doc); }),
+                     batch->end());
+        if (!batch->empty() || status != GetNextResult::ReturnStatus::kAdvanced) {
+            return status;
+        }
+    }
+}
+
+bool DocumentSourceMatch::documentMatches(const Document& doc) const {
+    // MatchExpression only takes BSON documents, so we have to make one. As an optimization, only
+    // serialize the fields we need to do the match.
+    BSONObj toMatch = _dependencies.needWholeDocument
+        ? doc.toBson()
+        : document_path_support::documentToBsonWithPaths(doc, _dependencies.fields);
+    return _expression->matchesBSON(toMatch);
+}
+
 Pipeline::SourceContainer::iterator DocumentSourceMatch::doOptimizeAt(
     Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) {
     invariant(*itr == this);
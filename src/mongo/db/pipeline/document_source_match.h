@@ -43,6 +43,12 @@ public:
     virtual ~DocumentSourceMatch() = default;
 
     GetNextResult getNext() override;
+    GetNextResult::ReturnStatus getNextBatch(std::vector<Document>* batch,
+                                             size_t maxBatchSize) override;
+
+    bool canProduceBatches() const override {
+        return true;
+    }
 
     boost::intrusive_ptr<DocumentSource> optimize() final;
 
@@ -169,6 +175,11 @@ protected:
     BSONObj _predicate;
 
 private:
+    /**
+     * Returns true if 'doc' matches this stage's predicate.
+     */
+    bool documentMatches(const Document& doc) const;
+
     std::unique_ptr<MatchExpression> _expression;
 
     const bool _isTextQuery;
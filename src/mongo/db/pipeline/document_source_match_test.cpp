@@ -498,6 +498,41 @@ TEST_F(DocumentSourceMatchTest, ShouldPropagatePauses) {
     ASSERT_TRUE(match->getNext().isEOF());
 }
 
+TEST_F(DocumentSourceMatchTest, GetNextBatchShouldFilterBatchesAndPropagatePauses) {
+    auto match = DocumentSourceMatch::create(BSON("a" << 1), getExpCtx());
+    auto mock = DocumentSourceMock::create({Document{{"a", 1}, {"b", 1}},
+                                            Document{{"a", 2}, {"b", 2}},
+                                            Document{{"a", 1}, {"b", 3}},
+                                            DocumentSource::GetNextResult::makePauseExecution(),
+                                            Document{{"a", 2}},
+                                            Document{{"a", 2}},
+                                            Document{{"a", 1}, {"b", 4}}});
+    match->setSource(mock.get());
+
+    std::vector<Document> batch;
+    ASSERT(match->getNextBatch(&batch, 2) ==
+           DocumentSource::GetNextResult::ReturnStatus::kAdvanced);
+    ASSERT_EQ(1U, batch.size());
+    ASSERT_DOCUMENT_EQ(batch[0], (Document{{"a", 1}, {"b", 1}}));
+
+    // The batch is cut short by the pause, but the matching document which preceded it is kept.
+    batch.clear();
+    ASSERT(match->getNextBatch(&batch, 2) ==
+           DocumentSource::GetNextResult::ReturnStatus::kPauseExecution);
+    ASSERT_EQ(1U, batch.size());
+    ASSERT_DOCUMENT_EQ(batch[0], (Document{{"a", 1}, {"b", 3}}));
+
+    // A batch in which nothing matches is skipped over rather than returned empty.
+    batch.clear();
+    ASSERT(match->getNextBatch(&batch, 2) == DocumentSource::GetNextResult::ReturnStatus::kEOF);
+    ASSERT_EQ(1U, batch.size());
+    ASSERT_DOCUMENT_EQ(batch[0], (Document{{"a", 1}, {"b", 4}}));
+
+    batch.clear();
+    ASSERT(match->getNextBatch(&batch, 2) == DocumentSource::GetNextResult::ReturnStatus::kEOF);
+    ASSERT_TRUE(batch.empty());
+}
+
 TEST_F(DocumentSourceMatchTest, ShouldCorrectlyJoinWithSubsequentMatch) {
     const auto match = DocumentSourceMatch::create(BSON("a" << 1), getExpCtx());
     const auto secondMatch = DocumentSourceMatch::create(BSON("b" << 1), getExpCtx());
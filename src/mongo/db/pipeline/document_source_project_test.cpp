@@ -74,6 +74,24 @@ TEST_F(ProjectStageTest, InclusionProjectionShouldRemoveUnspecifiedFields) {
     ASSERT_EQUALS(1, next.getDocument()["c"]["d"].getInt());
 }
 
+TEST_F(ProjectStageTest, GetNextBatchShouldTransformEachDocumentInTheBatch) {
+    auto project = DocumentSourceProject::create(BSON("_id" << false << "a" << true), getExpCtx());
+    auto source = DocumentSourceMock::create({"{a: 1, b: 1}", "{a: 2, b: 2}", "{a: 3, b: 3}"});
+    project->setSource(source.get());
+
+    vector<Document> batch;
+    ASSERT(project->getNextBatch(&batch, 2) ==
+           DocumentSource::GetNextResult::ReturnStatus::kAdvanced);
+    ASSERT_EQUALS(2U, batch.size());
+    ASSERT_DOCUMENT_EQ(batch[0], (Document{{"a", 1}}));
+    ASSERT_DOCUMENT_EQ(batch[1], (Document{{"a", 2}}));
+
+    batch.clear();
+    ASSERT(project->getNextBatch(&batch, 2) == DocumentSource::GetNextResult::ReturnStatus::kEOF);
+    ASSERT_EQUALS(1U, batch.size());
+    ASSERT_DOCUMENT_EQ(batch[0], (Document{{"a", 3}}));
+}
+
 TEST_F(ProjectStageTest, ShouldOptimizeInnerExpressions) {
     auto project = DocumentSourceProject::create(
         BSON("a" << BSON("$and" << BSON_ARRAY(BSON("$const" << true)))), getExpCtx());
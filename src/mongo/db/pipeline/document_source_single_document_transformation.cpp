@@ -70,6 +70,22 @@ DocumentSource::GetNextResult DocumentSourceSingleDocumentTransformation::getNex
     return _parsedTransform->applyTransformation(input.releaseDocument());
 }
 
+DocumentSource::GetNextResult::ReturnStatus
+DocumentSourceSingleDocumentTransformation::getNextBatch(std::vector<Document>* batch,
+                                                         size_t maxBatchSize) {
+    pExpCtx->checkForInterrupt();
+
+    auto status = pSource->getNextBatch(batch, maxBatchSize);
+
+    // Replace each input with its transformed output in place. Each input is released as soon as
+    // it has been overwritten.
+    for (auto&& doc : *batch) {
+        doc = _parsedTransform->applyTransformation(doc);
+    }
+
+    return status;
+}
+
 intrusive_ptr<DocumentSource> DocumentSourceSingleDocumentTransformation::optimize() {
     _parsedTransform->optimize();
     return this;
@@ -51,6 +51,11 @@ public:
     // virtuals from DocumentSource
     const char* getSourceName() const final;
     GetNextResult getNext() final;
+    GetNextResult::ReturnStatus getNextBatch(std::vector<Document>* batch,
+                                             size_t maxBatchSize) final;
+    bool canProduceBatches() const final {
+        return true;
+    }
     boost::intrusive_ptr<DocumentSource> optimize() final;
     Value serialize(boost::optional<ExplainOptions::Verbosity> explain = boost::none) const final;
     DepsTracker::State getDependencies(DepsTracker* deps) const final;
@@ -72,6 +72,25 @@ DocumentSource::GetNextResult DocumentSourceSkip::getNext() {
     return pSource->getNext();
 }
 
+DocumentSource::GetNextResult::ReturnStatus DocumentSourceSkip::getNextBatch(
+    std::vector<Document>* batch, size_t maxBatchSize) {
+    pExpCtx->checkForInterrupt();
+
+    while (true) {
+        auto status = pSource->getNextBatch(batch, maxBatchSize);
+        if (_nSkippedSoFar < _nToSkip) {
+            const auto toSkip =
+                std::min(static_cast<size_t>(_nToSkip - _nSkippedSoFar), batch->size());
+            batch->erase(batch->begin(), batch->begin() + toSkip);
+            _nSkippedSoFar += toSkip;
+        }
+
+        if (!batch->empty() || status != GetNextResult::ReturnStatus::kAdvanced) {
+            return status;
+        }
+    }
+}
+
 Value DocumentSourceSkip::serialize(boost::optional<ExplainOptions::Verbosity> explain) const {
     return Value(DOC(getSourceName() << _nToSkip));
 }
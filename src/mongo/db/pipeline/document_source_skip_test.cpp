@@ -66,6 +66,23 @@ TEST_F(DocumentSourceSkipTest, ShouldPropagatePauses) {
     ASSERT_TRUE(skip->getNext().isEOF());
 }
 
+TEST_F(DocumentSourceSkipTest, GetNextBatchShouldSkipAcrossBatches) {
+    auto skip = DocumentSourceSkip::create(getExpCtx(), 3);
+    auto mock = DocumentSourceMock::create({"{a: 1}", "{a: 2}", "{a: 3}", "{a: 4}", "{a: 5}"});
+    skip->setSource(mock.get());
+
+    // The first batch is skipped entirely, so a second one is requested.
+    std::vector<Document> batch;
+    ASSERT(skip->getNextBatch(&batch, 2) == DocumentSource::GetNextResult::ReturnStatus::kAdvanced);
+    ASSERT_EQ(1U, batch.size());
+    ASSERT_VALUE_EQ(Value(4), batch[0].getField("a"));
+
+    batch.clear();
+    ASSERT(skip->getNextBatch(&batch, 2) == DocumentSource::GetNextResult::ReturnStatus::kEOF);
+    ASSERT_EQ(1U, batch.size());
+    ASSERT_VALUE_EQ(Value(5), batch[0].getField("a"));
+}
+
 TEST_F(DocumentSourceSkipTest, SkipsChainedTogetherShouldNotOverFlowWhenOptimizing) {
     // $skip should not optimize if combining the two values of skips would overflow a long long.
     auto skipShort = DocumentSourceSkip::create(getExpCtx(), 1);
@@ -265,7 +265,45 @@ const char* ExpressionAbs::getOpName() const {
 
 /* ------------------------- ExpressionAdd ----------------------------- */
 
-Value ExpressionAdd::evaluate(const Document& root) const {
+namespace {
+
+/**
+ * Adds two numbers of the same type, for the common case of a binary $add over ints, longs, or
+ * doubles. This produces the same result as the general $add path without the bookkeeping it needs
+ * to handle any number of operands of mixed types. Returns boost::none if the general path must be
+ * used instead.
+ */
+boost::optional<Value> addSameTypeNumbers(const Value& lhs, const Value& rhs) {
+    if (lhs.getType() != rhs.getType()) {
+        return boost::none;
+    }
+
+    switch (lhs.getType()) {
+        case NumberInt:
+            return Value::createIntOrLong(static_cast<long long>(lhs.getInt()) + rhs.getInt());
+        case NumberLong: {
+            long long sum;
+            if (mongoSignedAddOverflow64(lhs.getLong(), rhs.getLong(), &sum)) {
+                // Let the general path round the exact sum to a double.
+                return boost::none;
+            }
+            return Value(sum);
+        }
+        case NumberDouble:
+            // The compensated sum of the general path starts at 0.0, which matters for the sign of
+            // a zero result.
+            return Value((0.0 + lhs.getDouble()) + rhs.getDouble());
+        default:
+            return boost::none;
+    }
+}
+
+/**
+ * The general $add path. 'getOperand(i)' returns the value of operand i, for i in [0, n). Operands
+ * are requested in order, and evaluation stops early if an operand is nullish.
+ */
+template <typename GetOperand>
+Value addOperands(size_t n, GetOperand getOperand) {
     // We'll try to return the narrowest possible result value while avoiding overflow, loss
     // of precision due to intermediate rounding or implicit use of decimal types. To do that,
     // compute a compensated sum for non-decimal values and a separate decimal sum for decimal
@@ -275,9 +313,8 @@ Value ExpressionAdd::evaluate(const Document& root) const {
     BSONType totalType = NumberInt;
     bool haveDate = false;
 
-    const size_t n = vpOperand.size();
     for (size_t i = 0; i < n; ++i) {
-        Value val = vpOperand[i]->evaluate(root);
+        Value val = getOperand(i);
 
         switch (val.getType()) {
             case NumberDecimal:
@@ -340,6 +377,27 @@ Value ExpressionAdd::evaluate(const Document& root) const {
     }
 }
 
+}  // namespace
+
+Value ExpressionAdd::evaluate(const Document& root) const {
+    if (vpOperand.size() == 2) {
+        Value lhs = vpOperand[0]->evaluate(root);
+        if (!lhs.numeric()) {
+            // The general path may not need to evaluate the right hand side at all.
+            return addOperands(
+                2, [&](size_t i) { return i == 0 ? lhs : vpOperand[1]->evaluate(root); });
+        }
+
+        Value rhs = vpOperand[1]->evaluate(root);
+        if (auto sum = addSameTypeNumbers(lhs, rhs)) {
+            return std::move(*sum);
+        }
+        return addOperands(2, [&](size_t i) { return i == 0 ? lhs : rhs; });
+    }
+
+    return addOperands(vpOperand.size(), [&](size_t i) { return vpOperand[i]->evaluate(root); });
+}
+
 REGISTER_EXPRESSION(add, ExpressionAdd::parse);
 const char* ExpressionAdd::getOpName() const {
     return "$add";
@@ -899,6 +957,19 @@ Value ExpressionCond::evaluate(const Document& root) const {
     return vpOperand[idx]->evaluate(root);
 }
 
+intrusive_ptr<Expression> ExpressionCond::optimize() {
+    intrusive_ptr<Expression> optimized = Base::optimize();
+    if (optimized.get() != this) {
+        return optimized;
+    }
+
+    // If the condition is constant, only one of the branches can ever be taken.
+    if (auto constCond = dynamic_cast<ExpressionConstant*>(vpOperand[0].get())) {
+        return vpOperand[constCond->getValue().coerceToBool() ? 1 : 2];
+    }
+    return this;
+}
+
 intrusive_ptr<Expression> ExpressionCond::parse(
     const boost::intrusive_ptr<ExpressionContext>& expCtx,
     BSONElement expr,
@@ -2574,7 +2645,42 @@ const char* ExpressionMod::getOpName() const {
 
 /* ------------------------- ExpressionMultiply ----------------------------- */
 
-Value ExpressionMultiply::evaluate(const Document& root) const {
+namespace {
+
+/**
+ * Multiplies two numbers of the same type, for the common case of a binary $multiply over ints,
+ * longs, or doubles. This produces the same result as the general $multiply path. Returns
+ * boost::none if the general path must be used instead.
+ */
+boost::optional<Value> multiplySameTypeNumbers(const Value& lhs, const Value& rhs) {
+    if (lhs.getType() != rhs.getType()) {
+        return boost::none;
+    }
+
+    switch (lhs.getType()) {
+        case NumberInt:
+            return Value::createIntOrLong(static_cast<long long>(lhs.getInt()) * rhs.getInt());
+        case NumberLong: {
+            long long product;
+            if (mongoSignedMultiplyOverflow64(lhs.getLong(), rhs.getLong(), &product)) {
+                return Value(static_cast<double>(lhs.getLong()) *
+                             static_cast<double>(rhs.getLong()));
+            }
+            return Value(product);
+        }
+        case NumberDouble:
+            return Value(lhs.getDouble() * rhs.getDouble());
+        default:
+            return boost::none;
+    }
+}
+
+/**
+ * The general $multiply path. 'getOperand(i)' returns the value of operand i, for i in [0, n).
+ * Operands are requested in order, and evaluation stops early if an operand is nullish.
+ */
+template <typename GetOperand>
+Value multiplyOperands(size_t n, GetOperand getOperand) {
     /*
       We'll try to return the narrowest possible result value.  To do that
       without creating intermediate Values, do the arithmetic for double
@@ -2587,9 +2693,8 @@ Value ExpressionMultiply::evaluate(const Document& root) const {
 
     BSONType productType = NumberInt;
 
-    const size_t n = vpOperand.size();
     for (size_t i = 0; i < n; ++i) {
-        Value val = vpOperand[i]->evaluate(root);
+        Value val = getOperand(i);
 
         if (val.numeric()) {
             BSONType oldProductType = productType;
@@ -2630,6 +2735,28 @@ Value ExpressionMultiply::evaluate(const Document& root) const {
         massert(16418, "$multiply resulted in a non-numeric type", false);
 }
 
+}  // namespace
+
+Value ExpressionMultiply::evaluate(const Document& root) const {
+    if (vpOperand.size() == 2) {
+        Value lhs = vpOperand[0]->evaluate(root);
+        if (!lhs.numeric()) {
+            // The general path may not need to evaluate the right hand side at all.
+            return multiplyOperands(
+                2, [&](size_t i) { return i == 0 ? lhs : vpOperand[1]->evaluate(root); });
+        }
+
+        Value rhs = vpOperand[1]->evaluate(root);
+        if (auto product = multiplySameTypeNumbers(lhs, rhs)) {
+            return std::move(*product);
+        }
+        return multiplyOperands(2, [&](size_t i) { return i == 0 ? lhs : rhs; });
+    }
+
+    return multiplyOperands(vpOperand.size(),
+                            [&](size_t i) { return vpOperand[i]->evaluate(root); });
+}
+
 REGISTER_EXPRESSION(multiply, ExpressionMultiply::parse);
 const char* ExpressionMultiply::getOpName() const {
     return "$multiply";
@@ -2646,6 +2773,19 @@ Value ExpressionIfNull::evaluate(const Document& root) const {
     return pRight;
 }
 
+intrusive_ptr<Expression> ExpressionIfNull::optimize() {
+    intrusive_ptr<Expression> optimized = ExpressionFixedArity<ExpressionIfNull, 2>::optimize();
+    if (optimized.get() != this) {
+        return optimized;
+    }
+
+    // If the first operand is a constant, we know which of the operands will be returned.
+    if (auto constLeft = dynamic_cast<ExpressionConstant*>(vpOperand[0].get())) {
+        return constLeft->getValue().nullish() ? vpOperand[1] : vpOperand[0];
+    }
+    return this;
+}
+
 REGISTER_EXPRESSION(ifNull, ExpressionIfNull::parse);
 const char* ExpressionIfNull::getOpName() const {
     return "$ifNull";
@@ -910,6 +910,7 @@ public:
     explicit ExpressionCond(const boost::intrusive_ptr<ExpressionContext>& expCtx) : Base(expCtx) {}
 
     Value evaluate(const Document& root) const final;
+    boost::intrusive_ptr<Expression> optimize() final;
     const char* getOpName() const final;
 
     static boost::intrusive_ptr<Expression> parse(
@@ -1254,6 +1255,7 @@ public:
         : ExpressionFixedArity<ExpressionIfNull, 2>(expCtx) {}
 
     Value evaluate(const Document& root) const final;
+    boost::intrusive_ptr<Expression> optimize() final;
     const char* getOpName() const final;
 };
 
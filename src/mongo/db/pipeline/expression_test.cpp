@@ -2818,6 +2818,119 @@ TEST(ExpressionIndexOfArray,
                     optimizedIndexInRangeWithDuplcateValues->evaluate(Document{{"x", 2}}));
 }
 
+/**
+ * Evaluates a binary ExpressionAdd or ExpressionMultiply over 'lhs' and 'rhs' without optimizing
+ * it, so that the operands are not folded.
+ */
+template <typename ExpressionType>
+Value evaluateBinaryArithmetic(Value lhs, Value rhs) {
+    intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    intrusive_ptr<ExpressionNary> expression = new ExpressionType(expCtx);
+    expression->addOperand(ExpressionConstant::create(expCtx, lhs));
+    expression->addOperand(ExpressionConstant::create(expCtx, rhs));
+    return expression->evaluate(Document());
+}
+
+TEST(ExpressionAddTest, BinaryAddOfSameTypeNumbers) {
+    auto add = evaluateBinaryArithmetic<ExpressionAdd>;
+
+    Value intSum = add(Value(1), Value(2));
+    ASSERT_EQ(NumberInt, intSum.getType());
+    ASSERT_VALUE_EQ(Value(3), intSum);
+
+    Value widenedIntSum = add(Value(numeric_limits<int>::max()), Value(1));
+    ASSERT_EQ(NumberLong, widenedIntSum.getType());
+    ASSERT_VALUE_EQ(Value(2147483648LL), widenedIntSum);
+
+    Value longSum = add(Value(1LL), Value(2LL));
+    ASSERT_EQ(NumberLong, longSum.getType());
+    ASSERT_VALUE_EQ(Value(3LL), longSum);
+
+    Value overflowedLongSum = add(Value(numeric_limits<long long>::max()), Value(1LL));
+    ASSERT_EQ(NumberDouble, overflowedLongSum.getType());
+    ASSERT_VALUE_EQ(Value(9223372036854775808.0), overflowedLongSum);
+
+    Value doubleSum = add(Value(1.5), Value(2.25));
+    ASSERT_EQ(NumberDouble, doubleSum.getType());
+    ASSERT_VALUE_EQ(Value(3.75), doubleSum);
+
+    // The general path starts from a sum of positive zero.
+    Value zeroSum = add(Value(-0.0), Value(-0.0));
+    ASSERT_EQ(NumberDouble, zeroSum.getType());
+    ASSERT_FALSE(std::signbit(zeroSum.getDouble()));
+
+    ASSERT_TRUE(std::isnan(add(Value(numeric_limits<double>::infinity()),
+                               Value(-numeric_limits<double>::infinity()))
+                               .getDouble()));
+    ASSERT_VALUE_EQ(Value(numeric_limits<double>::infinity()),
+                    add(Value(numeric_limits<double>::infinity()), Value(1.0)));
+}
+
+TEST(ExpressionAddTest, BinaryAddWithNullishFirstOperandDoesNotEvaluateSecondOperand) {
+    intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    auto expression = Expression::parseExpression(
+        expCtx, fromjson("{$add: ['$missing', '$str']}"), expCtx->variablesParseState);
+    ASSERT_VALUE_EQ(Value(BSONNULL), expression->evaluate(Document{{"str", "a"_sd}}));
+    ASSERT_THROWS(expression->evaluate(Document{{"missing", 1}, {"str", "a"_sd}}),
+                  AssertionException);
+}
+
+TEST(ExpressionMultiplyTest, BinaryMultiplyOfSameTypeNumbers) {
+    auto multiply = evaluateBinaryArithmetic<ExpressionMultiply>;
+
+    Value intProduct = multiply(Value(3), Value(4));
+    ASSERT_EQ(NumberInt, intProduct.getType());
+    ASSERT_VALUE_EQ(Value(12), intProduct);
+
+    Value widenedIntProduct =
+        multiply(Value(numeric_limits<int>::max()), Value(numeric_limits<int>::max()));
+    ASSERT_EQ(NumberLong, widenedIntProduct.getType());
+    ASSERT_VALUE_EQ(Value(4611686014132420609LL), widenedIntProduct);
+
+    Value longProduct = multiply(Value(3LL), Value(4LL));
+    ASSERT_EQ(NumberLong, longProduct.getType());
+    ASSERT_VALUE_EQ(Value(12LL), longProduct);
+
+    Value overflowedLongProduct = multiply(Value(numeric_limits<long long>::max()), Value(2LL));
+    ASSERT_EQ(NumberDouble, overflowedLongProduct.getType());
+    ASSERT_VALUE_EQ(Value(18446744073709551616.0), overflowedLongProduct);
+
+    Value doubleProduct = multiply(Value(2.5), Value(4.0));
+    ASSERT_EQ(NumberDouble, doubleProduct.getType());
+    ASSERT_VALUE_EQ(Value(10.0), doubleProduct);
+}
+
+TEST(ExpressionCondTest, ConstantConditionOptimizesToTheTakenBranch) {
+    intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+
+    auto thenBranch = Expression::parseExpression(
+        expCtx, fromjson("{$cond: [true, '$a', '$b']}"), expCtx->variablesParseState);
+    ASSERT_VALUE_EQ(Value("$a"_sd), thenBranch->optimize()->serialize(false));
+
+    auto elseBranch = Expression::parseExpression(
+        expCtx, fromjson("{$cond: [{$eq: [1, 2]}, '$a', '$b']}"), expCtx->variablesParseState);
+    ASSERT_VALUE_EQ(Value("$b"_sd), elseBranch->optimize()->serialize(false));
+
+    auto notConstant = Expression::parseExpression(
+        expCtx, fromjson("{$cond: ['$c', '$a', '$b']}"), expCtx->variablesParseState);
+    ASSERT_TRUE(dynamic_cast<ExpressionCond*>(notConstant->optimize().get()));
+}
+
+TEST(ExpressionIfNullTest, ConstantFirstOperandOptimizesToTheReturnedOperand) {
+    intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+
+    auto nullFirst = Expression::parseExpression(
+        expCtx, fromjson("{$ifNull: [null, '$b']}"), expCtx->variablesParseState);
+    ASSERT_VALUE_EQ(Value("$b"_sd), nullFirst->optimize()->serialize(false));
+
+    auto nonNullFirst = Expression::parseExpression(
+        expCtx, fromjson("{$ifNull: [5, '$b']}"), expCtx->variablesParseState);
+    auto optimized = nonNullFirst->optimize();
+    auto constant = dynamic_cast<ExpressionConstant*>(optimized.get());
+    ASSERT_TRUE(constant);
+    ASSERT_VALUE_EQ(Value(5), constant->getValue());
+}
+
 namespace FieldPath {
 
 /** The provided field path does not pass validation. */
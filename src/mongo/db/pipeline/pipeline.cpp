@@ -77,6 +77,11 @@ using DiskUseRequirement = StageConstraints::DiskUseRequirement;
 using FacetRequirement = StageConstraints::FacetRequirement;
 using StreamType = StageConstraints::StreamType;
 
+namespace {
+// The maximum number of results requested from the final stage per call to getNextBatch().
+const size_t kMaxBatchSize = 128;
+}  // namespace
+
 constexpr MatchExpressionParser::AllowedFeatureSet Pipeline::kAllowedMatcherFeatures;
 constexpr MatchExpressionParser::AllowedFeatureSet Pipeline::kGeoNearMatcherFeatures;
 
@@ -470,6 +475,26 @@ void Pipeline::stitch() {
 
 boost::optional<Document> Pipeline::getNext() {
     invariant(!_sources.empty());
+
+    if (_batchPosition < _batch.size() || _batchEndedWithEOF || _canExecuteInBatches()) {
+        while (_batchPosition == _batch.size()) {
+            if (_batchEndedWithEOF) {
+                // Report EOF once, but don't latch it: a tailable pipeline may produce more
+                // results on a later call.
+                _batchEndedWithEOF = false;
+                return boost::none;
+            }
+
+            // A batch which ends with kPauseExecution is treated like a paused getNext(), so we
+            // simply ask for another batch.
+            _batch.clear();
+            _batchPosition = 0;
+            _batchEndedWithEOF = _sources.back()->getNextBatch(&_batch, kMaxBatchSize) ==
+                DocumentSource::GetNextResult::ReturnStatus::kEOF;
+        }
+        return std::move(_batch[_batchPosition++]);
+    }
+
     auto nextResult = _sources.back()->getNext();
     while (nextResult.isPaused()) {
         nextResult = _sources.back()->getNext();
@@ -478,6 +503,12 @@ boost::optional<Document> Pipeline::getNext() {
                               : boost::optional<Document>{nextResult.releaseDocument()};
 }
 
+bool Pipeline::_canExecuteInBatches() const {
+    return std::all_of(_sources.rbegin(), _sources.rend(), [](const auto& stage) {
+        return stage->canProduceBatches();
+    });
+}
+
 vector<Value> Pipeline::writeExplainOps(ExplainOptions::Verbosity verbosity) const {
     vector<Value> array;
     for (SourceContainer::const_iterator it = _sources.begin(); it != _sources.end(); ++it) {
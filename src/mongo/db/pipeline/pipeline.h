@@ -250,6 +250,9 @@ public:
 
     /**
      * Returns the next result from the pipeline, or boost::none if there are no more results.
+     *
+     * If every stage in the pipeline can produce batches, results are pulled from the final stage
+     * a batch at a time and buffered here.
      */
     boost::optional<Document> getNext();
 
@@ -396,8 +399,19 @@ private:
      */
     Status _pipelineCanRunOnMongoS() const;
 
+    /**
+     * Returns true if every stage in the pipeline overrides DocumentSource::getNextBatch().
+     */
+    bool _canExecuteInBatches() const;
+
     SourceContainer _sources;
 
+    // Results pulled from the final stage by getNextBatch() which have not yet been returned, and
+    // whether that batch ended with EOF. Only used if _canExecuteInBatches() is true.
+    std::vector<Document> _batch;
+    size_t _batchPosition = 0;
+    bool _batchEndedWithEOF = false;
+
     SplitState _splitState = SplitState::kUnsplit;
     boost::intrusive_ptr<ExpressionContext> pCtx;
     bool _disposed = false;
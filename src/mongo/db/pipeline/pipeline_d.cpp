@@ -68,6 +68,7 @@
 #include "mongo/db/query/collation/collator_interface.h"
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/s/collection_sharding_state.h"
 #include "mongo/db/s/operation_sharding_state.h"
@@ -454,6 +455,7 @@ void PipelineD::prepareGenericCursorSource(Collection* collection,
                                                 expCtx,
                                                 oplogReplay,
                                                 sortStage,
+                                                groupStage,
                                                 std::move(rewrittenGroupStage),
                                                 deps,
                                                 queryObj,
@@ -520,6 +522,7 @@ void PipelineD::prepareGeoNearCursorSource(Collection* collection,
                                                 expCtx,
                                                 false,   /* oplogReplay */
                                                 nullptr, /* sortStage */
+                                                nullptr, /* groupStage */
                                                 nullptr, /* rewrittenGroupStage */
                                                 deps,
                                                 std::move(fullQuery),
@@ -553,6 +556,7 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> PipelineD::prep
     const intrusive_ptr<ExpressionContext>& expCtx,
     bool oplogReplay,
     const boost::intrusive_ptr<DocumentSourceSort>& sortStage,
+    const boost::intrusive_ptr<DocumentSourceGroup>& groupStage,
     std::unique_ptr<GroupFromFirstDocumentTransformation> rewrittenGroupStage,
     const DepsTracker& deps,
     const BSONObj& queryObj,
@@ -705,6 +709,10 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> PipelineD::prep
             if (sortStage->getLimitSrc()) {
                 // We need to reinsert the coalesced $limit after removing the $sort.
                 pipeline->_sources.push_front(sortStage->getLimitSrc());
+            } else if (groupStage && internalDocumentSourceGroupEnableStreaming.load() &&
+                       groupStage->canStreamWithSortPattern(*sortObj)) {
+                // The sort keeps the documents of each group together, so the $group can stream.
+                groupStage->setStreaming(true);
             }
             return std::move(exec);
         } else if (swExecutorSort == ErrorCodes::QueryPlanKilled) {
@@ -716,6 +724,64 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> PipelineD::prep
         }
         // The query system can't provide a non-blocking sort.
         *sortObj = BSONObj();
+    } else if (groupStage && internalDocumentSourceGroupEnableStreaming.load()) {
+        // See if the query system can provide input sorted on the group key without a blocking
+        // sort. This allows the $group to output each group as soon as its input is exhausted,
+        // rather than holding every group in memory or spilling them to disk.
+        const BSONObj groupSortPattern = groupStage->getStreamingSortPattern();
+        if (!groupSortPattern.isEmpty()) {
+            auto swExecutorGroupSort = attemptToGetExecutor(opCtx,
+                                                            collection,
+                                                            nss,
+                                                            expCtx,
+                                                            oplogReplay,
+                                                            queryObj,
+                                                            emptyProjection,
+                                                            groupSortPattern,
+                                                            boost::none,
+                                                            aggRequest,
+                                                            plannerOpts,
+                                                            matcherFeatures);
+
+            if (swExecutorGroupSort.isOK()) {
+                // Now see if the query system can also cover the projection.
+                auto swExecutorGroupSortAndProj = attemptToGetExecutor(opCtx,
+                                                                       collection,
+                                                                       nss,
+                                                                       expCtx,
+                                                                       oplogReplay,
+                                                                       queryObj,
+                                                                       *projectionObj,
+                                                                       groupSortPattern,
+                                                                       boost::none,
+                                                                       aggRequest,
+                                                                       plannerOpts,
+                                                                       matcherFeatures);
+
+                std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> exec;
+                if (swExecutorGroupSortAndProj.isOK()) {
+                    exec = std::move(swExecutorGroupSortAndProj.getValue());
+                } else if (swExecutorGroupSortAndProj == ErrorCodes::QueryPlanKilled) {
+                    return {ErrorCodes::OperationFailed,
+                            str::stream() << "Failed to determine whether query system can provide "
+                                             "a covered projection in addition to a non-blocking "
+                                             "sort for a streaming $group: "
+                                          << swExecutorGroupSortAndProj.getStatus().toString()};
+                } else {
+                    *projectionObj = BSONObj();
+                    exec = std::move(swExecutorGroupSort.getValue());
+                }
+
+                *sortObj = groupSortPattern;
+                groupStage->setStreaming(true);
+                return std::move(exec);
+            } else if (swExecutorGroupSort == ErrorCodes::QueryPlanKilled) {
+                return {ErrorCodes::OperationFailed,
+                        str::stream() << "Failed to determine whether query system can provide a "
+                                         "non-blocking sort for a streaming $group: "
+                                      << swExecutorGroupSort.getStatus().toString()};
+            }
+        }
     }
 
     // Either there was no $sort stage, or the query system could not provide a non-blocking
@@ -118,6 +118,10 @@ private:
      * Set 'rewrittenGroupStage' when the pipeline uses $match+$sort+$group stages that are
      * compatible with a DISTINCT_SCAN plan that visits the first document in each group
      * (SERVER-9507).
+     *
+     * Set 'groupStage' to the $group which follows the optional initial $sort, if any. If the query
+     * system can provide input sorted on the group key without a blocking sort, 'groupStage' is
+     * switched to streaming mode and 'sortObj' is set to the sort the executor provides.
      */
     static StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> prepareExecutor(
         OperationContext* opCtx,
@@ -127,6 +131,7 @@ private:
         const boost::intrusive_ptr<ExpressionContext>& expCtx,
         bool oplogReplay,
         const boost::intrusive_ptr<DocumentSourceSort>& sortStage,
+        const boost::intrusive_ptr<DocumentSourceGroup>& groupStage,
         std::unique_ptr<GroupFromFirstDocumentTransformation> rewrittenGroupStage,
         const DepsTracker& deps,
         const BSONObj& queryObj,
@@ -34,6 +34,7 @@
 #include "mongo/base/owned_pointer_vector.h"
 #include "mongo/bson/util/builder.h"
 #include "mongo/db/exec/cached_plan.h"
+#include "mongo/db/exec/column_scan.h"
 #include "mongo/db/exec/count_scan.h"
 #include "mongo/db/exec/distinct_scan.h"
 #include "mongo/db/exec/idhack.h"
@@ -157,6 +158,9 @@ size_t getKeysExamined(StageType type, const SpecificStats* specific) {
     } else if (STAGE_DISTINCT_SCAN == type) {
         const DistinctScanStats* spec = static_cast<const DistinctScanStats*>(specific);
         return spec->keysExamined;
+    } else if (STAGE_COLUMN_SCAN == type) {
+        const ColumnScanStats* spec = static_cast<const ColumnScanStats*>(specific);
+        return spec->keysExamined;
     }
 
     return 0;
@@ -184,6 +188,9 @@ size_t getDocsExamined(StageType type, const SpecificStats* specific) {
     } else if (STAGE_TEXT_OR == type) {
         const TextOrStats* spec = static_cast<const TextOrStats*>(specific);
         return spec->fetches;
+    } else if (STAGE_COLUMN_SCAN == type) {
+        const ColumnScanStats* spec = static_cast<const ColumnScanStats*>(specific);
+        return spec->docsExamined;
     }
 
     return 0;
@@ -199,7 +206,11 @@ void addStageSummaryStr(const PlanStage* stage, StringBuilder& sb) {
 
     // Some leaf nodes also provide info about the index they used.
     const SpecificStats* specific = stage->getSpecificStats();
-    if (STAGE_COUNT_SCAN == stage->stageType()) {
+    if (STAGE_COLUMN_SCAN == stage->stageType()) {
+        const ColumnScanStats* spec = static_cast<const ColumnScanStats*>(specific);
+        const KeyPattern keyPattern{spec->keyPattern};
+        sb << " " << keyPattern;
+    } else if (STAGE_COUNT_SCAN == stage->stageType()) {
         const CountScanStats* spec = static_cast<const CountScanStats*>(specific);
         const KeyPattern keyPattern{spec->keyPattern};
         sb << " " << keyPattern;
@@ -341,6 +352,8 @@ void Explain::statsToBSON(const PlanStageStats& stats,
         if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
             bob->appendNumber("memUsage", spec->memUsage);
             bob->appendNumber("memLimit", spec->memLimit);
+            bob->appendNumber("buildChild", spec->buildChild);
+            bob->appendNumber("bloomFilterRejects", spec->bloomFilterRejects);
 
             for (size_t i = 0; i < spec->mapAfterChild.size(); ++i) {
                 bob->appendNumber(string(stream() << "mapAfterChild_" << i),
@@ -364,6 +377,15 @@ void Explain::statsToBSON(const PlanStageStats& stats,
         if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
             bob->appendNumber("docsExamined", spec->docsTested);
         }
+    } else if (STAGE_COLUMN_SCAN == stats.stageType) {
+        ColumnScanStats* spec = static_cast<ColumnScanStats*>(stats.specific.get());
+        bob->append("keyPattern", spec->keyPattern);
+        bob->append("indexName", spec->indexName);
+        bob->append("paths", spec->paths);
+        if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
+            bob->appendNumber("keysExamined", spec->keysExamined);
+            bob->appendNumber("docsExamined", spec->docsExamined);
+        }
     } else if (STAGE_COUNT == stats.stageType) {
         CountStats* spec = static_cast<CountStats*>(stats.specific.get());
 
@@ -497,6 +519,7 @@ void Explain::statsToBSON(const PlanStageStats& stats,
         if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
             bob->appendNumber("keysExamined", spec->keysExamined);
             bob->appendNumber("seeks", spec->seeks);
+            bob->appendNumber("seeksAvoided", spec->seeksAvoided);
             bob->appendNumber("dupsTested", spec->dupsTested);
             bob->appendNumber("dupsDropped", spec->dupsDropped);
         }
@@ -966,6 +989,11 @@ void Explain::getSummaryStats(const PlanExecutor& exec, PlanSummaryStats* statsO
             const IndexScanStats* ixscanStats =
                 static_cast<const IndexScanStats*>(ixscan->getSpecificStats());
             statsOut->indexesUsed.insert(ixscanStats->indexName);
+        } else if (STAGE_COLUMN_SCAN == stages[i]->stageType()) {
+            const ColumnScan* columnScan = static_cast<const ColumnScan*>(stages[i]);
+            const ColumnScanStats* columnScanStats =
+                static_cast<const ColumnScanStats*>(columnScan->getSpecificStats());
+            statsOut->indexesUsed.insert(columnScanStats->indexName);
         } else if (STAGE_COUNT_SCAN == stages[i]->stageType()) {
             const CountScan* countScan = static_cast<const CountScan*>(stages[i]);
             const CountScanStats* countScanStats =
@@ -81,6 +81,7 @@
 #include "mongo/db/s/operation_sharding_state.h"
 #include "mongo/db/server_options.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/storage/clustered_record_id.h"
 #include "mongo/db/storage/oplog_hack.h"
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/scripting/engine.h"
@@ -261,8 +262,16 @@ void fillOutPlannerParams(OperationContext* opCtx,
         plannerParams->options |= QueryPlannerParams::GENERATE_COVERED_IXSCANS;
     }
 
+    if (internalQueryPlannerGenerateSkipScans.load()) {
+        plannerParams->options |= QueryPlannerParams::GENERATE_SKIP_SCANS;
+    }
+
     plannerParams->options |= QueryPlannerParams::SPLIT_LIMITED_SORT;
 
+    if (collection->isClustered()) {
+        plannerParams->options |= QueryPlannerParams::CLUSTERED_BY_ID;
+    }
+
     if (shouldWaitForOplogVisibility(
             opCtx, collection, canonicalQuery->getQueryRequest().isTailable())) {
         plannerParams->options |= QueryPlannerParams::OPLOG_SCAN_WAIT_FOR_VISIBLE;
@@ -312,6 +321,26 @@ struct PrepareExecutionResult {
     unique_ptr<PlanStage> root;
 };
 
+/**
+ * Builds the idhack plan of a clustered collection, which has no _id index: a collection scan of
+ * the single record keyed by the _id being looked up.
+ */
+unique_ptr<PlanStage> makeClusteredIdLookup(OperationContext* opCtx,
+                                            Collection* collection,
+                                            WorkingSet* ws,
+                                            const CanonicalQuery& canonicalQuery) {
+    auto recordId = clustered_record_id::keyForId(canonicalQuery.getQueryObj()["_id"]);
+    if (!recordId.isOK()) {
+        // No document of the collection can have this _id.
+        return make_unique<EOFStage>(opCtx);
+    }
+
+    CollectionScanParams params;
+    params.start = recordId.getValue();
+    params.maxRecord = recordId.getValue();
+    return make_unique<CollectionScan>(opCtx, collection, params, ws, canonicalQuery.root());
+}
+
 /**
  * Build an execution tree for the query described in 'canonicalQuery'.
  *
@@ -355,11 +384,16 @@ StatusWith<PrepareExecutionResult> prepareExecution(OperationContext* opCtx,
 
     const IndexDescriptor* descriptor = collection->getIndexCatalog()->findIdIndex(opCtx);
 
-    // If we have an _id index we can use an idhack plan.
-    if (descriptor && IDHackStage::supportsQuery(collection, *canonicalQuery)) {
+    // If we have an _id index, or the collection is clustered by _id, we can use an idhack plan.
+    if ((descriptor || collection->isClustered()) &&
+        IDHackStage::supportsQuery(collection, *canonicalQuery)) {
         LOG(2) << "Using idhack: " << redact(canonicalQuery->toStringShort());
 
-        root = make_unique<IDHackStage>(opCtx, canonicalQuery.get(), ws, descriptor);
+        if (descriptor) {
+            root = make_unique<IDHackStage>(opCtx, canonicalQuery.get(), ws, descriptor);
+        } else {
+            root = makeClusteredIdLookup(opCtx, collection, ws, *canonicalQuery);
+        }
 
         // Might have to filter out orphaned docs.
         if (plannerParams.options & QueryPlannerParams::INCLUDE_SHARD_FILTER) {
@@ -1456,6 +1490,12 @@ QueryPlannerParams fillOutPlannerParamsForDistinct(OperationContext* opCtx,
     QueryPlannerParams plannerParams;
     plannerParams.options = QueryPlannerParams::NO_TABLE_SCAN | plannerOptions;
 
+    // A skip scan which absorbs the whole filter into its bounds can become a DISTINCT_SCAN, which
+    // then skips both between the values of the distinct field and to the bounds of later fields.
+    if (internalQueryPlannerGenerateSkipScans.load()) {
+        plannerParams.options |= QueryPlannerParams::GENERATE_SKIP_SCANS;
+    }
+
     std::unique_ptr<IndexCatalog::IndexIterator> ii =
         collection->getIndexCatalog()->getIndexIterator(opCtx, false);
     auto query = parsedDistinct.getQuery()->getQueryRequest().getFilter();
@@ -633,6 +633,11 @@ IndexBoundsChecker::KeyState IndexBoundsChecker::checkKey(const BSONObj& key, In
     // Field number 'firstNonContainedField' of the index key is after interval we think it's
     // in.  Fields 0 through 'firstNonContained-1' are within their current intervals and we can
     // ignore them.
+    //
+    // The key is ahead of every interval up to and including the current one for that field, so
+    // the search for its new interval can start there. This matters for bounds with many point
+    // intervals, such as those built for a large $in, where the next interval is usually close.
+    size_t searchStart = _curInterval[firstNonContainedField];
     while (firstNonContainedField < _curInterval.size()) {
         // Find the interval that contains our field.
         size_t newIntervalForField;
@@ -640,7 +645,12 @@ IndexBoundsChecker::KeyState IndexBoundsChecker::checkKey(const BSONObj& key, In
         Location where = findIntervalForField(keyValues[firstNonContainedField],
                                               _bounds->fields[firstNonContainedField],
                                               _expectedDirection[firstNonContainedField],
-                                              &newIntervalForField);
+                                              &newIntervalForField,
+                                              searchStart);
+
+        // Nothing is known about the position of the key relative to the current intervals of
+        // the fields to the right.
+        searchStart = 0;
 
         if (WITHIN == where) {
             // Found a new interval for field firstNonContainedField.  Move our internal choice
@@ -720,18 +730,34 @@ IndexBoundsChecker::Location IndexBoundsChecker::findIntervalForField(
     const BSONElement& elt,
     const OrderedIntervalList& oil,
     const int expectedDirection,
-    size_t* newIntervalIndex) {
+    size_t* newIntervalIndex,
+    size_t startIntervalIndex) {
     // Binary search for interval.
     // Intervals are ordered in the same direction as our keys.
     // Key behind all intervals: [BEHIND, ..., BEHIND]
     // Key ahead of all intervals: [AHEAD, ..., AHEAD]
     // Key within one interval: [AHEAD, ..., WITHIN, BEHIND, ...]
     // Key not in any inteval: [AHEAD, ..., AHEAD, BEHIND, ...]
+    const auto keyAndDirection = std::make_pair(elt, expectedDirection);
+    const size_t numIntervals = oil.intervals.size();
+
+    // Gallop forward from 'startIntervalIndex' to bracket the left-most BEHIND/WITHIN interval,
+    // so that the cost of the search depends on how far the key moved rather than on the total
+    // number of intervals.
+    size_t low = std::min(startIntervalIndex, numIntervals);
+    size_t high = low;
+    for (size_t step = 1;
+         high < numIntervals && isKeyAheadOfInterval(oil.intervals[high], keyAndDirection);
+         step *= 2) {
+        low = high + 1;
+        high += step;
+    }
+    high = std::min(high, numIntervals);
 
     // Find left-most BEHIND/WITHIN interval.
-    vector<Interval>::const_iterator i = std::lower_bound(oil.intervals.begin(),
-                                                          oil.intervals.end(),
-                                                          std::make_pair(elt, expectedDirection),
+    vector<Interval>::const_iterator i = std::lower_bound(oil.intervals.begin() + low,
+                                                          oil.intervals.begin() + high,
+                                                          keyAndDirection,
                                                           isKeyAheadOfInterval);
 
     // Key ahead of all intervals.
@@ -255,14 +255,16 @@ public:
      *
      * If 'elt' cannot be advanced to any interval, return AHEAD.
      *
-     * Exposed for testing only.
+     * The caller may pass 'startIntervalIndex' if 'elt' is known to be AHEAD of every interval
+     * before that index, in which case the search starts there.
      *
-     * TODO(efficiency): Start search from a given index.
+     * Exposed for testing only.
      */
     static Location findIntervalForField(const BSONElement& elt,
                                          const OrderedIntervalList& oil,
                                          const int expectedDirection,
-                                         size_t* newIntervalIndex);
+                                         size_t* newIntervalIndex,
+                                         size_t startIntervalIndex = 0);
 
 private:
     /**
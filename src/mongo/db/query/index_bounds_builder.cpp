@@ -676,15 +676,46 @@ void IndexBoundsBuilder::_translatePredicate(const MatchExpression* expr,
 
         IndexBoundsBuilder::BoundsTightness tightness;
         bool arrayOrNullPresent = false;
+
+        // Scalar equalities become point intervals which share buffers of up to
+        // kMaxPointsBufferBytes, so that a large $in costs a few allocations rather than one per
+        // value. Collation keys and hashes can be larger than the values they are made from, so a
+        // buffer is closed well before it could outgrow the maximum BSONObj size.
+        const int kMaxPointsBufferBytes = 1024 * 1024;
+        boost::optional<BSONObjBuilder> pointsBob;
+        pointsBob.emplace();
         for (auto&& equality : ime->getEqualities()) {
-            translateEquality(equality, index, isHashed, oilOut, &tightness);
-            // The ordering invariant of oil has been violated by the call to translateEquality.
-            arrayOrNullPresent = arrayOrNullPresent || equality.type() == BSONType::jstNULL ||
-                equality.type() == BSONType::Array;
-            if (tightness != IndexBoundsBuilder::EXACT) {
-                *tightnessOut = tightness;
+            if (equality.type() == BSONType::jstNULL || equality.type() == BSONType::Array) {
+                // Nulls and arrays expand to several intervals. Translate them on the side so
+                // that translateEquality() only sorts the intervals generated for this equality.
+                OrderedIntervalList equalityOil;
+                translateEquality(equality, index, isHashed, &equalityOil, &tightness);
+                oilOut->intervals.insert(oilOut->intervals.end(),
+                                         std::make_move_iterator(equalityOil.intervals.begin()),
+                                         std::make_move_iterator(equalityOil.intervals.end()));
+                arrayOrNullPresent = true;
+                if (tightness != IndexBoundsBuilder::EXACT) {
+                    *tightnessOut = tightness;
+                }
+                continue;
+            }
+
+            if (isHashed) {
+                BSONObj dataObj = objFromElement(equality, index.collator);
+                pointsBob->appendAs(ExpressionMapping::hash(dataObj.firstElement()).firstElement(),
+                                    "");
+                *tightnessOut = IndexBoundsBuilder::INEXACT_FETCH;
+            } else {
+                CollationIndexKey::collationAwareIndexKeyAppend(
+                    equality, index.collator, pointsBob.get_ptr());
+            }
+
+            if (pointsBob->len() >= kMaxPointsBufferBytes) {
+                appendPointIntervals(pointsBob->obj(), oilOut);
+                pointsBob.emplace();
             }
         }
+        appendPointIntervals(pointsBob->obj(), oilOut);
 
         for (auto&& regex : ime->getRegexes()) {
             translateRegex(regex.get(), index, oilOut, &tightness);
@@ -824,43 +855,41 @@ void IndexBoundsBuilder::unionize(OrderedIntervalList* oilOut) {
     // Step 1: sort.
     std::sort(iv.begin(), iv.end(), IntervalComparison);
 
-    // Step 2: Walk through and merge.
-    size_t i = 0;
-    while (i < iv.size() - 1) {
-        // Compare i with i + 1.
-        Interval::IntervalComparison cmp = iv[i].compare(iv[i + 1]);
+    // Step 2: Walk through and merge. Surviving intervals are compacted towards the front of the
+    // vector, so that dropping an interval never requires erasing from the middle of it.
+    size_t last = 0;
+    for (size_t i = 1; i < iv.size(); ++i) {
+        // Compare the last surviving interval with interval i.
+        Interval::IntervalComparison cmp = iv[last].compare(iv[i]);
 
         // This means our sort didn't work.
-        verify(Interval::INTERVAL_SUCCEEDS != cmp);
+        verify(Interval::INTERVAL_SUCCEEDS != cmp && Interval::INTERVAL_OVERLAPS_AFTER != cmp);
 
-        // Intervals are correctly ordered.
         if (Interval::INTERVAL_PRECEDES == cmp) {
-            // We can move to the next pair.
-            ++i;
+            // Intervals are correctly ordered. Interval i becomes the last surviving interval.
+            if (++last != i) {
+                iv[last] = std::move(iv[i]);
+            }
         } else if (Interval::INTERVAL_EQUALS == cmp || Interval::INTERVAL_WITHIN == cmp) {
-            // Interval 'i' is equal to i+1, or is contained within i+1.
-            // Remove interval i and don't move to the next value of 'i'.
-            iv.erase(iv.begin() + i);
+            // Interval 'last' is equal to i, or is contained within i. Replace it with i.
+            iv[last] = std::move(iv[i]);
         } else if (Interval::INTERVAL_CONTAINS == cmp) {
-            // Interval 'i' contains i+1, remove i+1 and don't move to the next value of 'i'.
-            iv.erase(iv.begin() + i + 1);
+            // Interval 'last' contains i. Drop i.
         } else if (Interval::INTERVAL_OVERLAPS_BEFORE == cmp ||
                    Interval::INTERVAL_PRECEDES_COULD_UNION == cmp) {
-            // We want to merge intervals i and i+1.
-            // Interval 'i' starts before interval 'i+1'.
+            // We want to merge intervals 'last' and i.
+            // Interval 'last' starts before interval i.
             BSONObjBuilder bob;
-            bob.appendAs(iv[i].start, "");
-            bob.appendAs(iv[i + 1].end, "");
+            bob.appendAs(iv[last].start, "");
+            bob.appendAs(iv[i].end, "");
             BSONObj data = bob.obj();
-            bool startInclusive = iv[i].startInclusive;
-            bool endInclusive = iv[i + 1].endInclusive;
-            iv.erase(iv.begin() + i);
-            // iv[i] is now the former iv[i + 1]
-            iv[i] = makeRangeInterval(
+            bool startInclusive = iv[last].startInclusive;
+            bool endInclusive = iv[i].endInclusive;
+            iv[last] = makeRangeInterval(
                 data, IndexBounds::makeBoundInclusionFromBoundBools(startInclusive, endInclusive));
-            // Don't increment 'i'.
         }
     }
+    iv.resize(last + 1);
 }
 
 // static
@@ -882,6 +911,18 @@ Interval IndexBoundsBuilder::makePointInterval(const BSONObj& obj) {
     return ret;
 }
 
+// static
+void IndexBoundsBuilder::appendPointIntervals(const BSONObj& points, OrderedIntervalList* oilOut) {
+    oilOut->intervals.reserve(oilOut->intervals.size() + points.nFields());
+    for (auto&& point : points) {
+        Interval ret;
+        ret._intervalData = points;
+        ret.startInclusive = ret.endInclusive = true;
+        ret.start = ret.end = point;
+        oilOut->intervals.push_back(std::move(ret));
+    }
+}
+
 // static
 Interval IndexBoundsBuilder::makePointInterval(StringData str) {
     BSONObjBuilder bob;
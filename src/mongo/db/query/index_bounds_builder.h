@@ -137,6 +137,12 @@ public:
     static Interval makePointInterval(StringData str);
     static Interval makePointInterval(double d);
 
+    /**
+     * Appends a point interval to 'oilOut' for each field of 'points', in field order. The
+     * intervals all share the buffer of 'points' rather than each owning a copy of their value.
+     */
+    static void appendPointIntervals(const BSONObj& points, OrderedIntervalList* oilOut);
+
     /**
      * Wraps 'elt' in a BSONObj with an empty field name and returns the result. If 'elt' is a
      * string, and 'collator' is non-null, the result contains the collator-generated comparison key
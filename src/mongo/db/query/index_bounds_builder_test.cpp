@@ -966,6 +966,89 @@ TEST(IndexBoundsBuilderTest, TranslateInArray) {
     ASSERT_EQUALS(tightness, IndexBoundsBuilder::INEXACT_FETCH);
 }
 
+TEST(IndexBoundsBuilderTest, TranslateLargeIn) {
+    auto testIndex = buildSimpleIndexEntry();
+    BSONObjBuilder queryBob;
+    {
+        BSONObjBuilder aBob(queryBob.subobjStart("a"));
+        BSONArrayBuilder inBob(aBob.subarrayStart("$in"));
+        for (int i = 999; i >= 0; --i) {
+            inBob.append(i);
+        }
+        inBob.append(BSON_ARRAY(5));
+    }
+    BSONObj obj = queryBob.obj();
+    auto expr = parseMatchExpression(obj);
+    BSONElement elt = obj.firstElement();
+    OrderedIntervalList oil;
+    IndexBoundsBuilder::BoundsTightness tightness;
+    IndexBoundsBuilder::translate(expr.get(), elt, testIndex, &oil, &tightness);
+    ASSERT_EQUALS(oil.name, "a");
+
+    // The point interval [5, 5] generated for the array is merged with the one for the scalar 5.
+    ASSERT_EQUALS(oil.intervals.size(), 1001U);
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_EQUALS(Interval::INTERVAL_EQUALS,
+                      oil.intervals[i].compare(Interval(BSON("" << i << "" << i), true, true)));
+    }
+    ASSERT_EQUALS(
+        Interval::INTERVAL_EQUALS,
+        oil.intervals[1000].compare(Interval(fromjson("{'': [5], '': [5]}"), true, true)));
+    ASSERT_EQUALS(tightness, IndexBoundsBuilder::INEXACT_FETCH);
+}
+
+TEST(IndexBoundsBuilderTest, TranslateInWithPointsLargerThanOneBuffer) {
+    auto testIndex = buildSimpleIndexEntry();
+
+    // 100 strings of 20KB need the points to be split across several buffers.
+    const int kNumStrings = 100;
+    auto makePoint = [](int i) { return std::to_string(100 + i) + std::string(20 * 1024, 'x'); };
+    BSONObjBuilder queryBob;
+    {
+        BSONObjBuilder aBob(queryBob.subobjStart("a"));
+        BSONArrayBuilder inBob(aBob.subarrayStart("$in"));
+        for (int i = kNumStrings - 1; i >= 0; --i) {
+            inBob.append(makePoint(i));
+        }
+    }
+    BSONObj obj = queryBob.obj();
+    auto expr = parseMatchExpression(obj);
+    BSONElement elt = obj.firstElement();
+    OrderedIntervalList oil;
+    IndexBoundsBuilder::BoundsTightness tightness;
+    IndexBoundsBuilder::translate(expr.get(), elt, testIndex, &oil, &tightness);
+    ASSERT_EQUALS(oil.name, "a");
+
+    ASSERT_EQUALS(oil.intervals.size(), static_cast<size_t>(kNumStrings));
+    for (int i = 0; i < kNumStrings; ++i) {
+        const auto point = makePoint(i);
+        ASSERT_EQUALS(
+            Interval::INTERVAL_EQUALS,
+            oil.intervals[i].compare(Interval(BSON("" << point << "" << point), true, true)));
+    }
+    ASSERT_EQUALS(tightness, IndexBoundsBuilder::EXACT);
+}
+
+TEST(IndexBoundsBuilderTest, UnionizeMergesAdjacentAndContainedIntervals) {
+    OrderedIntervalList oil;
+    oil.intervals.push_back(Interval(BSON("" << 6 << "" << 6), true, true));
+    oil.intervals.push_back(Interval(BSON("" << 1 << "" << 3), true, false));
+    oil.intervals.push_back(Interval(BSON("" << 3 << "" << 4), true, true));
+    oil.intervals.push_back(Interval(BSON("" << 2 << "" << 2), true, true));
+    oil.intervals.push_back(Interval(BSON("" << 6 << "" << 6), true, true));
+    oil.intervals.push_back(Interval(BSON("" << 8 << "" << 9), true, true));
+    oil.intervals.push_back(Interval(BSON("" << 5 << "" << 7), false, false));
+    IndexBoundsBuilder::unionize(&oil);
+
+    ASSERT_EQUALS(oil.intervals.size(), 3U);
+    ASSERT_EQUALS(Interval::INTERVAL_EQUALS,
+                  oil.intervals[0].compare(Interval(BSON("" << 1 << "" << 4), true, true)));
+    ASSERT_EQUALS(Interval::INTERVAL_EQUALS,
+                  oil.intervals[1].compare(Interval(BSON("" << 5 << "" << 7), false, false)));
+    ASSERT_EQUALS(Interval::INTERVAL_EQUALS,
+                  oil.intervals[2].compare(Interval(BSON("" << 8 << "" << 9), true, true)));
+}
+
 TEST(IndexBoundsBuilderTest, TranslateLteBinData) {
     auto testIndex = buildSimpleIndexEntry();
     BSONObj obj = fromjson(
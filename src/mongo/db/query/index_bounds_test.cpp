@@ -36,6 +36,7 @@
 #include "mongo/db/jsobj.h"
 #include "mongo/db/json.h"
 #include "mongo/db/query/index_bounds.h"
+#include "mongo/db/query/index_bounds_builder.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/mongoutils/str.h"
@@ -1064,4 +1065,65 @@ TEST(IndexBoundsCheckerTest, FindIntervalForField) {
     testFindIntervalForField(0, pointsObj, -1, IndexBoundsChecker::AHEAD, 0U);
 }
 
+TEST(IndexBoundsCheckerTest, FindIntervalForFieldFromStartIndexMatchesFullSearch) {
+    // Point intervals on the even numbers [0, 200).
+    OrderedIntervalList oil("foo");
+    for (int i = 0; i < 200; i += 2) {
+        oil.intervals.push_back(Interval(BSON("" << i << "" << i), true, true));
+    }
+
+    for (int key = -1; key <= 200; ++key) {
+        BSONObj keyObj = BSON("" << key);
+        size_t expectedIndex = 0;
+        IndexBoundsChecker::Location expectedLocation = IndexBoundsChecker::findIntervalForField(
+            keyObj.firstElement(), oil, 1, &expectedIndex);
+
+        // Every interval before the start index is behind the key, so any such start index must
+        // produce the same answer as a search over all of the intervals.
+        size_t maxStartIndex =
+            expectedLocation == IndexBoundsChecker::AHEAD ? oil.intervals.size() : expectedIndex;
+        for (size_t start = 0; start <= maxStartIndex; ++start) {
+            size_t intervalIndex = 0;
+            IndexBoundsChecker::Location location = IndexBoundsChecker::findIntervalForField(
+                keyObj.firstElement(), oil, 1, &intervalIndex, start);
+            ASSERT_EQUALS(location, expectedLocation);
+            if (location != IndexBoundsChecker::AHEAD) {
+                ASSERT_EQUALS(intervalIndex, expectedIndex);
+            }
+        }
+    }
+}
+
+TEST(IndexBoundsCheckerTest, CheckKeyWalksManyPointIntervals) {
+    OrderedIntervalList oil("foo");
+    BSONObjBuilder pointsBob;
+    for (int i = 0; i < 1000; i += 10) {
+        pointsBob.append("", i);
+    }
+    IndexBoundsBuilder::appendPointIntervals(pointsBob.obj(), &oil);
+    ASSERT_EQUALS(oil.intervals.size(), 100U);
+
+    IndexBounds bounds;
+    bounds.fields.push_back(oil);
+    BSONObj idx = BSON("foo" << 1);
+    IndexBoundsChecker it(&bounds, idx, 1);
+    IndexSeekPoint seekPoint;
+    ASSERT(it.getStartSeekPoint(&seekPoint));
+
+    // Walk every key in [0, 1000). Keys that are multiples of ten are in bounds, and every other
+    // key must advance to the next multiple of ten.
+    for (int key = 0; key < 1000; ++key) {
+        IndexBoundsChecker::KeyState state = it.checkKey(BSON("" << key), &seekPoint);
+        if (key % 10 == 0) {
+            ASSERT_EQUALS(state, IndexBoundsChecker::VALID);
+        } else if (key > 990) {
+            ASSERT_EQUALS(state, IndexBoundsChecker::DONE);
+        } else {
+            ASSERT_EQUALS(state, IndexBoundsChecker::MUST_ADVANCE);
+            ASSERT_EQUALS(seekPoint.prefixLen, 0);
+            ASSERT_EQUALS(seekPoint.keySuffix[0]->numberInt(), (key / 10 + 1) * 10);
+        }
+    }
+}
+
 }  // namespace
@@ -220,6 +220,16 @@ struct SolutionCacheData {
         // The cached plan is a collection scan.
         COLLSCAN_SOLN,
 
+        // Indicates that the plan should scan the index stored
+        // in 'tree', skipping over the values of its leading
+        // fields (see QueryPlannerAccess::skipScanIndex()).
+        SKIP_SCAN_SOLN,
+
+        // Indicates that the plan should read the
+        // columns of the columnstore index stored in
+        // 'tree' in place of a collection scan.
+        COLUMN_SCAN_SOLN,
+
         // Build the solution by using 'tree'
         // to tag the match expression.
         USE_INDEX_TAGS_SOLN
@@ -227,7 +237,7 @@ struct SolutionCacheData {
 
     // The direction of the index scan used as
     // a proxy for a collection scan. Used only
-    // for WHOLE_IXSCAN_SOLN.
+    // for WHOLE_IXSCAN_SOLN and SKIP_SCAN_SOLN.
     int wholeIXSolnDir;
 
     // True if index filter was applied.
@@ -42,7 +42,9 @@
 #include "mongo/db/bson/dotted_path_support.h"
 #include "mongo/db/matcher/expression_array.h"
 #include "mongo/db/matcher/expression_geo.h"
+#include "mongo/db/matcher/expression_leaf.h"
 #include "mongo/db/matcher/expression_text.h"
+#include "mongo/db/query/collation/collator_interface.h"
 #include "mongo/db/query/index_bounds_builder.h"
 #include "mongo/db/query/index_tag.h"
 #include "mongo/db/query/indexability.h"
@@ -50,6 +52,7 @@
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/query/query_planner_common.h"
+#include "mongo/db/storage/clustered_record_id.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/log.h"
 #include "mongo/util/transitional_tools_do_not_use/vector_spooling.h"
@@ -137,6 +140,48 @@ std::vector<bool> canProvideSortWithMergeSort(
     return shouldReverseScan;
 }
 
+/**
+ * Bounds a scan of a collection clustered by _id to the RecordIds of the _ids allowed by the
+ * comparisons on _id in 'me', at the top level or inside a top-level $and. Comparisons against
+ * values which can't be a cluster key leave the scan unbounded on that side. The scan still
+ * applies the whole filter, so the bounds only need to enclose the matching documents.
+ */
+void setClusteredIdBounds(const MatchExpression* me,
+                          CollectionScanNode* csn,
+                          bool topLevel = true) {
+    if (me->matchType() == MatchExpression::AND && topLevel) {
+        for (size_t i = 0; i < me->numChildren(); ++i) {
+            setClusteredIdBounds(me->getChild(i), csn, false);
+        }
+        return;
+    }
+
+    if (!ComparisonMatchExpression::isComparisonMatchExpression(me) || me->path() != "_id") {
+        return;
+    }
+
+    auto recordId =
+        clustered_record_id::keyForId(static_cast<const ComparisonMatchExpression*>(me)->getData());
+    if (!recordId.isOK()) {
+        return;
+    }
+    const RecordId& bound = recordId.getValue();
+
+    const auto matchType = me->matchType();
+    if (matchType == MatchExpression::EQ || matchType == MatchExpression::GT ||
+        matchType == MatchExpression::GTE) {
+        if (!csn->minRecord || bound > *csn->minRecord) {
+            csn->minRecord = bound;
+        }
+    }
+    if (matchType == MatchExpression::EQ || matchType == MatchExpression::LT ||
+        matchType == MatchExpression::LTE) {
+        if (!csn->maxRecord || bound < *csn->maxRecord) {
+            csn->maxRecord = bound;
+        }
+    }
+}
+
 }  // namespace
 
 namespace mongo {
@@ -176,6 +221,11 @@ std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::makeCollectionScan(
         }
     }
 
+    if (params.options & QueryPlannerParams::CLUSTERED_BY_ID) {
+        csn->clusteredById = true;
+        setClusteredIdBounds(query.root(), csn.get());
+    }
+
     return std::move(csn);
 }
 
@@ -1292,6 +1342,131 @@ std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::scanWholeIndex(
     return solnRoot;
 }
 
+std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::skipScanIndex(
+    const IndexEntry& index,
+    const CanonicalQuery& query,
+    const QueryPlannerParams& params,
+    int direction) {
+    // Sparse and partial indexes may not contain every document, and the bounds of other index
+    // types don't describe a btree key.
+    if (INDEX_BTREE != index.type || index.sparse || index.filterExpr ||
+        index.keyPattern.nFields() < 2 ||
+        !CollatorInterface::collatorsMatch(index.collator, query.getCollator())) {
+        return nullptr;
+    }
+
+    unique_ptr<MatchExpression> filter = query.root()->shallowClone();
+
+    // Only the top-level conjuncts of the query are used to build bounds.
+    std::vector<MatchExpression*> conjuncts;
+    if (MatchExpression::AND == filter->matchType()) {
+        conjuncts = *filter->getChildVector();
+    } else {
+        conjuncts.push_back(filter.get());
+    }
+
+    auto canBuildBounds = [&index](const MatchExpression* expr) {
+        if (!Indexability::nodeCanUseIndexOnOwnField(expr)) {
+            return false;
+        }
+        switch (expr->matchType()) {
+            case MatchExpression::GEO:
+            case MatchExpression::GEO_NEAR:
+            case MatchExpression::TEXT:
+                return false;
+            case MatchExpression::INTERNAL_EXPR_EQ:
+                return !index.multikey;
+            default:
+                return true;
+        }
+    };
+
+    BSONObjIterator kpIt(index.keyPattern);
+    const BSONElement leadingElt = kpIt.next();
+    for (auto&& conjunct : conjuncts) {
+        if (conjunct->path() == leadingElt.fieldNameStringData() && canBuildBounds(conjunct)) {
+            // The enumerator plans the predicates over the leading field.
+            return nullptr;
+        }
+    }
+
+    IndexBounds bounds;
+    bounds.fields.resize(index.keyPattern.nFields());
+    IndexBoundsBuilder::allValuesForField(leadingElt, &bounds.fields[0]);
+
+    // The predicates which the bounds answer exactly, and which need not be filtered again.
+    std::vector<MatchExpression*> exactPredicates;
+    bool haveBoundedField = false;
+    for (size_t fieldNo = 1; kpIt.more(); ++fieldNo) {
+        const BSONElement keyElt = kpIt.next();
+        OrderedIntervalList* oil = &bounds.fields[fieldNo];
+
+        bool fieldIsBounded = false;
+        for (auto&& conjunct : conjuncts) {
+            if (haveBoundedField || conjunct->path() != keyElt.fieldNameStringData() ||
+                !canBuildBounds(conjunct)) {
+                continue;
+            }
+
+            IndexBoundsBuilder::BoundsTightness tightness;
+            if (!fieldIsBounded) {
+                IndexBoundsBuilder::translate(conjunct, keyElt, index, oil, &tightness);
+            } else if (!index.multikey) {
+                IndexBoundsBuilder::translateAndIntersect(conjunct, keyElt, index, oil, &tightness);
+            } else {
+                // Bounds for two predicates over a multikey field can't be intersected.
+                continue;
+            }
+            fieldIsBounded = true;
+
+            if (IndexBoundsBuilder::EXACT == tightness) {
+                exactPredicates.push_back(conjunct);
+            }
+        }
+
+        if (fieldIsBounded) {
+            haveBoundedField = true;
+        } else {
+            IndexBoundsBuilder::allValuesForField(keyElt, oil);
+        }
+    }
+
+    if (!haveBoundedField) {
+        return nullptr;
+    }
+
+    unique_ptr<IndexScanNode> isn = make_unique<IndexScanNode>(index);
+    isn->addKeyMetadata = query.getQueryRequest().returnKey();
+    isn->queryCollator = query.getCollator();
+    isn->bounds = std::move(bounds);
+    IndexBoundsBuilder::alignBounds(&isn->bounds, index.keyPattern);
+
+    if (-1 == direction) {
+        QueryPlannerCommon::reverseScans(isn.get());
+        isn->direction = -1;
+    }
+
+    if (MatchExpression::AND == filter->matchType()) {
+        auto children = filter->getChildVector();
+        for (auto&& exact : exactPredicates) {
+            children->erase(std::find(children->begin(), children->end(), exact));
+            delete exact;
+        }
+        filter = MatchExpression::optimize(std::move(filter));
+    } else if (!exactPredicates.empty()) {
+        filter.reset();
+    }
+
+    if (!filter || (MatchExpression::AND == filter->matchType() && 0 == filter->numChildren())) {
+        return std::move(isn);
+    }
+
+    unique_ptr<FetchNode> fetch = make_unique<FetchNode>();
+    fetch->filter = std::move(filter);
+    fetch->children.push_back(isn.release());
+    return std::move(fetch);
+}
+
 void QueryPlannerAccess::addFilterToSolutionNode(QuerySolutionNode* node,
                                                  MatchExpression* match,
                                                  MatchExpression::MatchType type) {
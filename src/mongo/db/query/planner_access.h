@@ -110,6 +110,18 @@ public:
                                                              const QueryPlannerParams& params,
                                                              int direction = 1);
 
+    /**
+     * Return a plan that scans the provided index with bounds on the first of its non-leading
+     * fields which the top-level predicates of 'query' constrain, and all values of its leading
+     * field. The index bounds checker then skips from each distinct leading value to the bounded
+     * range beneath it. Returns nullptr if the index is unsuitable, if the query constrains its
+     * leading field, or if it constrains none of its other fields.
+     */
+    static std::unique_ptr<QuerySolutionNode> skipScanIndex(const IndexEntry& index,
+                                                            const CanonicalQuery& query,
+                                                            const QueryPlannerParams& params,
+                                                            int direction = 1);
+
     /**
      * Return a plan that scans the provided index from [startKey to endKey).
      */
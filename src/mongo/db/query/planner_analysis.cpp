@@ -31,6 +31,7 @@
 
 #include "mongo/db/query/planner_analysis.h"
 
+#include <algorithm>
 #include <set>
 #include <vector>
 
@@ -40,6 +41,10 @@
 #include "mongo/db/index/s2_common.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression_geo.h"
+#include "mongo/db/matcher/expression_tree.h"
+#include "mongo/db/query/collation/collator_interface.h"
+#include "mongo/db/query/index_bounds_builder.h"
+#include "mongo/db/query/indexability.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/query/query_planner_common.h"
 #include "mongo/util/log.h"
@@ -302,6 +307,92 @@ auto isCoveredOrAlreadyFetched(const vector<StringData>& fields,
     return true;
 }
 
+/**
+ * Returns true if 'expr' gives the same result when applied to the keys of the index scanned by
+ * 'isn' as when applied to the documents. This holds for the predicates over a field of a
+ * non-multikey btree index which translate to EXACT or INEXACT_COVERED bounds, which are those
+ * that the access planner attaches to an index scan as a covered filter.
+ */
+bool isCoveredByIndexScan(const CanonicalQuery& query,
+                          const IndexScanNode* isn,
+                          const MatchExpression* expr) {
+    const IndexEntry& index = isn->index;
+    if (INDEX_BTREE != index.type || index.multikey ||
+        !CollatorInterface::collatorsMatch(query.getCollator(), index.collator)) {
+        return false;
+    }
+
+    if (!Indexability::isBoundsGenerating(expr) || MatchExpression::GEO == expr->matchType() ||
+        MatchExpression::GEO_NEAR == expr->matchType() ||
+        (index.sparse && MatchExpression::NOT == expr->matchType())) {
+        return false;
+    }
+
+    const BSONElement keyElt = index.keyPattern.getField(expr->path());
+    if (keyElt.eoo()) {
+        return false;
+    }
+
+    OrderedIntervalList oil;
+    IndexBoundsBuilder::BoundsTightness tightness;
+    IndexBoundsBuilder::translate(expr, keyElt, index, &oil, &tightness);
+    return IndexBoundsBuilder::EXACT == tightness ||
+        IndexBoundsBuilder::INEXACT_COVERED == tightness;
+}
+
+/**
+ * If 'solnRoot' is a FETCH over an index scan, moves the predicates of the FETCH filter which the
+ * index covers onto the index scan. The FETCH is dropped if nothing is left for it to filter, in
+ * which case the documents are fetched only after any blocking sort, skip and limit have
+ * discarded the index keys they don't need.
+ */
+std::unique_ptr<QuerySolutionNode> pushCoveredPredicatesToIndexScan(
+    const CanonicalQuery& query, std::unique_ptr<QuerySolutionNode> solnRoot) {
+    if (STAGE_FETCH != solnRoot->getType() || !solnRoot->filter ||
+        STAGE_IXSCAN != solnRoot->children[0]->getType()) {
+        return solnRoot;
+    }
+
+    auto isn = static_cast<IndexScanNode*>(solnRoot->children[0]);
+    std::vector<MatchExpression*> covered;
+    if (MatchExpression::AND == solnRoot->filter->matchType()) {
+        auto children = solnRoot->filter->getChildVector();
+        auto it = std::stable_partition(children->begin(),
+                                        children->end(),
+                                        [&](MatchExpression* child) {
+                                            return !isCoveredByIndexScan(query, isn, child);
+                                        });
+        covered.assign(it, children->end());
+        children->erase(it, children->end());
+    } else if (isCoveredByIndexScan(query, isn, solnRoot->filter.get())) {
+        covered.push_back(solnRoot->filter.release());
+    }
+
+    if (covered.empty()) {
+        return solnRoot;
+    }
+
+    auto scanFilter = std::make_unique<AndMatchExpression>();
+    if (isn->filter) {
+        scanFilter->add(isn->filter.release());
+    }
+    for (auto&& expr : covered) {
+        scanFilter->add(expr);
+    }
+    isn->filter = MatchExpression::optimize(std::move(scanFilter));
+
+    if (solnRoot->filter) {
+        solnRoot->filter = MatchExpression::optimize(std::move(solnRoot->filter));
+    }
+    if (solnRoot->filter && !(MatchExpression::AND == solnRoot->filter->matchType() &&
+                              0 == solnRoot->filter->numChildren())) {
+        return solnRoot;
+    }
+
+    solnRoot->children.clear();
+    return std::unique_ptr<QuerySolutionNode>(isn);
+}
+
 /**
  * Checks all properties that exclude a projection from being simple.
  */
@@ -741,6 +832,8 @@ std::unique_ptr<QuerySolution> QueryPlannerAnalysis::analyzeDataAccess(
 
     analyzeGeo(params, solnRoot.get());
 
+    solnRoot = pushCoveredPredicatesToIndexScan(query, std::move(solnRoot));
+
     // solnRoot finds all our results.  Let's see what transformations we must perform to the
     // data.
 
@@ -34,11 +34,13 @@
 #include "mongo/db/query/query_planner.h"
 
 #include <boost/optional.hpp>
+#include <set>
 #include <vector>
 
 #include "mongo/base/string_data.h"
 #include "mongo/bson/simple_bsonelement_comparator.h"
 #include "mongo/db/bson/dotted_path_support.h"
+#include "mongo/db/field_ref.h"
 #include "mongo/db/index/wildcard_key_generator.h"
 #include "mongo/db/index_names.h"
 #include "mongo/db/matcher/expression_algo.h"
@@ -289,6 +291,145 @@ std::unique_ptr<QuerySolution> buildWholeIXSoln(const IndexEntry& index,
     return QueryPlannerAnalysis::analyzeDataAccess(query, params, std::move(solnRoot));
 }
 
+std::unique_ptr<QuerySolution> buildSkipScanSoln(const IndexEntry& index,
+                                                 const CanonicalQuery& query,
+                                                 const QueryPlannerParams& params,
+                                                 int direction = 1) {
+    std::unique_ptr<QuerySolutionNode> solnRoot(
+        QueryPlannerAccess::skipScanIndex(index, query, params, direction));
+    if (!solnRoot) {
+        return nullptr;
+    }
+    return QueryPlannerAnalysis::analyzeDataAccess(query, params, std::move(solnRoot));
+}
+
+/**
+ * Adds the paths read by 'node' to 'fields'. Returns false if the result of 'node' may depend on
+ * more of the document than its paths, as for $where and $expr, or if 'node' requires an index.
+ */
+static bool getColumnScanFields(const MatchExpression* node, std::set<std::string>* fields) {
+    if (node->matchType() == MatchExpression::GEO_NEAR) {
+        return false;
+    }
+
+    if (node->getCategory() == MatchExpression::MatchCategory::kLogical) {
+        for (size_t i = 0; i < node->numChildren(); ++i) {
+            if (!getColumnScanFields(node->getChild(i), fields)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    if (node->matchType() == MatchExpression::ALWAYS_TRUE ||
+        node->matchType() == MatchExpression::ALWAYS_FALSE) {
+        return true;
+    }
+
+    // The value of a path holds everything beneath it, so the children of nodes such as
+    // $elemMatch need no fields of their own.
+    if (node->path().empty()) {
+        return false;
+    }
+    fields->insert(node->path().toString());
+    return true;
+}
+
+/**
+ * Builds a solution which reads the columns of the columnstore 'index' in place of a collection
+ * scan, or returns nullptr if the index lacks a column for some field the query needs. The objects
+ * reconstructed from the columns hold only the indexed paths, so the query must have a projection
+ * which can be computed without the whole document.
+ */
+std::unique_ptr<QuerySolution> buildColumnScanSoln(const IndexEntry& index,
+                                                   const CanonicalQuery& query,
+                                                   const QueryPlannerParams& params) {
+    invariant(index.type == IndexType::INDEX_COLUMN);
+
+    const QueryRequest& qr = query.getQueryRequest();
+    const ParsedProjection* proj = query.getProj();
+    if (!proj || proj->requiresDocument() || proj->wantIndexKey() || proj->wantSortKey() ||
+        !qr.getSort().isEmpty() || !qr.getMin().isEmpty() || !qr.getMax().isEmpty() ||
+        (params.options & QueryPlannerParams::INCLUDE_SHARD_FILTER)) {
+        return nullptr;
+    }
+
+    std::set<std::string> fields;
+    for (auto&& field : proj->getRequiredFields()) {
+        fields.insert(field.toString());
+    }
+    if (!getColumnScanFields(query.root(), &fields)) {
+        return nullptr;
+    }
+
+    // Each field is read from the column of the indexed path equal to it or containing it.
+    std::set<std::string> neededPaths;
+    for (auto&& field : fields) {
+        const FieldRef fieldRef(field);
+        bool covered = false;
+        for (auto&& elem : index.keyPattern) {
+            if (FieldRef(elem.fieldNameStringData()).isPrefixOfOrEqualTo(fieldRef)) {
+                neededPaths.insert(elem.fieldName());
+                covered = true;
+                break;
+            }
+        }
+        if (!covered) {
+            return nullptr;
+        }
+    }
+
+    std::vector<std::string> paths;
+    for (auto&& elem : index.keyPattern) {
+        if (neededPaths.count(elem.fieldName())) {
+            paths.push_back(elem.fieldName());
+        }
+    }
+
+    auto csn = stdx::make_unique<ColumnScanNode>(index, std::move(paths));
+    csn->filter = query.root()->shallowClone();
+    auto soln = QueryPlannerAnalysis::analyzeDataAccess(query, params, std::move(csn));
+    if (soln) {
+        auto scd = stdx::make_unique<SolutionCacheData>();
+        auto indexTree = stdx::make_unique<PlanCacheIndexTree>();
+        indexTree->setIndexEntry(index);
+        scd->tree = std::move(indexTree);
+        scd->solnType = SolutionCacheData::COLUMN_SCAN_SOLN;
+        soln->cacheData = std::move(scd);
+    }
+    return soln;
+}
+
+/**
+ * Builds a solution which scans 'index' in 'direction' to provide the sort. If skip scans are
+ * enabled and the query constrains a non-leading field of the index, the scan is bounded on that
+ * field rather than over the whole index.
+ */
+std::unique_ptr<QuerySolution> buildSortProvidingIXSoln(const IndexEntry& index,
+                                                        const CanonicalQuery& query,
+                                                        const QueryPlannerParams& params,
+                                                        int direction) {
+    auto scd = stdx::make_unique<SolutionCacheData>();
+    auto indexTree = stdx::make_unique<PlanCacheIndexTree>();
+    indexTree->setIndexEntry(index);
+    scd->tree = std::move(indexTree);
+    scd->wholeIXSolnDir = direction;
+
+    std::unique_ptr<QuerySolution> soln;
+    if (params.options & QueryPlannerParams::GENERATE_SKIP_SCANS) {
+        soln = buildSkipScanSoln(index, query, params, direction);
+        scd->solnType = SolutionCacheData::SKIP_SCAN_SOLN;
+    }
+    if (!soln) {
+        soln = buildWholeIXSoln(index, query, params, direction);
+        scd->solnType = SolutionCacheData::WHOLE_IXSCAN_SOLN;
+    }
+    if (soln) {
+        soln->cacheData = std::move(scd);
+    }
+    return soln;
+}
+
 bool providesSort(const CanonicalQuery& query, const BSONObj& kp) {
     return query.getQueryRequest().getSort().isPrefixOf(kp, SimpleBSONElementComparator::kInstance);
 }
@@ -458,6 +599,23 @@ StatusWith<std::unique_ptr<QuerySolution>> QueryPlanner::planFromCache(
         } else {
             return {std::move(soln)};
         }
+    } else if (SolutionCacheData::SKIP_SCAN_SOLN == winnerCacheData.solnType) {
+        // The solution can be constructed by a skip scan over the index.
+        auto soln = buildSkipScanSoln(
+            *winnerCacheData.tree->entry, query, params, winnerCacheData.wholeIXSolnDir);
+        if (!soln) {
+            return Status(ErrorCodes::BadValue, "plan cache error: skip scan soln");
+        } else {
+            return {std::move(soln)};
+        }
+    } else if (SolutionCacheData::COLUMN_SCAN_SOLN == winnerCacheData.solnType) {
+        // The solution reads the columns of a columnstore index.
+        auto soln = buildColumnScanSoln(*winnerCacheData.tree->entry, query, params);
+        if (!soln) {
+            return Status(ErrorCodes::BadValue, "plan cache error: column scan soln");
+        } else {
+            return {std::move(soln)};
+        }
     } else if (SolutionCacheData::COLLSCAN_SOLN == winnerCacheData.solnType) {
         // The cached solution is a collection scan. We don't cache collscans
         // with tailable==true, hence the false below.
@@ -615,6 +773,29 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::plan(
         }
     }
 
+    // Columnstore indexes cannot be scanned with bounds, so they are only considered in place of a
+    // collection scan.
+    std::vector<IndexEntry> columnStoreIndexes;
+    for (auto it = fullIndexList.begin(); it != fullIndexList.end();) {
+        if (it->type == IndexType::INDEX_COLUMN) {
+            columnStoreIndexes.push_back(std::move(*it));
+            it = fullIndexList.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    if (!hintedIndex.isEmpty() && !columnStoreIndexes.empty()) {
+        auto soln = buildColumnScanSoln(columnStoreIndexes.front(), query, params);
+        if (!soln) {
+            return Status(ErrorCodes::BadValue,
+                          "hinted columnstore index does not have a column for every field the "
+                          "query needs");
+        }
+        out.push_back(std::move(soln));
+        return {std::move(out)};
+    }
+
     // Figure out what fields we care about.
     stdx::unordered_set<string> fields;
     QueryPlannerIXSelect::getFields(query.root(), &fields);
@@ -925,16 +1106,8 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::plan(
                 const BSONObj kp = QueryPlannerAnalysis::getSortPattern(index.keyPattern);
                 if (providesSort(query, kp)) {
                     LOG(5) << "Planner: outputting soln that uses index to provide sort.";
-                    auto soln = buildWholeIXSoln(fullIndexList[i], query, params);
+                    auto soln = buildSortProvidingIXSoln(fullIndexList[i], query, params, 1);
                     if (soln) {
-                        PlanCacheIndexTree* indexTree = new PlanCacheIndexTree();
-                        indexTree->setIndexEntry(fullIndexList[i]);
-                        SolutionCacheData* scd = new SolutionCacheData();
-                        scd->tree.reset(indexTree);
-                        scd->solnType = SolutionCacheData::WHOLE_IXSCAN_SOLN;
-                        scd->wholeIXSolnDir = 1;
-
-                        soln->cacheData.reset(scd);
                         out.push_back(std::move(soln));
                         break;
                     }
@@ -942,16 +1115,8 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::plan(
                 if (providesSort(query, QueryPlannerCommon::reverseSortObj(kp))) {
                     LOG(5) << "Planner: outputting soln that uses (reverse) index "
                            << "to provide sort.";
-                    auto soln = buildWholeIXSoln(fullIndexList[i], query, params, -1);
+                    auto soln = buildSortProvidingIXSoln(fullIndexList[i], query, params, -1);
                     if (soln) {
-                        PlanCacheIndexTree* indexTree = new PlanCacheIndexTree();
-                        indexTree->setIndexEntry(fullIndexList[i]);
-                        SolutionCacheData* scd = new SolutionCacheData();
-                        scd->tree.reset(indexTree);
-                        scd->solnType = SolutionCacheData::WHOLE_IXSCAN_SOLN;
-                        scd->wholeIXSolnDir = -1;
-
-                        soln->cacheData.reset(scd);
                         out.push_back(std::move(soln));
                         break;
                     }
@@ -1000,13 +1165,60 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::plan(
         !QueryPlannerCommon::hasNode(query.root(), MatchExpression::GEO_NEAR) &&
         !QueryPlannerCommon::hasNode(query.root(), MatchExpression::TEXT) && hintedIndex.isEmpty();
 
+    // If no index could be used for the predicates, an index whose leading fields are
+    // unconstrained may still be scanned by skipping between the values of those fields. Whether
+    // that beats a collection scan depends on the number of distinct leading values, so these
+    // plans are left to the multi-planner to rank against the collscan.
+    size_t numSkipScanSolutions = 0;
+    if ((params.options & QueryPlannerParams::GENERATE_SKIP_SCANS) && out.empty() &&
+        possibleToCollscan) {
+        for (auto&& index : fullIndexList) {
+            if (out.size() >= params.maxIndexedSolutions) {
+                break;
+            }
+
+            auto soln = buildSkipScanSoln(index, query, params);
+            if (soln) {
+                LOG(5) << "Planner: outputting soln that skip scans index " << index.identifier;
+                PlanCacheIndexTree* indexTree = new PlanCacheIndexTree();
+                indexTree->setIndexEntry(index);
+
+                SolutionCacheData* scd = new SolutionCacheData();
+                scd->tree.reset(indexTree);
+                scd->solnType = SolutionCacheData::SKIP_SCAN_SOLN;
+                scd->wholeIXSolnDir = 1;
+                soln->cacheData.reset(scd);
+
+                out.push_back(std::move(soln));
+                ++numSkipScanSolutions;
+            }
+        }
+    }
+
     // The caller can explicitly ask for a collscan.
     bool collscanRequested = (params.options & QueryPlannerParams::INCLUDE_COLLSCAN);
 
-    // No indexed plans?  We must provide a collscan if possible or else we can't run the query.
-    bool collscanNeeded = (0 == out.size() && canTableScan);
+    // No indexed plans other than skip scans?  We must provide a collscan if possible or else we
+    // can't run the query.
+    bool collscanNeeded = (numSkipScanSolutions == out.size() && canTableScan);
+
+    // Reading only the needed columns of a columnstore index costs less than reading every
+    // document, so a column scan takes the place of the collscan unless the caller asked for one.
+    bool outputColumnScan = false;
+    if (possibleToCollscan && collscanNeeded) {
+        for (auto&& index : columnStoreIndexes) {
+            auto columnScan = buildColumnScanSoln(index, query, params);
+            if (columnScan) {
+                LOG(5) << "Planner: outputting a column scan:" << endl
+                       << redact(columnScan->toString());
+                out.push_back(std::move(columnScan));
+                outputColumnScan = true;
+                break;
+            }
+        }
+    }
 
-    if (possibleToCollscan && (collscanRequested || collscanNeeded)) {
+    if (possibleToCollscan && (collscanRequested || (collscanNeeded && !outputColumnScan))) {
         auto collscan = buildCollscanSoln(query, isTailable, params);
         if (collscan) {
             LOG(5) << "Planner: outputting a collscan:" << endl << redact(collscan->toString());
@@ -61,6 +61,11 @@ void QueryPlannerCommon::reverseScans(QuerySolutionNode* node) {
                   str::stream() << "Invalid bounds: " << redact(dn->bounds.toString()));
 
         dn->computeProperties();
+    } else if (STAGE_COLLSCAN == type) {
+        // Only a scan of a collection clustered by _id provides a sort to reverse.
+        CollectionScanNode* csn = static_cast<CollectionScanNode*>(node);
+        csn->direction *= -1;
+        csn->computeProperties();
     } else if (STAGE_SORT_MERGE == type) {
         // reverse direction of comparison for merge
         MergeSortNode* msn = static_cast<MergeSortNode*>(node);
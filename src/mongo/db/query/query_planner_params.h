@@ -98,6 +98,15 @@ struct QueryPlannerParams {
         // return exactly one document per value of the distinct field. See the comments above the
         // declaration of getExecutorDistinct() for more detail.
         STRICT_DISTINCT_ONLY = 1 << 11,
+
+        // Set this to generate IXSCAN plans over indexes whose leading fields are unconstrained by
+        // the query, when no index can be used otherwise. The scan skips from one value of the
+        // leading fields to the next using the bounds on a later field.
+        GENERATE_SKIP_SCANS = 1 << 12,
+
+        // Set this if the collection is clustered by _id. Its collection scans then read only the
+        // range of _ids the query allows, and return documents in _id order.
+        CLUSTERED_BY_ID = 1 << 13,
     };
 
     // See Options enum above.
@@ -39,6 +39,7 @@
 #include "mongo/db/query/collation/collator_interface_mock.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/query/query_planner_test_fixture.h"
+#include "mongo/db/storage/clustered_record_id.h"
 
 namespace {
 
@@ -1796,6 +1797,117 @@ TEST_F(QueryPlannerTest, SortSkipSoftLimit) {
         "{node: {cscan: {dir: 1}}}}}}}}");
 }
 
+TEST_F(QueryPlannerTest, CoveredPredicatesAreFilteredBeforeFetchWithSkipAndLimit) {
+    addIndex(BSON("a" << 1 << "b" << 1));
+    runQuerySortProjSkipNToReturn(fromjson("{b: {$gt: 5}}"), fromjson("{a: 1}"), BSONObj(), 2, -3);
+
+    assertNumSolutions(2U);
+    assertSolutionExists(
+        "{skip: {n: 2, node: {sort: {pattern: {a: 1}, limit: 5, node: {sortKeyGen: "
+        "{node: {cscan: {dir: 1, filter: {b: {$gt: 5}}}}}}}}}}");
+    assertSolutionExists(
+        "{limit: {n: 3, node: {fetch: {filter: null, node: {skip: {n: 2, node: "
+        "{ixscan: {filter: {b: {$gt: 5}}, pattern: {a: 1, b: 1}}}}}}}}}");
+}
+
+TEST_F(QueryPlannerTest, OnlyUncoveredPredicatesAreLeftOnFetchBelowSort) {
+    addIndex(BSON("a" << 1 << "b" << 1));
+    runQuerySortProj(fromjson("{b: {$gt: 5}, c: 1}"), fromjson("{a: 1}"), BSONObj());
+
+    assertNumSolutions(2U);
+    assertSolutionExists(
+        "{sort: {pattern: {a: 1}, limit: 0, node: {sortKeyGen: "
+        "{node: {cscan: {dir: 1, filter: {b: {$gt: 5}, c: 1}}}}}}}");
+    assertSolutionExists(
+        "{fetch: {filter: {c: 1}, node: "
+        "{ixscan: {filter: {b: {$gt: 5}}, pattern: {a: 1, b: 1}}}}}");
+}
+
+TEST_F(QueryPlannerTest, PredicatesOnMultikeyIndexAreNotFilteredBeforeFetch) {
+    // true means multikey
+    addIndex(BSON("a" << 1 << "b" << 1), true);
+    runQuerySortProjSkipNToReturn(fromjson("{b: {$gt: 5}}"), fromjson("{a: 1}"), BSONObj(), 0, -3);
+
+    assertNumSolutions(2U);
+    assertSolutionExists(
+        "{sort: {pattern: {a: 1}, limit: 3, node: {sortKeyGen: "
+        "{node: {cscan: {dir: 1, filter: {b: {$gt: 5}}}}}}}}");
+    assertSolutionExists(
+        "{limit: {n: 3, node: {fetch: {filter: {b: {$gt: 5}}, node: "
+        "{ixscan: {filter: null, pattern: {a: 1, b: 1}}}}}}}");
+}
+
+//
+// Skip scans
+//
+
+TEST_F(QueryPlannerTest, SkipScanNotGeneratedUnlessEnabled) {
+    addIndex(BSON("a" << 1 << "b" << 1));
+    runQuery(fromjson("{b: 5}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists("{cscan: {dir: 1, filter: {b: 5}}}");
+}
+
+TEST_F(QueryPlannerTest, SkipScanOverUnconstrainedLeadingField) {
+    params.options |= QueryPlannerParams::GENERATE_SKIP_SCANS;
+    addIndex(BSON("a" << 1 << "b" << 1));
+    runQuery(fromjson("{b: 5}"));
+
+    assertNumSolutions(2U);
+    assertSolutionExists("{cscan: {dir: 1, filter: {b: 5}}}");
+    assertSolutionExists(
+        "{fetch: {filter: null, node: {ixscan: {filter: null, pattern: {a: 1, b: 1}, bounds: "
+        "{a: [['MinKey', 'MaxKey', true, true]], b: [[5, 5, true, true]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, SkipScanLeavesUnboundedPredicatesOnFetch) {
+    params.options |= QueryPlannerParams::GENERATE_SKIP_SCANS;
+    addIndex(BSON("a" << 1 << "b" << 1));
+    runQuery(fromjson("{b: {$gt: 5}, c: 1}"));
+
+    assertNumSolutions(2U);
+    assertSolutionExists("{cscan: {dir: 1, filter: {b: {$gt: 5}, c: 1}}}");
+    assertSolutionExists(
+        "{fetch: {filter: {c: 1}, node: {ixscan: {filter: null, pattern: {a: 1, b: 1}, bounds: "
+        "{a: [['MinKey', 'MaxKey', true, true]], b: [[5, Infinity, false, true]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, SkipScanCanBeCovered) {
+    params.options |= QueryPlannerParams::GENERATE_SKIP_SCANS;
+    addIndex(BSON("a" << 1 << "b" << 1));
+    runQuerySortProj(fromjson("{b: 5}"), BSONObj(), fromjson("{_id: 0, b: 1}"));
+
+    assertNumSolutions(2U);
+    assertSolutionExists("{proj: {spec: {_id: 0, b: 1}, node: {cscan: {dir: 1, filter: {b: 5}}}}}");
+    assertSolutionExists(
+        "{proj: {spec: {_id: 0, b: 1}, node: {ixscan: {filter: null, pattern: {a: 1, b: 1}, "
+        "bounds: {a: [['MinKey', 'MaxKey', true, true]], b: [[5, 5, true, true]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, SkipScanProvidesSortOnLeadingField) {
+    params.options |= QueryPlannerParams::GENERATE_SKIP_SCANS;
+    addIndex(BSON("a" << 1 << "b" << 1));
+    runQuerySortProj(fromjson("{b: 5}"), fromjson("{a: -1}"), BSONObj());
+
+    assertNumSolutions(2U);
+    assertSolutionExists(
+        "{sort: {pattern: {a: -1}, limit: 0, node: {sortKeyGen: "
+        "{node: {cscan: {dir: 1, filter: {b: 5}}}}}}}");
+    assertSolutionExists(
+        "{fetch: {filter: null, node: {ixscan: {filter: null, dir: -1, pattern: {a: 1, b: 1}, "
+        "bounds: {a: [['MaxKey', 'MinKey', true, true]], b: [[5, 5, true, true]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, SkipScanNotGeneratedForSparseIndex) {
+    params.options |= QueryPlannerParams::GENERATE_SKIP_SCANS;
+    addIndex(BSON("a" << 1 << "b" << 1), false, true);
+    runQuery(fromjson("{b: 5}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists("{cscan: {dir: 1, filter: {b: 5}}}");
+}
+
 //
 // Sort elimination
 //
@@ -5975,4 +6087,49 @@ TEST_F(QueryPlannerTest, FetchAfterSortWhenOnlyProjectNeedsDocuments) {
         "{sortKeyGen:{node: {ixscan: "
         "{pattern: {a: 1, b: 1}}}}}}}}}}}");
 }
+
+//
+// Collections clustered by _id
+//
+
+TEST_F(QueryPlannerTest, ClusteredCollectionScanProvidesIdSort) {
+    params.options |= QueryPlannerParams::CLUSTERED_BY_ID;
+    addIndex(BSON("a" << 1));
+
+    runQuerySortProj(BSONObj(), BSON("_id" << 1), BSONObj());
+    assertNumSolutions(1U);
+    assertSolutionExists("{cscan: {dir: 1}}");
+
+    runQuerySortProj(BSONObj(), BSON("_id" << -1), BSONObj());
+    assertNumSolutions(1U);
+    assertSolutionExists("{cscan: {dir: -1}}");
+
+    // Only a collection clustered by _id returns documents in _id order.
+    params.options &= ~QueryPlannerParams::CLUSTERED_BY_ID;
+    runQuerySortProj(BSONObj(), BSON("_id" << 1), BSONObj());
+    assertNumSolutions(1U);
+    assertSolutionExists("{sort: {pattern: {_id: 1}, limit: 0, node: {sortKeyGen: {node: "
+                         "{cscan: {dir: 1}}}}}}");
+}
+
+TEST_F(QueryPlannerTest, ClusteredCollectionScanIsBoundedByIdRange) {
+    params.options |= QueryPlannerParams::CLUSTERED_BY_ID;
+
+    runQuery(fromjson("{_id: {$gte: 5, $lt: 10}, a: 1}"));
+    assertNumSolutions(1U);
+    assertSolutionExists("{cscan: {dir: 1, filter: {_id: {$gte: 5, $lt: 10}, a: 1}}}");
+    auto csn = static_cast<const CollectionScanNode*>(solns[0]->root.get());
+    ASSERT_EQ(clustered_record_id::keyForId(BSON("" << 5).firstElement()).getValue(),
+              *csn->minRecord);
+    ASSERT_EQ(clustered_record_id::keyForId(BSON("" << 10).firstElement()).getValue(),
+              *csn->maxRecord);
+
+    // A bound which can't be a cluster key leaves that side of the scan open.
+    runQuery(fromjson("{_id: {$gt: 'abc', $lte: 7}}"));
+    assertNumSolutions(1U);
+    csn = static_cast<const CollectionScanNode*>(solns[0]->root.get());
+    ASSERT_FALSE(csn->minRecord);
+    ASSERT_EQ(clustered_record_id::keyForId(BSON("" << 7).firstElement()).getValue(),
+              *csn->maxRecord);
+}
 }  // namespace
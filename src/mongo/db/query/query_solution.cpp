@@ -34,6 +34,7 @@
 #include "mongo/bson/bsontypes.h"
 #include "mongo/bson/mutable/document.h"
 #include "mongo/bson/simple_bsonelement_comparator.h"
+#include "mongo/db/field_ref.h"
 #include "mongo/db/index_names.h"
 #include "mongo/db/matcher/expression_geo.h"
 #include "mongo/db/query/collation/collation_index_key.h"
@@ -233,6 +234,14 @@ void CollectionScanNode::appendToString(mongoutils::str::stream* ss, int indent)
     *ss << "COLLSCAN\n";
     addIndent(ss, indent + 1);
     *ss << "ns = " << name << '\n';
+    if (minRecord) {
+        addIndent(ss, indent + 1);
+        *ss << "minRecord = " << *minRecord << '\n';
+    }
+    if (maxRecord) {
+        addIndent(ss, indent + 1);
+        *ss << "maxRecord = " << *maxRecord << '\n';
+    }
     if (NULL != filter) {
         addIndent(ss, indent + 1);
         *ss << "filter = " << filter->debugString();
@@ -240,6 +249,13 @@ void CollectionScanNode::appendToString(mongoutils::str::stream* ss, int indent)
     addCommon(ss, indent);
 }
 
+void CollectionScanNode::computeProperties() {
+    _sort.clear();
+    if (clusteredById) {
+        _sort.insert(BSON("_id" << direction));
+    }
+}
+
 QuerySolutionNode* CollectionScanNode::clone() const {
     CollectionScanNode* copy = new CollectionScanNode();
     cloneBaseData(copy);
@@ -250,6 +266,55 @@ QuerySolutionNode* CollectionScanNode::clone() const {
     copy->direction = this->direction;
     copy->shouldTrackLatestOplogTimestamp = this->shouldTrackLatestOplogTimestamp;
     copy->shouldWaitForOplogVisibility = this->shouldWaitForOplogVisibility;
+    copy->clusteredById = this->clusteredById;
+    copy->minRecord = this->minRecord;
+    copy->maxRecord = this->maxRecord;
+
+    return copy;
+}
+
+//
+// ColumnScanNode
+//
+
+ColumnScanNode::ColumnScanNode(IndexEntry index, std::vector<std::string> paths)
+    : _sort(SimpleBSONObjComparator::kInstance.makeBSONObjSet()),
+      index(std::move(index)),
+      paths(std::move(paths)) {}
+
+void ColumnScanNode::appendToString(mongoutils::str::stream* ss, int indent) const {
+    addIndent(ss, indent);
+    *ss << "COLUMN_SCAN\n";
+    addIndent(ss, indent + 1);
+    *ss << "indexName = " << index.identifier.catalogName << '\n';
+    addIndent(ss, indent + 1);
+    *ss << "paths = [";
+    for (size_t i = 0; i < paths.size(); ++i) {
+        *ss << (i == 0 ? " " : ", ") << paths[i];
+    }
+    *ss << " ]\n";
+    if (NULL != filter) {
+        addIndent(ss, indent + 1);
+        *ss << "filter = " << filter->debugString();
+    }
+    addCommon(ss, indent);
+}
+
+bool ColumnScanNode::hasField(const std::string& field) const {
+    const FieldRef fieldRef(field);
+    for (auto&& path : paths) {
+        if (FieldRef(path).isPrefixOfOrEqualTo(fieldRef)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+QuerySolutionNode* ColumnScanNode::clone() const {
+    ColumnScanNode* copy = new ColumnScanNode(this->index, this->paths);
+    cloneBaseData(copy);
+
+    copy->_sort = this->_sort;
 
     return copy;
 }
@@ -39,6 +39,7 @@
 #include "mongo/db/query/index_bounds.h"
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/stage_types.h"
+#include "mongo/db/record_id.h"
 
 namespace mongo {
 
@@ -299,6 +300,8 @@ struct CollectionScanNode : public QuerySolutionNode {
 
     virtual void appendToString(mongoutils::str::stream* ss, int indent) const;
 
+    void computeProperties();
+
     bool fetched() const {
         return true;
     }
@@ -319,6 +322,14 @@ struct CollectionScanNode : public QuerySolutionNode {
     // Name of the namespace.
     std::string name;
 
+    // Whether the collection is clustered by _id, so that the scan returns documents in _id order.
+    bool clusteredById = false;
+
+    // If present, the scan reads only the records from 'minRecord' to 'maxRecord'. Only set for
+    // collections clustered by _id.
+    boost::optional<RecordId> minRecord;
+    boost::optional<RecordId> maxRecord;
+
     // Should we make a tailable cursor?
     bool tailable;
 
@@ -333,6 +344,43 @@ struct CollectionScanNode : public QuerySolutionNode {
     bool shouldWaitForOplogVisibility = false;
 };
 
+/**
+ * Reads the columns of a columnstore index and reconstructs, for every document in the collection,
+ * an object holding only the values of 'paths'. Used in place of a collection scan when the index
+ * has a column for every field the query needs.
+ */
+struct ColumnScanNode : public QuerySolutionNode {
+    ColumnScanNode(IndexEntry index, std::vector<std::string> paths);
+    virtual ~ColumnScanNode() {}
+
+    virtual StageType getType() const {
+        return STAGE_COLUMN_SCAN;
+    }
+
+    virtual void appendToString(mongoutils::str::stream* ss, int indent) const;
+
+    // The reconstructed objects are not whole documents, but they hold every field within 'paths'.
+    bool fetched() const {
+        return false;
+    }
+    bool hasField(const std::string& field) const;
+    bool sortedByDiskLoc() const {
+        return false;
+    }
+    const BSONObjSet& getSort() const {
+        return _sort;
+    }
+
+    QuerySolutionNode* clone() const;
+
+    BSONObjSet _sort;
+
+    IndexEntry index;
+
+    // The indexed paths whose columns are read.
+    std::vector<std::string> paths;
+};
+
 struct AndHashNode : public QuerySolutionNode {
     AndHashNode();
     virtual ~AndHashNode();
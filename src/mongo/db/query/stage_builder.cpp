@@ -40,6 +40,7 @@
 #include "mongo/db/exec/and_hash.h"
 #include "mongo/db/exec/and_sorted.h"
 #include "mongo/db/exec/collection_scan.h"
+#include "mongo/db/exec/column_scan.h"
 #include "mongo/db/exec/count_scan.h"
 #include "mongo/db/exec/distinct_scan.h"
 #include "mongo/db/exec/ensure_sorted.h"
@@ -57,6 +58,7 @@
 #include "mongo/db/exec/text.h"
 #include "mongo/db/index/fts_access_method.h"
 #include "mongo/db/matcher/extensions_callback_real.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/s/collection_sharding_state.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/log.h"
@@ -66,6 +68,27 @@ namespace mongo {
 using std::unique_ptr;
 using stdx::make_unique;
 
+namespace {
+
+/**
+ * Returns true if a blocking sort by 'pattern' may buffer only the sort keys and RecordIds of
+ * fetched documents. A $meta sort depends on more than the document, so its sort key could not be
+ * checked again for a document that was fetched in a new snapshot.
+ */
+bool canSortMaterializeLate(const BSONObj& pattern) {
+    if (!internalQueryExecEnableSortLateMaterialization.load()) {
+        return false;
+    }
+    for (auto&& elt : pattern) {
+        if (elt.type() == BSONType::Object) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
 PlanStage* buildStages(OperationContext* opCtx,
                        const Collection* collection,
                        const CanonicalQuery& cq,
@@ -81,8 +104,27 @@ PlanStage* buildStages(OperationContext* opCtx,
             params.direction = (csn->direction == 1) ? CollectionScanParams::FORWARD
                                                      : CollectionScanParams::BACKWARD;
             params.shouldWaitForOplogVisibility = csn->shouldWaitForOplogVisibility;
+            params.minRecord = csn->minRecord;
+            params.maxRecord = csn->maxRecord;
             return new CollectionScan(opCtx, collection, params, ws, csn->filter.get());
         }
+        case STAGE_COLUMN_SCAN: {
+            const ColumnScanNode* csn = static_cast<const ColumnScanNode*>(root);
+
+            if (nullptr == collection) {
+                warning() << "Can't column scan null namespace";
+                return nullptr;
+            }
+
+            auto descriptor = collection->getIndexCatalog()->findIndexByName(
+                opCtx, csn->index.identifier.catalogName);
+            invariant(descriptor,
+                      str::stream() << "Namespace: " << collection->ns() << ", CanonicalQuery: "
+                                    << cq.toStringShort()
+                                    << ", IndexEntry: "
+                                    << csn->index.toString());
+            return new ColumnScan(opCtx, descriptor, csn->paths, ws, csn->filter.get());
+        }
         case STAGE_IXSCAN: {
             const IndexScanNode* ixn = static_cast<const IndexScanNode*>(root);
 
@@ -129,6 +171,11 @@ PlanStage* buildStages(OperationContext* opCtx,
             SortStageParams params;
             params.pattern = sn->pattern;
             params.limit = sn->limit;
+            if (canSortMaterializeLate(sn->pattern)) {
+                params.collection = collection;
+                params.filter = cq.root();
+                params.collator = cq.getCollator();
+            }
             return new SortStage(opCtx, params, ws, childStage);
         }
         case STAGE_SORT_KEY_GENERATOR: {
@@ -192,7 +239,7 @@ PlanStage* buildStages(OperationContext* opCtx,
         }
         case STAGE_AND_HASH: {
             const AndHashNode* ahn = static_cast<const AndHashNode*>(root);
-            auto ret = make_unique<AndHashStage>(opCtx, ws);
+            auto ret = make_unique<AndHashStage>(opCtx, ws, /*chooseBuildChild*/ true);
             for (size_t i = 0; i < ahn->children.size(); ++i) {
                 PlanStage* childStage =
                     buildStages(opCtx, collection, cq, qsol, ahn->children[i], ws);
@@ -40,6 +40,10 @@ enum StageType {
     STAGE_CACHED_PLAN,
     STAGE_COLLSCAN,
 
+    // Reconstructs documents from the columns of a columnstore index in place of a collection
+    // scan.
+    STAGE_COLUMN_SCAN,
+
     // This stage sits at the root of the query tree and counts up the number of results
     // returned by its child.
     STAGE_COUNT,
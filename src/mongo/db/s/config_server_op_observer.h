@@ -157,6 +157,8 @@ public:
                        const NamespaceString& collectionName,
                        OptionalCollectionUUID uuid) override {}
 
+    void onBatchedWriteCommit(OperationContext* opCtx) override {}
+
     void onUnpreparedTransactionCommit(
         OperationContext* opCtx, const std::vector<repl::ReplOperation>& statements) override {}
 
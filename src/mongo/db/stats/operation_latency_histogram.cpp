@@ -32,13 +32,26 @@
 #include "mongo/db/stats/operation_latency_histogram.h"
 
 #include <algorithm>
+#include <cmath>
 
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/platform/bits.h"
+#include "mongo/util/assert_util.h"
 
 namespace mongo {
 
+namespace {
+
+// Latencies above this are recorded in the last fine-grained bucket. It is the largest value whose
+// fine-grained bucket falls into the last bucket of 'kLowerBounds'.
+const uint64_t kMaxTrackableLatency = (1ULL << 41) - 1;
+
+}  // namespace
+
+const std::array<double, 4> OperationLatencyHistogram::kReportedPercentiles = {
+    50.0, 90.0, 99.0, 99.9};
+
 const std::array<uint64_t, OperationLatencyHistogram::kMaxBuckets>
     OperationLatencyHistogram::kLowerBounds = {0,
                                                2,
@@ -92,6 +105,63 @@ const std::array<uint64_t, OperationLatencyHistogram::kMaxBuckets>
                                                549755813888,
                                                1099511627776};
 
+OperationLatencyHistogram::OperationLatencyHistogram(int precisionBits, size_t numStripes)
+    : _precisionBits(precisionBits) {
+    invariant(_precisionBits >= kMinPrecisionBits && _precisionBits <= kMaxPrecisionBits);
+    invariant(numStripes > 0);
+    _numFineBuckets = _getFineBucket(kMaxTrackableLatency) + 1;
+    _allocateStripes(numStripes);
+}
+
+OperationLatencyHistogram::OperationLatencyHistogram(const OperationLatencyHistogram& other)
+    : _precisionBits(other._precisionBits), _numFineBuckets(other._numFineBuckets) {
+    _allocateStripes(other._stripes.size());
+    *this = other;
+}
+
+OperationLatencyHistogram& OperationLatencyHistogram::operator=(
+    const OperationLatencyHistogram& other) {
+    if (this == &other) {
+        return *this;
+    }
+
+    if (_precisionBits != other._precisionBits || _stripes.size() != other._stripes.size()) {
+        _precisionBits = other._precisionBits;
+        _numFineBuckets = other._numFineBuckets;
+        _allocateStripes(other._stripes.size());
+    }
+
+    const size_t numCounters = kNumOpTypes * _countersPerOpType();
+    for (size_t stripe = 0; stripe < _stripes.size(); ++stripe) {
+        for (size_t i = 0; i < numCounters; ++i) {
+            _stripes[stripe][i].store(other._stripes[stripe][i].loadRelaxed());
+        }
+    }
+    return *this;
+}
+
+void OperationLatencyHistogram::_allocateStripes(size_t numStripes) {
+    _stripes.clear();
+    for (size_t i = 0; i < numStripes; ++i) {
+        _stripes.emplace_back(new AtomicWord<long long>[kNumOpTypes * _countersPerOpType()]);
+    }
+}
+
+OperationLatencyHistogram::HistogramData OperationLatencyHistogram::_merge(OpType type) const {
+    HistogramData data;
+    data.buckets.resize(_numFineBuckets);
+
+    const size_t base = type * _countersPerOpType();
+    for (const auto& stripe : _stripes) {
+        for (size_t i = 0; i < _numFineBuckets; ++i) {
+            data.buckets[i] += stripe[base + i].loadRelaxed();
+        }
+        data.entryCount += stripe[base + _numFineBuckets].loadRelaxed();
+        data.sum += stripe[base + _numFineBuckets + 1].loadRelaxed();
+    }
+    return data;
+}
+
 void OperationLatencyHistogram::_append(const HistogramData& data,
                                         const char* key,
                                         bool includeHistograms,
@@ -99,16 +169,47 @@ void OperationLatencyHistogram::_append(const HistogramData& data,
 
     BSONObjBuilder histogramBuilder(builder->subobjStart(key));
     if (includeHistograms) {
+        // Aggregate the fine-grained buckets into the reported buckets. Each fine-grained bucket
+        // lies entirely within one reported bucket.
+        std::array<uint64_t, kMaxBuckets> buckets{};
+        uint64_t total = 0;
+        for (size_t i = 0; i < _numFineBuckets; i++) {
+            buckets[_getBucket(_getFineBucketLowerBound(i))] += data.buckets[i];
+            total += data.buckets[i];
+        }
+
         BSONArrayBuilder arrayBuilder(histogramBuilder.subarrayStart("histogram"));
         for (int i = 0; i < kMaxBuckets; i++) {
-            if (data.buckets[i] == 0)
+            if (buckets[i] == 0)
                 continue;
             BSONObjBuilder entryBuilder(arrayBuilder.subobjStart());
             entryBuilder.append("micros", static_cast<long long>(kLowerBounds[i]));
-            entryBuilder.append("count", static_cast<long long>(data.buckets[i]));
+            entryBuilder.append("count", static_cast<long long>(buckets[i]));
             entryBuilder.doneFast();
         }
         arrayBuilder.doneFast();
+
+        // Report each percentile as the highest latency in the fine-grained bucket which holds it.
+        // The counts are taken from the same merged buckets as the histogram, so that concurrent
+        // increments cannot make the ranks inconsistent with the buckets.
+        if (total > 0) {
+            BSONArrayBuilder percentilesBuilder(histogramBuilder.subarrayStart("percentiles"));
+            size_t fineBucket = 0;
+            uint64_t seen = data.buckets[0];
+            for (double percentile : kReportedPercentiles) {
+                const uint64_t rank = std::max<uint64_t>(
+                    1, static_cast<uint64_t>(std::ceil(percentile / 100 * total)));
+                while (seen < rank) {
+                    seen += data.buckets[++fineBucket];
+                }
+                BSONObjBuilder entryBuilder(percentilesBuilder.subobjStart());
+                entryBuilder.append("percentile", percentile);
+                entryBuilder.append("micros",
+                                    static_cast<long long>(_getFineBucketUpperBound(fineBucket)));
+                entryBuilder.doneFast();
+            }
+            percentilesBuilder.doneFast();
+        }
     }
     histogramBuilder.append("latency", static_cast<long long>(data.sum));
     histogramBuilder.append("ops", static_cast<long long>(data.entryCount));
@@ -116,10 +217,10 @@ void OperationLatencyHistogram::_append(const HistogramData& data,
 }
 
 void OperationLatencyHistogram::append(bool includeHistograms, BSONObjBuilder* builder) const {
-    _append(_reads, "reads", includeHistograms, builder);
-    _append(_writes, "writes", includeHistograms, builder);
-    _append(_commands, "commands", includeHistograms, builder);
-    _append(_transactions, "transactions", includeHistograms, builder);
+    _append(_merge(kReads), "reads", includeHistograms, builder);
+    _append(_merge(kWrites), "writes", includeHistograms, builder);
+    _append(_merge(kCommands), "commands", includeHistograms, builder);
+    _append(_merge(kTransactions), "transactions", includeHistograms, builder);
 }
 
 // Computes the log base 2 of value, and checks for cases of split buckets.
@@ -149,30 +250,75 @@ int OperationLatencyHistogram::_getBucket(uint64_t value) {
     }
 }
 
-void OperationLatencyHistogram::_incrementData(uint64_t latency, int bucket, HistogramData* data) {
-    data->buckets[bucket]++;
-    data->entryCount++;
-    data->sum += latency;
+// Values below 2^precisionBits get a bucket each. Above that, each power of two is split into
+// 2^precisionBits equally sized buckets, indexed by the significant bits following the leading one.
+size_t OperationLatencyHistogram::_getFineBucket(uint64_t latency) const {
+    const uint64_t subBuckets = 1ULL << _precisionBits;
+    const uint64_t value = std::min(latency, kMaxTrackableLatency);
+    if (value < subBuckets) {
+        return value;
+    }
+
+    const int log2 = 63 - countLeadingZeros64(value);
+    const int shift = log2 - _precisionBits;
+    return (shift + 1) * subBuckets + ((value >> shift) - subBuckets);
+}
+
+uint64_t OperationLatencyHistogram::_getFineBucketLowerBound(size_t fineBucket) const {
+    const uint64_t subBuckets = 1ULL << _precisionBits;
+    if (fineBucket < subBuckets) {
+        return fineBucket;
+    }
+
+    const int shift = fineBucket / subBuckets - 1;
+    return (subBuckets + fineBucket % subBuckets) << shift;
+}
+
+uint64_t OperationLatencyHistogram::_getFineBucketUpperBound(size_t fineBucket) const {
+    const uint64_t subBuckets = 1ULL << _precisionBits;
+    if (fineBucket < subBuckets) {
+        return fineBucket;
+    }
+
+    const int shift = fineBucket / subBuckets - 1;
+    return _getFineBucketLowerBound(fineBucket) + (1ULL << shift) - 1;
+}
+
+size_t OperationLatencyHistogram::_getStripe() const {
+    if (_stripes.size() == 1) {
+        return 0;
+    }
+
+    // Each thread always increments the same stripe, assigned round-robin on first use.
+    static AtomicWord<unsigned> nextThreadSeed{0};
+    thread_local const unsigned threadSeed = nextThreadSeed.fetchAndAddRelaxed(1);
+    return threadSeed % _stripes.size();
 }
 
 void OperationLatencyHistogram::increment(uint64_t latency, Command::ReadWriteType type) {
-    int bucket = _getBucket(latency);
+    OpType opType;
     switch (type) {
         case Command::ReadWriteType::kRead:
-            _incrementData(latency, bucket, &_reads);
+            opType = kReads;
             break;
         case Command::ReadWriteType::kWrite:
-            _incrementData(latency, bucket, &_writes);
+            opType = kWrites;
             break;
         case Command::ReadWriteType::kCommand:
-            _incrementData(latency, bucket, &_commands);
+            opType = kCommands;
             break;
         case Command::ReadWriteType::kTransaction:
-            _incrementData(latency, bucket, &_transactions);
+            opType = kTransactions;
             break;
         default:
             MONGO_UNREACHABLE;
     }
+
+    auto& stripe = _stripes[_getStripe()];
+    const size_t base = opType * _countersPerOpType();
+    stripe[base + _getFineBucket(latency)].fetchAndAddRelaxed(1);
+    stripe[base + _numFineBuckets].fetchAndAddRelaxed(1);
+    stripe[base + _numFineBuckets + 1].fetchAndAddRelaxed(static_cast<long long>(latency));
 }
 
 }  // namespace mongo
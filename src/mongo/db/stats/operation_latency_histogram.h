@@ -29,8 +29,11 @@
 #pragma once
 
 #include <array>
+#include <memory>
+#include <vector>
 
 #include "mongo/db/commands.h"
+#include "mongo/platform/atomic_word.h"
 
 namespace mongo {
 
@@ -40,7 +43,14 @@ class BSONObjBuilder;
  * Stores statistics for latencies of read, write, command, and multi-document transaction
  * operations.
  *
- * Note: This class is not thread-safe.
+ * Latencies are recorded into fine-grained buckets with 2^precisionBits sub-buckets per power of
+ * two, so that any recorded latency is known to within a relative error of 2^-precisionBits. The
+ * fine-grained buckets are aggregated into the coarser 'kLowerBounds' buckets for reporting, and
+ * are used to compute latency percentiles.
+ *
+ * This class is thread-safe: increment() never takes a lock. The counters may be split into
+ * several stripes, each of which is updated by a disjoint set of threads, so that concurrent
+ * increments do not contend on the same cache lines. The stripes are merged when appended.
  */
 class OperationLatencyHistogram {
 public:
@@ -49,19 +59,39 @@ public:
     // Inclusive lower bounds of the histogram buckets.
     static const std::array<uint64_t, kMaxBuckets> kLowerBounds;
 
+    // Bounds on the number of significant bits used to bucket a latency. At least one bit is
+    // needed for the fine-grained buckets to nest within the buckets in 'kLowerBounds'.
+    static const int kMinPrecisionBits = 1;
+    static const int kMaxPrecisionBits = 7;
+    static const int kDefaultPrecisionBits = 2;
+
+    // The percentiles reported when histograms are requested.
+    static const std::array<double, 4> kReportedPercentiles;
+
+    explicit OperationLatencyHistogram(int precisionBits = kDefaultPrecisionBits,
+                                       size_t numStripes = 1);
+
+    OperationLatencyHistogram(const OperationLatencyHistogram& other);
+    OperationLatencyHistogram& operator=(const OperationLatencyHistogram& other);
+
     /**
      * Increments the bucket of the histogram based on the operation type.
      */
     void increment(uint64_t latency, Command::ReadWriteType type);
 
     /**
-     * Appends the four histograms with latency totals and operation counts.
+     * Appends the four histograms with latency totals and operation counts. If 'includeHistograms'
+     * is true, also appends the bucket counts and latency percentiles of each histogram.
      */
     void append(bool includeHistograms, BSONObjBuilder* builder) const;
 
 private:
+    // The operation types, in the order their counters are laid out in each stripe.
+    enum OpType { kReads, kWrites, kCommands, kTransactions, kNumOpTypes };
+
+    // A merged, point-in-time copy of the counters for one operation type.
     struct HistogramData {
-        std::array<uint64_t, kMaxBuckets> buckets{};
+        std::vector<uint64_t> buckets;
         uint64_t entryCount = 0;
         uint64_t sum = 0;
     };
@@ -70,13 +100,39 @@ private:
 
     static uint64_t _getBucketMicros(int bucket);
 
+    /**
+     * Maps a latency to its fine-grained bucket, and a fine-grained bucket to the range of
+     * latencies it covers.
+     */
+    size_t _getFineBucket(uint64_t latency) const;
+    uint64_t _getFineBucketLowerBound(size_t fineBucket) const;
+    uint64_t _getFineBucketUpperBound(size_t fineBucket) const;
+
+    /**
+     * Returns the stripe which the current thread should increment.
+     */
+    size_t _getStripe() const;
+
+    /**
+     * Number of counters for each operation type: the fine-grained buckets followed by the
+     * operation count and the latency sum.
+     */
+    size_t _countersPerOpType() const {
+        return _numFineBuckets + 2;
+    }
+
+    void _allocateStripes(size_t numStripes);
+
+    HistogramData _merge(OpType type) const;
+
     void _append(const HistogramData& data,
                  const char* key,
                  bool includeHistograms,
                  BSONObjBuilder* builder) const;
 
-    void _incrementData(uint64_t latency, int bucket, HistogramData* data);
+    int _precisionBits;
+    size_t _numFineBuckets;
 
-    HistogramData _reads, _writes, _commands, _transactions;
+    std::vector<std::unique_ptr<AtomicWord<long long>[]>> _stripes;
 };
 }  // namespace mongo
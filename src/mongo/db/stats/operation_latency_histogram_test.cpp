@@ -38,6 +38,7 @@
 
 #include "mongo/db/commands.h"
 #include "mongo/db/jsobj.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/unittest.h"
 
 namespace mongo {
@@ -92,4 +93,82 @@ TEST(OperationLatencyHistogram, CheckBucketCountsAndTotalLatency) {
         ASSERT_EQUALS(bucket["count"].Long(), (i < kMaxBuckets - 1) ? 3 : 2);
     }
 }
+
+TEST(OperationLatencyHistogram, PercentilesWithinPrecision) {
+    const int precisionBits = 5;
+    OperationLatencyHistogram hist(precisionBits);
+    for (uint64_t latency = 1; latency <= 100000; latency++) {
+        hist.increment(latency, Command::ReadWriteType::kRead);
+    }
+
+    BSONObjBuilder outBuilder;
+    hist.append(true, &outBuilder);
+    BSONObj out = outBuilder.done();
+
+    std::vector<BSONElement> percentiles = out["reads"]["percentiles"].Array();
+    ASSERT_EQUALS(percentiles.size(), OperationLatencyHistogram::kReportedPercentiles.size());
+    for (size_t i = 0; i < percentiles.size(); i++) {
+        const double percentile = percentiles[i].Obj()["percentile"].Double();
+        ASSERT_EQUALS(percentile, OperationLatencyHistogram::kReportedPercentiles[i]);
+
+        // The reported value is the highest latency in the bucket holding the exact percentile, so
+        // it may only exceed the exact value by the width of that bucket.
+        const double exact = percentile * 1000;
+        const double reported = percentiles[i].Obj()["micros"].Long();
+        ASSERT_GTE(reported, exact);
+        ASSERT_LTE(reported, exact * (1 + 1.0 / (1 << precisionBits)));
+    }
+
+    // Histograms without any operations do not report percentiles.
+    ASSERT_FALSE(out["writes"].Obj().hasField("percentiles"));
+}
+
+TEST(OperationLatencyHistogram, ConcurrentIncrementsAreAllCounted) {
+    const int kNumThreads = 8;
+    const int kIncrementsPerThread = 10000;
+    OperationLatencyHistogram hist(OperationLatencyHistogram::kDefaultPrecisionBits, 4);
+
+    std::vector<stdx::thread> threads;
+    for (int i = 0; i < kNumThreads; i++) {
+        threads.emplace_back([&hist] {
+            for (int j = 0; j < kIncrementsPerThread; j++) {
+                hist.increment(j % 100, Command::ReadWriteType::kWrite);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    BSONObjBuilder outBuilder;
+    hist.append(true, &outBuilder);
+    BSONObj out = outBuilder.done();
+    ASSERT_EQUALS(out["writes"]["ops"].Long(), kNumThreads * kIncrementsPerThread);
+    ASSERT_EQUALS(out["writes"]["latency"].Long(),
+                  kNumThreads * (kIncrementsPerThread / 100) * (99 * 100 / 2));
+
+    long long bucketTotal = 0;
+    for (auto&& bucket : out["writes"]["histogram"].Array()) {
+        bucketTotal += bucket.Obj()["count"].Long();
+    }
+    ASSERT_EQUALS(bucketTotal, kNumThreads * kIncrementsPerThread);
+}
+
+TEST(OperationLatencyHistogram, CopyPreservesCounts) {
+    OperationLatencyHistogram hist(OperationLatencyHistogram::kDefaultPrecisionBits, 2);
+    hist.increment(10, Command::ReadWriteType::kCommand);
+    hist.increment(5000, Command::ReadWriteType::kCommand);
+
+    OperationLatencyHistogram copy(hist);
+    OperationLatencyHistogram assigned;
+    assigned = hist;
+
+    BSONObjBuilder originalBuilder, copyBuilder, assignedBuilder;
+    hist.append(true, &originalBuilder);
+    copy.append(true, &copyBuilder);
+    assigned.append(true, &assignedBuilder);
+    BSONObj original = originalBuilder.obj();
+    ASSERT_BSONOBJ_EQ(original, copyBuilder.obj());
+    ASSERT_BSONOBJ_EQ(original, assignedBuilder.obj());
+}
 }  // namespace mongo
@@ -35,6 +35,7 @@
 
 #include "mongo/db/jsobj.h"
 #include "mongo/db/service_context.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/log.h"
 
 namespace mongo {
@@ -48,8 +49,21 @@ namespace {
 
 const auto getTop = ServiceContext::declareDecoration<Top>();
 
+// The global histogram is precise enough to report tail latencies to within about 3%.
+const int kGlobalHistogramPrecisionBits = 5;
+
+// Bound the number of stripes in the global histogram, as each costs about 38KB.
+const size_t kMaxGlobalHistogramStripes = 16;
+
+size_t numGlobalHistogramStripes() {
+    return std::max<size_t>(
+        1, std::min<size_t>(stdx::thread::hardware_concurrency(), kMaxGlobalHistogramStripes));
+}
+
 }  // namespace
 
+Top::Top() : _globalHistogramStats(kGlobalHistogramPrecisionBits, numGlobalHistogramStripes()) {}
+
 Top::UsageData::UsageData(const UsageData& older, const UsageData& newer) {
     // this won't be 100% accurate on rollovers and drop(), but at least it won't be negative
     time = (newer.time >= older.time) ? (newer.time - older.time) : newer.time;
@@ -211,17 +225,14 @@ void Top::appendLatencyStats(StringData ns, bool includeHistograms, BSONObjBuild
 void Top::incrementGlobalLatencyStats(OperationContext* opCtx,
                                       uint64_t latency,
                                       Command::ReadWriteType readWriteType) {
-    stdx::lock_guard<SimpleMutex> guard(_lock);
     _incrementHistogram(opCtx, latency, &_globalHistogramStats, readWriteType);
 }
 
 void Top::appendGlobalLatencyStats(bool includeHistograms, BSONObjBuilder* builder) {
-    stdx::lock_guard<SimpleMutex> guard(_lock);
     _globalHistogramStats.append(includeHistograms, builder);
 }
 
 void Top::incrementGlobalTransactionLatencyStats(uint64_t latency) {
-    stdx::lock_guard<SimpleMutex> guard(_lock);
     _globalHistogramStats.increment(latency, Command::ReadWriteType::kTransaction);
 }
 
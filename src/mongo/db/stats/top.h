@@ -52,7 +52,7 @@ class Top {
 public:
     static Top& get(ServiceContext* service);
 
-    Top() = default;
+    Top();
 
     struct UsageData {
         UsageData() : time(0), count(0) {}
@@ -116,7 +116,8 @@ public:
     void appendLatencyStats(StringData ns, bool includeHistograms, BSONObjBuilder* builder);
 
     /**
-     * Increments the global histogram only if the operation came from a user.
+     * Increments the global histogram only if the operation came from a user. Does not take
+     * '_lock'.
      */
     void incrementGlobalLatencyStats(OperationContext* opCtx,
                                      uint64_t latency,
@@ -150,6 +151,9 @@ private:
                              Command::ReadWriteType readWriteType);
 
     mutable SimpleMutex _lock;
+
+    // Updated by every user operation, so it is striped and thread-safe rather than being guarded
+    // by '_lock'.
     OperationLatencyHistogram _globalHistogramStats;
     UsageMap _usage;
     std::set<std::string> _collDropNs;
@@ -0,0 +1,101 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/clustered_record_id.h"
+
+#include <cmath>
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/record_id.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+namespace clustered_record_id {
+namespace {
+
+// Integers and dates are each given a quarter of the RecordId space, with dates above integers
+// since that is how BSON orders them. The top of the date range stays clear of the reserved
+// RecordIds.
+const int64_t kRangeWidth = 1LL << 61;
+const int64_t kIntegerBase = kRangeWidth;
+const int64_t kDateBase = 3 * kRangeWidth;
+const int64_t kMaxDate = kRangeWidth - (1LL << 21);
+
+Status badClusterKey(const BSONElement& id) {
+    return {ErrorCodes::BadValue,
+            str::stream() << "The _id of a document in a clustered collection must be an integer "
+                             "or a date between -2^61 and 2^61, found: "
+                          << id.toString(false)};
+}
+
+}  // namespace
+
+StatusWith<RecordId> keyForId(const BSONElement& id) {
+    switch (id.type()) {
+        case NumberInt:
+        case NumberLong: {
+            long long value = id.numberLong();
+            if (value <= -kRangeWidth || value >= kRangeWidth) {
+                return badClusterKey(id);
+            }
+            return RecordId(kIntegerBase + value);
+        }
+        case NumberDouble: {
+            double value = id.numberDouble();
+            if (!(value > -kRangeWidth && value < kRangeWidth) || std::trunc(value) != value) {
+                return badClusterKey(id);
+            }
+            return RecordId(kIntegerBase + static_cast<int64_t>(value));
+        }
+        case Date: {
+            long long millis = id.date().toMillisSinceEpoch();
+            if (millis <= -kRangeWidth || millis >= kMaxDate) {
+                return badClusterKey(id);
+            }
+            return RecordId(kDateBase + millis);
+        }
+        default:
+            return badClusterKey(id);
+    }
+}
+
+StatusWith<RecordId> extractKey(const char* data, int len) {
+    const BSONObj obj(data);
+    const BSONElement id = obj["_id"];
+    if (id.eoo()) {
+        return {ErrorCodes::BadValue, "A document in a clustered collection must have an _id"};
+    }
+    return keyForId(id);
+}
+
+}  // namespace clustered_record_id
+}  // namespace mongo
@@ -0,0 +1,60 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include "mongo/base/status_with.h"
+
+namespace mongo {
+class BSONElement;
+class RecordId;
+
+/**
+ * The documents of a clustered collection are stored in its RecordStore keyed by their _id, so
+ * that the collection needs no separate _id index. The _id of such a document must be an integer
+ * or a date, which is encoded in a RecordId that sorts the same way as the _id itself.
+ */
+namespace clustered_record_id {
+
+/**
+ * Returns the RecordId under which the document with the given _id is stored in a clustered
+ * collection, or an error if the _id cannot be a cluster key.
+ *
+ * Numeric _ids which compare equal, such as 1, NumberLong(1) and 1.0, have the same RecordId.
+ */
+StatusWith<RecordId> keyForId(const BSONElement& id);
+
+/**
+ * data and len must be the arguments from RecordStore::insert() on a clustered collection.
+ */
+StatusWith<RecordId> extractKey(const char* data, int len);
+
+}  // namespace clustered_record_id
+}  // namespace mongo
@@ -0,0 +1,83 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/clustered_record_id.h"
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/record_id.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+RecordId keyFor(const BSONObj& doc) {
+    return unittest::assertGet(clustered_record_id::keyForId(doc["_id"]));
+}
+
+TEST(ClusteredRecordIdTest, KeysSortLikeIds) {
+    std::vector<BSONObj> ids{BSON("_id" << -(1LL << 40)),
+                             BSON("_id" << -1),
+                             BSON("_id" << 0),
+                             BSON("_id" << 1),
+                             BSON("_id" << (1LL << 50)),
+                             BSON("_id" << Date_t::fromMillisSinceEpoch(-1000)),
+                             BSON("_id" << Date_t::fromMillisSinceEpoch(0)),
+                             BSON("_id" << Date_t::fromMillisSinceEpoch(1))};
+
+    for (size_t i = 0; i < ids.size(); ++i) {
+        ASSERT(keyFor(ids[i]).isNormal()) << ids[i];
+        if (i > 0) {
+            ASSERT_LT(keyFor(ids[i - 1]), keyFor(ids[i])) << ids[i - 1] << " " << ids[i];
+        }
+    }
+}
+
+TEST(ClusteredRecordIdTest, EqualNumbersHaveTheSameKey) {
+    ASSERT_EQ(keyFor(BSON("_id" << 7)), keyFor(BSON("_id" << 7LL)));
+    ASSERT_EQ(keyFor(BSON("_id" << 7)), keyFor(BSON("_id" << 7.0)));
+}
+
+TEST(ClusteredRecordIdTest, RejectsIdsThatCannotBeClusterKeys) {
+    ASSERT_NOT_OK(clustered_record_id::keyForId(BSON("_id"
+                                                     << "abc")["_id"]));
+    ASSERT_NOT_OK(clustered_record_id::keyForId(BSON("_id" << OID::gen())["_id"]));
+    ASSERT_NOT_OK(clustered_record_id::keyForId(BSON("_id" << 1.5)["_id"]));
+    ASSERT_NOT_OK(clustered_record_id::keyForId(BSON("_id" << (1LL << 62))["_id"]));
+    ASSERT_NOT_OK(clustered_record_id::keyForId(
+        BSON("_id" << Date_t::fromMillisSinceEpoch(1LL << 62))["_id"]));
+
+    BSONObj noId = BSON("a" << 1);
+    ASSERT_NOT_OK(clustered_record_id::extractKey(noId.objdata(), noId.objsize()));
+}
+
+}  // namespace
+}  // namespace mongo
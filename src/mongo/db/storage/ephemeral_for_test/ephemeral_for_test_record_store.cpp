@@ -518,27 +518,30 @@ StatusWith<RecordData> EphemeralForTestRecordStore::updateWithDamages(
     stdx::lock_guard<stdx::recursive_mutex> lock(_data->recordsMutex);
 
     EphemeralForTestRecord* oldRecord = recordFor(loc);
-    const int len = oldRecord->size;
+    const int oldLen = oldRecord->size;
 
-    EphemeralForTestRecord newRecord(len);
-    memcpy(newRecord.data.get(), oldRecord->data.get(), len);
-
-    opCtx->recoveryUnit()->registerChange(new RemoveChange(opCtx, _data, loc, *oldRecord));
-    *oldRecord = newRecord;
-
-    cappedDeleteAsNeeded_inlock(opCtx);
-
-    char* root = newRecord.data.get();
+    // Damages may grow or shrink the record, so apply them to a scratch copy before sizing the new
+    // record.
+    std::string root(oldRecord->data.get(), oldLen);
     mutablebson::DamageVector::const_iterator where = damages.begin();
     const mutablebson::DamageVector::const_iterator end = damages.end();
     for (; where != end; ++where) {
-        const char* sourcePtr = damageSource + where->sourceOffset;
-        char* targetPtr = root + where->targetOffset;
-        std::memcpy(targetPtr, sourcePtr, where->size);
+        root.replace(where->targetOffset,
+                     where->targetSize,
+                     damageSource + where->sourceOffset,
+                     where->size);
     }
 
+    const int len = root.size();
+    EphemeralForTestRecord newRecord(len);
+    memcpy(newRecord.data.get(), root.data(), len);
+
+    opCtx->recoveryUnit()->registerChange(new RemoveChange(opCtx, _data, loc, *oldRecord));
+    _data->dataSize += len - oldLen;
     *oldRecord = newRecord;
 
+    cappedDeleteAsNeeded_inlock(opCtx);
+
     return newRecord.toRecordData();
 }
 
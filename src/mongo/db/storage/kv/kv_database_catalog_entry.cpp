@@ -34,6 +34,7 @@
 #include "mongo/db/catalog/index_catalog_entry.h"
 #include "mongo/db/index/2d_access_method.h"
 #include "mongo/db/index/btree_access_method.h"
+#include "mongo/db/index/column_store_access_method.h"
 #include "mongo/db/index/fts_access_method.h"
 #include "mongo/db/index/hash_access_method.h"
 #include "mongo/db/index/haystack_access_method.h"
@@ -90,6 +91,9 @@ IndexAccessMethod* KVDatabaseCatalogEntry::getIndex(OperationContext* opCtx,
     if (IndexNames::WILDCARD == type)
         return new WildcardAccessMethod(index, sdi);
 
+    if (IndexNames::COLUMN == type)
+        return new ColumnStoreAccessMethod(index, sdi);
+
     log() << "Can't find index for keyPattern " << desc->keyPattern();
 
     // We should never reach this point.
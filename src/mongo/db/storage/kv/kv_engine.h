@@ -262,6 +262,16 @@ public:
         return true;
     }
 
+    /**
+     * Returns true if the record stores of clustered collections are keyed by the RecordIds which
+     * clustered_record_id derives from the _id of their documents.
+     *
+     * This must not change over the lifetime of the engine.
+     */
+    virtual bool supportsClusteredCollections() const {
+        return false;
+    }
+
     /**
      * Returns true if storage engine supports --directoryperdb.
      * See:
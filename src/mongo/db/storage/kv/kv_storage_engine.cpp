@@ -93,7 +93,8 @@ KVStorageEngine::KVStorageEngine(
           [this](Timestamp timestamp) { _onMinOfCheckpointAndOldestTimestampChanged(timestamp); }),
       _supportsDocLocking(_engine->supportsDocLocking()),
       _supportsDBLocking(_engine->supportsDBLocking()),
-      _supportsCappedCollections(_engine->supportsCappedCollections()) {
+      _supportsCappedCollections(_engine->supportsCappedCollections()),
+      _supportsClusteredCollections(_engine->supportsClusteredCollections()) {
     uassert(28601,
             "Storage engine does not support --directoryperdb",
             !(options.directoryPerDB && !engine->supportsDirectoryPerDB()));
@@ -119,6 +119,10 @@ public:
         return _supportsCappedCollections;
     }
 
+    virtual bool supportsClusteredCollections() const {
+        return _supportsClusteredCollections;
+    }
+
     virtual Status closeDatabase(OperationContext* opCtx, StringData db);
 
     virtual Status dropDatabase(OperationContext* opCtx, StringData db);
@@ -422,6 +426,7 @@ private:
     const bool _supportsDocLocking;
     const bool _supportsDBLocking;
     const bool _supportsCappedCollections;
+    const bool _supportsClusteredCollections;
     Timestamp _initialDataTimestamp = Timestamp::kAllowUnstableCheckpointsSentinel;
 
     std::unique_ptr<RecordStore> _catalogRecordStore;
@@ -411,7 +411,8 @@ public:
     /**
      * Updates the record positioned at 'loc' in-place using the deltas described by 'damages'. The
      * 'damages' vector describes contiguous ranges of 'damageSource' from which to copy and apply
-     * byte-level changes to the data. Behavior is undefined for calling this on a non-existant loc.
+     * byte-level changes to the data. A damage whose 'targetSize' differs from its 'size' grows or
+     * shrinks the record. Behavior is undefined for calling this on a non-existant loc.
      *
      * @return the updated version of the record. If unowned data is returned, then it is valid
      * until the next modification of this Record or the lock on the collection has been released.
@@ -548,6 +549,9 @@ public:
      * Return the RecordId of an oplog entry as close to startingPosition as possible without
      * being higher. If there are no entries <= startingPosition, return RecordId().
      *
+     * Record stores of clustered collections do the same for their documents, so that scans can
+     * start from a bound on the _id.
+     *
      * If you don't implement the oplogStartHack, just use the default implementation which
      * returns boost::none.
      */
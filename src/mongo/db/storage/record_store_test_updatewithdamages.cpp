@@ -84,12 +84,15 @@ TEST(RecordStoreTestHarness, UpdateWithDamages) {
             dv[0].sourceOffset = 5;
             dv[0].targetOffset = 0;
             dv[0].size = 2;
+            dv[0].targetSize = 2;
             dv[1].sourceOffset = 3;
             dv[1].targetOffset = 2;
             dv[1].size = 3;
+            dv[1].targetSize = 3;
             dv[2].sourceOffset = 0;
             dv[2].targetOffset = 5;
             dv[2].size = 3;
+            dv[2].targetSize = 3;
 
             WriteUnitOfWork uow(opCtx.get());
             auto newRecStatus = rs->updateWithDamages(opCtx.get(), loc, rec, data.c_str(), dv);
@@ -108,6 +111,69 @@ TEST(RecordStoreTestHarness, UpdateWithDamages) {
     }
 }
 
+// Insert a record and update it with a DamageVector containing DamageEvents which grow and shrink
+// the record. Each DamageEvent targets the record as modified by the earlier ones.
+TEST(RecordStoreTestHarness, UpdateWithResizingDamages) {
+    const auto harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
+
+    if (!rs->updateWithDamagesSupported())
+        return;
+
+    string data = "00010111";
+    RecordId loc;
+    const RecordData rec(data.c_str(), data.size() + 1);
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        {
+            WriteUnitOfWork uow(opCtx.get());
+            StatusWith<RecordId> res =
+                rs->insertRecord(opCtx.get(), rec.data(), rec.size(), Timestamp());
+            ASSERT_OK(res.getStatus());
+            loc = res.getValue();
+            uow.commit();
+        }
+    }
+
+    string modifiedData = "ab00111cd";
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        {
+            const char* damageSource = "abcd";
+            mutablebson::DamageVector dv(3);
+            dv[0].sourceOffset = 0;
+            dv[0].targetOffset = 0;
+            dv[0].size = 2;
+            dv[0].targetSize = 1;
+            dv[1].sourceOffset = 0;
+            dv[1].targetOffset = 4;
+            dv[1].size = 0;
+            dv[1].targetSize = 3;
+            dv[2].sourceOffset = 2;
+            dv[2].targetOffset = 7;
+            dv[2].size = 2;
+            dv[2].targetSize = 0;
+
+            WriteUnitOfWork uow(opCtx.get());
+            auto newRecStatus = rs->updateWithDamages(opCtx.get(), loc, rec, damageSource, dv);
+            ASSERT_OK(newRecStatus.getStatus());
+            ASSERT_EQUALS(modifiedData, newRecStatus.getValue().data());
+            ASSERT_EQUALS(static_cast<int>(modifiedData.size() + 1),
+                          newRecStatus.getValue().size());
+            uow.commit();
+        }
+    }
+
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        {
+            RecordData record = rs->dataFor(opCtx.get(), loc);
+            ASSERT_EQUALS(modifiedData, record.data());
+            ASSERT_EQUALS(static_cast<int>(modifiedData.size() + 1), record.size());
+        }
+    }
+}
+
 // Insert a record and try to perform an in-place update on it with a DamageVector
 // containing overlapping DamageEvents.
 TEST(RecordStoreTestHarness, UpdateWithOverlappingDamageEvents) {
@@ -150,9 +216,11 @@ TEST(RecordStoreTestHarness, UpdateWithOverlappingDamageEvents) {
             dv[0].sourceOffset = 3;
             dv[0].targetOffset = 0;
             dv[0].size = 5;
+            dv[0].targetSize = 5;
             dv[1].sourceOffset = 0;
             dv[1].targetOffset = 3;
             dv[1].size = 5;
+            dv[1].targetSize = 5;
 
             WriteUnitOfWork uow(opCtx.get());
             auto newRecStatus = rs->updateWithDamages(opCtx.get(), loc, rec, data.c_str(), dv);
@@ -214,9 +282,11 @@ TEST(RecordStoreTestHarness, UpdateWithOverlappingDamageEventsReversed) {
             dv[0].sourceOffset = 0;
             dv[0].targetOffset = 3;
             dv[0].size = 5;
+            dv[0].targetSize = 5;
             dv[1].sourceOffset = 3;
             dv[1].targetOffset = 0;
             dv[1].size = 5;
+            dv[1].targetSize = 5;
 
             WriteUnitOfWork uow(opCtx.get());
             auto newRecStatus = rs->updateWithDamages(opCtx.get(), loc, rec, data.c_str(), dv);
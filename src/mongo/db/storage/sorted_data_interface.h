@@ -283,6 +283,35 @@ public:
         virtual boost::optional<IndexKeyEntry> seek(const IndexSeekPoint& seekPoint,
                                                     RequestedInfo parts = kKeyAndLoc) = 0;
 
+        /**
+         * Describes how a call to seekAhead() reached its target.
+         */
+        struct SeekAheadStats {
+            // Number of entries stepped over, and not returned, on the way to the target.
+            size_t entriesSkipped = 0;
+
+            // Whether the cursor had to be repositioned by a full seek.
+            bool seeked = false;
+        };
+
+        /**
+         * Like seek(), but for callers which know that seekPoint lies ahead of the current
+         * position in the direction of the scan, such as an index scan moving on to its next
+         * interval. Since the target is often close by, implementations may first step over up to
+         * 'maxNexts' entries looking for it before falling back to a full seek. Callers should
+         * bound 'maxNexts' by how far apart they expect consecutive seek points to be.
+         *
+         * The cursor must have been positioned by a prior seek or next(). It is always legal to
+         * ignore 'maxNexts' and seek, which is what the default implementation does.
+         */
+        virtual boost::optional<IndexKeyEntry> seekAhead(const IndexSeekPoint& seekPoint,
+                                                         int maxNexts,
+                                                         SeekAheadStats* stats,
+                                                         RequestedInfo parts = kKeyAndLoc) {
+            stats->seeked = true;
+            return seek(seekPoint, parts);
+        }
+
         /**
          * Seeks to a key with a hint to the implementation that you only want exact matches. If
          * an exact match can't be found, boost::none will be returned and the resulting
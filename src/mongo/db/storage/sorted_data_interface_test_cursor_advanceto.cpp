@@ -665,5 +665,98 @@ TEST(SortedDataInterface, AdvanceToIndirectExclusiveReversed) {
     }
 }
 
+// Insert multiple single-field keys and move ahead to later ones with seekAhead(). The cursor
+// must land on the same entry a seek() would, whether or not it stepped there.
+TEST(SortedDataInterface, SeekAhead) {
+    const auto harnessHelper(newSortedDataInterfaceHarnessHelper());
+    const std::unique_ptr<SortedDataInterface> sorted(
+        harnessHelper->newSortedDataInterface(/*unique=*/false, /*partial=*/false));
+
+    {
+        const ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        {
+            WriteUnitOfWork uow(opCtx.get());
+            ASSERT_OK(sorted->insert(opCtx.get(), key1, loc1, true));
+            ASSERT_OK(sorted->insert(opCtx.get(), key2, loc2, true));
+            ASSERT_OK(sorted->insert(opCtx.get(), key3, loc3, true));
+            ASSERT_OK(sorted->insert(opCtx.get(), key4, loc4, true));
+            ASSERT_OK(sorted->insert(opCtx.get(), key5, loc5, true));
+            uow.commit();
+        }
+    }
+
+    {
+        const ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        const std::unique_ptr<SortedDataInterface::Cursor> cursor(sorted->newCursor(opCtx.get()));
+
+        ASSERT_EQ(cursor->seek(key1, true), IndexKeyEntry(key1, loc1));
+
+        IndexSeekPoint seekPoint;
+        seekPoint.keyPrefix = key3;
+        seekPoint.prefixLen = 1;
+        seekPoint.prefixExclusive = false;
+
+        SortedDataInterface::Cursor::SeekAheadStats stats;
+        ASSERT_EQ(cursor->seekAhead(seekPoint, 4, &stats), IndexKeyEntry(key3, loc3));
+        if (!stats.seeked) {
+            ASSERT_EQ(1U, stats.entriesSkipped);
+        }
+
+        // With no budget for stepping, the cursor must seek.
+        seekPoint.keyPrefix = key5;
+        stats = {};
+        ASSERT_EQ(cursor->seekAhead(seekPoint, 0, &stats), IndexKeyEntry(key5, loc5));
+        ASSERT(stats.seeked);
+
+        seekPoint.keyPrefix = key6;
+        stats = {};
+        ASSERT_EQ(cursor->seekAhead(seekPoint, 4, &stats), boost::none);
+    }
+}
+
+// Insert multiple single-field keys and move ahead to earlier ones with seekAhead() using a
+// reverse cursor.
+TEST(SortedDataInterface, SeekAheadReversed) {
+    const auto harnessHelper(newSortedDataInterfaceHarnessHelper());
+    const std::unique_ptr<SortedDataInterface> sorted(
+        harnessHelper->newSortedDataInterface(/*unique=*/false, /*partial=*/false));
+
+    {
+        const ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        {
+            WriteUnitOfWork uow(opCtx.get());
+            ASSERT_OK(sorted->insert(opCtx.get(), key1, loc1, true));
+            ASSERT_OK(sorted->insert(opCtx.get(), key2, loc2, true));
+            ASSERT_OK(sorted->insert(opCtx.get(), key3, loc3, true));
+            ASSERT_OK(sorted->insert(opCtx.get(), key4, loc4, true));
+            ASSERT_OK(sorted->insert(opCtx.get(), key5, loc5, true));
+            uow.commit();
+        }
+    }
+
+    {
+        const ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        const std::unique_ptr<SortedDataInterface::Cursor> cursor(
+            sorted->newCursor(opCtx.get(), false));
+
+        ASSERT_EQ(cursor->seek(key5, true), IndexKeyEntry(key5, loc5));
+
+        IndexSeekPoint seekPoint;
+        seekPoint.keyPrefix = key2;
+        seekPoint.prefixLen = 1;
+        seekPoint.prefixExclusive = false;
+
+        SortedDataInterface::Cursor::SeekAheadStats stats;
+        ASSERT_EQ(cursor->seekAhead(seekPoint, 4, &stats), IndexKeyEntry(key2, loc2));
+        if (!stats.seeked) {
+            ASSERT_EQ(2U, stats.entriesSkipped);
+        }
+
+        seekPoint.keyPrefix = key0;
+        stats = {};
+        ASSERT_EQ(cursor->seekAhead(seekPoint, 4, &stats), boost::none);
+    }
+}
+
 }  // namespace
 }  // namespace mongo
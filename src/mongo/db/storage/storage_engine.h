@@ -207,6 +207,14 @@ public:
         return true;
     }
 
+    /**
+     * Returns whether the storage engine supports clustered collections, whose records are keyed
+     * by their _id. See CollectionOptions::clustered.
+     */
+    virtual bool supportsClusteredCollections() const {
+        return false;
+    }
+
     /**
      * Returns whether the engine supports a journalling concept or not.
      */
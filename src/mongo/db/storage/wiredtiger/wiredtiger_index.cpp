@@ -855,13 +855,44 @@ public:
     boost::optional<IndexKeyEntry> seek(const IndexSeekPoint& seekPoint,
                                         RequestedInfo parts) override {
         dassert(_opCtx->lockState()->isReadLocked());
-        // TODO: don't go to a bson obj then to a KeyString, go straight
-        BSONObj key = IndexEntryComparison::makeQueryObject(seekPoint, _forward);
+        setQuery(seekPoint);
+        seekWTCursor(_query);
+        updatePosition();
+        return curr(parts);
+    }
 
-        // makeQueryObject handles the discriminator in the real exclusive cases.
-        const auto discriminator =
-            _forward ? KeyString::kExclusiveBefore : KeyString::kExclusiveAfter;
-        _query.resetToKey(key, _idx.ordering(), discriminator);
+    boost::optional<IndexKeyEntry> seekAhead(const IndexSeekPoint& seekPoint,
+                                             int maxNexts,
+                                             SeekAheadStats* stats,
+                                             RequestedInfo parts) override {
+        dassert(_opCtx->lockState()->isReadLocked());
+        setQuery(seekPoint);
+
+        // A search_near() descends the btree from its root. When the target is only a few entries
+        // away, it is cheaper to step towards it and compare the raw KeyStrings, which also avoids
+        // decoding the entries stepped over. We can only step from a position we have returned.
+        if (!_eof && !_lastMoveSkippedKey) {
+            WT_CURSOR* c = _cursor->get();
+            for (int i = 0; i < maxNexts; ++i) {
+                advanceWTCursor();
+                if (_cursorAtEof) {
+                    updatePosition(true);
+                    return curr(parts);
+                }
+
+                WT_ITEM item;
+                getKey(c, &item);
+                // The query is built with a discriminator, so it never compares equal to a key.
+                const int cmp = compareToQuery(item);
+                if (_forward ? cmp > 0 : cmp < 0) {
+                    updatePosition(true);
+                    return curr(parts);
+                }
+                ++stats->entriesSkipped;
+            }
+        }
+
+        stats->seeked = true;
         seekWTCursor(_query);
         updatePosition();
         return curr(parts);
@@ -1001,6 +1032,27 @@ protected:
         }
     }
 
+    void setQuery(const IndexSeekPoint& seekPoint) {
+        // TODO: don't go to a bson obj then to a KeyString, go straight
+        BSONObj key = IndexEntryComparison::makeQueryObject(seekPoint, _forward);
+
+        // makeQueryObject handles the discriminator in the real exclusive cases.
+        const auto discriminator =
+            _forward ? KeyString::kExclusiveBefore : KeyString::kExclusiveAfter;
+        _query.resetToKey(key, _idx.ordering(), discriminator);
+    }
+
+    // Compares a key read from the WT cursor against _query using the same byte-wise ordering as
+    // WT itself.
+    int compareToQuery(const WT_ITEM& item) const {
+        const int cmp =
+            std::memcmp(item.data, _query.getBuffer(), std::min(item.size, _query.getSize()));
+        if (cmp != 0) {
+            return cmp;
+        }
+        return item.size < _query.getSize() ? -1 : (item.size > _query.getSize() ? 1 : 0);
+    }
+
     void advanceWTCursor() {
         WT_CURSOR* c = _cursor->get();
         int ret = wiredTigerPrepareConflictRetry(
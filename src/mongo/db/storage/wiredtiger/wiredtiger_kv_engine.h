@@ -85,6 +85,10 @@ public:
 
     bool supportsDocLocking() const override;
 
+    bool supportsClusteredCollections() const override {
+        return true;
+    }
+
     bool supportsDirectoryPerDB() const override;
 
     bool isDurable() const override {
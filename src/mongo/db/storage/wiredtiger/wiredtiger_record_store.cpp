@@ -47,6 +47,8 @@
 #include "mongo/db/repl/repl_settings.h"
 #include "mongo/db/server_recovery.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/storage/clustered_record_id.h"
+#include "mongo/db/storage/index_entry_comparison.h"
 #include "mongo/db/storage/oplog_hack.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_customization_hooks.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
@@ -85,6 +87,27 @@ void checkOplogFormatVersion(OperationContext* opCtx, const std::string& uri) {
 
     fassertNoTrace(39998, appMetadata.getValue().getIntField("oplogKeyExtractionVersion") == 1);
 }
+
+// Statistics about the oplog stones and the truncation of the oplog, reported by the
+// 'oplogTruncation' serverStatus section.
+struct OplogTruncationStats {
+    stdx::mutex mutex;
+    std::string processingMethod;  // How the stones were computed at startup. Guarded by 'mutex'.
+
+    AtomicWord<long long> totalTimeProcessingMicros;
+    AtomicWord<long long> totalTimeTruncatingMicros;
+    AtomicWord<long long> truncateCount;
+    AtomicWord<long long> minBytesPerStone;
+    AtomicWord<long long> insertBytesPerSecond;
+
+    // When the oplog first exceeded its maximum size since it was last truncated, or zero.
+    AtomicWord<long long> excessSinceMillis;
+} oplogTruncationStats;
+
+void setOplogStonesProcessingMethod(StringData method) {
+    stdx::lock_guard<stdx::mutex> lk(oplogTruncationStats.mutex);
+    oplogTruncationStats.processingMethod = method.toString();
+}
 }  // namespace
 
 MONGO_FAIL_POINT_DEFINE(WTWriteConflictException);
@@ -121,7 +144,7 @@ public:
 
         _oplogStones->_currentRecords.addAndFetch(_countInserted);
         int64_t newCurrentBytes = _oplogStones->_currentBytes.addAndFetch(_bytesInserted);
-        if (newCurrentBytes >= _oplogStones->_minBytesPerStone) {
+        if (newCurrentBytes >= _oplogStones->_minBytesPerStone.load()) {
             _oplogStones->createNewStoneIfNeeded(_highestInserted);
         }
     }
@@ -145,6 +168,8 @@ public:
 
         stdx::lock_guard<stdx::mutex> lk(_oplogStones->_mutex);
         _oplogStones->_stones.clear();
+        _oplogStones->_saveStones_inlock();
+        _oplogStones->_updateExcessSince_inlock();
     }
 
     void rollback() final {}
@@ -159,17 +184,22 @@ WiredTigerRecordStore::OplogStones::OplogStones(OperationContext* opCtx, WiredTi
 
     invariant(rs->isCapped());
     invariant(rs->cappedMaxSize() > 0);
-    unsigned long long maxSize = rs->cappedMaxSize();
-
-    const unsigned long long kMinStonesToKeep = 10ULL;
-    const unsigned long long kMaxStonesToKeep = 100ULL;
+    int64_t maxSize = rs->cappedMaxSize();
 
-    unsigned long long numStones = maxSize / BSONObjMaxInternalSize;
+    int64_t numStones = maxSize / BSONObjMaxInternalSize;
     size_t numStonesToKeep = std::min(kMaxStonesToKeep, std::max(kMinStonesToKeep, numStones));
-    _minBytesPerStone = maxSize / numStonesToKeep;
-    invariant(_minBytesPerStone > 0);
+    _minBytesPerStone.store(maxSize / numStonesToKeep);
+    invariant(_minBytesPerStone.load() > 0);
 
-    _calculateStones(opCtx, numStonesToKeep);
+    Timer timer;
+    if (!_calculateStonesFromSizeStorer(opCtx)) {
+        _calculateStones(opCtx, numStonesToKeep);
+    }
+    oplogTruncationStats.totalTimeProcessingMicros.store(timer.micros());
+    oplogTruncationStats.minBytesPerStone.store(_minBytesPerStone.load());
+
+    _saveStones_inlock();
+    _updateExcessSince_inlock();
     _pokeReclaimThreadIfNeeded();  // Reclaim stones if over the limit.
 }
 
@@ -227,6 +257,8 @@ WiredTigerRecordStore::OplogStones::peekOldestStoneIfNeeded() const {
 void WiredTigerRecordStore::OplogStones::popOldestStone() {
     stdx::lock_guard<stdx::mutex> lk(_mutex);
     _stones.pop_front();
+    _saveStones_inlock();
+    _updateExcessSince_inlock();
 }
 
 void WiredTigerRecordStore::OplogStones::createNewStoneIfNeeded(RecordId lastRecord) {
@@ -237,7 +269,7 @@ void WiredTigerRecordStore::OplogStones::createNewStoneIfNeeded(RecordId lastRec
         return;
     }
 
-    if (_currentBytes.load() < _minBytesPerStone) {
+    if (_currentBytes.load() < _minBytesPerStone.load()) {
         // Must have raced to create a new stone, someone else already triggered it.
         return;
     }
@@ -253,6 +285,9 @@ void WiredTigerRecordStore::OplogStones::createNewStoneIfNeeded(RecordId lastRec
     OplogStones::Stone stone = {_currentRecords.swap(0), _currentBytes.swap(0), lastRecord};
     _stones.push_back(stone);
 
+    _adaptMinBytesPerStone_inlock(stone.bytes);
+    _saveStones_inlock();
+    _updateExcessSince_inlock();
     _pokeReclaimThreadIfNeeded();
 }
 
@@ -296,6 +331,9 @@ void WiredTigerRecordStore::OplogStones::updateStonesAfterCappedTruncateAfter(
     // being filled.
     _currentRecords.addAndFetch(recordsInStonesToRemove - recordsRemoved);
     _currentBytes.addAndFetch(bytesInStonesToRemove - bytesRemoved);
+
+    _saveStones_inlock();
+    _updateExcessSince_inlock();
 }
 
 void WiredTigerRecordStore::OplogStones::setMinBytesPerStone(int64_t size) {
@@ -305,7 +343,108 @@ void WiredTigerRecordStore::OplogStones::setMinBytesPerStone(int64_t size) {
 
     // Only allow changing the minimum bytes per stone if no data has been inserted.
     invariant(_stones.size() == 0 && _currentRecords.load() == 0);
-    _minBytesPerStone = size;
+    _minBytesPerStone.store(size);
+    _adaptiveSizing = false;
+}
+
+void WiredTigerRecordStore::OplogStones::appendTruncationStats(BSONObjBuilder* builder) {
+    {
+        stdx::lock_guard<stdx::mutex> lk(oplogTruncationStats.mutex);
+        builder->append("processingMethod", oplogTruncationStats.processingMethod);
+    }
+    builder->append("totalTimeProcessingMicros",
+                    oplogTruncationStats.totalTimeProcessingMicros.load());
+    builder->append("totalTimeTruncatingMicros",
+                    oplogTruncationStats.totalTimeTruncatingMicros.load());
+    builder->append("truncateCount", oplogTruncationStats.truncateCount.load());
+    builder->append("minBytesPerStone", oplogTruncationStats.minBytesPerStone.load());
+    builder->append("insertBytesPerSecond", oplogTruncationStats.insertBytesPerSecond.load());
+
+    // How long the oplog has been larger than its maximum size, which is how far truncation lags
+    // behind the inserts. Truncation is also held back by the oplog needed for recovery.
+    long long excessSinceMillis = oplogTruncationStats.excessSinceMillis.load();
+    long long lagMillis = 0;
+    if (excessSinceMillis != 0) {
+        lagMillis = std::max(0LL, Date_t::now().toMillisSinceEpoch() - excessSinceMillis);
+    }
+    builder->append("truncationLagMillis", lagMillis);
+}
+
+void WiredTigerRecordStore::OplogStones::recordTruncation(Microseconds elapsed) {
+    oplogTruncationStats.totalTimeTruncatingMicros.fetchAndAdd(
+        durationCount<Microseconds>(elapsed));
+    oplogTruncationStats.truncateCount.fetchAndAdd(1);
+}
+
+void WiredTigerRecordStore::OplogStones::_saveStones_inlock() {
+    BSONObjBuilder builder;
+    builder.append("minBytesPerStone", _minBytesPerStone.load());
+    {
+        BSONArrayBuilder stonesBuilder(builder.subarrayStart("stones"));
+        for (auto&& stone : _stones) {
+            stonesBuilder.append(BSON("records" << stone.records << "bytes" << stone.bytes
+                                                << "lastRecord"
+                                                << Timestamp(stone.lastRecord.repr())));
+        }
+    }
+
+    _rs->_sizeInfo->setOplogStones(builder.obj());
+    if (_rs->_sizeStorer) {
+        _rs->_sizeStorer->store(_rs->_uri, _rs->_sizeInfo);
+    }
+}
+
+std::pair<int64_t, int64_t> WiredTigerRecordStore::OplogStones::_minBytesPerStoneBounds(
+    int64_t maxSize) {
+    int64_t lowerBound = std::max(int64_t(1), maxSize / kMaxStonesToKeep);
+    int64_t upperBound = std::max(lowerBound, maxSize / kMinStonesToKeep);
+    return {lowerBound, upperBound};
+}
+
+void WiredTigerRecordStore::OplogStones::_adaptMinBytesPerStone_inlock(int64_t stoneBytes) {
+    Date_t now = Date_t::now();
+    Date_t lastStoneCreated = _lastStoneCreated;
+    _lastStoneCreated = now;
+
+    if (!_adaptiveSizing || lastStoneCreated == Date_t()) {
+        // There is nothing to measure the rate of inserts against until the second stone.
+        return;
+    }
+
+    // Weigh the most recent stone enough for the size to follow a change in workload within a few
+    // stones, without swinging with every burst of inserts.
+    const double kRateWeight = 0.25;
+
+    double seconds = std::max(1LL, durationCount<Milliseconds>(now - lastStoneCreated)) / 1000.0;
+    double rate = stoneBytes / seconds;
+    _bytesPerSecond =
+        _bytesPerSecond == 0 ? rate : kRateWeight * rate + (1 - kRateWeight) * _bytesPerSecond;
+
+    auto bounds = _minBytesPerStoneBounds(_rs->cappedMaxSize());
+    double targetBytes = _bytesPerSecond * durationCount<Seconds>(kTargetSecondsPerStone);
+    int64_t minBytesPerStone = targetBytes >= bounds.second
+        ? bounds.second
+        : std::max(bounds.first, static_cast<int64_t>(targetBytes));
+
+    if (minBytesPerStone != _minBytesPerStone.load()) {
+        LOG(1) << "Oplog grows at approximately " << static_cast<long long>(_bytesPerSecond)
+               << " bytes per second, resizing the oplog stones from "
+               << _minBytesPerStone.load() << " to " << minBytesPerStone << " bytes";
+        _minBytesPerStone.store(minBytesPerStone);
+    }
+
+    oplogTruncationStats.minBytesPerStone.store(minBytesPerStone);
+    oplogTruncationStats.insertBytesPerSecond.store(static_cast<long long>(_bytesPerSecond));
+}
+
+void WiredTigerRecordStore::OplogStones::_updateExcessSince_inlock() {
+    if (!hasExcessStones_inlock()) {
+        _excessSince = Date_t();
+    } else if (_excessSince == Date_t()) {
+        _excessSince = Date_t::now();
+    }
+    oplogTruncationStats.excessSinceMillis.store(
+        _excessSince == Date_t() ? 0 : _excessSince.toMillisSinceEpoch());
 }
 
 void WiredTigerRecordStore::OplogStones::_calculateStones(OperationContext* opCtx,
@@ -332,7 +471,7 @@ void WiredTigerRecordStore::OplogStones::_calculateStones(OperationContext* opCt
     // Use the oplog's average record size to estimate the number of records in each stone, and thus
     // estimate the combined size of the records.
     double avgRecordSize = double(dataSize) / double(numRecords);
-    double estRecordsPerStone = std::ceil(_minBytesPerStone / avgRecordSize);
+    double estRecordsPerStone = std::ceil(_minBytesPerStone.load() / avgRecordSize);
     double estBytesPerStone = estRecordsPerStone * avgRecordSize;
 
     _calculateStonesBySampling(opCtx, int64_t(estRecordsPerStone), int64_t(estBytesPerStone));
@@ -340,27 +479,117 @@ void WiredTigerRecordStore::OplogStones::_calculateStones(OperationContext* opCt
 
 void WiredTigerRecordStore::OplogStones::_calculateStonesByScanning(OperationContext* opCtx) {
     log() << "Scanning the oplog to determine where to place markers for truncation";
+    setOplogStonesProcessingMethod("scanning");
+
+    invariant(_stones.empty());
+    _currentRecords.store(0);
+    _currentBytes.store(0);
+    invariant(_scanForStones(opCtx, RecordId()));
+
+    // Having scanned the whole oplog, the stones and the stone being filled account for all of it.
+    long long numRecords = _currentRecords.load();
+    long long dataSize = _currentBytes.load();
+    for (auto&& stone : _stones) {
+        numRecords += stone.records;
+        dataSize += stone.bytes;
+    }
 
-    long long numRecords = 0;
-    long long dataSize = 0;
+    _rs->updateStatsAfterRepair(opCtx, numRecords, dataSize);
+}
 
+bool WiredTigerRecordStore::OplogStones::_scanForStones(OperationContext* opCtx,
+                                                        const RecordId& startAfter) {
     auto cursor = _rs->getCursor(opCtx, true);
+    if (!startAfter.isNull() && !cursor->seekExact(startAfter)) {
+        return false;
+    }
+
     while (auto record = cursor->next()) {
         _currentRecords.addAndFetch(1);
         int64_t newCurrentBytes = _currentBytes.addAndFetch(record->data.size());
-        if (newCurrentBytes >= _minBytesPerStone) {
+        if (newCurrentBytes >= _minBytesPerStone.load()) {
             LOG(1) << "Placing a marker at optime "
                    << Timestamp(record->id.repr()).toStringPretty();
 
             OplogStones::Stone stone = {_currentRecords.swap(0), _currentBytes.swap(0), record->id};
             _stones.push_back(stone);
         }
+    }
+    return true;
+}
 
-        numRecords++;
-        dataSize += record->data.size();
+bool WiredTigerRecordStore::OplogStones::_calculateStonesFromSizeStorer(OperationContext* opCtx) {
+    BSONObj saved = _rs->_sizeInfo->getOplogStones();
+    if (saved.isEmpty()) {
+        return false;
     }
 
-    _rs->updateStatsAfterRepair(opCtx, numRecords, dataSize);
+    RecordId firstRecord;
+    RecordId lastRecord;
+    {
+        auto record = _rs->getCursor(opCtx, /*forward=*/true)->next();
+        if (!record) {
+            return false;
+        }
+        firstRecord = record->id;
+    }
+    {
+        auto record = _rs->getCursor(opCtx, /*forward=*/false)->next();
+        if (!record) {
+            return false;
+        }
+        lastRecord = record->id;
+    }
+
+    std::deque<OplogStones::Stone> stones;
+    int64_t minBytesPerStone;
+    try {
+        minBytesPerStone = saved["minBytesPerStone"].safeNumberLong();
+        for (auto&& elem : saved["stones"].Obj()) {
+            BSONObj stoneObj = elem.Obj();
+            RecordId stoneLastRecord(stoneObj["lastRecord"].timestamp().asLL());
+            if (stoneLastRecord < firstRecord) {
+                // The records of this stone were truncated after the stones were last saved.
+                continue;
+            }
+            if (stoneLastRecord > lastRecord) {
+                // The records of this stone and those after it were not durable.
+                break;
+            }
+            stones.push_back({stoneObj["records"].safeNumberLong(),
+                              stoneObj["bytes"].safeNumberLong(),
+                              stoneLastRecord});
+        }
+    } catch (const DBException& ex) {
+        warning() << "Ignoring the saved oplog stones " << saved << ": " << redact(ex);
+        return false;
+    }
+
+    if (stones.empty() || minBytesPerStone <= 0) {
+        return false;
+    }
+
+    // The maximum size of the oplog may have changed since the stones were saved.
+    auto bounds = _minBytesPerStoneBounds(_rs->cappedMaxSize());
+    int64_t initialMinBytesPerStone = _minBytesPerStone.load();
+    _minBytesPerStone.store(std::min(bounds.second, std::max(bounds.first, minBytesPerStone)));
+
+    // Place stones over the records inserted after the last saved stone.
+    RecordId lastSavedRecord = stones.back().lastRecord;
+    _stones = std::move(stones);
+    _currentRecords.store(0);
+    _currentBytes.store(0);
+    if (!_scanForStones(opCtx, lastSavedRecord)) {
+        _stones.clear();
+        _minBytesPerStone.store(initialMinBytesPerStone);
+        return false;
+    }
+
+    log() << "Restored " << _stones.size() << " oplog stones from the size storer, the stone "
+          << "being filled contains " << _currentRecords.load() << " records totaling to "
+          << _currentBytes.load() << " bytes";
+    setOplogStonesProcessingMethod("persisted");
+    return true;
 }
 
 void WiredTigerRecordStore::OplogStones::_calculateStonesBySampling(OperationContext* opCtx,
@@ -444,6 +673,7 @@ void WiredTigerRecordStore::OplogStones::_calculateStonesBySampling(OperationCon
     // Account for the partially filled chunk.
     _currentRecords.store(_rs->numRecords(opCtx) - estRecordsPerStone * wholeStones);
     _currentBytes.store(_rs->dataSize(opCtx) - estBytesPerStone * wholeStones);
+    setOplogStonesProcessingMethod("sampling");
 }
 
 void WiredTigerRecordStore::OplogStones::_pokeReclaimThreadIfNeeded() {
@@ -454,13 +684,22 @@ void WiredTigerRecordStore::OplogStones::_pokeReclaimThreadIfNeeded() {
 
 void WiredTigerRecordStore::OplogStones::adjust(int64_t maxSize) {
     stdx::lock_guard<stdx::mutex> lk(_mutex);
-    const unsigned long long kMinStonesToKeep = 10ULL;
-    const unsigned long long kMaxStonesToKeep = 100ULL;
 
-    unsigned long long numStones = maxSize / BSONObjMaxInternalSize;
-    size_t numStonesToKeep = std::min(kMaxStonesToKeep, std::max(kMinStonesToKeep, numStones));
-    _minBytesPerStone = maxSize / numStonesToKeep;
-    invariant(_minBytesPerStone > 0);
+    int64_t numStones = maxSize / BSONObjMaxInternalSize;
+    int64_t numStonesToKeep = std::min(kMaxStonesToKeep, std::max(kMinStonesToKeep, numStones));
+    int64_t minBytesPerStone = maxSize / numStonesToKeep;
+    if (_adaptiveSizing && _bytesPerSecond > 0) {
+        // Keep the size adapted to the insert rate, within the bounds of the new maximum size.
+        auto bounds = _minBytesPerStoneBounds(maxSize);
+        minBytesPerStone = std::min(bounds.second,
+                                    std::max<int64_t>(bounds.first, _minBytesPerStone.load()));
+    }
+    _minBytesPerStone.store(minBytesPerStone);
+    invariant(_minBytesPerStone.load() > 0);
+    oplogTruncationStats.minBytesPerStone.store(minBytesPerStone);
+
+    _saveStones_inlock();
+    _updateExcessSince_inlock();
     _pokeReclaimThreadIfNeeded();
 }
 
@@ -642,6 +881,7 @@ WiredTigerRecordStore::WiredTigerRecordStore(WiredTigerKVEngine* kvEngine,
       _isCapped(params.isCapped),
       _isEphemeral(params.isEphemeral),
       _isOplog(NamespaceString::oplog(params.ns)),
+      _isClustered(params.isClustered),
       _cappedMaxSize(params.cappedMaxSize),
       _cappedMaxSizeSlack(std::min(params.cappedMaxSize / 10, int64_t(16 * 1024 * 1024))),
       _cappedMaxDocs(params.cappedMaxDocs),
@@ -1176,6 +1416,7 @@ void WiredTigerRecordStore::reclaimOplog(OperationContext* opCtx) {
 void WiredTigerRecordStore::reclaimOplog(OperationContext* opCtx, Timestamp mayTruncateUpTo) {
     Timer timer;
     while (auto stone = _oplogStones->peekOldestStoneIfNeeded()) {
+        Timer truncateTimer;
         invariant(stone->lastRecord.isValid());
 
         if (static_cast<std::uint64_t>(stone->lastRecord.repr()) >= mayTruncateUpTo.asULL()) {
@@ -1217,6 +1458,8 @@ void WiredTigerRecordStore::reclaimOplog(OperationContext* opCtx, Timestamp mayT
 
             // Stash the truncate point for next time to cleanly skip over tombstones, etc.
             _oplogStones->firstRecord = stone->lastRecord;
+
+            OplogStones::recordTruncation(Microseconds(truncateTimer.micros()));
         } catch (const WriteConflictException&) {
             LOG(1) << "Caught WriteConflictException while truncating oplog entries, retrying";
         }
@@ -1255,6 +1498,18 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
     WT_CURSOR* c = curwrap.get();
     invariant(c);
 
+    // A clustered collection relies on the insert failing to keep its _ids unique. The session
+    // caches one cursor per table, which every other write opens with overwrite=true, so turn
+    // overwrite off only for these inserts and restore it before the cursor goes back to the cache.
+    if (_isClustered) {
+        invariantWTOK(c->reconfigure(c, "overwrite=false"));
+    }
+    ON_BLOCK_EXIT([&] {
+        if (_isClustered) {
+            invariantWTOK(c->reconfigure(c, "overwrite=true"));
+        }
+    });
+
     RecordId highestId = RecordId();
     dassert(nRecords != 0);
     for (size_t i = 0; i < nRecords; i++) {
@@ -1265,6 +1520,15 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
             if (!status.isOK())
                 return status.getStatus();
             record.id = status.getValue();
+        } else if (_isClustered) {
+            // The _ids of a batch need not be in order.
+            StatusWith<RecordId> status =
+                clustered_record_id::extractKey(record.data.data(), record.data.size());
+            if (!status.isOK())
+                return status.getStatus();
+            record.id = status.getValue();
+            highestId = std::max(highestId, record.id);
+            continue;
         } else if (_isCapped) {
             record.id = _nextId();
         } else {
@@ -1297,6 +1561,11 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
         WiredTigerItem value(record.data.data(), record.data.size());
         c->set_value(c, value.Get());
         int ret = WT_OP_CHECK(c->insert(c));
+        if (ret == WT_DUPLICATE_KEY && _isClustered) {
+            BSONObj doc(record.data.data());
+            return buildDupKeyErrorStatus(
+                BSON("" << doc["_id"]), ns(), "clustered _id", BSON("_id" << 1));
+        }
         if (ret)
             return wtRCToStatus(ret, "WiredTigerRecordStore::insertRecord");
     }
@@ -1432,7 +1701,7 @@ StatusWith<RecordData> WiredTigerRecordStore::updateWithDamages(
         entries[i].data.data = damageSource + where->sourceOffset;
         entries[i].data.size = where->size;
         entries[i].offset = where->targetOffset;
-        entries[i].size = where->size;
+        entries[i].size = where->targetSize;
     }
 
     WiredTigerCursor curwrap(_uri, _tableId, true, opCtx);
@@ -1450,6 +1719,8 @@ StatusWith<RecordData> WiredTigerRecordStore::updateWithDamages(
     WT_ITEM value;
     invariantWTOK(c->get_value(c, &value));
 
+    _increaseDataSize(opCtx, static_cast<int64_t>(value.size) - oldRec.size());
+
     return RecordData(static_cast<const char*>(value.data), value.size).getOwned();
 }
 
@@ -1599,16 +1870,18 @@ boost::optional<RecordId> WiredTigerRecordStore::oplogStartHack(
     OperationContext* opCtx, const RecordId& startingPosition) const {
     dassert(opCtx->lockState()->isReadLocked());
 
-    if (!_isOplog)
+    if (!_isOplog && !_isClustered)
         return boost::none;
 
-    auto wtRu = WiredTigerRecoveryUnit::get(opCtx);
-    wtRu->setIsOplogReader();
-
     RecordId searchFor = startingPosition;
-    auto visibilityTs = wtRu->getOplogVisibilityTs();
-    if (visibilityTs && searchFor.repr() > *visibilityTs) {
-        searchFor = RecordId(*visibilityTs);
+    if (_isOplog) {
+        auto wtRu = WiredTigerRecoveryUnit::get(opCtx);
+        wtRu->setIsOplogReader();
+
+        auto visibilityTs = wtRu->getOplogVisibilityTs();
+        if (visibilityTs && searchFor.repr() > *visibilityTs) {
+            searchFor = RecordId(*visibilityTs);
+        }
     }
 
     WiredTigerCursor cursor(_uri, _tableId, true, opCtx);
@@ -1616,13 +1889,21 @@ boost::optional<RecordId> WiredTigerRecordStore::oplogStartHack(
 
     int cmp;
     setKey(c, searchFor);
-    int ret = c->search_near(c, &cmp);
-    if (ret == 0 && cmp > 0)
-        ret = c->prev(c);  // landed one higher than startingPosition
+    int ret;
+    if (_isOplog) {
+        ret = c->search_near(c, &cmp);
+        if (ret == 0 && cmp > 0)
+            ret = c->prev(c);  // landed one higher than startingPosition
+        // It's illegal for oplog documents to be in a prepare state.
+        invariant(ret != WT_PREPARE_CONFLICT);
+    } else {
+        // The documents of a clustered collection can be prepared, like those of any other.
+        ret = wiredTigerPrepareConflictRetry(opCtx, [&] { return c->search_near(c, &cmp); });
+        if (ret == 0 && cmp > 0)
+            ret = wiredTigerPrepareConflictRetry(opCtx, [&] { return c->prev(c); });
+    }
     if (ret == WT_NOTFOUND)
         return RecordId();  // nothing <= startingPosition
-    // It's illegal for oplog documents to be in a prepare state.
-    invariant(ret != WT_PREPARE_CONFLICT);
     invariantWTOK(ret);
 
     return getKey(c);
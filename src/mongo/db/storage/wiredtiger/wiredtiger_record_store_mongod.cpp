@@ -39,12 +39,14 @@
 #include "mongo/db/catalog/database.h"
 #include "mongo/db/catalog/database_holder.h"
 #include "mongo/db/client.h"
+#include "mongo/db/commands/server_status.h"
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_record_store_oplog_stones.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
 #include "mongo/stdx/mutex.h"
 #include "mongo/util/background.h"
@@ -166,6 +168,22 @@ bool initRsOplogBackgroundThread(StringData ns) {
     return true;
 }
 
+class OplogTruncationServerStatusSection : public ServerStatusSection {
+public:
+    OplogTruncationServerStatusSection() : ServerStatusSection("oplogTruncation") {}
+
+    bool includeByDefault() const override {
+        return true;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx,
+                            const BSONElement& configElement) const override {
+        BSONObjBuilder builder;
+        WiredTigerRecordStore::OplogStones::appendTruncationStats(&builder);
+        return builder.obj();
+    }
+} oplogTruncationServerStatusSection;
+
 MONGO_INITIALIZER(SetInitRsOplogBackgroundThreadCallback)(InitializerContext* context) {
     WiredTigerKVEngine::setInitRsOplogBackgroundThreadCallback(initRsOplogBackgroundThread);
     return Status::OK();
@@ -35,14 +35,21 @@
 #include "mongo/platform/atomic_word.h"
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/mutex.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
+class BSONObjBuilder;
 class OperationContext;
 class RecordId;
 
 // Keep "milestones" against the oplog to efficiently remove the old records when the collection
 // grows beyond its desired maximum size.
+//
+// The size of a stone adapts to the rate at which the oplog grows, so that stones are created
+// about once every kTargetSecondsPerStone, within the bounds given by the maximum size of the
+// oplog. The stones are saved in the size storer whenever they change, so that startup only needs
+// to scan the records inserted after the last stone rather than sample the whole oplog.
 class WiredTigerRecordStore::OplogStones {
 public:
     struct Stone {
@@ -111,8 +118,20 @@ public:
         return _currentRecords.load();
     }
 
+    // Fixes the minimum number of bytes per stone, which then no longer adapts to the insert rate.
     void setMinBytesPerStone(int64_t size);
 
+    int64_t minBytesPerStone() const {
+        return _minBytesPerStone.load();
+    }
+
+    // Reports how the stones were computed at startup and how truncation keeps up with inserts,
+    // for the 'oplogTruncation' serverStatus section.
+    static void appendTruncationStats(BSONObjBuilder* builder);
+
+    // Records the time taken by a truncation of the oplog.
+    static void recordTruncation(Microseconds elapsed);
+
 private:
     class InsertChange;
     class TruncateChange;
@@ -123,10 +142,37 @@ private:
                                     int64_t estRecordsPerStone,
                                     int64_t estBytesPerStone);
 
+    // Restores the stones saved in the size storer, and places stones over the records inserted
+    // after the last of them. Returns false if there are no usable saved stones.
+    bool _calculateStonesFromSizeStorer(OperationContext* opCtx);
+
+    // Places stones over the records following 'startAfter', or over all records if it is null.
+    // Returns false if 'startAfter' no longer exists.
+    bool _scanForStones(OperationContext* opCtx, const RecordId& startAfter);
+
+    // Saves the stones in the size storer, to be written by its next flush.
+    void _saveStones_inlock();
+
+    // Returns the bounds on the minimum number of bytes per stone for an oplog of 'maxSize'.
+    static std::pair<int64_t, int64_t> _minBytesPerStoneBounds(int64_t maxSize);
+
+    // Updates the estimated rate of growth of the oplog with a stone created now, and resizes the
+    // stone being filled accordingly.
+    void _adaptMinBytesPerStone_inlock(int64_t stoneBytes);
+
+    // Tracks when the oplog first exceeded its maximum size since it was last truncated.
+    void _updateExcessSince_inlock();
+
     void _pokeReclaimThreadIfNeeded();
 
     static const uint64_t kRandomSamplesPerStone = 10;
 
+    static constexpr int64_t kMinStonesToKeep = 10;
+    static constexpr int64_t kMaxStonesToKeep = 100;
+
+    // With adaptive sizing, the time it should take to fill a stone.
+    static constexpr Seconds kTargetSecondsPerStone{60};
+
     WiredTigerRecordStore* _rs;
 
     stdx::mutex _oplogReclaimMutex;
@@ -138,7 +184,19 @@ private:
 
     // Minimum number of bytes the stone being filled should contain before it gets added to the
     // deque of oplog stones.
-    int64_t _minBytesPerStone;
+    AtomicWord<long long> _minBytesPerStone;
+
+    // False once setMinBytesPerStone() fixes the size of the stones.
+    bool _adaptiveSizing = true;
+
+    // Exponentially weighted moving average of the rate at which the oplog grows, in bytes per
+    // second, or zero until the first stone is created. Guarded by '_mutex'.
+    double _bytesPerSecond = 0;
+    Date_t _lastStoneCreated;
+
+    // When the oplog first exceeded its maximum size since the last truncation, or Date_t() if it
+    // does not exceed it. Guarded by '_mutex'.
+    Date_t _excessSince;
 
     AtomicWord<long long> _currentRecords;  // Number of records in the stone being filled.
     AtomicWord<long long> _currentBytes;    // Number of bytes in the stone being filled.
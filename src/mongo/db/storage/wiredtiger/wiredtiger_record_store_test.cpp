@@ -867,5 +867,98 @@ TEST(WiredTigerRecordStoreTest, OplogStones_AscendingOrder) {
     }
 }
 
+// Verify that the oplog stones are saved in the size storer information whenever they change, and
+// are restored from it along with the records inserted after the last of them.
+TEST(WiredTigerRecordStoreTest, OplogStones_RestoreFromSizeStorer) {
+    std::unique_ptr<RecordStoreHarnessHelper> harnessHelper = newRecordStoreHarnessHelper();
+
+    const int64_t cappedMaxSize = 10 * 1024;  // 10KB
+    unique_ptr<RecordStore> rs(
+        harnessHelper->newCappedRecordStore("local.oplog.stones", cappedMaxSize, -1));
+
+    WiredTigerRecordStore* wtrs = static_cast<WiredTigerRecordStore*>(rs.get());
+    WiredTigerRecordStore::OplogStones* oplogStones = wtrs->oplogStones();
+
+    oplogStones->setMinBytesPerStone(100);
+
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+
+        ASSERT_EQ(insertBSONWithSize(opCtx.get(), rs.get(), Timestamp(1, 1), 100), RecordId(1, 1));
+        ASSERT_EQ(insertBSONWithSize(opCtx.get(), rs.get(), Timestamp(1, 2), 50), RecordId(1, 2));
+        ASSERT_EQ(insertBSONWithSize(opCtx.get(), rs.get(), Timestamp(1, 3), 60), RecordId(1, 3));
+        ASSERT_EQ(insertBSONWithSize(opCtx.get(), rs.get(), Timestamp(1, 4), 70), RecordId(1, 4));
+
+        ASSERT_EQ(2U, oplogStones->numStones());
+        ASSERT_EQ(1, oplogStones->currentRecords());
+        ASSERT_EQ(70, oplogStones->currentBytes());
+    }
+
+    // The restored stones match the saved ones, and the record inserted after the last saved stone
+    // is found by scanning. The restored size of the stones adapts to the insert rate again, so it
+    // is brought within the bounds for the maximum size of the oplog.
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+
+        WiredTigerRecordStore::OplogStones restoredStones(opCtx.get(), wtrs);
+        ASSERT_EQ(2U, restoredStones.numStones());
+        ASSERT_EQ(1, restoredStones.currentRecords());
+        ASSERT_EQ(70, restoredStones.currentBytes());
+        ASSERT_EQ(cappedMaxSize / 100, restoredStones.minBytesPerStone());
+    }
+
+    // The stones are saved again after a rollback removes some of them.
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+
+        rs->cappedTruncateAfter(opCtx.get(), RecordId(1, 2), true);
+        ASSERT_EQ(1U, oplogStones->numStones());
+        ASSERT_EQ(0, oplogStones->currentRecords());
+        ASSERT_EQ(0, oplogStones->currentBytes());
+
+        WiredTigerRecordStore::OplogStones restoredStones(opCtx.get(), wtrs);
+        ASSERT_EQ(1U, restoredStones.numStones());
+        ASSERT_EQ(0, restoredStones.currentRecords());
+        ASSERT_EQ(0, restoredStones.currentBytes());
+    }
+}
+
+// Verify that the size of the oplog stones adapts to the rate of inserts within the bounds given by
+// the maximum size of the oplog.
+TEST(WiredTigerRecordStoreTest, OplogStones_AdaptiveSize) {
+    std::unique_ptr<RecordStoreHarnessHelper> harnessHelper = newRecordStoreHarnessHelper();
+
+    const int64_t cappedMaxSize = 10 * 1024;  // 10KB
+    unique_ptr<RecordStore> rs(
+        harnessHelper->newCappedRecordStore("local.oplog.stones", cappedMaxSize, -1));
+
+    WiredTigerRecordStore* wtrs = static_cast<WiredTigerRecordStore*>(rs.get());
+    WiredTigerRecordStore::OplogStones* oplogStones = wtrs->oplogStones();
+
+    ASSERT_EQ(cappedMaxSize / 10, oplogStones->minBytesPerStone());
+
+    // The stones are filled far faster than the target time per stone, so their size stays at the
+    // upper bound.
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+
+        for (int i = 1; i <= 4; ++i) {
+            ASSERT_EQ(insertBSONWithSize(opCtx.get(), rs.get(), Timestamp(1, i), 1100),
+                      RecordId(1, i));
+        }
+
+        ASSERT_EQ(4U, oplogStones->numStones());
+        ASSERT_EQ(cappedMaxSize / 10, oplogStones->minBytesPerStone());
+    }
+
+    // Shrinking the oplog lowers the bounds on the size of the stones.
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+
+        ASSERT_OK(wtrs->updateCappedSize(opCtx.get(), 5000));
+        ASSERT_EQ(500, oplogStones->minBytesPerStone());
+    }
+}
+
 }  // namespace
 }  // namespace mongo
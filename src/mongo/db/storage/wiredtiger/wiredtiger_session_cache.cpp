@@ -34,6 +34,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 
 #include "mongo/base/error_codes.h"
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/global_settings.h"
 #include "mongo/db/repl/repl_settings.h"
@@ -111,6 +112,7 @@ WT_CURSOR* WiredTigerSession::getCursor(const std::string& uri, uint64_t id, boo
             WT_CURSOR* c = i->_cursor;
             _cursors.erase(i);
             _cursorsOut++;
+            _cursorCacheHits++;
             return c;
         }
     }
@@ -118,6 +120,7 @@ WT_CURSOR* WiredTigerSession::getCursor(const std::string& uri, uint64_t id, boo
     WT_CURSOR* cursor = NULL;
     _openCursor(_session, uri, allowOverwrite ? "" : "overwrite=false", &cursor);
     _cursorsOut++;
+    _cursorsOpened++;
     return cursor;
 }
 
@@ -127,6 +130,7 @@ WT_CURSOR* WiredTigerSession::getReadOnceCursor(const std::string& uri, bool all
     WT_CURSOR* cursor = NULL;
     _openCursor(_session, uri, config, &cursor);
     _cursorsOut++;
+    _cursorsOpened++;
     return cursor;
 }
 
@@ -196,11 +200,36 @@ uint64_t WiredTigerSession::genTableId() {
 
 // -----------------------
 
+namespace {
+
+// The number of session slots is a power of two between these bounds, and at least twice the
+// number of hardware threads, so that threads running at the same time rarely share a slot.
+const size_t kMinNumSessionSlots = 32;
+const size_t kMaxNumSessionSlots = 1024;
+
+size_t computeNumSessionSlots() {
+    const size_t hardwareThreads = stdx::thread::hardware_concurrency();
+
+    size_t numSlots = kMinNumSessionSlots;
+    while (numSlots < 2 * hardwareThreads && numSlots < kMaxNumSessionSlots) {
+        numSlots *= 2;
+    }
+    return numSlots;
+}
+
+// Threads are numbered in the order they first use a session cache, which spreads them evenly
+// over the slots.
+AtomicWord<unsigned> nextThreadNumber(0);
+thread_local unsigned threadNumber = nextThreadNumber.fetchAndAdd(1);
+
+}  // namespace
+
 WiredTigerSessionCache::WiredTigerSessionCache(WiredTigerKVEngine* engine)
     : _engine(engine),
       _conn(engine->getConnection()),
       _clockSource(_engine->getClockSource()),
       _shuttingDown(0),
+      _sessionSlots(computeNumSessionSlots()),
       _prepareCommitOrAbortCounter(0) {}
 
 WiredTigerSessionCache::WiredTigerSessionCache(WT_CONNECTION* conn, ClockSource* cs)
@@ -208,6 +237,7 @@ WiredTigerSessionCache::WiredTigerSessionCache(WT_CONNECTION* conn, ClockSource*
       _conn(conn),
       _clockSource(cs),
       _shuttingDown(0),
+      _sessionSlots(computeNumSessionSlots()),
       _prepareCommitOrAbortCounter(0) {}
 
 WiredTigerSessionCache::~WiredTigerSessionCache() {
@@ -327,25 +357,32 @@ void WiredTigerSessionCache::notifyPreparedUnitOfWorkHasCommittedOrAborted() {
 
 
 void WiredTigerSessionCache::closeAllCursors(const std::string& uri) {
-    stdx::lock_guard<stdx::mutex> lock(_cacheLock);
-    for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
-        (*i)->closeAllCursors(uri);
-    }
+    _visitIdleSessions([&](WiredTigerSession* session) {
+        session->closeAllCursors(uri);
+        return true;
+    });
 }
 
 void WiredTigerSessionCache::closeCursorsForQueuedDrops() {
     // Increment the cursor epoch so that all cursors from this epoch are closed.
     _cursorEpoch.fetchAndAdd(1);
 
-    stdx::lock_guard<stdx::mutex> lock(_cacheLock);
-    for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
-        (*i)->closeCursorsForQueuedDrops(_engine);
-    }
+    _visitIdleSessions([&](WiredTigerSession* session) {
+        session->closeCursorsForQueuedDrops(_engine);
+        return true;
+    });
 }
 
 size_t WiredTigerSessionCache::getIdleSessionsCount() {
+    size_t count = 0;
+    for (auto&& slot : _sessionSlots) {
+        if (slot.session.load()) {
+            ++count;
+        }
+    }
+
     stdx::lock_guard<stdx::mutex> lock(_cacheLock);
-    return _sessions.size();
+    return count + _sessions.size();
 }
 
 void WiredTigerSessionCache::closeExpiredIdleSessions(int64_t idleTimeMillis) {
@@ -355,20 +392,12 @@ void WiredTigerSessionCache::closeExpiredIdleSessions(int64_t idleTimeMillis) {
     }
 
     auto cutoffTime = _clockSource->now() - Milliseconds(idleTimeMillis);
-    {
-        stdx::lock_guard<stdx::mutex> lock(_cacheLock);
-        // Discard all sessions that became idle before the cutoff time
-        for (auto it = _sessions.begin(); it != _sessions.end();) {
-            auto session = *it;
-            invariant(session->getIdleExpireTime() != Date_t::min());
-            if (session->getIdleExpireTime() < cutoffTime) {
-                it = _sessions.erase(it);
-                delete (session);
-            } else {
-                ++it;
-            }
-        }
-    }
+
+    // Discard all sessions that became idle before the cutoff time
+    _visitIdleSessions([&](WiredTigerSession* session) {
+        invariant(session->getIdleExpireTime() != Date_t::min());
+        return session->getIdleExpireTime() >= cutoffTime;
+    });
 }
 
 void WiredTigerSessionCache::closeAll() {
@@ -379,6 +408,15 @@ void WiredTigerSessionCache::closeAll() {
         stdx::lock_guard<stdx::mutex> lock(_cacheLock);
         _epoch.fetchAndAdd(1);
         _sessions.swap(swap);
+        _numOverflowSessions.store(0);
+    }
+
+    // A session released into a slot concurrently with this may still be cached with the old
+    // epoch. It is closed by whichever thread next takes it out of the slot.
+    for (auto&& slot : _sessionSlots) {
+        if (WiredTigerSession* session = slot.session.swap(nullptr)) {
+            swap.push_back(session);
+        }
     }
 
     for (SessionCache::iterator i = swap.begin(); i != swap.end(); i++) {
@@ -390,25 +428,109 @@ bool WiredTigerSessionCache::isEphemeral() {
     return _engine && _engine->isEphemeral();
 }
 
+size_t WiredTigerSessionCache::_slotIndexForThisThread() const {
+    return threadNumber & (_sessionSlots.size() - 1);
+}
+
+WiredTigerSession* WiredTigerSessionCache::_takeFromSlot(SessionSlot* slot) {
+    // Avoid writing to the slot's cache line when it is empty.
+    if (!slot->session.loadRelaxed()) {
+        return nullptr;
+    }
+
+    WiredTigerSession* session = slot->session.swap(nullptr);
+    if (!session) {
+        return nullptr;
+    }
+
+    if (session->_getEpoch() != _epoch.load()) {
+        // This session was released into the slot just as closeAll() emptied it.
+        invariant(session->_getEpoch() < _epoch.load());
+        delete session;
+        return nullptr;
+    }
+
+    // Reset the idle time
+    session->setIdleExpireTime(Date_t::min());
+    return session;
+}
+
+void WiredTigerSessionCache::_visitIdleSessions(
+    const stdx::function<bool(WiredTigerSession*)>& visitor) {
+    {
+        stdx::lock_guard<stdx::mutex> lock(_cacheLock);
+        for (auto it = _sessions.begin(); it != _sessions.end();) {
+            if (visitor(*it)) {
+                ++it;
+            } else {
+                delete (*it);
+                it = _sessions.erase(it);
+            }
+        }
+        _numOverflowSessions.store(_sessions.size());
+    }
+
+    // Take each session out of its slot while visiting it, so that no other thread can use it
+    // meanwhile. If the slot has been refilled in the meantime, the session overflows to the
+    // shared pool.
+    for (auto&& slot : _sessionSlots) {
+        WiredTigerSession* session = slot.session.swap(nullptr);
+        if (!session) {
+            continue;
+        }
+
+        if (!visitor(session)) {
+            delete session;
+            continue;
+        }
+
+        if (slot.session.compareAndSwap(nullptr, session) != nullptr) {
+            stdx::lock_guard<stdx::mutex> lock(_cacheLock);
+            _sessions.push_back(session);
+            _numOverflowSessions.store(_sessions.size());
+        }
+    }
+}
+
 UniqueWiredTigerSession WiredTigerSessionCache::getSession() {
     // We should never be able to get here after _shuttingDown is set, because no new
     // operations should be allowed to start.
     invariant(!(_shuttingDown.loadRelaxed() & kShuttingDownMask));
 
-    {
+    // This thread's slot most likely holds the session it used last.
+    const size_t ownIndex = _slotIndexForThisThread();
+    SessionSlot& ownSlot = _sessionSlots[ownIndex];
+    if (WiredTigerSession* cachedSession = _takeFromSlot(&ownSlot)) {
+        ownSlot.hits.fetchAndAddRelaxed(1);
+        return UniqueWiredTigerSession(cachedSession);
+    }
+
+    if (_numOverflowSessions.load() > 0) {
         stdx::lock_guard<stdx::mutex> lock(_cacheLock);
         if (!_sessions.empty()) {
             // Get the most recently used session so that if we discard sessions, we're
             // discarding older ones
             WiredTigerSession* cachedSession = _sessions.back();
             _sessions.pop_back();
+            _numOverflowSessions.store(_sessions.size());
             // Reset the idle time
             cachedSession->setIdleExpireTime(Date_t::min());
+            _overflowHits.fetchAndAddRelaxed(1);
+            return UniqueWiredTigerSession(cachedSession);
+        }
+    }
+
+    // Opening a session is far more expensive than taking the idle session of another thread.
+    for (size_t i = 1; i < _sessionSlots.size(); ++i) {
+        SessionSlot& slot = _sessionSlots[(ownIndex + i) & (_sessionSlots.size() - 1)];
+        if (WiredTigerSession* cachedSession = _takeFromSlot(&slot)) {
+            _steals.fetchAndAddRelaxed(1);
             return UniqueWiredTigerSession(cachedSession);
         }
     }
 
     // Outside of the cache partition lock, but on release will be put back on the cache
+    _sessionsOpened.fetchAndAddRelaxed(1);
     return UniqueWiredTigerSession(
         new WiredTigerSession(_conn, this, _epoch.load(), _cursorEpoch.load()));
 }
@@ -453,6 +575,16 @@ void WiredTigerSessionCache::releaseSession(WiredTigerSession* session) {
     if (session->_getCursorEpoch() != cursorEpoch)
         session->closeCursorsForQueuedDrops(_engine);
 
+    SessionSlot& ownSlot = _sessionSlots[_slotIndexForThisThread()];
+    if (session->_cursorCacheHits) {
+        ownSlot.cursorCacheHits.fetchAndAddRelaxed(session->_cursorCacheHits);
+        session->_cursorCacheHits = 0;
+    }
+    if (session->_cursorsOpened) {
+        ownSlot.cursorsOpened.fetchAndAddRelaxed(session->_cursorsOpened);
+        session->_cursorsOpened = 0;
+    }
+
     bool returnedToCache = false;
     uint64_t currentEpoch = _epoch.load();
     bool dropQueuedIdentsAtSessionEnd = session->isDropQueuedIdentsAtSessionEndAllowed();
@@ -462,11 +594,21 @@ void WiredTigerSessionCache::releaseSession(WiredTigerSession* session) {
     session->dropQueuedIdentsAtSessionEndAllowed(true);
     session->setIdleExpireTime(_clockSource->now());
 
-    if (session->_getEpoch() == currentEpoch) {  // check outside of lock to reduce contention
-        stdx::lock_guard<stdx::mutex> lock(_cacheLock);
-        if (session->_getEpoch() == _epoch.load()) {  // recheck inside the lock for correctness
+    if (session->_getEpoch() == currentEpoch) {
+        if (ownSlot.session.compareAndSwap(nullptr, session) == nullptr) {
+            // If a concurrent closeAll() swept the slots before this, the session is closed by
+            // whichever thread next takes it out of the slot and sees its stale epoch.
             returnedToCache = true;
-            _sessions.push_back(session);
+        } else {
+            // This thread's slot already holds a session, so overflow to the shared pool.
+            _overflowReleases.fetchAndAddRelaxed(1);
+            stdx::lock_guard<stdx::mutex> lock(_cacheLock);
+            // Recheck inside the lock for correctness.
+            if (session->_getEpoch() == _epoch.load()) {
+                returnedToCache = true;
+                _sessions.push_back(session);
+                _numOverflowSessions.store(_sessions.size());
+            }
         }
     } else
         invariant(session->_getEpoch() < currentEpoch);
@@ -484,6 +626,28 @@ void WiredTigerSessionCache::setJournalListener(JournalListener* jl) {
     _journalListener = jl;
 }
 
+void WiredTigerSessionCache::appendStats(BSONObjBuilder& b) const {
+    long long slotHits = 0;
+    long long cursorCacheHits = 0;
+    long long cursorsOpened = 0;
+    for (auto&& slot : _sessionSlots) {
+        slotHits += slot.hits.loadRelaxed();
+        cursorCacheHits += slot.cursorCacheHits.loadRelaxed();
+        cursorsOpened += slot.cursorsOpened.loadRelaxed();
+    }
+
+    BSONObjBuilder bb(b.subobjStart("sessionCache"));
+    bb.append("slots", static_cast<long long>(_sessionSlots.size()));
+    bb.append("slotHits", slotHits);
+    bb.append("overflowHits", _overflowHits.loadRelaxed());
+    bb.append("steals", _steals.loadRelaxed());
+    bb.append("sessionsOpened", _sessionsOpened.loadRelaxed());
+    bb.append("overflowReleases", _overflowReleases.loadRelaxed());
+    bb.append("cursorCacheHits", cursorCacheHits);
+    bb.append("cursorsOpened", cursorsOpened);
+    bb.done();
+}
+
 bool WiredTigerSessionCache::isEngineCachingCursors() {
     return gWiredTigerCursorCacheSize.load() <= 0;
 }
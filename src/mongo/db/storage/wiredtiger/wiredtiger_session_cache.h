@@ -29,19 +29,24 @@
 
 #pragma once
 
+#include <boost/align/aligned_allocator.hpp>
 #include <list>
 #include <string>
+#include <vector>
 
 #include <wiredtiger.h>
 
 #include "mongo/db/storage/journal_listener.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_snapshot_manager.h"
 #include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/functional.h"
 #include "mongo/stdx/mutex.h"
 #include "mongo/util/concurrency/spin_lock.h"
+#include "mongo/util/with_alignment.h"
 
 namespace mongo {
 
+class BSONObjBuilder;
 class WiredTigerKVEngine;
 class WiredTigerSessionCache;
 
@@ -186,11 +191,23 @@ private:
     int _cursorsOut;
     bool _dropQueuedIdentsAtSessionEnd = true;
     Date_t _idleExpireTime;
+
+    // Cursor cache statistics since the session was last released to the session cache, which
+    // then adds them to its own.
+    uint64_t _cursorCacheHits = 0;
+    uint64_t _cursorsOpened = 0;
 };
 
 /**
  *  This cache implements a shared pool of WiredTiger sessions with the goal to amortize the
  *  cost of session creation and destruction over multiple uses.
+ *
+ *  Each thread has a slot in the cache, which holds at most one idle session. A thread releases
+ *  its session into its own slot, and looks there first when it needs a session, so it usually
+ *  gets back the session it used last, along with that session's cached cursors, without taking
+ *  any lock. Sessions released while the thread's slot is full overflow to a shared pool. A thread
+ *  which finds both its slot and the shared pool empty takes the idle session of another thread
+ *  before opening a new one.
  */
 class WiredTigerSessionCache {
 public:
@@ -305,7 +322,29 @@ public:
         return _prepareCommitOrAbortCounter.loadRelaxed();
     }
 
+    /**
+     * Appends session and cursor cache statistics for serverStatus.
+     */
+    void appendStats(BSONObjBuilder& b) const;
+
 private:
+    /**
+     * Holds the idle session of the threads which map to it, and their statistics, which are kept
+     * here so that threads using different slots do not share a cache line. A session in a slot
+     * is owned by the slot and is moved in and out of it with atomic swaps.
+     */
+    struct SessionSlot {
+        AtomicWord<WiredTigerSession*> session{nullptr};
+
+        AtomicWord<long long> hits{0};
+        AtomicWord<long long> cursorCacheHits{0};
+        AtomicWord<long long> cursorsOpened{0};
+    };
+
+    using AlignedSessionSlot = CacheAligned<SessionSlot>;
+    using SessionSlots =
+        std::vector<AlignedSessionSlot, boost::alignment::aligned_allocator<AlignedSessionSlot>>;
+
     WiredTigerKVEngine* _engine;      // not owned, might be NULL
     WT_CONNECTION* _conn;             // not owned
     ClockSource* const _clockSource;  // not owned
@@ -317,10 +356,24 @@ private:
     AtomicWord<unsigned> _shuttingDown;
     static const uint32_t kShuttingDownMask = 1 << 31;
 
+    // A power of two scaled with the number of hardware threads, indexed by a per-thread number.
+    SessionSlots _sessionSlots;
+
+    // Guards the shared pool of sessions which did not fit in their thread's slot.
     stdx::mutex _cacheLock;
     typedef std::vector<WiredTigerSession*> SessionCache;
     SessionCache _sessions;
 
+    // The size of _sessions, so that getSession() can skip _cacheLock when the pool is empty.
+    AtomicWord<long long> _numOverflowSessions{0};
+
+    // Statistics for the paths through getSession() and releaseSession() which miss the thread's
+    // slot.
+    AtomicWord<long long> _overflowHits{0};
+    AtomicWord<long long> _steals{0};
+    AtomicWord<long long> _sessionsOpened{0};
+    AtomicWord<long long> _overflowReleases{0};
+
     // Bumped when all open sessions need to be closed
     AtomicWord<unsigned long long> _epoch;  // atomic so we can check it outside of the lock
 
@@ -349,6 +402,23 @@ private:
      * session and releasing it, the session is directly released. This method is thread safe.
      */
     void releaseSession(WiredTigerSession* session);
+
+    /**
+     * Returns the index of the calling thread's slot in '_sessionSlots'.
+     */
+    size_t _slotIndexForThisThread() const;
+
+    /**
+     * Takes the idle session out of 'slot', if any. A session cached before a concurrent closeAll
+     * is closed rather than returned.
+     */
+    WiredTigerSession* _takeFromSlot(SessionSlot* slot);
+
+    /**
+     * Calls 'visitor' on every idle session, with exclusive access to it. Sessions for which it
+     * returns false are closed.
+     */
+    void _visitIdleSessions(const stdx::function<bool(WiredTigerSession*)>& visitor);
 };
 
 /**
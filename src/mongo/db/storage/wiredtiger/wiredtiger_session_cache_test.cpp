@@ -33,8 +33,10 @@
 #include <string>
 
 #include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/system_clock_source.h"
@@ -113,4 +115,72 @@ TEST(WiredTigerSessionCacheTest, CheckSessionCacheCleanup) {
     ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
 }
 
+BSONObj getSessionCacheStats(WiredTigerSessionCache* sessionCache) {
+    BSONObjBuilder bob;
+    sessionCache->appendStats(bob);
+    return bob.obj().getObjectField("sessionCache").getOwned();
+}
+
+TEST(WiredTigerSessionCacheTest, SameThreadReusesSessionFromItsSlot) {
+    WiredTigerSessionCacheHarnessHelper harnessHelper("");
+    WiredTigerSessionCache* sessionCache = harnessHelper.getSessionCache();
+
+    WiredTigerSession* first;
+    {
+        UniqueWiredTigerSession session = sessionCache->getSession();
+        first = session.get();
+    }
+    {
+        UniqueWiredTigerSession session = sessionCache->getSession();
+        ASSERT_EQUALS(first, session.get());
+    }
+
+    BSONObj stats = getSessionCacheStats(sessionCache);
+    ASSERT_EQUALS(stats["sessionsOpened"].numberLong(), 1);
+    ASSERT_EQUALS(stats["slotHits"].numberLong(), 1);
+    ASSERT_EQUALS(stats["overflowReleases"].numberLong(), 0);
+}
+
+TEST(WiredTigerSessionCacheTest, SecondSessionOverflowsToSharedPool) {
+    WiredTigerSessionCacheHarnessHelper harnessHelper("");
+    WiredTigerSessionCache* sessionCache = harnessHelper.getSessionCache();
+    {
+        UniqueWiredTigerSession first = sessionCache->getSession();
+        UniqueWiredTigerSession second = sessionCache->getSession();
+    }
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 2U);
+
+    // One session is taken from the slot, the other from the shared pool.
+    {
+        UniqueWiredTigerSession first = sessionCache->getSession();
+        UniqueWiredTigerSession second = sessionCache->getSession();
+        ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
+    }
+
+    BSONObj stats = getSessionCacheStats(sessionCache);
+    ASSERT_EQUALS(stats["sessionsOpened"].numberLong(), 2);
+    ASSERT_EQUALS(stats["slotHits"].numberLong(), 1);
+    ASSERT_EQUALS(stats["overflowHits"].numberLong(), 1);
+    ASSERT_EQUALS(stats["overflowReleases"].numberLong(), 2);
+
+    sessionCache->closeAll();
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
+}
+
+TEST(WiredTigerSessionCacheTest, SessionReleasedByAnotherThreadIsStolen) {
+    WiredTigerSessionCacheHarnessHelper harnessHelper("");
+    WiredTigerSessionCache* sessionCache = harnessHelper.getSessionCache();
+
+    stdx::thread([&] { UniqueWiredTigerSession session = sessionCache->getSession(); }).join();
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 1U);
+
+    {
+        UniqueWiredTigerSession session = sessionCache->getSession();
+        ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
+    }
+
+    BSONObj stats = getSessionCacheStats(sessionCache);
+    ASSERT_EQUALS(stats["sessionsOpened"].numberLong(), 1);
+}
+
 }  // namespace mongo
@@ -119,6 +119,11 @@ std::shared_ptr<WiredTigerSizeStorer::SizeInfo> WiredTigerSizeStorer::load(Strin
     auto result = std::make_shared<SizeInfo>();
     result->numRecords.store(data["numRecords"].safeNumberLong());
     result->dataSize.store(data["dataSize"].safeNumberLong());
+    if (auto oplogStones = data["oplogStones"]) {
+        if (oplogStones.type() == Object) {
+            result->setOplogStones(oplogStones.Obj().getOwned());
+        }
+    }
     return result;
 }
 
@@ -155,8 +160,14 @@ void WiredTigerSizeStorer::flush(bool syncToDisk) {
             // still be written back. So, the required order is to clear the dirty flag first.
             SizeInfo& sizeInfo = *it->second;
             sizeInfo._dirty.store(false);
-            BSONObj data = BSON("numRecords" << sizeInfo.numRecords.load() << "dataSize"
-                                             << sizeInfo.dataSize.load());
+            BSONObjBuilder dataBuilder;
+            dataBuilder.append("numRecords", sizeInfo.numRecords.load());
+            dataBuilder.append("dataSize", sizeInfo.dataSize.load());
+            BSONObj oplogStones = sizeInfo.getOplogStones();
+            if (!oplogStones.isEmpty()) {
+                dataBuilder.append("oplogStones", oplogStones);
+            }
+            BSONObj data = dataBuilder.obj();
 
             auto& uri = it->first;
             LOG(2) << "WiredTigerSizeStorer::flush " << uri << " -> " << redact(data);
@@ -34,6 +34,7 @@
 #include <wiredtiger.h>
 
 #include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobj.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/stdx/mutex.h"
@@ -44,7 +45,8 @@ namespace mongo {
 /**
  * The WiredTigerSizeStorer class serves as a write buffer to durably store size information for
  * MongoDB collections. The size storer uses a separate WiredTiger table as key-value store, where
- * the URI serves as key and the value is a BSON document with `numRecords` and `dataSize` fields.
+ * the URI serves as key and the value is a BSON document with `numRecords` and `dataSize` fields,
+ * and for the oplog an `oplogStones` field describing its truncation points.
  * This buffering is neccessary to allow concurrent updates of size information without causing
  * write conflicts. The dirty size information is periodically stored written back to the table,
  * including on clean shutdown and/or catalog reload. Crashes or replica-set fail-overs may result
@@ -68,9 +70,26 @@ public:
         AtomicWord<long long> numRecords;
         AtomicWord<long long> dataSize;
 
+        /**
+         * The oplog stones of an oplog, so that they need not be recomputed on startup. Empty for
+         * other record stores.
+         */
+        BSONObj getOplogStones() const {
+            stdx::lock_guard<stdx::mutex> lk(_oplogStonesMutex);
+            return _oplogStones;
+        }
+
+        void setOplogStones(BSONObj oplogStones) {
+            stdx::lock_guard<stdx::mutex> lk(_oplogStonesMutex);
+            _oplogStones = std::move(oplogStones);
+        }
+
     private:
         friend WiredTigerSizeStorer;
         AtomicWord<bool> _dirty;
+
+        mutable stdx::mutex _oplogStonesMutex;
+        BSONObj _oplogStones;
     };
 
     WiredTigerSizeStorer(WT_CONNECTION* conn,
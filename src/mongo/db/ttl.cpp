@@ -43,12 +43,14 @@
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/client.h"
 #include "mongo/db/commands/fsync_locked.h"
+#include "mongo/db/commands/server_status.h"
 #include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/exec/delete.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/namespace_string.h"
+#include "mongo/db/op_observer.h"
 #include "mongo/db/ops/insert.h"
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/repl/replication_coordinator.h"
@@ -58,6 +60,9 @@
 #include "mongo/util/concurrency/idle_thread_block.h"
 #include "mongo/util/exit.h"
 #include "mongo/util/log.h"
+#include "mongo/util/scopeguard.h"
+#include "mongo/util/string_map.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -68,6 +73,93 @@ ServerStatusMetricField<Counter64> ttlPassesDisplay("ttl.passes", &ttlPasses);
 ServerStatusMetricField<Counter64> ttlDeletedDocumentsDisplay("ttl.deletedDocuments",
                                                               &ttlDeletedDocuments);
 
+Counter64 ttlDeleteBatches;
+
+ServerStatusMetricField<Counter64> ttlDeleteBatchesDisplay("ttl.deleteBatches", &ttlDeleteBatches);
+
+namespace {
+
+// Bounds the size of the applyOps oplog entry of a batch well below the BSON size limit.
+const size_t kMaxBatchedDeleteBytes = BSONObjMaxUserSize / 2;
+
+/**
+ * Per-collection statistics of the TTL monitor, reported by the 'ttl' serverStatus section.
+ */
+class TTLCollectionStats {
+public:
+    void recordIndexPass(const NamespaceString& nss,
+                         long long deletedDocuments,
+                         long long deleteBatches,
+                         Milliseconds elapsed) {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        auto& stats = _stats[nss.ns()];
+        stats.deletedDocuments += deletedDocuments;
+        stats.deleteBatches += deleteBatches;
+        stats.elapsedMillis += durationCount<Milliseconds>(elapsed);
+        stats.lastDeletedDocuments = deletedDocuments;
+        stats.lastPassTime = Date_t::now();
+    }
+
+    /**
+     * Discards the statistics of collections which no longer have a TTL index.
+     */
+    void retainOnly(const std::vector<std::string>& ttlCollections) {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        StringMap<Stats> retained;
+        for (const auto& ns : ttlCollections) {
+            auto it = _stats.find(ns);
+            if (it != _stats.end()) {
+                retained[ns] = it->second;
+            }
+        }
+        _stats.swap(retained);
+    }
+
+    BSONObj toBSON() const {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        BSONObjBuilder builder;
+        for (const auto& entry : _stats) {
+            BSONObjBuilder collBuilder(builder.subobjStart(entry.first));
+            collBuilder.append("deletedDocuments", entry.second.deletedDocuments);
+            collBuilder.append("deleteBatches", entry.second.deleteBatches);
+            collBuilder.append("totalDeleteMillis", entry.second.elapsedMillis);
+            collBuilder.append("lastPassDeletedDocuments", entry.second.lastDeletedDocuments);
+            collBuilder.append("lastPassTime", entry.second.lastPassTime);
+        }
+        return builder.obj();
+    }
+
+private:
+    struct Stats {
+        long long deletedDocuments = 0;
+        long long deleteBatches = 0;
+        long long elapsedMillis = 0;
+        long long lastDeletedDocuments = 0;
+        Date_t lastPassTime;
+    };
+
+    mutable stdx::mutex _mutex;
+    StringMap<Stats> _stats;
+};
+
+TTLCollectionStats ttlCollectionStats;
+
+class TTLServerStatusSection : public ServerStatusSection {
+public:
+    TTLServerStatusSection() : ServerStatusSection("ttl") {}
+
+    bool includeByDefault() const override {
+        return false;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx,
+                            const BSONElement& configElement) const override {
+        return BSON("collections" << ttlCollectionStats.toBSON());
+    }
+} ttlServerStatusSection;
+
+}  // namespace
+
 class TTLMonitor : public BackgroundJob {
 public:
     TTLMonitor() {}
@@ -127,6 +219,7 @@ private:
         std::vector<BSONObj> ttlIndexes;
 
         ttlPasses.increment();
+        ttlCollectionStats.retainOnly(ttlCollections);
 
         // Get all TTL indexes from every collection.
         for (const std::string& collectionNS : ttlCollections) {
@@ -151,36 +244,62 @@ private:
         }
 
         for (const BSONObj& idx : ttlIndexes) {
+            Timer timer;
+            TTLIndexPassStats passStats;
             try {
-                doTTLForIndex(&opCtx, idx);
+                // Delete in batches until the index has no more expired documents, releasing the
+                // locks between the batches.
+                while (doTTLForIndex(&opCtx, idx, &passStats)) {
+                    const int batchDelayMillis = ttlMonitorBatchDelayMillis.load();
+                    if (batchDelayMillis > 0) {
+                        MONGO_IDLE_THREAD_BLOCK;
+                        sleepmillis(batchDelayMillis);
+                    }
+
+                    if (globalInShutdownDeprecated() || !ttlMonitorEnabled.load()) {
+                        break;
+                    }
+                }
             } catch (const DBException& dbex) {
                 error() << "Error processing ttl index: " << idx << " -- " << dbex.toString();
-                // Continue on to the next index.
-                continue;
             }
+
+            ttlCollectionStats.recordIndexPass(NamespaceString(idx["ns"].String()),
+                                               passStats.deletedDocuments,
+                                               passStats.deleteBatches,
+                                               Milliseconds(timer.millis()));
         }
     }
 
+    struct TTLIndexPassStats {
+        long long deletedDocuments = 0;
+        long long deleteBatches = 0;
+    };
+
     /**
      * Remove documents from the collection using the specified TTL index after a sufficient amount
      * of time has passed according to its expiry specification.
+     *
+     * When 'ttlMonitorBatchedDeletes' is set, at most one batch of documents is removed, and the
+     * return value says whether more expired documents may remain. Otherwise, all expired
+     * documents are removed and the return value is false.
      */
-    void doTTLForIndex(OperationContext* opCtx, BSONObj idx) {
+    bool doTTLForIndex(OperationContext* opCtx, BSONObj idx, TTLIndexPassStats* passStats) {
         const NamespaceString collectionNSS(idx["ns"].String());
         if (collectionNSS.isDropPendingNamespace()) {
-            return;
+            return false;
         }
         if (!userAllowedWriteNS(collectionNSS).isOK()) {
             error() << "namespace '" << collectionNSS
                     << "' doesn't allow deletes, skipping ttl job for: " << idx;
-            return;
+            return false;
         }
 
         const BSONObj key = idx["key"].Obj();
         const StringData name = idx["name"].valueStringData();
         if (key.nFields() != 1) {
             error() << "key for ttl index can only have 1 field, skipping ttl job for: " << idx;
-            return;
+            return false;
         }
 
         LOG(1) << "ns: " << collectionNSS << " key: " << key << " name: " << name;
@@ -189,18 +308,18 @@ private:
         Collection* collection = autoGetCollection.getCollection();
         if (!collection) {
             // Collection was dropped.
-            return;
+            return false;
         }
 
         if (!repl::ReplicationCoordinator::get(opCtx)->canAcceptWritesFor(opCtx, collectionNSS)) {
-            return;
+            return false;
         }
 
         const IndexDescriptor* desc = collection->getIndexCatalog()->findIndexByName(opCtx, name);
         if (!desc) {
             LOG(1) << "index not found (index build in progress? index dropped?), skipping "
                    << "ttl job for: " << idx;
-            return;
+            return false;
         }
 
         // Re-read 'idx' from the descriptor, in case the collection or index definition changed
@@ -209,7 +328,7 @@ private:
 
         if (IndexType::INDEX_BTREE != IndexNames::nameToType(desc->getAccessMethodName())) {
             error() << "special index can't be used as a ttl index, skipping ttl job for: " << idx;
-            return;
+            return false;
         }
 
         BSONElement secondsExpireElt = idx[secondsExpireField];
@@ -217,7 +336,7 @@ private:
             error() << "ttl indexes require the " << secondsExpireField << " field to be "
                     << "numeric but received a type of " << typeName(secondsExpireElt.type())
                     << ", skipping ttl job for: " << idx;
-            return;
+            return false;
         }
 
         const Date_t kDawnOfTime =
@@ -242,6 +361,17 @@ private:
         auto canonicalQuery = CanonicalQuery::canonicalize(opCtx, std::move(qr));
         invariant(canonicalQuery.getStatus());
 
+        if (ttlMonitorBatchedDeletes.load()) {
+            return deleteExpiredBatch(opCtx,
+                                      collection,
+                                      desc,
+                                      startKey,
+                                      endKey,
+                                      direction,
+                                      *canonicalQuery.getValue()->root(),
+                                      passStats);
+        }
+
         auto params = std::make_unique<DeleteStageParams>();
         params->isMulti = true;
         params->canonicalQuery = canonicalQuery.getValue().get();
@@ -261,12 +391,93 @@ private:
         if (!result.isOK()) {
             error() << "ttl query execution for index " << idx
                     << " failed with status: " << redact(result);
-            return;
+            return false;
         }
 
         const long long numDeleted = DeleteStage::getNumDeleted(*exec);
         ttlDeletedDocuments.increment(numDeleted);
+        passStats->deletedDocuments += numDeleted;
         LOG(1) << "deleted: " << numDeleted;
+        return false;
+    }
+
+    /**
+     * Deletes up to 'ttlMonitorBatchSize' documents whose keys in 'desc' are within the given
+     * bounds and which still match 'expiredFilter', in a single WriteUnitOfWork whose deletes are
+     * replicated as one applyOps oplog entry. Returns true if more expired documents may remain.
+     */
+    bool deleteExpiredBatch(OperationContext* opCtx,
+                            Collection* collection,
+                            const IndexDescriptor* desc,
+                            const BSONObj& startKey,
+                            const BSONObj& endKey,
+                            InternalPlanner::Direction direction,
+                            const MatchExpression& expiredFilter,
+                            TTLIndexPassStats* passStats) {
+        const size_t batchSize = ttlMonitorBatchSize.load();
+
+        std::vector<RecordId> recordIds;
+        {
+            auto exec = InternalPlanner::indexScan(opCtx,
+                                                   collection,
+                                                   desc,
+                                                   startKey,
+                                                   endKey,
+                                                   BoundInclusion::kIncludeBothStartAndEndKeys,
+                                                   PlanExecutor::NO_YIELD,
+                                                   direction);
+            RecordId recordId;
+            while (recordIds.size() < batchSize &&
+                   PlanExecutor::ADVANCED == exec->getNext(nullptr, &recordId)) {
+                recordIds.push_back(recordId);
+            }
+        }
+
+        if (recordIds.empty()) {
+            return false;
+        }
+
+        long long numDeleted = 0;
+        bool reachedBatchBytes = false;
+        writeConflictRetry(opCtx, "ttlBatchedDelete", collection->ns().ns(), [&] {
+            numDeleted = 0;
+            reachedBatchBytes = false;
+
+            auto& batchedWrites = OpObserver::BatchedWrites::get(opCtx);
+            batchedWrites.reset();
+            batchedWrites.active = true;
+            ON_BLOCK_EXIT([&] { batchedWrites.reset(); });
+
+            WriteUnitOfWork wuow(opCtx);
+            for (const auto& recordId : recordIds) {
+                // The document may have been removed, or updated not to expire yet, since the index
+                // scan.
+                Snapshotted<BSONObj> doc;
+                if (!collection->findDoc(opCtx, recordId, &doc) ||
+                    !expiredFilter.matchesBSON(doc.value())) {
+                    continue;
+                }
+
+                collection->deleteDocument(opCtx, kUninitializedStmtId, recordId, nullptr);
+                ++numDeleted;
+
+                if (batchedWrites.operationsBytes >= kMaxBatchedDeleteBytes) {
+                    reachedBatchBytes = true;
+                    break;
+                }
+            }
+
+            opCtx->getServiceContext()->getOpObserver()->onBatchedWriteCommit(opCtx);
+            wuow.commit();
+        });
+
+        ttlDeletedDocuments.increment(numDeleted);
+        ttlDeleteBatches.increment();
+        passStats->deletedDocuments += numDeleted;
+        passStats->deleteBatches += 1;
+        LOG(1) << "deleted batch of: " << numDeleted;
+
+        return numDeleted > 0 && (reachedBatchBytes || recordIds.size() == batchSize);
     }
 };
 
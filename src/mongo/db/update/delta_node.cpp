@@ -0,0 +1,307 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/update/delta_node.h"
+
+#include <algorithm>
+
+#include "mongo/base/parse_number.h"
+#include "mongo/bson/mutable/algorithm.h"
+#include "mongo/db/update/document_diff.h"
+#include "mongo/db/update/storage_validation.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+
+namespace {
+
+/**
+ * Applies a document diff to a mutable document, keeping track of the paths it modifies.
+ */
+class DiffApplier {
+public:
+    explicit DiffApplier(const UpdateNode::ApplyParams& applyParams) : _applyParams(applyParams) {}
+
+    void applyObjectDiff(mutablebson::Element object, const BSONObj& diff) {
+        for (auto&& elem : diff) {
+            const auto name = elem.fieldNameStringData();
+            if (name == doc_diff::kDeleteSectionFieldName) {
+                for (auto&& deleted : sectionObj(elem)) {
+                    auto child = mutablebson::findFirstChildNamed(object, deleted.fieldName());
+                    if (!child.ok()) {
+                        continue;
+                    }
+                    FieldRef::FieldRefTempAppend tempAppend(_path, deleted.fieldNameStringData());
+                    recordModified();
+                    invariant(child.remove());
+                }
+            } else if (name == doc_diff::kUpdateSectionFieldName ||
+                       name == doc_diff::kInsertSectionFieldName) {
+                for (auto&& value : sectionObj(elem)) {
+                    auto child = mutablebson::findFirstChildNamed(object, value.fieldName());
+                    FieldRef::FieldRefTempAppend tempAppend(_path, value.fieldNameStringData());
+                    if (child.ok()) {
+                        setValue(child, value);
+                    } else {
+                        recordModified();
+                        invariant(object.appendElement(value));
+                    }
+                }
+            } else if (!name.empty() && name[0] == doc_diff::kSubDiffFieldPrefix) {
+                const auto fieldName = name.substr(1);
+                applySubDiff(
+                    mutablebson::findFirstChildNamed(object, fieldName), fieldName, subDiff(elem));
+            } else {
+                uasserted(51160,
+                          str::stream() << "Unrecognized field '" << name
+                                        << "' in the diff of an object in an update");
+            }
+        }
+    }
+
+    void applyArrayDiff(mutablebson::Element array, const BSONObj& diff) {
+        // The array element with index 'childIndex', or the end of the array, in which case
+        // 'childIndex' is the size of the array.
+        auto child = array.leftChild();
+        size_t childIndex = 0;
+        boost::optional<size_t> lastIndex;
+        bool removed = false;
+
+        for (auto&& elem : diff) {
+            const auto name = elem.fieldNameStringData();
+            if (name == doc_diff::kArrayHeaderFieldName) {
+                continue;
+            }
+            if (name == doc_diff::kArrayRemoveFieldName) {
+                uassert(51165,
+                        str::stream() << "Removal " << elem
+                                      << " in the diff of an array in an update must come before "
+                                         "the other changes to the array",
+                        !lastIndex && !removed);
+                applyRemoval(array, elem);
+                removed = true;
+                child = array.leftChild();
+                continue;
+            }
+
+            int parsedIndex = -1;
+            uassert(51161,
+                    str::stream() << "Unrecognized field '" << name
+                                  << "' in the diff of an array in an update",
+                    name.size() > 1 &&
+                        (name[0] == doc_diff::kUpdateFieldPrefix ||
+                         name[0] == doc_diff::kSubDiffFieldPrefix) &&
+                        parseNumberFromStringWithBase(name.substr(1), 10, &parsedIndex).isOK() &&
+                        parsedIndex >= 0);
+            const auto index = static_cast<size_t>(parsedIndex);
+            uassert(51162,
+                    str::stream() << "Array indexes in the diff of an array in an update must be "
+                                     "ascending, but found "
+                                  << index
+                                  << " after "
+                                  << *lastIndex,
+                    !lastIndex || index > *lastIndex);
+            lastIndex = index;
+
+            while (child.ok() && childIndex < index) {
+                child = child.rightSibling();
+                ++childIndex;
+            }
+
+            const auto indexName = name.substr(1);
+            if (name[0] == doc_diff::kSubDiffFieldPrefix) {
+                applySubDiff(child, indexName, subDiff(elem));
+                continue;
+            }
+
+            FieldRef::FieldRefTempAppend tempAppend(_path, indexName);
+            if (child.ok()) {
+                setValue(child, elem);
+                continue;
+            }
+
+            // Appending past the end of the array pads it with nulls, as $set does.
+            auto& doc = array.getDocument();
+            recordModified();
+            for (; childIndex < index; ++childIndex) {
+                invariant(array.pushBack(doc.makeElementNull(StringData())));
+            }
+            invariant(array.pushBack(doc.makeElementWithNewFieldName(StringData(), elem)));
+            ++childIndex;
+        }
+    }
+
+    /**
+     * Removes elements from 'array' as described by 'removal', an array of the index of the first
+     * element to remove, the number of elements to remove and the length the array must have. Any
+     * other length means the diff was already applied, so the array is left alone.
+     */
+    void applyRemoval(mutablebson::Element array, const BSONElement& removal) {
+        std::vector<BSONElement> parts;
+        if (removal.type() == BSONType::Array) {
+            removal.embeddedObject().elems(parts);
+        }
+        uassert(51166,
+                str::stream() << "Removal " << removal
+                              << " in the diff of an array in an update must be an array of the "
+                                 "index, count and length of the array as non-negative integers, "
+                                 "with the removed elements within the array",
+                parts.size() == 3 &&
+                    std::all_of(parts.begin(),
+                                parts.end(),
+                                [](const BSONElement& part) {
+                                    return part.isNumber() && part.safeNumberLong() >= 0;
+                                }) &&
+                    parts[0].safeNumberLong() + parts[1].safeNumberLong() <=
+                        parts[2].safeNumberLong());
+        const auto index = static_cast<size_t>(parts[0].safeNumberLong());
+        const auto count = static_cast<size_t>(parts[1].safeNumberLong());
+        const auto length = static_cast<size_t>(parts[2].safeNumberLong());
+        if (count == 0 || mutablebson::countChildren(array) != length) {
+            return;
+        }
+
+        recordModified();
+        auto child = mutablebson::getNthChild(array, index);
+        for (size_t i = 0; i < count; ++i) {
+            auto next = child.rightSibling();
+            invariant(child.remove());
+            child = next;
+        }
+    }
+
+    bool noop() const {
+        return _noop;
+    }
+
+    bool indexesAffected() const {
+        return _indexesAffected;
+    }
+
+private:
+    static BSONObj sectionObj(const BSONElement& section) {
+        uassert(51163,
+                str::stream() << "Section '" << section.fieldNameStringData()
+                              << "' of the diff of an object in an update must be an object",
+                section.type() == BSONType::Object);
+        return section.embeddedObject();
+    }
+
+    static BSONObj subDiff(const BSONElement& elem) {
+        uassert(51164,
+                str::stream() << "Subdiff '" << elem.fieldNameStringData()
+                              << "' in the diff of an update must be an object",
+                elem.type() == BSONType::Object);
+        return elem.embeddedObject();
+    }
+
+    /**
+     * Applies 'diff' to the object or array 'child'. Does nothing if 'child' is missing or of the
+     * wrong type, which can only happen when the diff is applied more than once.
+     */
+    void applySubDiff(mutablebson::Element child, StringData fieldName, const BSONObj& diff) {
+        if (!child.ok()) {
+            return;
+        }
+
+        FieldRef::FieldRefTempAppend tempAppend(_path, fieldName);
+        if (doc_diff::isArrayDiff(diff)) {
+            if (child.getType() == BSONType::Array) {
+                applyArrayDiff(child, diff);
+            }
+        } else if (child.getType() == BSONType::Object) {
+            applyObjectDiff(child, diff);
+        }
+    }
+
+    void setValue(mutablebson::Element child, const BSONElement& value) {
+        if (child.hasValue() && child.getValue().binaryEqualValues(value)) {
+            return;
+        }
+        recordModified();
+        invariant(child.setValueBSONElement(value));
+    }
+
+    void recordModified() {
+        uassert(ErrorCodes::ImmutableField,
+                str::stream() << "Performing an update on the path '" << _path.dottedField()
+                              << "' would modify an immutable field",
+                !_applyParams.immutablePaths.findConflicts(&_path, nullptr));
+
+        _noop = false;
+        if (_applyParams.indexData && _applyParams.indexData->mightBeIndexed(_path)) {
+            _indexesAffected = true;
+        }
+        if (_applyParams.modifiedPaths) {
+            _applyParams.modifiedPaths->keepShortest(_path);
+        }
+    }
+
+    const UpdateNode::ApplyParams& _applyParams;
+
+    // The path to the field currently being modified.
+    FieldRef _path;
+
+    bool _noop = true;
+    bool _indexesAffected = false;
+};
+
+}  // namespace
+
+DeltaNode::DeltaNode(BSONObj diff) : UpdateNode(Type::Delta), _diff(diff.getOwned()) {}
+
+UpdateNode::ApplyResult DeltaNode::apply(ApplyParams applyParams) const {
+    invariant(applyParams.pathToCreate->empty());
+    invariant(applyParams.pathTaken->empty());
+
+    DiffApplier applier(applyParams);
+    applier.applyObjectDiff(applyParams.element, _diff);
+    if (applier.noop()) {
+        return ApplyResult::noopResult();
+    }
+
+    if (applyParams.validateForStorage) {
+        storage_validation::storageValid(applyParams.element.getDocument());
+    }
+
+    ApplyResult applyResult;
+    applyResult.indexesAffected = applier.indexesAffected();
+    return applyResult;
+}
+
+BSONObj DeltaNode::serialize() const {
+    return BSON(LogBuilder::kUpdateSemanticsFieldName
+                << static_cast<int>(UpdateSemantics::kDelta)
+                << doc_diff::kDiffFieldName
+                << _diff);
+}
+
+}  // namespace mongo
@@ -0,0 +1,88 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mongo/db/update/update_node.h"
+#include "mongo/stdx/memory.h"
+
+namespace mongo {
+
+/**
+ * An UpdateNode representing an oplog update entry which holds a document diff ({$v: 2, diff:
+ * <diff>}) rather than update modifiers. See document_diff.h for the format of the diff.
+ */
+class DeltaNode : public UpdateNode {
+
+public:
+    explicit DeltaNode(BSONObj diff);
+
+    std::unique_ptr<UpdateNode> clone() const final {
+        return stdx::make_unique<DeltaNode>(*this);
+    }
+
+    void setCollator(const CollatorInterface* collator) final {}
+
+    /**
+     * Applies the diff to the document that 'applyParams.element' is the root of. Like $set and
+     * $unset, the diff is applied idempotently: fields it deletes may already be missing, and
+     * subdiffs of fields which are missing or no longer of the right type are skipped.
+     * 'applyParams.pathToCreate' and 'applyParams.pathTaken' must be empty.
+     */
+    ApplyResult apply(ApplyParams applyParams) const final;
+
+    /**
+     * Returns the oplog update entry this node was parsed from.
+     */
+    BSONObj serialize() const;
+
+    /**
+     * DeltaNode is never part of an update operator tree so this method cannot be called.
+     */
+    void produceSerializationMap(
+        FieldRef* currentPath,
+        std::map<std::string, std::vector<std::pair<std::string, BSONObj>>>*
+            operatorOrientedUpdates) const final {
+        MONGO_UNREACHABLE;
+    }
+
+    void acceptVisitor(UpdateNodeVisitor* visitor) final {
+        visitor->visit(this);
+    }
+
+private:
+    BSONObj _diff;
+};
+
+}  // namespace mongo
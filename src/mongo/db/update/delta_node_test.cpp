@@ -0,0 +1,249 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/update/delta_node.h"
+
+#include "mongo/bson/mutable/algorithm.h"
+#include "mongo/bson/mutable/mutable_bson_test_utils.h"
+#include "mongo/db/json.h"
+#include "mongo/db/update/document_diff.h"
+#include "mongo/db/update/update_node_test_fixture.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using DeltaNodeTest = UpdateNodeTest;
+
+/**
+ * Applies the diff between 'pre' and 'post' to 'pre', checks that it produces exactly 'post', and
+ * that applying it again leaves 'post' unchanged.
+ */
+void assertDiffRoundTrips(const BSONObj& pre, const BSONObj& post) {
+    auto diff = doc_diff::computeDiff(pre, post, BSONObjMaxUserSize);
+    ASSERT(diff);
+    DeltaNode node(*diff);
+
+    FieldRefSet immutablePaths;
+    mutablebson::Document doc(pre);
+    UpdateNode::ApplyParams applyParams(doc.root(), immutablePaths);
+    node.apply(applyParams);
+    ASSERT_TRUE(post.binaryEqual(doc.getObject())) << "diff: " << *diff
+                                                   << ", result: " << doc.getObject();
+
+    mutablebson::Document reapplied(post);
+    UpdateNode::ApplyParams reapplyParams(reapplied.root(), immutablePaths);
+    node.apply(reapplyParams);
+    ASSERT_TRUE(post.binaryEqual(reapplied.getObject())) << "diff: " << *diff << ", result: "
+                                                         << reapplied.getObject();
+}
+
+TEST_F(DeltaNodeTest, DiffsRoundTrip) {
+    assertDiffRoundTrips(fromjson("{_id: 1, a: 1}"), fromjson("{_id: 1, a: 1}"));
+    assertDiffRoundTrips(fromjson("{_id: 1, a: 1, b: 2}"), fromjson("{_id: 1, a: 'x', b: 2}"));
+    assertDiffRoundTrips(fromjson("{_id: 1, a: 1, b: 2}"), fromjson("{_id: 1, b: 2}"));
+    assertDiffRoundTrips(fromjson("{_id: 1, a: 1}"), fromjson("{_id: 1, a: 1, b: {c: 1}}"));
+    assertDiffRoundTrips(fromjson("{_id: 1, a: 1, b: 2, c: 3}"),
+                         fromjson("{_id: 1, c: 3, a: 1, b: 2}"));
+    assertDiffRoundTrips(fromjson("{_id: 1, a: {b: 1, c: 'abcdefghijklmnopqrstuvwxyz'}}"),
+                         fromjson("{_id: 1, a: {c: 'abcdefghijklmnopqrstuvwxyz', d: 1}}"));
+    assertDiffRoundTrips(fromjson("{_id: 1, a: [1, 2, 3, 4, 5, 6, 7, 8, 9, 10]}"),
+                         fromjson("{_id: 1, a: [1, 2, 3, 4, 0, 6, 7, 8, 9, 10, 11]}"));
+    assertDiffRoundTrips(fromjson("{_id: 1, a: [1, 2, 3, 4, 5, 6, 7, 8, 9, 10]}"),
+                         fromjson("{_id: 1, a: [1, 2, 3]}"));
+    assertDiffRoundTrips(fromjson("{_id: 1, a: [{b: 1, c: 'abcdefghijklmnopqrstuvwxyz'}, "
+                                  "{b: [1, 2, 3, 4, 5]}]}"),
+                         fromjson("{_id: 1, a: [{b: 2, c: 'abcdefghijklmnopqrstuvwxyz'}, "
+                                  "{b: [1, 2, 3, 4, 5, 6]}]}"));
+    assertDiffRoundTrips(fromjson("{_id: 1, a: {b: {c: {d: 'abcdefghijklmnopqrstuvwxyz'}}}}"),
+                         fromjson("{_id: 1, a: {b: {c: {d: 'abcdefghijklmnopqrstuvwxyzz'}}}}"));
+    assertDiffRoundTrips(fromjson("{_id: 1, a: {'0': 1, '1': 2}}"),
+                         fromjson("{_id: 1, a: [1, 2]}"));
+    assertDiffRoundTrips(fromjson("{_id: 1, a: 1}"), fromjson("{_id: 1, a: NumberLong(1)}"));
+}
+
+TEST_F(DeltaNodeTest, DiffsRemovingArrayElementsRoundTrip) {
+    BSONArrayBuilder pre;
+    BSONArrayBuilder removedFront;
+    BSONArrayBuilder removedMiddle;
+    BSONArrayBuilder removedBack;
+    for (int i = 0; i < 100; ++i) {
+        pre.append(i);
+        if (i >= 3) {
+            removedFront.append(i);
+        }
+        if (i != 50) {
+            removedMiddle.append(i == 20 ? -1 : i);
+        }
+        if (i < 90) {
+            removedBack.append(i);
+        }
+    }
+    auto preObj = BSON("_id" << 1 << "a" << pre.arr());
+    assertDiffRoundTrips(preObj, BSON("_id" << 1 << "a" << removedFront.arr()));
+    assertDiffRoundTrips(preObj, BSON("_id" << 1 << "a" << removedMiddle.arr()));
+    assertDiffRoundTrips(preObj, BSON("_id" << 1 << "a" << removedBack.arr()));
+}
+
+TEST_F(DeltaNodeTest, Noop) {
+    DeltaNode node(fromjson("{u: {a: 1}, d: {b: false}, sc: {u: {d: 1}}}"));
+
+    mutablebson::Document doc(fromjson("{a: 1, c: {d: 1}}"));
+    auto result = node.apply(getApplyParams(doc.root()));
+    ASSERT_TRUE(result.noop);
+    ASSERT_FALSE(result.indexesAffected);
+    ASSERT_EQUALS(fromjson("{a: 1, c: {d: 1}}"), doc);
+    ASSERT_TRUE(doc.isInPlaceModeEnabled());
+    ASSERT_EQUALS("{}", getModifiedPaths());
+}
+
+TEST_F(DeltaNodeTest, UpdatesInPlace) {
+    DeltaNode node(fromjson("{u: {a: 2}, sb: {a: true, u1: 5}}"));
+
+    mutablebson::Document doc(fromjson("{a: 1, b: [1, 2, 3]}"));
+    auto result = node.apply(getApplyParams(doc.root()));
+    ASSERT_FALSE(result.noop);
+    ASSERT_EQUALS(fromjson("{a: 2, b: [1, 5, 3]}"), doc);
+    ASSERT_TRUE(doc.isInPlaceModeEnabled());
+    ASSERT_EQUALS("{a, b.1}", getModifiedPaths());
+}
+
+TEST_F(DeltaNodeTest, SkipsSubDiffsOfMissingFields) {
+    DeltaNode node(fromjson("{u: {a: 2}, sb: {u: {c: 1}}, sc: {a: true, u0: 1}}"));
+
+    mutablebson::Document doc(fromjson("{a: 1, c: 'string'}"));
+    auto result = node.apply(getApplyParams(doc.root()));
+    ASSERT_FALSE(result.noop);
+    ASSERT_EQUALS(fromjson("{a: 2, c: 'string'}"), doc);
+    ASSERT_EQUALS("{a}", getModifiedPaths());
+}
+
+TEST_F(DeltaNodeTest, PadsArraysWithNulls) {
+    DeltaNode node(fromjson("{sa: {a: true, u1: 'x', u4: 'y'}}"));
+
+    mutablebson::Document doc(fromjson("{a: [0]}"));
+    auto result = node.apply(getApplyParams(doc.root()));
+    ASSERT_FALSE(result.noop);
+    ASSERT_EQUALS(fromjson("{a: [0, 'x', null, null, 'y']}"), doc);
+    ASSERT_EQUALS("{a.1, a.4}", getModifiedPaths());
+}
+
+TEST_F(DeltaNodeTest, RemovesArrayElements) {
+    DeltaNode node(fromjson("{sa: {a: true, r: [1, 2, 5], u1: 'x'}}"));
+
+    mutablebson::Document doc(fromjson("{a: [0, 1, 2, 3, 4]}"));
+    auto result = node.apply(getApplyParams(doc.root()));
+    ASSERT_FALSE(result.noop);
+    ASSERT_EQUALS(fromjson("{a: [0, 'x', 4]}"), doc);
+    ASSERT_EQUALS("{a}", getModifiedPaths());
+
+    // The array no longer has the length the removal applies to, so applying it again is a noop.
+    resetApplyParams();
+    result = node.apply(getApplyParams(doc.root()));
+    ASSERT_TRUE(result.noop);
+    ASSERT_EQUALS(fromjson("{a: [0, 'x', 4]}"), doc);
+}
+
+TEST_F(DeltaNodeTest, IndexesAffected) {
+    DeltaNode node(fromjson("{sa: {u: {b: 1}}}"));
+    addIndexedPath("a.c");
+
+    mutablebson::Document doc(fromjson("{a: {b: 0, c: 0}}"));
+    auto result = node.apply(getApplyParams(doc.root()));
+    ASSERT_FALSE(result.noop);
+    ASSERT_FALSE(result.indexesAffected);
+
+    resetApplyParams();
+    addIndexedPath("a.b");
+    mutablebson::Document indexedDoc(fromjson("{a: {b: 0, c: 0}}"));
+    result = node.apply(getApplyParams(indexedDoc.root()));
+    ASSERT_FALSE(result.noop);
+    ASSERT_TRUE(result.indexesAffected);
+    ASSERT_EQUALS(fromjson("{a: {b: 1, c: 0}}"), indexedDoc);
+}
+
+TEST_F(DeltaNodeTest, CannotModifyImmutableField) {
+    DeltaNode node(fromjson("{u: {_id: 2}}"));
+    addImmutablePath("_id");
+
+    mutablebson::Document doc(fromjson("{_id: 1, a: 1}"));
+    ASSERT_THROWS_CODE_AND_WHAT(node.apply(getApplyParams(doc.root())),
+                                AssertionException,
+                                ErrorCodes::ImmutableField,
+                                "Performing an update on the path '_id' would modify an immutable "
+                                "field");
+}
+
+TEST_F(DeltaNodeTest, CannotDeleteImmutableField) {
+    DeltaNode node(fromjson("{d: {_id: false}}"));
+    addImmutablePath("_id");
+
+    mutablebson::Document doc(fromjson("{_id: 1, a: 1}"));
+    ASSERT_THROWS_CODE(
+        node.apply(getApplyParams(doc.root())), AssertionException, ErrorCodes::ImmutableField);
+}
+
+TEST_F(DeltaNodeTest, RejectsMalformedDiffs) {
+    mutablebson::Document doc(fromjson("{a: [1, 2, 3], b: {c: 1}}"));
+    ASSERT_THROWS_CODE(DeltaNode(fromjson("{x: {a: 1}}")).apply(getApplyParams(doc.root())),
+                       AssertionException,
+                       51160);
+    ASSERT_THROWS_CODE(DeltaNode(fromjson("{sa: {a: true, x1: 1}}"))
+                           .apply(getApplyParams(doc.root())),
+                       AssertionException,
+                       51161);
+    ASSERT_THROWS_CODE(DeltaNode(fromjson("{sa: {a: true, u2: 1, u1: 1}}"))
+                           .apply(getApplyParams(doc.root())),
+                       AssertionException,
+                       51162);
+    ASSERT_THROWS_CODE(DeltaNode(fromjson("{u: 1}")).apply(getApplyParams(doc.root())),
+                       AssertionException,
+                       51163);
+    ASSERT_THROWS_CODE(DeltaNode(fromjson("{sb: 1}")).apply(getApplyParams(doc.root())),
+                       AssertionException,
+                       51164);
+    ASSERT_THROWS_CODE(DeltaNode(fromjson("{sa: {a: true, u0: 1, r: [1, 1, 3]}}"))
+                           .apply(getApplyParams(doc.root())),
+                       AssertionException,
+                       51165);
+    ASSERT_THROWS_CODE(DeltaNode(fromjson("{sa: {a: true, r: [2, 2, 3]}}"))
+                           .apply(getApplyParams(doc.root())),
+                       AssertionException,
+                       51166);
+}
+
+TEST_F(DeltaNodeTest, Serialize) {
+    auto diff = fromjson("{u: {a: 1}, sb: {a: true, u0: 2}}");
+    ASSERT_BSONOBJ_EQ(BSON("$v" << 2 << "diff" << diff), DeltaNode(diff).serialize());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,343 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/update/document_diff.h"
+
+#include <cstring>
+
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+
+namespace doc_diff {
+
+namespace {
+
+// Subdocuments nested deeper than this are replaced rather than diffed, so that the diff never
+// nests deeper than the documents it is computed from.
+const int kMaxDiffDepth = 50;
+
+bool rawEqual(const BSONElement& lhs, const BSONElement& rhs) {
+    return lhs.size() == rhs.size() && std::memcmp(lhs.rawdata(), rhs.rawdata(), lhs.size()) == 0;
+}
+
+std::string prefixedFieldName(char prefix, StringData fieldName) {
+    return std::string(1, prefix) + fieldName.toString();
+}
+
+boost::optional<BSONObj> diffArray(const BSONObj& pre, const BSONObj& post, int depth);
+
+/**
+ * Appends the diff of the object or array values of 'pre' and 'post' to 'subDiffs' under 's<name>'.
+ * Returns false without appending anything if the values can't be diffed or their diff is no
+ * smaller than the new value, in which case the caller logs the new value instead.
+ */
+bool appendValueDiff(const BSONElement& pre,
+                     const BSONElement& post,
+                     StringData name,
+                     int depth,
+                     BSONObjBuilder* subDiffs);
+
+BSONObj diffObject(const BSONObj& pre, const BSONObj& post, int depth) {
+    BSONObjBuilder deletes;
+    BSONObjBuilder updates;
+    BSONObjBuilder inserts;
+    BSONObjBuilder subDiffs;
+
+    auto diffValue = [&](const BSONElement& preElem, const BSONElement& postElem) {
+        if (rawEqual(preElem, postElem)) {
+            return;
+        }
+        if (!appendValueDiff(
+                preElem, postElem, postElem.fieldNameStringData(), depth, &subDiffs)) {
+            updates.append(postElem);
+        }
+    };
+
+    BSONObjIterator preIt(pre);
+    BSONObjIterator postIt(post);
+
+    // Fields usually keep their order, so walk the documents in step for as long as they do.
+    while (preIt.more() && postIt.more()) {
+        auto preElem = *preIt;
+        auto postElem = *postIt;
+        if (preElem.fieldNameStringData() != postElem.fieldNameStringData()) {
+            break;
+        }
+        diffValue(preElem, postElem);
+        ++preIt;
+        ++postIt;
+    }
+
+    if (preIt.more() || postIt.more()) {
+        std::vector<BSONElement> preRest;
+        std::vector<BSONElement> postRest;
+        StringMap<bool> preNames;
+        StringMap<bool> postNames;
+        for (; preIt.more(); ++preIt) {
+            preRest.push_back(*preIt);
+            preNames[preRest.back().fieldNameStringData()] = true;
+        }
+        for (; postIt.more(); ++postIt) {
+            postRest.push_back(*postIt);
+            postNames[postRest.back().fieldNameStringData()] = true;
+        }
+
+        // The remaining fields of 'pre' which 'post' still has, in their original order.
+        std::vector<BSONElement> kept;
+        for (auto&& preElem : preRest) {
+            if (postNames.find(preElem.fieldNameStringData()) == postNames.end()) {
+                deletes.append(preElem.fieldNameStringData(), false);
+            } else {
+                kept.push_back(preElem);
+            }
+        }
+
+        // Fields of 'post' match the kept fields of 'pre' in order, followed by new fields. Once
+        // that stops being true, the fields which were reordered are deleted and appended again.
+        size_t keptIndex = 0;
+        size_t postIndex = 0;
+        for (; postIndex < postRest.size(); ++postIndex) {
+            const auto& postElem = postRest[postIndex];
+            if (keptIndex < kept.size() &&
+                kept[keptIndex].fieldNameStringData() == postElem.fieldNameStringData()) {
+                diffValue(kept[keptIndex++], postElem);
+            } else if (keptIndex == kept.size() &&
+                       preNames.find(postElem.fieldNameStringData()) == preNames.end()) {
+                inserts.append(postElem);
+            } else {
+                break;
+            }
+        }
+        for (; keptIndex < kept.size(); ++keptIndex) {
+            deletes.append(kept[keptIndex].fieldNameStringData(), false);
+        }
+        for (; postIndex < postRest.size(); ++postIndex) {
+            inserts.append(postRest[postIndex]);
+        }
+    }
+
+    BSONObjBuilder diff;
+    if (!deletes.asTempObj().isEmpty()) {
+        diff.append(kDeleteSectionFieldName, deletes.obj());
+    }
+    if (!updates.asTempObj().isEmpty()) {
+        diff.append(kUpdateSectionFieldName, updates.obj());
+    }
+    if (!inserts.asTempObj().isEmpty()) {
+        diff.append(kInsertSectionFieldName, inserts.obj());
+    }
+    diff.appendElements(subDiffs.done());
+    return diff.obj();
+}
+
+/**
+ * Returns the index at which the elements of 'pre' are removed to shrink it to the length of
+ * 'post'. The elements the arrays have in common at their start stay before it, and those they
+ * have in common at their end after it. The elements of 'post' in between are compared either with
+ * the elements of 'pre' before the removed ones or with those after them, whichever matches more.
+ */
+size_t removalIndex(const std::vector<BSONElement>& pre, const std::vector<BSONElement>& post) {
+    const size_t numRemoved = pre.size() - post.size();
+
+    size_t prefix = 0;
+    while (prefix < post.size() && rawEqual(pre[prefix], post[prefix])) {
+        ++prefix;
+    }
+    size_t suffix = 0;
+    while (prefix + suffix < post.size() &&
+           rawEqual(pre[pre.size() - 1 - suffix], post[post.size() - 1 - suffix])) {
+        ++suffix;
+    }
+
+    const size_t end = post.size() - suffix;
+    size_t matchesBefore = 0;
+    size_t matchesAfter = 0;
+    for (size_t i = prefix; i < end; ++i) {
+        matchesBefore += rawEqual(pre[i], post[i]);
+        matchesAfter += rawEqual(pre[i + numRemoved], post[i]);
+    }
+    return matchesAfter >= matchesBefore ? prefix : end;
+}
+
+boost::optional<BSONObj> diffArray(const BSONObj& pre, const BSONObj& post, int depth) {
+    std::vector<BSONElement> preElems;
+    std::vector<BSONElement> postElems;
+    pre.elems(preElems);
+    post.elems(postElems);
+
+    BSONObjBuilder diff;
+    diff.append(kArrayHeaderFieldName, true);
+
+    // The elements of 'post' before 'removeIndex' are compared with the elements of 'pre' at the
+    // same index, and the others with the elements 'numRemoved' further along.
+    size_t numRemoved = 0;
+    size_t removeIndex = postElems.size();
+    if (postElems.size() < preElems.size()) {
+        numRemoved = preElems.size() - postElems.size();
+        removeIndex = removalIndex(preElems, postElems);
+
+        BSONArrayBuilder removal(diff.subarrayStart(kArrayRemoveFieldName));
+        removal.append(static_cast<int>(removeIndex));
+        removal.append(static_cast<int>(numRemoved));
+        removal.append(static_cast<int>(preElems.size()));
+    }
+
+    for (size_t i = 0; i < postElems.size(); ++i) {
+        const std::string index = std::to_string(i);
+        const size_t preIndex = i < removeIndex ? i : i + numRemoved;
+        if (preIndex < preElems.size()) {
+            if (rawEqual(preElems[preIndex], postElems[i]) ||
+                appendValueDiff(preElems[preIndex], postElems[i], index, depth, &diff)) {
+                continue;
+            }
+        }
+        diff.appendAs(postElems[i], prefixedFieldName(kUpdateFieldPrefix, index));
+    }
+    return diff.obj();
+}
+
+bool appendValueDiff(const BSONElement& pre,
+                     const BSONElement& post,
+                     StringData name,
+                     int depth,
+                     BSONObjBuilder* subDiffs) {
+    if (pre.type() != post.type() || depth >= kMaxDiffDepth) {
+        return false;
+    }
+
+    boost::optional<BSONObj> subDiff;
+    if (pre.type() == BSONType::Object) {
+        subDiff = diffObject(pre.embeddedObject(), post.embeddedObject(), depth + 1);
+    } else if (pre.type() == BSONType::Array) {
+        subDiff = diffArray(pre.embeddedObject(), post.embeddedObject(), depth + 1);
+    }
+    if (!subDiff || subDiff->objsize() >= post.valuesize()) {
+        return false;
+    }
+
+    subDiffs->append(prefixedFieldName(kSubDiffFieldPrefix, name), *subDiff);
+    return true;
+}
+
+void describeObjectDiff(const BSONObj& diff,
+                        const std::string& prefix,
+                        BSONObjBuilder* updatedFields,
+                        std::vector<std::string>* removedFields);
+
+void describeArrayDiff(const BSONObj& diff,
+                       const std::string& prefix,
+                       BSONObjBuilder* updatedFields,
+                       std::vector<std::string>* removedFields) {
+    for (auto&& elem : diff) {
+        auto name = elem.fieldNameStringData();
+        if (name == kArrayHeaderFieldName) {
+            continue;
+        }
+        if (name == kArrayRemoveFieldName && elem.type() == BSONType::Array) {
+            std::vector<BSONElement> removal;
+            elem.embeddedObject().elems(removal);
+            if (removal.size() == 3) {
+                const long long index = removal[0].safeNumberLong();
+                for (long long i = 0; i < removal[1].safeNumberLong(); ++i) {
+                    removedFields->push_back(prefix + std::to_string(index + i));
+                }
+            }
+            continue;
+        }
+        const auto path = prefix + name.substr(1).toString();
+        if (name[0] == kUpdateFieldPrefix) {
+            updatedFields->appendAs(elem, path);
+        } else if (name[0] == kSubDiffFieldPrefix && elem.type() == BSONType::Object) {
+            describeObjectDiff(elem.embeddedObject(), path + ".", updatedFields, removedFields);
+        }
+    }
+}
+
+void describeObjectDiff(const BSONObj& diff,
+                        const std::string& prefix,
+                        BSONObjBuilder* updatedFields,
+                        std::vector<std::string>* removedFields) {
+    if (isArrayDiff(diff)) {
+        describeArrayDiff(diff, prefix, updatedFields, removedFields);
+        return;
+    }
+
+    const auto inserts = diff[kInsertSectionFieldName];
+    for (auto&& elem : diff) {
+        auto name = elem.fieldNameStringData();
+        if (name == kDeleteSectionFieldName && elem.type() == BSONType::Object) {
+            for (auto&& deleted : elem.embeddedObject()) {
+                // A field which was moved is both deleted and appended, and reported as updated.
+                auto field = deleted.fieldNameStringData();
+                if (inserts.type() != BSONType::Object ||
+                    !inserts.embeddedObject().hasField(field)) {
+                    removedFields->push_back(prefix + field.toString());
+                }
+            }
+        } else if ((name == kUpdateSectionFieldName || name == kInsertSectionFieldName) &&
+                   elem.type() == BSONType::Object) {
+            for (auto&& updated : elem.embeddedObject()) {
+                updatedFields->appendAs(updated, prefix + updated.fieldName());
+            }
+        } else if (!name.empty() && name[0] == kSubDiffFieldPrefix &&
+                   elem.type() == BSONType::Object) {
+            describeObjectDiff(elem.embeddedObject(),
+                               prefix + name.substr(1).toString() + ".",
+                               updatedFields,
+                               removedFields);
+        }
+    }
+}
+
+}  // namespace
+
+boost::optional<BSONObj> computeDiff(const BSONObj& pre, const BSONObj& post, size_t maxDiffSize) {
+    auto diff = diffObject(pre, post, 0);
+    if (static_cast<size_t>(diff.objsize()) > maxDiffSize) {
+        return boost::none;
+    }
+    return diff;
+}
+
+bool isArrayDiff(const BSONObj& diff) {
+    return StringData(diff.firstElementFieldName()) == kArrayHeaderFieldName;
+}
+
+void describeDiff(const BSONObj& diff,
+                  BSONObjBuilder* updatedFields,
+                  std::vector<std::string>* removedFields) {
+    describeObjectDiff(diff, "", updatedFields, removedFields);
+}
+
+}  // namespace doc_diff
+
+}  // namespace mongo
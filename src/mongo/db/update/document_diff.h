@@ -0,0 +1,103 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "mongo/base/string_data.h"
+#include "mongo/db/jsobj.h"
+
+namespace mongo {
+
+/**
+ * A document diff describes how to turn one version of a document into another, and is logged to
+ * the oplog in place of $set and $unset modifiers (as {$v: 2, diff: <diff>}) so that changing one
+ * element of a large array or one field of a large subdocument doesn't log all of it.
+ *
+ * The diff of an object is itself an object with the fields
+ *
+ *   d: {<field>: false, ...}    Fields to delete.
+ *   u: {<field>: <value>, ...}  Fields whose value is replaced, keeping their position.
+ *   i: {<field>: <value>, ...}  Fields to append, in order, after all the others.
+ *   s<field>: <diff>            The diff of an object or array field.
+ *
+ * and the diff of an array is an object with the fields
+ *
+ *   a: true                     Marks the diff of an array.
+ *   r: [<index>, <count>, <length>]
+ *                               Removes <count> elements at <index>, if the array has <length>.
+ *   u<index>: <value>           Replaces or appends the element at <index>.
+ *   s<index>: <diff>            The diff of an object or array element.
+ *
+ * Deletions and removals are applied first, so that a field which moved is both deleted and
+ * appended, and the indexes of array elements are their indexes once the removed ones are gone.
+ * A removal only applies to an array which still has the length it had before the update, so that
+ * applying the diff again leaves the array alone.
+ */
+namespace doc_diff {
+
+// The name of the field holding the diff in an oplog update entry.
+constexpr StringData kDiffFieldName = "diff"_sd;
+
+constexpr StringData kDeleteSectionFieldName = "d"_sd;
+constexpr StringData kUpdateSectionFieldName = "u"_sd;
+constexpr StringData kInsertSectionFieldName = "i"_sd;
+constexpr StringData kArrayHeaderFieldName = "a"_sd;
+constexpr StringData kArrayRemoveFieldName = "r"_sd;
+constexpr char kUpdateFieldPrefix = 'u';
+constexpr char kSubDiffFieldPrefix = 's';
+
+/**
+ * Computes the diff which turns 'pre' into 'post'. Returns boost::none if the diff would be larger
+ * than 'maxDiffSize' bytes.
+ */
+boost::optional<BSONObj> computeDiff(const BSONObj& pre, const BSONObj& post, size_t maxDiffSize);
+
+/**
+ * Returns true if 'diff', the diff of an object or array field, is the diff of an array.
+ */
+bool isArrayDiff(const BSONObj& diff);
+
+/**
+ * Describes 'diff' in terms of dotted paths, the way change streams report updates: the new value
+ * of each replaced, appended, or array element path is appended to 'updatedFields', and each
+ * deleted path is added to 'removedFields'. Removed array elements are reported by their index
+ * before the update.
+ */
+void describeDiff(const BSONObj& diff,
+                  BSONObjBuilder* updatedFields,
+                  std::vector<std::string>* removedFields);
+
+}  // namespace doc_diff
+
+}  // namespace mongo
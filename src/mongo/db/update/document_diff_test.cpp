@@ -0,0 +1,181 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/update/document_diff.h"
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/json.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+BSONObj computeDiff(const BSONObj& pre, const BSONObj& post) {
+    auto diff = doc_diff::computeDiff(pre, post, BSONObjMaxUserSize);
+    ASSERT(diff);
+    return *diff;
+}
+
+BSONObj largeArray(size_t size, size_t changedIndex, int changedValue) {
+    BSONArrayBuilder array;
+    for (size_t i = 0; i < size; ++i) {
+        array.append(i == changedIndex ? changedValue : static_cast<int>(i));
+    }
+    return BSON("_id" << 1 << "a" << array.arr());
+}
+
+TEST(DocumentDiffTest, IdenticalDocumentsHaveAnEmptyDiff) {
+    auto doc = fromjson("{_id: 1, a: {b: [1, 2]}}");
+    ASSERT_BSONOBJ_EQ(BSONObj(), computeDiff(doc, doc));
+}
+
+TEST(DocumentDiffTest, ChangedFieldsAreUpdated) {
+    ASSERT_BSONOBJ_EQ(fromjson("{u: {a: 2, c: 'x'}}"),
+                      computeDiff(fromjson("{_id: 1, a: 1, b: 1, c: 1}"),
+                                  fromjson("{_id: 1, a: 2, b: 1, c: 'x'}")));
+}
+
+TEST(DocumentDiffTest, DeletedAndAppendedFields) {
+    ASSERT_BSONOBJ_EQ(fromjson("{d: {b: false}, i: {d: 1}}"),
+                      computeDiff(fromjson("{_id: 1, a: 1, b: 1, c: 1}"),
+                                  fromjson("{_id: 1, a: 1, c: 1, d: 1}")));
+}
+
+TEST(DocumentDiffTest, ReorderedFieldsAreDeletedAndAppended) {
+    ASSERT_BSONOBJ_EQ(fromjson("{d: {b: false}, i: {c: 1, b: 1}}"),
+                      computeDiff(fromjson("{_id: 1, a: 1, b: 1}"),
+                                  fromjson("{_id: 1, a: 1, c: 1, b: 1}")));
+}
+
+TEST(DocumentDiffTest, ChangedSubdocumentIsDiffed) {
+    ASSERT_BSONOBJ_EQ(
+        fromjson("{sa: {u: {b: 2}}}"),
+        computeDiff(fromjson("{_id: 1, a: {b: 1, c: 'abcdefghijklmnopqrstuvwxyz'}}"),
+                    fromjson("{_id: 1, a: {b: 2, c: 'abcdefghijklmnopqrstuvwxyz'}}")));
+}
+
+TEST(DocumentDiffTest, SmallSubdocumentIsReplaced) {
+    ASSERT_BSONOBJ_EQ(
+        fromjson("{u: {a: {b: 2}}}"),
+        computeDiff(fromjson("{_id: 1, a: {b: 1}}"), fromjson("{_id: 1, a: {b: 2}}")));
+}
+
+TEST(DocumentDiffTest, ChangedArrayElementIsDiffed) {
+    ASSERT_BSONOBJ_EQ(fromjson("{sa: {a: true, u500: -1}}"),
+                      computeDiff(largeArray(1000, 1000, 0), largeArray(1000, 500, -1)));
+}
+
+TEST(DocumentDiffTest, AppendedArrayElementsAreDiffed) {
+    ASSERT_BSONOBJ_EQ(fromjson("{sa: {a: true, u3: 'd', u4: 'e'}}"),
+                      computeDiff(fromjson("{_id: 1, a: ['abc', 'abc', 'abc']}"),
+                                  fromjson("{_id: 1, a: ['abc', 'abc', 'abc', 'd', 'e']}")));
+}
+
+TEST(DocumentDiffTest, RemovedArrayElementsAreDiffed) {
+    BSONArrayBuilder pre;
+    BSONArrayBuilder post;
+    for (int i = 0; i < 1000; ++i) {
+        pre.append(i);
+        if (i < 500 || i >= 502) {
+            post.append(i);
+        }
+    }
+    ASSERT_BSONOBJ_EQ(fromjson("{sa: {a: true, r: [500, 2, 1000]}}"),
+                      computeDiff(BSON("_id" << 1 << "a" << pre.arr()),
+                                  BSON("_id" << 1 << "a" << post.arr())));
+}
+
+TEST(DocumentDiffTest, ArrayElementsAreRemovedWhereTheyLeaveTheFewestChanges) {
+    // Dropping the last element and changing an earlier one compares the elements before the
+    // removal with the ones at the same index, rather than shifting them all.
+    BSONArrayBuilder post;
+    for (int i = 0; i < 999; ++i) {
+        post.append(i == 10 ? -1 : i);
+    }
+    ASSERT_BSONOBJ_EQ(
+        fromjson("{sa: {a: true, r: [999, 1, 1000], u10: -1}}"),
+        computeDiff(largeArray(1000, 1000, 0), BSON("_id" << 1 << "a" << post.arr())));
+}
+
+TEST(DocumentDiffTest, ShrunkArrayIsReplaced) {
+    ASSERT_BSONOBJ_EQ(fromjson("{u: {a: ['abc', 'abc']}}"),
+                      computeDiff(fromjson("{_id: 1, a: ['abc', 'abc', 'abc']}"),
+                                  fromjson("{_id: 1, a: ['abc', 'abc']}")));
+}
+
+TEST(DocumentDiffTest, ArrayOfSubdocumentsIsDiffed) {
+    ASSERT_BSONOBJ_EQ(
+        fromjson("{sa: {a: true, s1: {u: {b: 2}}}}"),
+        computeDiff(fromjson("{_id: 1, a: [{b: 0, c: 'abcdefghijklmnopqrstuvwxyz'}, "
+                             "{b: 1, c: 'abcdefghijklmnopqrstuvwxyz'}]}"),
+                    fromjson("{_id: 1, a: [{b: 0, c: 'abcdefghijklmnopqrstuvwxyz'}, "
+                             "{b: 2, c: 'abcdefghijklmnopqrstuvwxyz'}]}")));
+}
+
+TEST(DocumentDiffTest, ChangedTypeIsUpdated) {
+    ASSERT_BSONOBJ_EQ(fromjson("{u: {a: [1, 2, 3, 4]}}"),
+                      computeDiff(fromjson("{_id: 1, a: {'0': 1, '1': 2, '2': 3, '3': 4}}"),
+                                  fromjson("{_id: 1, a: [1, 2, 3, 4]}")));
+}
+
+TEST(DocumentDiffTest, FailsIfDiffIsTooLarge) {
+    auto pre = fromjson("{_id: 1, a: 1}");
+    auto post = fromjson("{_id: 1, a: 'abcdefghijklmnopqrstuvwxyz'}");
+    ASSERT_FALSE(doc_diff::computeDiff(pre, post, 16));
+    ASSERT(doc_diff::computeDiff(pre, post, 64));
+}
+
+TEST(DocumentDiffTest, DescribeDiff) {
+    BSONObjBuilder updatedFields;
+    std::vector<std::string> removedFields;
+    doc_diff::describeDiff(fromjson("{d: {b: false, c: false}, u: {x: 1}, i: {c: 2}, "
+                                    "ss: {u: {t: 3}}, sa: {a: true, u1: 4, s2: {d: {y: false}}}}"),
+                           &updatedFields,
+                           &removedFields);
+    ASSERT_BSONOBJ_EQ(fromjson("{x: 1, c: 2, 's.t': 3, 'a.1': 4}"), updatedFields.obj());
+    ASSERT_EQ(2U, removedFields.size());
+    ASSERT_EQ("b", removedFields[0]);
+    ASSERT_EQ("a.2.y", removedFields[1]);
+}
+
+TEST(DocumentDiffTest, DescribeArrayRemoval) {
+    BSONObjBuilder updatedFields;
+    std::vector<std::string> removedFields;
+    doc_diff::describeDiff(
+        fromjson("{sa: {a: true, r: [3, 2, 10], u3: 'x'}}"), &updatedFields, &removedFields);
+    ASSERT_BSONOBJ_EQ(fromjson("{'a.3': 'x'}"), updatedFields.obj());
+    ASSERT_EQ(2U, removedFields.size());
+    ASSERT_EQ("a.3", removedFields[0]);
+    ASSERT_EQ("a.4", removedFields[1]);
+}
+
+}  // namespace
+}  // namespace mongo
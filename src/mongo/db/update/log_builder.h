@@ -43,6 +43,10 @@ enum class UpdateSemantics {
     // system introduces support for arrayFilters and $[] syntax.
     kUpdateNode = 1,
 
+    // Only used in oplog entries, which hold a diff of the document (see document_diff.h) rather
+    // than the update modifiers that produced it.
+    kDelta = 2,
+
     // Must be last.
     kNumUpdateSemantics
 };
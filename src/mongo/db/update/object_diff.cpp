@@ -0,0 +1,184 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/update/object_diff.h"
+
+#include <cstring>
+#include <vector>
+
+namespace mongo {
+
+namespace object_diff {
+
+namespace {
+
+using mutablebson::DamageEvent;
+using mutablebson::DamageVector;
+
+bool rawEqual(const BSONElement& lhs, const BSONElement& rhs) {
+    return lhs.size() == rhs.size() && std::memcmp(lhs.rawdata(), rhs.rawdata(), lhs.size()) == 0;
+}
+
+class DamageBuilder {
+public:
+    DamageBuilder(const BSONObj& newObj, size_t maxDamagedBytes, DamageVector* damages)
+        : _newBase(newObj.objdata()), _maxDamagedBytes(maxDamagedBytes), _damages(damages) {}
+
+    /**
+     * Appends the damages turning the embedded object 'oldObj' into 'newObj'. Everything in the
+     * documents before these objects must already be accounted for by earlier damages.
+     */
+    bool diffObjects(const BSONObj& oldObj, const BSONObj& newObj) {
+        if (oldObj.objsize() == newObj.objsize()) {
+            if (std::memcmp(oldObj.objdata(), newObj.objdata(), oldObj.objsize()) == 0) {
+                return true;
+            }
+        } else if (!replace(newObj.objdata(), sizeof(int32_t), sizeof(int32_t))) {
+            return false;
+        }
+
+        std::vector<BSONElement> oldElems;
+        std::vector<BSONElement> newElems;
+        oldObj.elems(oldElems);
+        newObj.elems(newElems);
+
+        // Fields which keep their position and name only need their values diffed.
+        size_t prefix = 0;
+        for (; prefix < oldElems.size() && prefix < newElems.size(); ++prefix) {
+            const BSONElement& oldElem = oldElems[prefix];
+            const BSONElement& newElem = newElems[prefix];
+            if (oldElem.fieldNameStringData() != newElem.fieldNameStringData()) {
+                break;
+            }
+            if (rawEqual(oldElem, newElem)) {
+                continue;
+            }
+
+            bool ok;
+            if (oldElem.type() != newElem.type()) {
+                ok = replace(newElem.rawdata(), newElem.size(), oldElem.size());
+            } else if (oldElem.type() == BSONType::Object || oldElem.type() == BSONType::Array) {
+                ok = diffObjects(oldElem.embeddedObject(), newElem.embeddedObject());
+            } else {
+                ok = replace(newElem.value(), newElem.valuesize(), oldElem.valuesize());
+            }
+            if (!ok) {
+                return false;
+            }
+        }
+
+        // Identical trailing fields are left alone, so that a field added, removed, or renamed in
+        // the middle of an object doesn't damage everything after it.
+        size_t suffix = 0;
+        while (prefix + suffix < oldElems.size() && prefix + suffix < newElems.size() &&
+               rawEqual(oldElems[oldElems.size() - 1 - suffix],
+                        newElems[newElems.size() - 1 - suffix])) {
+            ++suffix;
+        }
+
+        const char* oldBegin = elementOrEnd(oldObj, oldElems, prefix);
+        const char* oldEnd = elementOrEnd(oldObj, oldElems, oldElems.size() - suffix);
+        const char* newBegin = elementOrEnd(newObj, newElems, prefix);
+        const char* newEnd = elementOrEnd(newObj, newElems, newElems.size() - suffix);
+        if (oldBegin == oldEnd && newBegin == newEnd) {
+            return true;
+        }
+        return replace(newBegin, newEnd - newBegin, oldEnd - oldBegin);
+    }
+
+private:
+    /**
+     * Returns the start of the element at 'index' of 'obj', or of its terminating EOO byte if
+     * 'index' is past its last element.
+     */
+    static const char* elementOrEnd(const BSONObj& obj,
+                                    const std::vector<BSONElement>& elems,
+                                    size_t index) {
+        return index < elems.size() ? elems[index].rawdata() : obj.objdata() + obj.objsize() - 1;
+    }
+
+    /**
+     * Records that 'targetSize' bytes of the old document, at the position corresponding to
+     * 'newData', are replaced by the 'size' bytes of the new document at 'newData'.
+     */
+    bool replace(const char* newData, size_t size, size_t targetSize) {
+        _damagedBytes += size;
+        if (_damagedBytes > _maxDamagedBytes) {
+            return false;
+        }
+
+        const auto offset = static_cast<DamageEvent::OffsetSizeType>(newData - _newBase);
+        if (!_damages->empty()) {
+            // Coalesce with the previous damage if it ends where this one begins.
+            DamageEvent& last = _damages->back();
+            if (last.targetOffset + last.size == offset) {
+                last.size += size;
+                last.targetSize += targetSize;
+                return true;
+            }
+        }
+        if (_damages->size() >= kMaxDamageEvents) {
+            return false;
+        }
+
+        DamageEvent event;
+        event.sourceOffset = offset;
+        event.targetOffset = offset;
+        event.size = size;
+        event.targetSize = targetSize;
+        _damages->push_back(event);
+        return true;
+    }
+
+    const char* const _newBase;
+    const size_t _maxDamagedBytes;
+    size_t _damagedBytes = 0;
+    DamageVector* const _damages;
+};
+
+}  // namespace
+
+bool computeDamages(const BSONObj& oldObj,
+                    const BSONObj& newObj,
+                    size_t maxDamagedBytes,
+                    mutablebson::DamageVector* damages) {
+    damages->clear();
+    DamageBuilder builder(newObj, maxDamagedBytes, damages);
+    if (!builder.diffObjects(oldObj, newObj)) {
+        damages->clear();
+        return false;
+    }
+    return true;
+}
+
+}  // namespace object_diff
+
+}  // namespace mongo
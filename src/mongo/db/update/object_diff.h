@@ -0,0 +1,64 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include "mongo/bson/mutable/damage_vector.h"
+#include "mongo/db/jsobj.h"
+
+namespace mongo {
+
+namespace object_diff {
+
+// Cap on the number of damage events computeDamages() will produce for a single document.
+static const size_t kMaxDamageEvents = 64;
+
+/**
+ * Computes the damages which turn 'oldObj' into 'newObj', so that an update which changes the size
+ * of a document can still be written to the storage engine as a delta rather than as a new copy of
+ * the document. The damages use 'newObj.objdata()' as their source and are ordered by offset.
+ *
+ * Fields which keep their name are diffed recursively when they are both objects or both arrays,
+ * and otherwise have their value (or whole element, if the type changed) replaced. A run of fields
+ * which were added, removed, or renamed is replaced as a single region.
+ *
+ * Returns false, leaving 'damages' empty, if the damages would copy more than 'maxDamagedBytes'
+ * bytes of 'newObj' or need more than kMaxDamageEvents events. In that case it is cheaper to write
+ * out 'newObj' in full.
+ */
+bool computeDamages(const BSONObj& oldObj,
+                    const BSONObj& newObj,
+                    size_t maxDamagedBytes,
+                    mutablebson::DamageVector* damages);
+
+}  // namespace object_diff
+
+}  // namespace mongo
@@ -0,0 +1,175 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/update/object_diff.h"
+
+#include <string>
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/json.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using mutablebson::DamageVector;
+
+/**
+ * Applies 'damages' to the bytes of 'oldObj' in order, the way a storage engine would, using the
+ * bytes of 'newObj' as the damage source.
+ */
+std::string applyDamages(const BSONObj& oldObj,
+                         const BSONObj& newObj,
+                         const DamageVector& damages) {
+    std::string result(oldObj.objdata(), oldObj.objsize());
+    for (const auto& damage : damages) {
+        ASSERT_EQ(damage.sourceOffset, damage.targetOffset);
+        ASSERT_LTE(damage.targetOffset + damage.targetSize, result.size());
+        result.replace(damage.targetOffset,
+                       damage.targetSize,
+                       newObj.objdata() + damage.sourceOffset,
+                       damage.size);
+    }
+    return result;
+}
+
+/**
+ * Asserts that the damages computed for turning 'oldObj' into 'newObj' produce 'newObj', and
+ * returns them.
+ */
+DamageVector assertDamagesApply(const BSONObj& oldObj, const BSONObj& newObj) {
+    DamageVector damages;
+    ASSERT_TRUE(object_diff::computeDamages(oldObj, newObj, newObj.objsize(), &damages));
+    ASSERT_EQ(std::string(newObj.objdata(), newObj.objsize()),
+              applyDamages(oldObj, newObj, damages));
+    return damages;
+}
+
+size_t damagedBytes(const DamageVector& damages) {
+    size_t bytes = 0;
+    for (const auto& damage : damages) {
+        bytes += damage.size;
+    }
+    return bytes;
+}
+
+TEST(ObjectDiffTest, IdenticalObjectsHaveNoDamages) {
+    BSONObj obj = fromjson("{_id: 1, a: {b: [1, 2, 3]}, c: 'abc'}");
+    ASSERT_TRUE(assertDamagesApply(obj, obj.copy()).empty());
+}
+
+TEST(ObjectDiffTest, SameSizeValueChangeOnlyDamagesTheValue) {
+    auto damages = assertDamagesApply(fromjson("{_id: 1, a: {b: 1}, c: 'abc'}"),
+                                      fromjson("{_id: 1, a: {b: 2}, c: 'abc'}"));
+    ASSERT_EQ(1U, damages.size());
+    ASSERT_EQ(4U, damages[0].size);
+    ASSERT_EQ(4U, damages[0].targetSize);
+}
+
+TEST(ObjectDiffTest, TypeChangeReplacesTheElement) {
+    BSONObj oldObj = BSON("_id" << 1 << "a" << 1 << "c"
+                                << "abc");
+    BSONObj newObj = BSON("_id" << 1 << "a" << 1LL << "c"
+                                << "abc");
+    auto damages = assertDamagesApply(oldObj, newObj);
+    ASSERT_EQ(2U, damages.size());
+    ASSERT_EQ(static_cast<size_t>(newObj["a"].size()), damages[1].size);
+    ASSERT_EQ(static_cast<size_t>(oldObj["a"].size()), damages[1].targetSize);
+}
+
+TEST(ObjectDiffTest, AddedFieldIsInserted) {
+    auto damages = assertDamagesApply(fromjson("{_id: 1, a: 'abcdefghijklmnopqrstuvwxyz', b: 1}"),
+                                      fromjson("{_id: 1, a: 'abcdefghijklmnopqrstuvwxyz', b: 1, "
+                                               "c: 2}"));
+    ASSERT_EQ(2U, damages.size());
+    ASSERT_EQ(0U, damages[1].targetSize);
+}
+
+TEST(ObjectDiffTest, RemovedFieldIsDeleted) {
+    auto damages = assertDamagesApply(fromjson("{_id: 1, a: 1, b: 'abcdefghijklmnopqrstuvwxyz'}"),
+                                      fromjson("{_id: 1, b: 'abcdefghijklmnopqrstuvwxyz'}"));
+    ASSERT_EQ(2U, damages.size());
+    ASSERT_EQ(0U, damages[1].size);
+    ASSERT_LT(damagedBytes(damages), 8U);
+}
+
+TEST(ObjectDiffTest, PushToNestedArrayOnlyDamagesTheArray) {
+    BSONObj oldObj = fromjson(
+        "{_id: 1, a: {b: [1, 2, 3], c: 'abcdefghijklmnopqrstuvwxyz'}, "
+        "d: 'abcdefghijklmnopqrstuvwxyz'}");
+    BSONObj newObj = fromjson(
+        "{_id: 1, a: {b: [1, 2, 3, 4], c: 'abcdefghijklmnopqrstuvwxyz'}, "
+        "d: 'abcdefghijklmnopqrstuvwxyz'}");
+    auto damages = assertDamagesApply(oldObj, newObj);
+    ASSERT_LT(damagedBytes(damages), 32U);
+}
+
+TEST(ObjectDiffTest, RenamedFieldIsReplaced) {
+    assertDamagesApply(fromjson("{_id: 1, a: 1, b: 2, c: 3}"),
+                       fromjson("{_id: 1, a: 1, x: 2, c: 3}"));
+    assertDamagesApply(fromjson("{_id: 1, a: 1, b: 2}"), fromjson("{_id: 1, b: 2, a: 1}"));
+    assertDamagesApply(fromjson("{_id: 1, a: [1, 2]}"), fromjson("{_id: 1, a: {'0': 1, '1': 2}}"));
+}
+
+TEST(ObjectDiffTest, EmptyObjects) {
+    assertDamagesApply(BSONObj(), fromjson("{a: 1}"));
+    assertDamagesApply(fromjson("{a: 1}"), BSONObj());
+    assertDamagesApply(fromjson("{a: {}}"), fromjson("{a: {b: []}}"));
+}
+
+TEST(ObjectDiffTest, FailsIfDamagesExceedTheByteBudget) {
+    BSONObj oldObj = fromjson("{_id: 1, a: 'abc'}");
+    BSONObj newObj = fromjson("{_id: 1, a: 'abcdefghijklmnopqrstuvwxyz'}");
+    DamageVector damages;
+    ASSERT_FALSE(object_diff::computeDamages(oldObj, newObj, 8, &damages));
+    ASSERT_TRUE(damages.empty());
+    ASSERT_TRUE(object_diff::computeDamages(oldObj, newObj, newObj.objsize(), &damages));
+    ASSERT_FALSE(damages.empty());
+}
+
+TEST(ObjectDiffTest, FailsIfDamagesNeedTooManyEvents) {
+    BSONObjBuilder oldBuilder;
+    BSONObjBuilder newBuilder;
+    for (size_t i = 0; i <= object_diff::kMaxDamageEvents; ++i) {
+        oldBuilder.append(std::to_string(i), "abcdefgh");
+        oldBuilder.append("x" + std::to_string(i), 0);
+        newBuilder.append(std::to_string(i), "abcdefgh");
+        newBuilder.append("x" + std::to_string(i), 1);
+    }
+    BSONObj oldObj = oldBuilder.obj();
+    BSONObj newObj = newBuilder.obj();
+    DamageVector damages;
+    ASSERT_FALSE(object_diff::computeDamages(oldObj, newObj, newObj.objsize(), &damages));
+    ASSERT_TRUE(damages.empty());
+}
+
+}  // namespace
+}  // namespace mongo
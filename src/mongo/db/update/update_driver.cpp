@@ -39,6 +39,8 @@
 #include "mongo/db/matcher/expression_leaf.h"
 #include "mongo/db/matcher/extensions_callback_noop.h"
 #include "mongo/db/server_options.h"
+#include "mongo/db/update/delta_node.h"
+#include "mongo/db/update/document_diff.h"
 #include "mongo/db/update/log_builder.h"
 #include "mongo/db/update/modifier_table.h"
 #include "mongo/db/update/object_replace_node.h"
@@ -67,8 +69,10 @@ StatusWith<UpdateSemantics> updateSemanticsFromElement(BSONElement element) {
 
     auto updateSemantics = element.numberLong();
 
-    // As of 3.7, we only support one version of the update language.
-    if (updateSemantics != static_cast<int>(UpdateSemantics::kUpdateNode)) {
+    // As of 3.7, we only support one version of the update language, plus the document diffs which
+    // are logged in its place.
+    if (updateSemantics != static_cast<int>(UpdateSemantics::kUpdateNode) &&
+        updateSemantics != static_cast<int>(UpdateSemantics::kDelta)) {
         return {ErrorCodes::Error(40682),
                 str::stream() << "Unrecognized value for '$v' (UpdateSemantics) field: "
                               << updateSemantics};
@@ -181,7 +185,22 @@ void UpdateDriver::parse(
                 "The $v update field is only recognized internally",
                 _fromOplogApplication);
 
-        uassertStatusOK(updateSemanticsFromElement(updateSemanticsElement));
+        auto updateSemantics = uassertStatusOK(updateSemanticsFromElement(updateSemanticsElement));
+        if (updateSemantics == UpdateSemantics::kDelta) {
+            auto diff = updateExpr[doc_diff::kDiffFieldName];
+            uassert(ErrorCodes::FailedToParse,
+                    str::stream() << "An update with $v: 2 must have an object '"
+                                  << doc_diff::kDiffFieldName
+                                  << "' field and no other fields, but found: "
+                                  << updateExpr,
+                    diff.type() == BSONType::Object && updateExpr.nFields() == 2);
+            uassert(ErrorCodes::FailedToParse,
+                    "arrayFilters may not be specified for an update with $v: 2",
+                    arrayFilters.empty());
+
+            _root = stdx::make_unique<DeltaNode>(diff.embeddedObject());
+            return;
+        }
     }
 
     auto root = stdx::make_unique<UpdateObjectNode>();
@@ -264,7 +283,7 @@ Status UpdateDriver::update(StringData matchedField,
     // The supplied 'modifiedPaths' must be an empty set.
     invariant(!modifiedPaths || modifiedPaths->empty());
 
-    if (_logOp && logOpRec) {
+    if (_logOp && logOpRec && !isDelta()) {
         applyParams.logBuilder = &logBuilder;
     }
     auto applyResult = _root->apply(applyParams);
@@ -275,6 +294,14 @@ Status UpdateDriver::update(StringData matchedField,
     if (docWasModified) {
         *docWasModified = !applyResult.noop;
     }
+    if (isDelta()) {
+        // A diff is logged as it is, since it is already in the form of an oplog entry.
+        if (_logOp && logOpRec) {
+            *logOpRec = static_cast<DeltaNode*>(_root.get())->serialize();
+        }
+        return Status::OK();
+    }
+
     if (!_replacementMode && _logOp && logOpRec) {
         // If there are binVersion=3.6 mongod nodes in the replica set, they need to be told that
         // this update is using the "kUpdateNode" version of the update semantics and not the older
@@ -299,6 +326,10 @@ bool UpdateDriver::isDocReplacement() const {
     return _replacementMode;
 }
 
+bool UpdateDriver::isDelta() const {
+    return _root && _root->type == UpdateNode::Type::Delta;
+}
+
 bool UpdateDriver::modsAffectIndices() const {
     return _affectIndices;
 }
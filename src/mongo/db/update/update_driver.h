@@ -38,6 +38,7 @@
 #include "mongo/db/field_ref_set.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/query/canonical_query.h"
+#include "mongo/db/update/delta_node.h"
 #include "mongo/db/update/modifier_table.h"
 #include "mongo/db/update/object_replace_node.h"
 #include "mongo/db/update/update_node_visitor.h"
@@ -131,6 +132,12 @@ public:
     bool isDocReplacement() const;
     static bool isDocReplacement(const BSONObj& updateExpr);
 
+    /**
+     * Returns true if the update is an oplog entry holding a document diff, which is applied
+     * directly rather than through update modifiers.
+     */
+    bool isDelta() const;
+
     bool modsAffectIndices() const;
     void refreshIndexKeys(const UpdateIndexData* indexedFields);
 
@@ -157,6 +164,9 @@ public:
      * produce a logically equivalent update expression.
      */
     BSONObj serialize() const {
+        if (isDelta()) {
+            return static_cast<DeltaNode*>(_root.get())->serialize();
+        }
         return _replacementMode ? static_cast<ObjectReplaceNode*>(_root.get())->serialize()
                                 : static_cast<UpdateObjectNode*>(_root.get())->serialize();
     }
@@ -66,7 +66,7 @@ class FieldRef;
 class UpdateNode {
 public:
     enum class Context { kAll, kInsertOnly };
-    enum class Type { Object, Array, Leaf, Replacement };
+    enum class Type { Object, Array, Leaf, Replacement, Delta };
 
     explicit UpdateNode(Type type, Context context = Context::kAll)
         : context(context), type(type) {}
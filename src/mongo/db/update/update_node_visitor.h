@@ -39,6 +39,7 @@ class BitNode;
 class CompareNode;
 class ConflictPlaceholderNode;
 class CurrentDateNode;
+class DeltaNode;
 class ObjectReplaceNode;
 class PopNode;
 class PullAllNode;
@@ -71,6 +72,7 @@ public:
     virtual void visit(CompareNode*) = 0;
     virtual void visit(ConflictPlaceholderNode*) = 0;
     virtual void visit(CurrentDateNode*) = 0;
+    virtual void visit(DeltaNode*) = 0;
     virtual void visit(ObjectReplaceNode*) = 0;
     virtual void visit(PopNode*) = 0;
     virtual void visit(PullAllNode*) = 0;
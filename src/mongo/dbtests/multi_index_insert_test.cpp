@@ -0,0 +1,221 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kDefault
+
+#include "mongo/platform/basic.h"
+
+#include <vector>
+
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/client.h"
+#include "mongo/db/db_raii.h"
+#include "mongo/db/index/index_access_method.h"
+#include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/repl/oplog.h"
+#include "mongo/dbtests/dbtests.h"
+#include "mongo/platform/random.h"
+#include "mongo/util/log.h"
+#include "mongo/util/timer.h"
+
+namespace mongo {
+namespace {
+
+const int kNumIndexes = 10;
+const int kNumBatches = 20;
+const int kBatchSize = 1000;
+
+/**
+ * Inserts the same randomly ordered documents into two collections with 'kNumIndexes' indexes
+ * each: one document at a time, so that the keys of every index are inserted in random order, and
+ * in batches, so that the keys of each index are inserted in index order. Both collections must
+ * end up with the same keys. The throughput of both is logged, to compare the two paths.
+ *
+ * When 'Replicated' is true, every document carries its own timestamp, as on a secondary applying
+ * an oplog batch, so that each key is written at the timestamp of its document.
+ */
+template <bool Replicated>
+class MultiIndexInsertThroughput {
+public:
+    MultiIndexInsertThroughput() {
+        const ServiceContext::UniqueOperationContext opCtxPtr = cc().makeOperationContext();
+        OperationContext& opCtx = *opCtxPtr;
+        for (auto ns : {kSingleNs, kBatchNs}) {
+            for (int i = 0; i < kNumIndexes; ++i) {
+                ASSERT_OK(dbtests::createIndex(&opCtx, ns, BSON(fieldName(i) << 1)));
+            }
+        }
+    }
+
+    ~MultiIndexInsertThroughput() {
+        const ServiceContext::UniqueOperationContext opCtxPtr = cc().makeOperationContext();
+        OperationContext& opCtx = *opCtxPtr;
+        for (auto ns : {kSingleNs, kBatchNs}) {
+            dbtests::WriteContextForTests ctx(&opCtx, ns);
+            WriteUnitOfWork wuow(&opCtx);
+            ctx.db()->dropCollection(&opCtx, ns).transitional_ignore();
+            wuow.commit();
+        }
+    }
+
+    void run() {
+        const ServiceContext::UniqueOperationContext opCtxPtr = cc().makeOperationContext();
+        OperationContext& opCtx = *opCtxPtr;
+        repl::UnreplicatedWritesBlock uwb(&opCtx);
+
+        const long long numDocs = kNumBatches * kBatchSize;
+        PseudoRandom random(1234);
+        std::vector<BSONObj> docs;
+        for (int i = 0; i < numDocs; ++i) {
+            BSONObjBuilder bob;
+            bob.append("_id", i);
+            for (int field = 0; field < kNumIndexes; ++field) {
+                bob.append(fieldName(field), random.nextInt64());
+            }
+            docs.push_back(bob.obj());
+        }
+
+        // Each collection is written at its own, increasing, timestamps.
+        const long long singleMillis = insertAll(&opCtx, kSingleNs, makeBatches(docs, 1), false);
+        const long long batchMillis =
+            insertAll(&opCtx, kBatchNs, makeBatches(docs, 1 + numDocs), true);
+
+        log() << "Inserted " << numDocs << (Replicated ? " replicated" : "")
+              << " documents into " << kNumIndexes << " indexes one at a time in " << singleMillis
+              << "ms and in batches of " << kBatchSize << " in " << batchMillis << "ms";
+
+        // Each index holds the same keys in both collections, one per document. The documents were
+        // inserted in the same order, so the keys also point at the same RecordIds.
+        AutoGetCollection singleColl(&opCtx, NamespaceString(kSingleNs), MODE_IS);
+        AutoGetCollection batchColl(&opCtx, NamespaceString(kBatchNs), MODE_IS);
+        const IndexCatalog* batchCatalog = batchColl.getCollection()->getIndexCatalog();
+        auto it = singleColl.getCollection()->getIndexCatalog()->getIndexIterator(&opCtx, false);
+        int numIndexes = 0;
+        while (it->more()) {
+            const IndexCatalogEntry* singleIndex = it->next();
+            const IndexDescriptor* batchDesc =
+                batchCatalog->findIndexByName(&opCtx, singleIndex->descriptor()->indexName());
+            ASSERT(batchDesc);
+            auto singleCursor = singleIndex->accessMethod()->newCursor(&opCtx);
+            auto batchCursor = batchCatalog->getEntry(batchDesc)->accessMethod()->newCursor(&opCtx);
+
+            long long numKeys = 0;
+            auto singleKey = singleCursor->seek(kMinBSONKey, true);
+            auto batchKey = batchCursor->seek(kMinBSONKey, true);
+            while (singleKey && batchKey) {
+                ASSERT_BSONOBJ_EQ(singleKey->key, batchKey->key);
+                ASSERT_EQ(singleKey->loc, batchKey->loc);
+                ++numKeys;
+                singleKey = singleCursor->next();
+                batchKey = batchCursor->next();
+            }
+            ASSERT(!singleKey);
+            ASSERT(!batchKey);
+            ASSERT_EQ(numDocs, numKeys);
+            ++numIndexes;
+        }
+        ASSERT_EQ(kNumIndexes + 1, numIndexes);
+    }
+
+private:
+    static constexpr auto kSingleNs = Replicated
+        ? "unittests.multi_index_insert_replicated_single"_sd
+        : "unittests.multi_index_insert_single"_sd;
+    static constexpr auto kBatchNs = Replicated
+        ? "unittests.multi_index_insert_replicated_batch"_sd
+        : "unittests.multi_index_insert_batch"_sd;
+
+    static std::string fieldName(int i) {
+        return str::stream() << "f" << i;
+    }
+
+    /**
+     * Splits 'docs' into batches of 'kBatchSize' statements. When 'Replicated' is true, the
+     * statements are timestamped in order, starting at 'firstTs'.
+     */
+    static std::vector<std::vector<InsertStatement>> makeBatches(const std::vector<BSONObj>& docs,
+                                                                 unsigned firstTs) {
+        std::vector<std::vector<InsertStatement>> batches(kNumBatches);
+        for (size_t i = 0; i < docs.size(); ++i) {
+            auto& batch = batches[i / kBatchSize];
+            if (Replicated) {
+                batch.emplace_back(docs[i], Timestamp(firstTs + i, 0), 0LL);
+            } else {
+                batch.emplace_back(docs[i]);
+            }
+        }
+        return batches;
+    }
+
+    /**
+     * Inserts each of 'batches' in its own WriteUnitOfWork and returns the time taken.
+     */
+    static long long insertAll(OperationContext* opCtx,
+                               StringData ns,
+                               const std::vector<std::vector<InsertStatement>>& batches,
+                               bool batched) {
+        dbtests::WriteContextForTests ctx(opCtx, ns);
+        Collection* collection = ctx.getCollection();
+
+        Timer timer;
+        for (auto&& batch : batches) {
+            WriteUnitOfWork wuow(opCtx);
+            if (batched) {
+                ASSERT_OK(collection->insertDocuments(opCtx, batch.begin(), batch.end(), nullptr));
+            } else {
+                for (auto&& stmt : batch) {
+                    ASSERT_OK(collection->insertDocument(opCtx, stmt, nullptr));
+                }
+            }
+            wuow.commit();
+        }
+        return timer.millis();
+    }
+};
+
+class All : public Suite {
+public:
+    All() : Suite("multi_index_insert") {}
+
+    void setupTests() {
+        add<MultiIndexInsertThroughput<false>>();
+
+        // Timestamped writes need a storage engine which supports them.
+        auto storageEngine = cc().getServiceContext()->getStorageEngine();
+        if (storageEngine->supportsReadConcernSnapshot()) {
+            add<MultiIndexInsertThroughput<true>>();
+        }
+    }
+};
+
+SuiteInstance<All> multiIndexInsertTests;
+
+}  // namespace
+}  // namespace mongo
@@ -431,6 +431,99 @@ public:
     }
 };
 
+// An AND with two children, where the second child is smaller and so should be hashed.
+class QueryStageAndHashChoosesSmallerChild : public QueryStageAndBase {
+public:
+    void run() {
+        dbtests::WriteContextForTests ctx(&_opCtx, ns());
+        Database* db = ctx.db();
+        Collection* coll = ctx.getCollection();
+        if (!coll) {
+            WriteUnitOfWork wuow(&_opCtx);
+            coll = db->createCollection(&_opCtx, ns());
+            wuow.commit();
+        }
+
+        for (int i = 0; i < 50; ++i) {
+            insert(BSON("foo" << i << "bar" << i));
+        }
+
+        addIndex(BSON("foo" << 1));
+        addIndex(BSON("bar" << 1));
+
+        WorkingSet ws;
+        auto ah = make_unique<AndHashStage>(&_opCtx, &ws, /*chooseBuildChild*/ true);
+
+        // Bar >= 10
+        auto params = makeIndexScanParams(&_opCtx, getIndex(BSON("bar" << 1), coll));
+        params.bounds.startKey = BSON("" << 10);
+        ah->addChild(new IndexScan(&_opCtx, params, &ws, NULL));
+
+        // Foo <= 20
+        params = makeIndexScanParams(&_opCtx, getIndex(BSON("foo" << 1), coll));
+        params.bounds.startKey = BSON("" << 20);
+        params.direction = -1;
+        ah->addChild(new IndexScan(&_opCtx, params, &ws, NULL));
+
+        // foo == bar, and foo<=20, bar>=10, so our values are:
+        // foo == 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20.
+        ASSERT_EQUALS(11, countResults(ah.get()));
+
+        // The scan over foo has 21 results to the scan over bar's 40, so it was hashed. Once it was
+        // done, the remaining results from the scan over bar were all outside the intersection.
+        const AndHashStats* stats = static_cast<const AndHashStats*>(ah->getSpecificStats());
+        ASSERT_EQUALS(1U, stats->buildChild);
+        ASSERT_EQUALS(1U, stats->mapAfterChild.size());
+        ASSERT_EQUALS(21U, stats->mapAfterChild[0]);
+        ASSERT_GREATER_THAN(stats->bloomFilterRejects, 0U);
+    }
+};
+
+// An AND with two children, where most results from the last child are not in the first.
+class QueryStageAndHashBloomFilterRejects : public QueryStageAndBase {
+public:
+    void run() {
+        dbtests::WriteContextForTests ctx(&_opCtx, ns());
+        Database* db = ctx.db();
+        Collection* coll = ctx.getCollection();
+        if (!coll) {
+            WriteUnitOfWork wuow(&_opCtx);
+            coll = db->createCollection(&_opCtx, ns());
+            wuow.commit();
+        }
+
+        for (int i = 0; i < 200; ++i) {
+            insert(BSON("foo" << i << "bar" << i));
+        }
+
+        addIndex(BSON("foo" << 1));
+        addIndex(BSON("bar" << 1));
+
+        WorkingSet ws;
+        auto ah = make_unique<AndHashStage>(&_opCtx, &ws);
+
+        // Foo <= 20
+        auto params = makeIndexScanParams(&_opCtx, getIndex(BSON("foo" << 1), coll));
+        params.bounds.startKey = BSON("" << 20);
+        params.direction = -1;
+        ah->addChild(new IndexScan(&_opCtx, params, &ws, NULL));
+
+        // Bar >= 10
+        params = makeIndexScanParams(&_opCtx, getIndex(BSON("bar" << 1), coll));
+        params.bounds.startKey = BSON("" << 10);
+        ah->addChild(new IndexScan(&_opCtx, params, &ws, NULL));
+
+        ASSERT_EQUALS(11, countResults(ah.get()));
+
+        // Of the 179 results from the scan over bar which are not in the intersection, the Bloom
+        // filter should have discarded most.
+        const AndHashStats* stats = static_cast<const AndHashStats*>(ah->getSpecificStats());
+        ASSERT_EQUALS(0U, stats->buildChild);
+        ASSERT_GREATER_THAN(stats->bloomFilterRejects, 150U);
+        ASSERT_LESS_THAN_OR_EQUALS(stats->bloomFilterRejects, 179U);
+    }
+};
+
 // An AND with three children.
 // Add large keys (512 bytes) to index of last child to verify that
 // keys in last child are not buffered
@@ -1341,6 +1434,8 @@ public:
         add<QueryStageAndHashTwoLeaf>();
         add<QueryStageAndHashTwoLeafFirstChildLargeKeys>();
         add<QueryStageAndHashTwoLeafLastChildLargeKeys>();
+        add<QueryStageAndHashChoosesSmallerChild>();
+        add<QueryStageAndHashBloomFilterRejects>();
         add<QueryStageAndHashThreeLeaf>();
         add<QueryStageAndHashThreeLeafMiddleChildLargeKeys>();
         add<QueryStageAndHashWithNothing>();
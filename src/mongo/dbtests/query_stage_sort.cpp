@@ -106,10 +106,11 @@ public:
 
     /*
      * Wraps a sort stage with a QueuedDataStage in a plan executor. Returns the plan executor,
-     * which is owned by the caller.
+     * which is owned by the caller. If 'materializeLate' is true, the sort stage is given the
+     * collection so that it can buffer sort keys and RecordIds instead of documents.
      */
     unique_ptr<PlanExecutor, PlanExecutor::Deleter> makePlanExecutorWithSortStage(
-        Collection* coll) {
+        Collection* coll, bool materializeLate = false) {
         // Build the mock scan stage which feeds the data.
         auto ws = make_unique<WorkingSet>();
         auto queuedDataStage = make_unique<QueuedDataStage>(&_opCtx, ws.get());
@@ -118,6 +119,9 @@ public:
         SortStageParams params;
         params.pattern = BSON("foo" << 1);
         params.limit = limit();
+        if (materializeLate) {
+            params.collection = coll;
+        }
 
         auto keyGenStage = make_unique<SortKeyGeneratorStage>(
             &_opCtx, queuedDataStage.release(), ws.get(), params.pattern, nullptr);
@@ -512,6 +516,95 @@ public:
     }
 };
 
+// A sort with a limit which buffers only sort keys fetches the top documents again once sorted.
+// Documents that were deleted or moved out of the top k in the meantime are replaced by the next
+// best ones, so the sort still returns k documents.
+class QueryStageSortLateMaterialization : public QueryStageSortTestBase {
+public:
+    virtual int numObj() {
+        return 2000;
+    }
+    virtual int limit() const {
+        return 10;
+    }
+
+    void run() {
+        dbtests::WriteContextForTests ctx(&_opCtx, ns());
+        Database* db = ctx.db();
+        Collection* coll = db->getCollection(&_opCtx, ns());
+        if (!coll) {
+            WriteUnitOfWork wuow(&_opCtx);
+            coll = db->createCollection(&_opCtx, ns());
+            wuow.commit();
+        }
+
+        fillData();
+
+        set<RecordId> recordIds;
+        getRecordIds(&recordIds, coll);
+
+        auto exec = makePlanExecutorWithSortStage(coll, true);
+        SortStage* ss = static_cast<SortStage*>(exec->getRootStage());
+        SortKeyGeneratorStage* keyGenStage =
+            static_cast<SortKeyGeneratorStage*>(ss->getChildren()[0].get());
+        QueuedDataStage* queuedDataStage =
+            static_cast<QueuedDataStage*>(keyGenStage->getChildren()[0].get());
+
+        // Read all of the data from the queued data stage. Only the top 'limit()' items, and as
+        // many next best items in reserve, are kept.
+        while (!queuedDataStage->isEOF()) {
+            WorkingSetID id = WorkingSet::INVALID_ID;
+            ASSERT_NOT_EQUALS(PlanStage::ADVANCED, ss->work(&id));
+        }
+
+        // Each buffered item holds a sort key rather than a whole working set member.
+        auto stats = static_cast<const SortStats*>(ss->getSpecificStats());
+        ASSERT_LT(stats->memUsage,
+                  2 * limit() * (sizeof(RecordId) + BSON("foo" << 0).objsize() + 64));
+
+        // Move the document with foo == 0 out of the top k and delete the one with foo == 1.
+        exec->saveState();
+        set<RecordId>::iterator it = recordIds.begin();
+        Snapshotted<BSONObj> oldDoc = coll->docFor(&_opCtx, *it);
+        CollectionUpdateArgs args;
+        {
+            WriteUnitOfWork wuow(&_opCtx);
+            coll->updateDocument(&_opCtx,
+                                 *it++,
+                                 oldDoc,
+                                 BSON("_id" << oldDoc.value()["_id"] << "foo" << numObj()),
+                                 false,
+                                 NULL,
+                                 &args);
+            wuow.commit();
+        }
+        OpDebug* const nullOpDebug = nullptr;
+        {
+            WriteUnitOfWork wuow(&_opCtx);
+            coll->deleteDocument(&_opCtx, kUninitializedStmtId, *it++, nullOpDebug);
+            wuow.commit();
+        }
+        exec->restoreState();
+
+        int count = 0;
+        int expectedVal = 2;
+        while (!ss->isEOF()) {
+            WorkingSetID id = WorkingSet::INVALID_ID;
+            PlanStage::StageState status = ss->work(&id);
+            if (PlanStage::ADVANCED != status) {
+                ASSERT_NE(status, PlanStage::FAILURE);
+                continue;
+            }
+            WorkingSetMember* member = exec->getWorkingSet()->get(id);
+            ASSERT(member->hasObj());
+            ASSERT(member->hasComputed(WSM_SORT_KEY));
+            ASSERT_EQUALS(expectedVal++, member->obj.value().getField("foo").Int());
+            ++count;
+        }
+        ASSERT_EQUALS(limit(), count);
+    }
+};
+
 // Should error out if we sort with parallel arrays.
 class QueryStageSortParallelArrays : public QueryStageSortTestBase {
 public:
@@ -587,6 +680,7 @@ public:
         add<QueryStageSortDeletionInvalidation>();
         add<QueryStageSortDeletionInvalidationWithLimit<10>>();
         add<QueryStageSortDeletionInvalidationWithLimit<1>>();
+        add<QueryStageSortLateMaterialization>();
         add<QueryStageSortParallelArrays>();
     }
 };
@@ -300,6 +300,8 @@ constexpr Milliseconds ConnectionPool::kDefaultHostTimeout;
 size_t const ConnectionPool::kDefaultMaxConns = std::numeric_limits<size_t>::max();
 size_t const ConnectionPool::kDefaultMinConns = 1;
 size_t const ConnectionPool::kDefaultMaxConnecting = std::numeric_limits<size_t>::max();
+size_t const ConnectionPool::kDefaultMultiplexedRequestsPerConnection = 16;
+constexpr Milliseconds ConnectionPool::kDefaultMultiplexedMaxTime;
 constexpr Milliseconds ConnectionPool::kDefaultRefreshRequirement;
 constexpr Milliseconds ConnectionPool::kDefaultRefreshTimeout;
 
@@ -78,6 +78,8 @@ public:
     static const size_t kDefaultMaxConns;
     static const size_t kDefaultMinConns;
     static const size_t kDefaultMaxConnecting;
+    static const size_t kDefaultMultiplexedRequestsPerConnection;
+    static constexpr Milliseconds kDefaultMultiplexedMaxTime = Milliseconds(1000);   // 1sec
     static constexpr Milliseconds kDefaultRefreshRequirement = Milliseconds(60000);  // 1min
     static constexpr Milliseconds kDefaultRefreshTimeout = Milliseconds(20000);      // 20secs
 
@@ -124,6 +126,28 @@ public:
          */
         Milliseconds hostTimeout = kDefaultHostTimeout;
 
+        /**
+         * The maximum number of connections per host over which the owning NetworkInterface
+         * multiplexes concurrent commands, matching replies to requests by responseTo. Zero
+         * disables multiplexing, in which case every in-flight command checks out a connection of
+         * its own.
+         */
+        size_t multiplexedConnectionsPerHost = 0;
+
+        /**
+         * The number of commands in flight on a multiplexed connection at which another connection
+         * to the same host is preferred, as long as fewer than multiplexedConnectionsPerHost are
+         * open. Past that limit commands go to the least loaded connection regardless.
+         */
+        size_t multiplexedRequestsPerConnection = kDefaultMultiplexedRequestsPerConnection;
+
+        /**
+         * The longest maxTimeMS a command may carry and still be multiplexed. The server runs the
+         * commands on a connection one after another, so commands which may run for longer, as
+         * well as tailable and awaitData queries and their getMores, get a connection of their own.
+         */
+        Milliseconds multiplexedMaxTime = kDefaultMultiplexedMaxTime;
+
         /**
          * An egress tag closer manager which will provide global access to this connection pool.
          * The manager set's tags and potentially drops connections that don't match those tags.
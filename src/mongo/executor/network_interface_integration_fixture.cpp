@@ -48,14 +48,11 @@ namespace executor {
 
 void NetworkInterfaceIntegrationFixture::startNet(
     std::unique_ptr<NetworkConnectionHook> connectHook) {
-    ConnectionPool::Options options;
-#ifdef _WIN32
-    // Connections won't queue on widnows, so attempting to open too many connections
-    // concurrently will result in refused connections and test failure.
-    options.maxConnections = 16u;
-#else
-    options.maxConnections = 256u;
-#endif
+    startNet(std::move(connectHook), makeConnectionPoolOptions());
+}
+
+void NetworkInterfaceIntegrationFixture::startNet(
+    std::unique_ptr<NetworkConnectionHook> connectHook, ConnectionPool::Options options) {
     _net = makeNetworkInterface(
         "NetworkInterfaceIntegrationFixture", std::move(connectHook), nullptr, std::move(options));
 
@@ -75,6 +72,18 @@ ConnectionString NetworkInterfaceIntegrationFixture::fixture() {
     return unittest::getFixtureConnectionString();
 }
 
+ConnectionPool::Options NetworkInterfaceIntegrationFixture::makeConnectionPoolOptions() {
+    ConnectionPool::Options options;
+#ifdef _WIN32
+    // Connections won't queue on widnows, so attempting to open too many connections
+    // concurrently will result in refused connections and test failure.
+    options.maxConnections = 16u;
+#else
+    options.maxConnections = 256u;
+#endif
+    return options;
+}
+
 void NetworkInterfaceIntegrationFixture::setRandomNumberGenerator(PseudoRandom* generator) {
     _rng = generator;
 }
@@ -38,6 +38,7 @@
 #include "mongo/client/connection_string.h"
 #include "mongo/db/commands/test_commands_enabled.h"
 #include "mongo/db/wire_version.h"
+#include "mongo/executor/connection_pool_stats.h"
 #include "mongo/executor/network_connection_hook.h"
 #include "mongo/executor/network_interface_integration_fixture.h"
 #include "mongo/executor/test_network_connection_hook.h"
@@ -51,6 +52,7 @@
 #include "mongo/util/assert_util.h"
 #include "mongo/util/log.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 namespace executor {
@@ -384,6 +386,153 @@ TEST_F(NetworkInterfaceTest, IsMasterRequestMissingInternalClientInfoWhenNotInte
     assertNumOps(0u, 0u, 0u, 1u);
 }
 
+class NetworkInterfaceMultiplexedTest : public NetworkInterfaceIntegrationFixture {
+public:
+    static constexpr size_t kConnectionsPerHost = 2;
+
+    void setUp() override {
+        setTestCommandsEnabled(true);
+
+        auto options = makeConnectionPoolOptions();
+        options.multiplexedConnectionsPerHost = kConnectionsPerHost;
+        options.multiplexedRequestsPerConnection = 4;
+        startNet(nullptr, std::move(options));
+    }
+};
+
+TEST_F(NetworkInterfaceMultiplexedTest, ConcurrentCommandsShareConnections) {
+    const int kNumCommands = 50;
+
+    std::vector<Future<RemoteCommandResponse>> deferreds;
+    for (int i = 0; i < kNumCommands; ++i) {
+        RemoteCommandRequest request{fixture().getServers().front(),
+                                     "admin",
+                                     BSON("echo" << 1 << "i" << i),
+                                     BSONObj(),
+                                     nullptr,
+                                     Minutes(5)};
+        deferreds.push_back(runCommand(makeCallbackHandle(), std::move(request)));
+    }
+
+    // Every reply must have been routed back to the request it answers.
+    for (int i = 0; i < kNumCommands; ++i) {
+        auto res = deferreds[i].get();
+        ASSERT_OK(res.status);
+        ASSERT_EQ(res.data.getObjectField("echo").getIntField("i"), i);
+    }
+
+    ConnectionPoolStats stats;
+    net().appendConnectionStats(&stats);
+    ASSERT_LTE(stats.totalCreated, kConnectionsPerHost);
+}
+
+/**
+ * Multiplexes every command over a single connection, so that a command sent after a slow one is
+ * stuck behind it until the server gets to it.
+ */
+class NetworkInterfaceSlowMultiplexedTest : public NetworkInterfaceIntegrationFixture {
+public:
+    static constexpr int kSlowCommandSecs = 3;
+
+    void setUp() override {
+        setTestCommandsEnabled(true);
+
+        auto options = makeConnectionPoolOptions();
+        options.multiplexedConnectionsPerHost = 1;
+        startNet(nullptr, std::move(options));
+    }
+
+    RemoteCommandRequest makeRequest(BSONObj cmdObj,
+                                     Milliseconds timeout = RemoteCommandRequest::kNoTimeout) {
+        return RemoteCommandRequest(
+            fixture().getServers().front(), "admin", cmdObj, BSONObj(), nullptr, timeout);
+    }
+
+    Future<RemoteCommandResponse> startSlowCommand(BSONObj extraFields = BSONObj()) {
+        BSONObjBuilder bob;
+        bob.append("sleep", 1);
+        bob.append("lock", "none");
+        bob.append("secs", kSlowCommandSecs);
+        bob.appendElements(extraFields);
+        return runCommand(makeCallbackHandle(), makeRequest(bob.obj()));
+    }
+
+    BSONObj makeEchoCommand() {
+        return BSON("echo" << 1 << "foo"
+                           << "bar");
+    }
+};
+
+TEST_F(NetworkInterfaceSlowMultiplexedTest, TimeOutCommandStuckBehindSlowOne) {
+    auto slow = startSlowCommand();
+    auto fast = runCommand(makeCallbackHandle(), makeRequest(makeEchoCommand(), Milliseconds(500)));
+
+    auto fastResult = fast.get();
+    auto slowResult = slow.get();
+
+    // mongos doesn't implement the sleep command, so nothing was stuck there.
+    if (pingCommandMissing(slowResult)) {
+        return;
+    }
+
+    // Abandoning the reply to the fast command must leave the slow one running.
+    ASSERT_EQ(ErrorCodes::NetworkInterfaceExceededTimeLimit, fastResult.status);
+    ASSERT_OK(slowResult.status);
+    ASSERT_OK(getStatusFromCommandResult(slowResult.data));
+
+    // The connection was retired, so later commands get a new one.
+    auto next = runCommand(makeCallbackHandle(), makeRequest(makeEchoCommand())).get();
+    ASSERT_OK(next.status);
+    ASSERT_OK(getStatusFromCommandResult(next.data));
+}
+
+TEST_F(NetworkInterfaceSlowMultiplexedTest, CancelCommandStuckBehindSlowOne) {
+    auto slow = startSlowCommand();
+
+    auto cbh = makeCallbackHandle();
+    auto fast = runCommand(cbh, makeRequest(makeEchoCommand()));
+    sleepmillis(100);
+    net().cancelCommand(cbh);
+
+    auto fastResult = fast.get();
+    auto slowResult = slow.get();
+
+    if (pingCommandMissing(slowResult)) {
+        return;
+    }
+
+    // The canceled command completes without waiting for the slow one.
+    ASSERT_EQ(ErrorCodes::CallbackCanceled, fastResult.status);
+    ASSERT(fastResult.elapsedMillis);
+    ASSERT_LT(*fastResult.elapsedMillis, Seconds(kSlowCommandSecs));
+    ASSERT_OK(slowResult.status);
+    ASSERT_OK(getStatusFromCommandResult(slowResult.data));
+
+    auto next = runCommand(makeCallbackHandle(), makeRequest(makeEchoCommand())).get();
+    ASSERT_OK(next.status);
+    ASSERT_OK(getStatusFromCommandResult(next.data));
+}
+
+TEST_F(NetworkInterfaceSlowMultiplexedTest, LongMaxTimeMSCommandGetsItsOwnConnection) {
+    // A maxTimeMS past multiplexedMaxTime sends the slow command on a connection of its own, so
+    // the fast one isn't stuck behind it.
+    auto slow = startSlowCommand(BSON("maxTimeMS" << 60 * 1000));
+    auto fast = runCommand(makeCallbackHandle(),
+                           makeRequest(makeEchoCommand(), Seconds(kSlowCommandSecs - 1)));
+
+    auto fastResult = fast.get();
+    auto slowResult = slow.get();
+
+    if (pingCommandMissing(slowResult)) {
+        return;
+    }
+
+    ASSERT_OK(fastResult.status);
+    ASSERT_OK(getStatusFromCommandResult(fastResult.data));
+    ASSERT_OK(slowResult.status);
+    ASSERT_OK(getStatusFromCommandResult(slowResult.data));
+}
+
 }  // namespace
 }  // namespace executor
 }  // namespace mongo
@@ -213,6 +213,15 @@ Status NetworkInterfaceTL::startCommand(const TaskExecutor::CallbackHandle& cbHa
         return Status::OK();
     }
 
+    if (_canMultiplex(request)) {
+        auto response = _getMultiplexedConn(state).then(
+            [ this, state, future = std::move(pf.future), baton ]() mutable {
+                return _onAcquireMultiplexedConn(state, std::move(future), baton);
+            });
+        _finishCommand(state, std::move(response), std::move(onFinish));
+        return Status::OK();
+    }
+
     // Interacting with the connection pool can involve more work than just getting a connection
     // out.  In particular, we can end up having to spin up new connections, and fulfilling promises
     // for other requesters.  Returning connections has the same issue.
@@ -252,30 +261,14 @@ Status NetworkInterfaceTL::startCommand(const TaskExecutor::CallbackHandle& cbHa
     auto remainingWork =
         [ this, state, future = std::move(pf.future), baton, onFinish = std::move(onFinish) ](
             StatusWith<std::shared_ptr<CommandState::ConnHandle>> swConn) mutable {
-        makeReadyFutureWith([&] {
-            return _onAcquireConn(
-                state, std::move(future), std::move(*uassertStatusOK(swConn)), baton);
-        })
-            .onError([](Status error) -> StatusWith<RemoteCommandResponse> {
-                // The TransportLayer has, for historical reasons returned SocketException for
-                // network errors, but sharding assumes HostUnreachable on network errors.
-                if (error == ErrorCodes::SocketException) {
-                    error = Status(ErrorCodes::HostUnreachable, error.reason());
-                }
-                return error;
-            })
-            .getAsync([ this, state, onFinish = std::move(onFinish) ](
-                StatusWith<RemoteCommandResponse> response) {
-                auto duration = now() - state->start;
-                if (!response.isOK()) {
-                    onFinish(RemoteCommandResponse(response.getStatus(), duration));
-                } else {
-                    const auto& rs = response.getValue();
-                    LOG(2) << "Request " << state->request.id << " finished with response: "
-                           << redact(rs.isOK() ? rs.data.toString() : rs.status.toString());
-                    onFinish(rs);
-                }
-            });
+        _finishCommand(state,
+                       makeReadyFutureWith([&] {
+                           return _onAcquireConn(state,
+                                                 std::move(future),
+                                                 std::move(*uassertStatusOK(swConn)),
+                                                 baton);
+                       }),
+                       std::move(onFinish));
     };
 
     if (baton) {
@@ -306,6 +299,64 @@ Status NetworkInterfaceTL::startCommand(const TaskExecutor::CallbackHandle& cbHa
     return Status::OK();
 }
 
+void NetworkInterfaceTL::_finishCommand(std::shared_ptr<CommandState> state,
+                                        Future<RemoteCommandResponse> response,
+                                        RemoteCommandCompletionFn&& onFinish) {
+    std::move(response)
+        .onError([](Status error) -> StatusWith<RemoteCommandResponse> {
+            // The TransportLayer has, for historical reasons returned SocketException for
+            // network errors, but sharding assumes HostUnreachable on network errors.
+            if (error == ErrorCodes::SocketException) {
+                error = Status(ErrorCodes::HostUnreachable, error.reason());
+            }
+            return error;
+        })
+        .getAsync([ this, state, onFinish = std::move(onFinish) ](
+            StatusWith<RemoteCommandResponse> response) {
+            auto duration = now() - state->start;
+            if (!response.isOK()) {
+                onFinish(RemoteCommandResponse(response.getStatus(), duration));
+            } else {
+                const auto& rs = response.getValue();
+                LOG(2) << "Request " << state->request.id << " finished with response: "
+                       << redact(rs.isOK() ? rs.data.toString() : rs.status.toString());
+                onFinish(rs);
+            }
+        });
+}
+
+void NetworkInterfaceTL::_armCommandTimer(std::shared_ptr<CommandState> state,
+                                          const BatonHandle& baton,
+                                          stdx::function<void()> cancelRemote) {
+    state->timer = _reactor->makeTimer();
+    state->timer->waitUntil(state->deadline, baton)
+        .getAsync([this, state, cancelRemote](Status status) {
+            if (status == ErrorCodes::CallbackCanceled) {
+                invariant(state->done.load());
+                return;
+            }
+
+            if (state->done.swap(true)) {
+                return;
+            }
+
+            if (getTestCommandsEnabled()) {
+                stdx::lock_guard<stdx::mutex> lk(_mutex);
+                _counters.timedOut++;
+            }
+
+            const std::string message = str::stream()
+                << "Request " << state->request.id << " timed out"
+                << ", deadline was " << state->deadline.toString() << ", op was "
+                << redact(state->request.toString());
+
+            LOG(2) << message;
+            state->promise.setError(Status(ErrorCodes::NetworkInterfaceExceededTimeLimit, message));
+
+            cancelRemote();
+        });
+}
+
 // This is only called from within a then() callback on a future, so throwing is equivalent to
 // returning a ready Future with a not-OK status.
 Future<RemoteCommandResponse> NetworkInterfaceTL::_onAcquireConn(
@@ -339,34 +390,7 @@ Future<RemoteCommandResponse> NetworkInterfaceTL::_onAcquireConn(
                                     << state->request.timeout);
         }
 
-        state->timer = _reactor->makeTimer();
-        state->timer->waitUntil(state->deadline, baton)
-            .getAsync([this, client, state, baton](Status status) {
-                if (status == ErrorCodes::CallbackCanceled) {
-                    invariant(state->done.load());
-                    return;
-                }
-
-                if (state->done.swap(true)) {
-                    return;
-                }
-
-                if (getTestCommandsEnabled()) {
-                    stdx::lock_guard<stdx::mutex> lk(_mutex);
-                    _counters.timedOut++;
-                }
-
-                const std::string message = str::stream()
-                    << "Request " << state->request.id << " timed out"
-                    << ", deadline was " << state->deadline.toString() << ", op was "
-                    << redact(state->request.toString());
-
-                LOG(2) << message;
-                state->promise.setError(
-                    Status(ErrorCodes::NetworkInterfaceExceededTimeLimit, message));
-
-                client->cancel(baton);
-            });
+        _armCommandTimer(state, baton, [client, baton] { client->cancel(baton); });
     }
 
     client->runCommandRequest(state->request, baton)
@@ -416,6 +440,322 @@ Future<RemoteCommandResponse> NetworkInterfaceTL::_onAcquireConn(
     return future;
 }
 
+bool NetworkInterfaceTL::_canMultiplex(const RemoteCommandRequest& request) const {
+    if (!_isMultiplexing()) {
+        return false;
+    }
+
+    // The server runs the commands on a connection one after another, so a command which may
+    // block for a long time would hold up every command queued behind it. Tailable and awaitData
+    // queries, and getMores with a maxTimeMS, which is only accepted for awaitData cursors, wait
+    // for new results, so they are sent on a connection of their own, as are commands allowed to
+    // run for longer than multiplexedMaxTime.
+    const auto& cmdObj = request.cmdObj;
+    if (cmdObj["tailable"].trueValue() || cmdObj["awaitData"].trueValue()) {
+        return false;
+    }
+
+    const auto maxTimeMS = cmdObj["maxTimeMS"];
+    if (maxTimeMS.isNumber()) {
+        if (StringData(cmdObj.firstElementFieldName()) == "getMore"_sd) {
+            return false;
+        }
+        if (Milliseconds(maxTimeMS.numberLong()) > _connPoolOpts.multiplexedMaxTime) {
+            return false;
+        }
+    }
+    return true;
+}
+
+AsyncDBClient* NetworkInterfaceTL::MultiplexedConnection::client() const {
+    return checked_cast<connection_pool_tl::TLConnection*>(conn.get())->client();
+}
+
+Future<void> NetworkInterfaceTL::_getMultiplexedConn(std::shared_ptr<CommandState> state) {
+    stdx::unique_lock<stdx::mutex> lk(_multiplexedMutex);
+    auto& host = _multiplexedHosts[state->request.target];
+
+    std::shared_ptr<MultiplexedConnection> leastLoaded;
+    size_t liveConns = 0;
+    for (const auto& conn : host.conns) {
+        if (conn->retired) {
+            continue;
+        }
+
+        ++liveConns;
+        if (!leastLoaded || conn->commands.size() < leastLoaded->commands.size()) {
+            leastLoaded = conn;
+        }
+    }
+
+    const bool canOpen =
+        liveConns + host.connecting < _connPoolOpts.multiplexedConnectionsPerHost;
+
+    if (leastLoaded) {
+        leastLoaded->commands.insert(state);
+        state->multiplexedConn = leastLoaded;
+
+        // Grow the set of connections in the background once the existing ones are busy, so that
+        // this command doesn't have to wait for a connection to be established.
+        const bool shouldOpen = canOpen &&
+            leastLoaded->commands.size() > _connPoolOpts.multiplexedRequestsPerConnection;
+        if (shouldOpen) {
+            ++host.connecting;
+        }
+        lk.unlock();
+
+        if (shouldOpen) {
+            _openMultiplexedConn(state->request);
+        }
+        return Future<void>::makeReady();
+    }
+
+    // There is no usable connection to this host yet, so wait for one to be established.
+    auto pf = makePromiseFuture<void>();
+    host.waiters.emplace_back(state, std::move(pf.promise));
+    if (canOpen) {
+        ++host.connecting;
+    }
+    lk.unlock();
+
+    if (canOpen) {
+        _openMultiplexedConn(state->request);
+    }
+    return std::move(pf.future);
+}
+
+void NetworkInterfaceTL::_openMultiplexedConn(const RemoteCommandRequest& request) {
+    auto target = request.target;
+    auto connFuture = [&] {
+        auto conn = _pool->tryGet(request.target, request.sslMode);
+
+        if (conn) {
+            return Future<ConnectionPool::ConnectionHandle>(std::move(*conn));
+        }
+
+        return _reactor->execute([this, request] {
+            return makeReadyFutureWith([this, request] {
+                return _pool->get(request.target, request.sslMode, request.timeout);
+            });
+        });
+    }();
+
+    std::move(connFuture)
+        .getAsync([this, target](StatusWith<ConnectionPool::ConnectionHandle> swConn) {
+            _onMultiplexedConnOpened(target, std::move(swConn));
+        });
+}
+
+void NetworkInterfaceTL::_onMultiplexedConnOpened(
+    const HostAndPort& target, StatusWith<ConnectionPool::ConnectionHandle> swConn) {
+    std::shared_ptr<MultiplexedConnection> mconn;
+    if (swConn.isOK()) {
+        auto conn = std::move(swConn.getValue());
+        auto deleter = conn.get_deleter();
+        mconn = std::make_shared<MultiplexedConnection>(
+            target,
+            CommandState::ConnHandle(conn.release(), CommandState::Deleter{deleter, _reactor}));
+    }
+
+    stdx::unique_lock<stdx::mutex> lk(_multiplexedMutex);
+    auto& host = _multiplexedHosts[target];
+    invariant(host.connecting > 0);
+    --host.connecting;
+
+    if (!mconn) {
+        LOG(2) << "Failed to get a multiplexed connection to " << target << ": "
+               << swConn.getStatus();
+
+        // Leave the waiters for any other connection still being established to this host.
+        if (host.connecting > 0) {
+            return;
+        }
+
+        auto waiters = std::exchange(host.waiters, {});
+        if (host.conns.empty()) {
+            _multiplexedHosts.erase(target);
+        }
+        lk.unlock();
+
+        for (auto& waiter : waiters) {
+            waiter.second.setError(swConn.getStatus());
+        }
+        return;
+    }
+
+    auto waiters = std::exchange(host.waiters, {});
+    if (waiters.empty()) {
+        // This connection was opened in anticipation of load which has since gone away. Returning
+        // it leaves it warm in the pool for the next command to this host.
+        if (host.conns.empty()) {
+            _multiplexedHosts.erase(target);
+        }
+        lk.unlock();
+
+        mconn->conn->indicateSuccess();
+        return;
+    }
+
+    for (auto& waiter : waiters) {
+        mconn->commands.insert(waiter.first);
+        waiter.first->multiplexedConn = mconn;
+    }
+    host.conns.push_back(mconn);
+    lk.unlock();
+
+    for (auto& waiter : waiters) {
+        waiter.second.emplaceValue();
+    }
+}
+
+// Like _onAcquireConn(), this is only called from within a then() callback on a future, so
+// throwing is equivalent to returning a ready Future with a not-OK status.
+Future<RemoteCommandResponse> NetworkInterfaceTL::_onAcquireMultiplexedConn(
+    std::shared_ptr<CommandState> state,
+    Future<RemoteCommandResponse> future,
+    const BatonHandle& baton) {
+    if (MONGO_FAIL_POINT(networkInterfaceDiscardCommandsAfterAcquireConn)) {
+        _releaseMultiplexedConn(state, Status::OK());
+        return future;
+    }
+
+    if (state->done.load()) {
+        _releaseMultiplexedConn(state, Status::OK());
+        uasserted(ErrorCodes::CallbackCanceled, "Command was canceled");
+    }
+
+    auto client = [&] {
+        stdx::lock_guard<stdx::mutex> lk(_multiplexedMutex);
+        return state->multiplexedConn->client();
+    }();
+
+    if (state->deadline != RemoteCommandRequest::kNoExpirationDate) {
+        auto nowVal = now();
+        if (nowVal >= state->deadline) {
+            _releaseMultiplexedConn(state, Status::OK());
+            auto connDuration = nowVal - state->start;
+            uasserted(ErrorCodes::NetworkInterfaceExceededTimeLimit,
+                      str::stream() << "Remote command timed out while waiting to get a "
+                                       "multiplexed connection, took "
+                                    << connDuration
+                                    << ", timeout was set to "
+                                    << state->request.timeout);
+        }
+
+        _armCommandTimer(state, baton, [this, state] { _retireMultiplexedConn(state); });
+    }
+
+    client->runMultiplexedCommandRequest(state->request)
+        .then([this, state](RemoteCommandResponse response) {
+            _eraseInUseConn(state->cbHandle);
+            _releaseMultiplexedConn(state, response.status);
+
+            if (state->done.load()) {
+                uasserted(ErrorCodes::CallbackCanceled, "Callback was canceled");
+            }
+
+            if (_metadataHook && response.status.isOK()) {
+                auto target = state->request.target.toString();
+                response.status =
+                    _metadataHook->readReplyMetadata(nullptr, std::move(target), response.data);
+            }
+
+            return RemoteCommandResponse(std::move(response));
+        })
+        .getAsync([this, state, baton](StatusWith<RemoteCommandResponse> swr) {
+            if (state->done.swap(true))
+                return;
+
+            if (getTestCommandsEnabled()) {
+                stdx::lock_guard<stdx::mutex> lk(_mutex);
+                if (swr.isOK() && swr.getValue().status.isOK()) {
+                    _counters.succeeded++;
+                } else {
+                    _counters.failed++;
+                }
+            }
+
+            if (state->timer) {
+                state->timer->cancel(baton);
+            }
+
+            state->promise.setFromStatusWith(std::move(swr));
+        });
+
+    return future;
+}
+
+void NetworkInterfaceTL::_releaseMultiplexedConn(const std::shared_ptr<CommandState>& state,
+                                                 const Status& status) {
+    stdx::unique_lock<stdx::mutex> lk(_multiplexedMutex);
+    auto mconn = std::exchange(state->multiplexedConn, nullptr);
+    if (!mconn) {
+        return;
+    }
+
+    mconn->commands.erase(state);
+    if (!status.isOK()) {
+        mconn->retired = true;
+    }
+
+    if (!mconn->commands.empty()) {
+        // If everything left on a retired connection has been abandoned, nobody is waiting for
+        // the outstanding replies, so close the connection rather than wait for them.
+        const bool shouldClose = mconn->retired &&
+            std::all_of(mconn->commands.begin(),
+                        mconn->commands.end(),
+                        [](const std::shared_ptr<CommandState>& command) {
+                            return command->done.load();
+                        });
+        lk.unlock();
+
+        if (shouldClose) {
+            mconn->client()->cancel();
+        }
+        return;
+    }
+
+    // This was the last command on the connection, so hand it back to the pool.
+    auto hostIt = _multiplexedHosts.find(mconn->target);
+    if (hostIt != _multiplexedHosts.end()) {
+        auto& host = hostIt->second;
+        host.conns.erase(std::remove(host.conns.begin(), host.conns.end(), mconn),
+                         host.conns.end());
+        if (host.conns.empty() && host.connecting == 0 && host.waiters.empty()) {
+            _multiplexedHosts.erase(hostIt);
+        }
+    }
+    lk.unlock();
+
+    if (status.isOK()) {
+        mconn->conn->indicateUsed();
+        mconn->conn->indicateSuccess();
+    } else {
+        mconn->conn->indicateFailure(status);
+    }
+    mconn->conn.reset();
+}
+
+void NetworkInterfaceTL::_retireMultiplexedConn(const std::shared_ptr<CommandState>& state) {
+    stdx::unique_lock<stdx::mutex> lk(_multiplexedMutex);
+    auto mconn = state->multiplexedConn;
+    if (!mconn) {
+        // The command is still waiting for a connection and will give it up once it gets one.
+        return;
+    }
+
+    mconn->retired = true;
+    const bool shouldClose = std::all_of(
+        mconn->commands.begin(),
+        mconn->commands.end(),
+        [](const std::shared_ptr<CommandState>& command) { return command->done.load(); });
+    lk.unlock();
+
+    if (shouldClose) {
+        mconn->client()->cancel();
+    }
+}
+
 void NetworkInterfaceTL::_eraseInUseConn(const TaskExecutor::CallbackHandle& cbHandle) {
     stdx::lock_guard<stdx::mutex> lk(_inProgressMutex);
     _inProgress.erase(cbHandle);
@@ -448,6 +788,10 @@ void NetworkInterfaceTL::cancelCommand(const TaskExecutor::CallbackHandle& cbHan
     if (state->conn) {
         auto client = checked_cast<connection_pool_tl::TLConnection*>(state->conn.get());
         client->client()->cancel(baton);
+    } else if (_isMultiplexing()) {
+        // Canceling the session would fail every other command sharing the connection, so the
+        // reply to this one is just abandoned instead.
+        _retireMultiplexedConn(state);
     }
 }
 
@@ -577,6 +921,16 @@ bool NetworkInterfaceTL::onNetworkThread() {
 }
 
 void NetworkInterfaceTL::dropConnections(const HostAndPort& hostAndPort) {
+    if (_isMultiplexing()) {
+        stdx::lock_guard<stdx::mutex> lk(_multiplexedMutex);
+        auto it = _multiplexedHosts.find(hostAndPort);
+        if (it != _multiplexedHosts.end()) {
+            for (auto& conn : it->second.conns) {
+                conn->retired = true;
+            }
+        }
+    }
+
     _pool->dropConnections(hostAndPort);
 }
 
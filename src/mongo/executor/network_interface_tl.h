@@ -30,6 +30,7 @@
 #pragma once
 
 #include <deque>
+#include <vector>
 
 #include "mongo/client/async_client.h"
 #include "mongo/db/service_context.h"
@@ -38,6 +39,7 @@
 #include "mongo/rpc/metadata/metadata_hook.h"
 #include "mongo/stdx/thread.h"
 #include "mongo/stdx/unordered_map.h"
+#include "mongo/stdx/unordered_set.h"
 #include "mongo/transport/baton.h"
 #include "mongo/transport/transport_layer.h"
 
@@ -84,6 +86,8 @@ public:
     void dropConnections(const HostAndPort& hostAndPort) override;
 
 private:
+    struct MultiplexedConnection;
+
     struct CommandState {
         CommandState(RemoteCommandRequest request_,
                      TaskExecutor::CallbackHandle cbHandle_,
@@ -108,12 +112,41 @@ private:
         using ConnHandle = std::unique_ptr<ConnectionPool::ConnectionInterface, Deleter>;
 
         ConnHandle conn;
+        // Only used when multiplexing is enabled, in place of conn. Guarded by _multiplexedMutex.
+        std::shared_ptr<MultiplexedConnection> multiplexedConn;
         std::unique_ptr<transport::ReactorTimer> timer;
 
         AtomicWord<bool> done;
         Promise<RemoteCommandResponse> promise;
     };
 
+    /**
+     * A pooled connection shared by the concurrent commands to one host while multiplexing is
+     * enabled. It stays checked out of the pool for as long as any command is in flight on it.
+     */
+    struct MultiplexedConnection {
+        MultiplexedConnection(HostAndPort target_, CommandState::ConnHandle conn_)
+            : target(std::move(target_)), conn(std::move(conn_)) {}
+
+        AsyncDBClient* client() const;
+
+        const HostAndPort target;
+        CommandState::ConnHandle conn;
+        stdx::unordered_set<std::shared_ptr<CommandState>> commands;
+
+        // A retired connection takes no new commands. It is retired once a command on it fails,
+        // times out or is canceled, and is closed early if only abandoned commands remain on it.
+        bool retired = false;
+    };
+
+    struct MultiplexedHost {
+        std::vector<std::shared_ptr<MultiplexedConnection>> conns;
+        size_t connecting = 0;
+
+        // Commands waiting for a connection to this host to finish being established.
+        std::vector<std::pair<std::shared_ptr<CommandState>, Promise<void>>> waiters;
+    };
+
     struct AlarmState {
         AlarmState(Date_t when_,
                    TaskExecutor::CallbackHandle cbHandle_,
@@ -140,6 +173,26 @@ private:
                                                  Future<RemoteCommandResponse> future,
                                                  CommandState::ConnHandle conn,
                                                  const BatonHandle& baton);
+    void _finishCommand(std::shared_ptr<CommandState> state,
+                        Future<RemoteCommandResponse> response,
+                        RemoteCommandCompletionFn&& onFinish);
+    void _armCommandTimer(std::shared_ptr<CommandState> state,
+                          const BatonHandle& baton,
+                          stdx::function<void()> cancelRemote);
+
+    bool _isMultiplexing() const {
+        return _connPoolOpts.multiplexedConnectionsPerHost > 0;
+    }
+    bool _canMultiplex(const RemoteCommandRequest& request) const;
+    Future<void> _getMultiplexedConn(std::shared_ptr<CommandState> state);
+    void _openMultiplexedConn(const RemoteCommandRequest& request);
+    void _onMultiplexedConnOpened(const HostAndPort& target,
+                                  StatusWith<ConnectionPool::ConnectionHandle> swConn);
+    Future<RemoteCommandResponse> _onAcquireMultiplexedConn(std::shared_ptr<CommandState> state,
+                                                            Future<RemoteCommandResponse> future,
+                                                            const BatonHandle& baton);
+    void _releaseMultiplexedConn(const std::shared_ptr<CommandState>& state, const Status& status);
+    void _retireMultiplexedConn(const std::shared_ptr<CommandState>& state);
 
     std::string _instanceName;
     ServiceContext* _svcCtx;
@@ -163,6 +216,9 @@ private:
     stdx::unordered_map<TaskExecutor::CallbackHandle, std::shared_ptr<AlarmState>>
         _inProgressAlarms;
 
+    stdx::mutex _multiplexedMutex;
+    stdx::unordered_map<HostAndPort, MultiplexedHost> _multiplexedHosts;
+
     stdx::condition_variable _workReadyCond;
     bool _isExecutorRunnable = false;
 };
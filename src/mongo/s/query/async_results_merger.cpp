@@ -126,7 +126,9 @@ bool AsyncResultsMerger::remotesExhausted() const {
 
 bool AsyncResultsMerger::_remotesExhausted(WithLock) const {
     for (const auto& remote : _remotes) {
-        if (!remote.exhausted()) {
+        // A remote which was pruned while a request to it was outstanding is not considered
+        // exhausted until the callback for that request has run.
+        if (!remote.exhausted() || remote.cbHandle.isValid()) {
             return false;
         }
     }
@@ -287,7 +289,11 @@ StatusWith<ClusterQueryResult> AsyncResultsMerger::nextReady() {
         return {ClusterQueryResult()};
     }
 
-    return _params.getSort() ? _nextReadySorted(lk) : _nextReadyUnsorted(lk);
+    auto result = _params.getSort() ? _nextReadySorted(lk) : _nextReadyUnsorted(lk);
+    if (!result.isEOF()) {
+        ++_numResultsReturned;
+    }
+    return result;
 }
 
 ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock) {
@@ -353,7 +359,7 @@ ClusterQueryResult AsyncResultsMerger::_nextReadyUnsorted(WithLock) {
     return {};
 }
 
-Status AsyncResultsMerger::_askForNextBatch(WithLock, size_t remoteIndex) {
+Status AsyncResultsMerger::_askForNextBatch(WithLock lk, size_t remoteIndex) {
     invariant(_opCtx, "Cannot schedule a getMore without an OperationContext");
     auto& remote = _remotes[remoteIndex];
 
@@ -368,6 +374,14 @@ Status AsyncResultsMerger::_askForNextBatch(WithLock, size_t remoteIndex) {
         adjustedBatchSize = *_params.getBatchSize() - remote.fetchedCount;
     }
 
+    // No single remote can contribute more results than the merging operation still needs, so
+    // avoid making the remote produce a batch which will be discarded.
+    if (auto remaining = _remainingLimit(lk)) {
+        const std::int64_t limitBatchSize = std::max(*remaining, 1LL);
+        adjustedBatchSize = adjustedBatchSize ? std::min(*adjustedBatchSize, limitBatchSize)
+                                              : limitBatchSize;
+    }
+
     BSONObj cmdObj = GetMoreRequest(remote.cursorNss,
                                     remote.cursorId,
                                     adjustedBatchSize,
@@ -418,6 +432,9 @@ Status AsyncResultsMerger::scheduleGetMores() {
 }
 
 Status AsyncResultsMerger::_scheduleGetMores(WithLock lk) {
+    // Avoid asking for more results from remotes which can no longer contribute to the merge.
+    _pruneLaggingRemotes(lk);
+
     // Schedule remote work on hosts for which we need more results.
     for (size_t i = 0; i < _remotes.size(); ++i) {
         auto& remote = _remotes[i];
@@ -600,6 +617,11 @@ void AsyncResultsMerger::_processBatchResults(WithLock lk,
                                               CbResponse const& response,
                                               size_t remoteIndex) {
     auto& remote = _remotes[remoteIndex];
+    if (remote.exhausted()) {
+        // The remote was pruned while this request was outstanding and its cursor has already been
+        // killed, so whatever it returned can no longer contribute to the merge.
+        return;
+    }
     if (!response.isOK()) {
         _cleanUpFailedBatch(lk, response.status, remoteIndex);
         return;
@@ -623,6 +645,9 @@ void AsyncResultsMerger::_processBatchResults(WithLock lk,
         return;
     }
 
+    // The new results may be enough to satisfy the limit without waiting on the other remotes.
+    _pruneLaggingRemotes(lk);
+
     // If the cursor is tailable and we just received an empty batch, the next return value should
     // be boost::none in order to indicate the end of the batch. We do not ask for the next batch if
     // the cursor is tailable, as batches received from remote tailable cursors should be passed
@@ -675,11 +700,80 @@ bool AsyncResultsMerger::_addBatchToBuffer(WithLock lk,
     // If we're doing a sorted merge, then we have to make sure to put this remote onto the merge
     // queue.
     if (_params.getSort() && !response.getBatch().empty()) {
+        remote.lastSortKey =
+            extractSortKey(response.getBatch().back(), _params.getCompareWholeSortKey()).getOwned();
         _mergeQueue.push(remoteIndex);
     }
     return true;
 }
 
+boost::optional<long long> AsyncResultsMerger::_remainingLimit(WithLock) const {
+    if (!_params.getLimit()) {
+        return boost::none;
+    }
+    return std::max(*_params.getLimit() - _numResultsReturned, 0LL);
+}
+
+void AsyncResultsMerger::_pruneLaggingRemotes(WithLock lk) {
+    auto remaining = _remainingLimit(lk);
+    if (!remaining || _tailableMode != TailableModeEnum::kNormal || _lifecycleState != kAlive ||
+        !_opCtx) {
+        return;
+    }
+
+    const auto& sort = _params.getSort();
+    for (size_t i = 0; i < _remotes.size(); ++i) {
+        auto& remote = _remotes[i];
+        if (remote.hasNext() || remote.exhausted() || !remote.status.isOK()) {
+            continue;
+        }
+
+        // Without a sort key from this remote we know nothing about where its results will fall in
+        // the merged stream.
+        if (sort && !remote.lastSortKey) {
+            continue;
+        }
+
+        // Count the buffered results which will be returned before anything this remote may still
+        // produce. For a sorted merge, results whose sort key ties with the remote's last sort key
+        // count as well, since the relative order of equal keys from different remotes is
+        // arbitrary. Each remote's buffer is sorted, so it suffices to look at its first and last
+        // keys; a partially preceding buffer contributes only its first result to the count.
+        long long numPreceding = 0;
+        for (size_t j = 0; j < _remotes.size() && numPreceding < *remaining; ++j) {
+            const auto& other = _remotes[j];
+            if (j == i || !other.hasNext()) {
+                continue;
+            }
+
+            if (!sort || compareSortKeys(*other.lastSortKey, *remote.lastSortKey, *sort) <= 0) {
+                numPreceding += other.docBuffer.size();
+            } else if (compareSortKeys(extractSortKey(*other.docBuffer.front().getResult(),
+                                                      _params.getCompareWholeSortKey()),
+                                       *remote.lastSortKey,
+                                       *sort) <= 0) {
+                ++numPreceding;
+            }
+        }
+
+        if (numPreceding < *remaining) {
+            continue;
+        }
+
+        LOG(1) << "Closing cursor " << remote.cursorId << " on " << remote.shardHostAndPort
+               << " since its results can no longer contribute to the remaining " << *remaining
+               << " results of the merge";
+
+        if (remote.cbHandle.isValid()) {
+            _executor->cancel(remote.cbHandle);
+        }
+        _scheduleKillCursor(lk, _opCtx, remote);
+
+        // Treat the remote as exhausted so that the merge no longer waits on it.
+        remote.cursorId = 0;
+    }
+}
+
 void AsyncResultsMerger::_signalCurrentEventIfReady(WithLock lk) {
     if (_ready(lk) && _currentEvent.isValid()) {
         // To prevent ourselves from signalling the event twice, we set '_currentEvent' as
@@ -699,22 +793,28 @@ bool AsyncResultsMerger::_haveOutstandingBatchRequests(WithLock) {
     return false;
 }
 
-void AsyncResultsMerger::_scheduleKillCursors(WithLock, OperationContext* opCtx) {
+void AsyncResultsMerger::_scheduleKillCursors(WithLock lk, OperationContext* opCtx) {
     invariant(_killCompleteEvent.isValid());
 
     for (const auto& remote : _remotes) {
         if (remote.status.isOK() && remote.cursorId && !remote.exhausted()) {
-            BSONObj cmdObj = KillCursorsRequest(_params.getNss(), {remote.cursorId}).toBSON();
-
-            executor::RemoteCommandRequest request(
-                remote.getTargetHost(), _params.getNss().db().toString(), cmdObj, opCtx);
-
-            // Send kill request; discard callback handle, if any, or failure report, if not.
-            _executor->scheduleRemoteCommand(request, [](auto const&) {}).getStatus().ignore();
+            _scheduleKillCursor(lk, opCtx, remote);
         }
     }
 }
 
+void AsyncResultsMerger::_scheduleKillCursor(WithLock,
+                                             OperationContext* opCtx,
+                                             const RemoteCursorData& remote) {
+    BSONObj cmdObj = KillCursorsRequest(_params.getNss(), {remote.cursorId}).toBSON();
+
+    executor::RemoteCommandRequest request(
+        remote.getTargetHost(), _params.getNss().db().toString(), cmdObj, opCtx);
+
+    // Send kill request; discard callback handle, if any, or failure report, if not.
+    _executor->scheduleRemoteCommand(request, [](auto const&) {}).getStatus().ignore();
+}
+
 executor::TaskExecutor::EventHandle AsyncResultsMerger::kill(OperationContext* opCtx) {
     stdx::lock_guard<stdx::mutex> lk(_mutex);
 
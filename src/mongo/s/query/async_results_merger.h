@@ -67,6 +67,13 @@ class CursorResponse;
  * This requires waiting until we have a response from every remote before returning results.
  * Without a sort, we are ready to return results as soon as we have *any* response from a remote.
  *
+ * If the merging operation only consumes a known number of results (the 'limit' parameter), the
+ * merge stops waiting on any remote which can no longer contribute to that many results: once the
+ * other remotes have buffered enough results, its cursor is killed and it is treated as exhausted.
+ * Without a sort any buffered results count; with a sort only those whose sort key is before or
+ * equal to the last sort key the remote has returned do. The getMore batch size is also capped at
+ * the number of results which are still needed.
+ *
  * On any error, the caller is responsible for shutting down the ARM using the kill() method.
  *
  * Does not throw exceptions.
@@ -302,6 +309,11 @@ private:
         // Count of fetched docs during ARM processing of the current batch. Used to reduce the
         // batchSize in getMore when mongod returned less docs than the requested batchSize.
         long long fetchedCount = 0;
+
+        // For sorted merges, the sort key of the last result received from this remote. Since the
+        // remote returns results in sort order, it will never return a result which sorts before
+        // this key.
+        boost::optional<BSONObj> lastSortKey;
     };
 
     class MergingComparator {
@@ -440,6 +452,27 @@ private:
      */
     void _scheduleKillCursors(WithLock, OperationContext* opCtx);
 
+    /**
+     * Schedules a killCursors command for the cursor open on the given remote, ignoring the result.
+     */
+    void _scheduleKillCursor(WithLock, OperationContext* opCtx, const RemoteCursorData& remote);
+
+    /**
+     * For merges with a limit, kills the cursors of any remotes which have no buffered results
+     * and can no longer contribute to the results still required by the limit, and marks them as
+     * exhausted so that the merge no longer waits on them. A remote can be pruned once the other
+     * remotes have buffered at least as many results as are still needed. For a sorted merge, only
+     * results whose sort key is before or equal to the last sort key received from the remote
+     * count towards that.
+     */
+    void _pruneLaggingRemotes(WithLock);
+
+    /**
+     * Returns the number of results which the merging operation may still consume, or boost::none
+     * if there is no limit.
+     */
+    boost::optional<long long> _remainingLimit(WithLock) const;
+
     /**
      * Updates the given remote's metadata (e.g. the cursor id) based on information in 'response'.
      */
@@ -481,6 +514,10 @@ private:
     // For sorted tailable cursors, records the current high-water-mark sort key. Empty otherwise.
     BSONObj _highWaterMark;
 
+    // The number of results which have been returned from nextReady(). Used to determine how many
+    // results are still needed when a limit is set.
+    long long _numResultsReturned = 0;
+
     //
     // Killing
     //
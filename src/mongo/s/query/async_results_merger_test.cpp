@@ -1115,6 +1115,118 @@ TEST_F(AsyncResultsMergerTest, GetMoreBatchSizes) {
     ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
 }
 
+TEST_F(AsyncResultsMergerTest, GetMoreBatchSizeCappedByRemainingLimit) {
+    BSONObj findCmd = fromjson("{find: 'testcoll'}");
+    std::vector<RemoteCursor> cursors;
+    std::vector<BSONObj> batch1 = {fromjson("{_id: 1}"), fromjson("{_id: 2}")};
+    cursors.push_back(makeRemoteCursor(
+        kTestShardIds[0], kTestShardHosts[0], CursorResponse(kTestNss, 1, batch1)));
+    auto params = makeARMParamsFromExistingCursors(std::move(cursors), findCmd, 10);
+    params.setLimit(5);
+    auto arm =
+        stdx::make_unique<AsyncResultsMerger>(operationContext(), executor(), std::move(params));
+
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{_id: 1}"), *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{_id: 2}"), *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_FALSE(arm->ready());
+
+    // Only three more results will be consumed, so the getMore should not ask for the full batch.
+    auto readyEvent = unittest::assertGet(arm->nextEvent());
+    BSONObj scheduledCmd = getNthPendingRequest(0).cmdObj;
+    auto request = GetMoreRequest::parseFromBSON("anydbname", scheduledCmd);
+    ASSERT_OK(request.getStatus());
+    ASSERT_EQ(*request.getValue().batchSize, 3LL);
+
+    std::vector<CursorResponse> responses;
+    std::vector<BSONObj> batch2 = {fromjson("{_id: 3}")};
+    responses.emplace_back(kTestNss, CursorId(0), batch2);
+    scheduleNetworkResponses(std::move(responses));
+    executor()->waitForEvent(readyEvent);
+
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{_id: 3}"), *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_TRUE(arm->ready());
+    ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
+}
+
+TEST_F(AsyncResultsMergerTest, UnsortedLimitKillsLaggingRemotes) {
+    std::vector<RemoteCursor> cursors;
+    cursors.push_back(
+        makeRemoteCursor(kTestShardIds[0], kTestShardHosts[0], CursorResponse(kTestNss, 1, {})));
+    cursors.push_back(
+        makeRemoteCursor(kTestShardIds[1], kTestShardHosts[1], CursorResponse(kTestNss, 2, {})));
+    cursors.push_back(
+        makeRemoteCursor(kTestShardIds[2], kTestShardHosts[2], CursorResponse(kTestNss, 3, {})));
+    auto params = makeARMParamsFromExistingCursors(std::move(cursors));
+    params.setLimit(2);
+    auto arm =
+        stdx::make_unique<AsyncResultsMerger>(operationContext(), executor(), std::move(params));
+
+    ASSERT_FALSE(arm->ready());
+    auto readyEvent = unittest::assertGet(arm->nextEvent());
+    ASSERT_FALSE(arm->ready());
+
+    // The first shard returns enough results to satisfy the limit.
+    std::vector<CursorResponse> responses;
+    std::vector<BSONObj> batch1 = {fromjson("{_id: 1}"), fromjson("{_id: 2}")};
+    responses.emplace_back(kTestNss, CursorId(1), batch1);
+    scheduleNetworkResponses(std::move(responses));
+
+    // The outstanding getMores on the other shards are canceled, and their cursors are killed.
+    assertKillCusorsCmdHasCursorId(getNthPendingRequest(0u).cmdObj, 2);
+    assertKillCusorsCmdHasCursorId(getNthPendingRequest(1u).cmdObj, 3);
+    runReadyCallbacks();
+
+    executor()->waitForEvent(readyEvent);
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{_id: 1}"), *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{_id: 2}"), *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_FALSE(arm->remotesExhausted());
+
+    // Once the limit has been reached, the ARM does not ask the first shard for more results.
+    ASSERT_FALSE(arm->ready());
+    readyEvent = unittest::assertGet(arm->nextEvent());
+    assertKillCusorsCmdHasCursorId(getNthPendingRequest(2u).cmdObj, 1);
+    executor()->waitForEvent(readyEvent);
+    ASSERT_TRUE(arm->ready());
+    ASSERT_TRUE(arm->remotesExhausted());
+    ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
+}
+
+TEST_F(AsyncResultsMergerTest, SortedLimitDoesNotWaitOnRemoteOnceSatisfied) {
+    BSONObj findCmd = fromjson("{find: 'testcoll', sort: {_id: 1}}");
+    std::vector<RemoteCursor> cursors;
+    std::vector<BSONObj> batch1 = {fromjson("{$sortKey: {'': 1}}")};
+    cursors.push_back(makeRemoteCursor(
+        kTestShardIds[0], kTestShardHosts[0], CursorResponse(kTestNss, 1, batch1)));
+    std::vector<BSONObj> batch2 = {fromjson("{$sortKey: {'': 2}}")};
+    cursors.push_back(makeRemoteCursor(
+        kTestShardIds[1], kTestShardHosts[1], CursorResponse(kTestNss, 2, batch2)));
+    auto params = makeARMParamsFromExistingCursors(std::move(cursors), findCmd);
+    params.setLimit(1);
+    auto arm =
+        stdx::make_unique<AsyncResultsMerger>(operationContext(), executor(), std::move(params));
+
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: {'': 1}}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+
+    // The first shard has no buffered results, but nothing it returns could be used, so rather than
+    // scheduling a getMore the ARM kills its cursor and is immediately ready.
+    ASSERT_FALSE(arm->ready());
+    auto readyEvent = unittest::assertGet(arm->nextEvent());
+    ASSERT_TRUE(arm->ready());
+    assertKillCusorsCmdHasCursorId(getNthPendingRequest(0u).cmdObj, 1);
+    executor()->waitForEvent(readyEvent);
+
+    auto killEvent = arm->kill(operationContext());
+    assertKillCusorsCmdHasCursorId(getNthPendingRequest(1u).cmdObj, 2);
+    executor()->waitForEvent(killEvent);
+}
+
 TEST_F(AsyncResultsMergerTest, AllowPartialResults) {
     BSONObj findCmd = fromjson("{find: 'testcoll', allowPartialResults: true}");
     std::vector<RemoteCursor> cursors;
@@ -85,6 +85,11 @@ struct ClusterClientCursorParams {
         armParams.setRemotes(std::move(remotes));
         armParams.setTailableMode(tailableMode);
         armParams.setBatchSize(batchSize);
+        if (limit) {
+            // The skip is applied on top of the merge, so the merge must produce both the results
+            // to be skipped and the results to be returned.
+            armParams.setLimit(*limit + skip.value_or(0));
+        }
         armParams.setNss(nsString);
         armParams.setAllowPartialResults(isAllowPartialResults);
 
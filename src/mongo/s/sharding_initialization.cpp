@@ -184,6 +184,13 @@ Status initializeGlobalShardingState(OperationContext* opCtx,
         ? gShardingTaskExecutorPoolMaxConnecting
         : ConnectionPool::kDefaultMaxConnecting;
 
+    connPoolOptions.multiplexedConnectionsPerHost =
+        gShardingTaskExecutorPoolMultiplexedConnectionsPerHost;
+    connPoolOptions.multiplexedRequestsPerConnection =
+        gShardingTaskExecutorPoolMultiplexedRequestsPerConnection;
+    connPoolOptions.multiplexedMaxTime =
+        Milliseconds(gShardingTaskExecutorPoolMultiplexedMaxTimeMS);
+
     connPoolOptions.hostTimeout = Milliseconds(gShardingTaskExecutorPoolHostTimeoutMS);
     connPoolOptions.refreshRequirement =
         Milliseconds(gShardingTaskExecutorPoolRefreshRequirementMS);